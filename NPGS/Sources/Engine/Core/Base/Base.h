@@ -36,6 +36,8 @@
 #define _ASTRO_END }
 #define _CONFIG_BEGIN namespace Config {
 #define _CONFIG_END }
+#define _DYNAMICS_BEGIN namespace Dynamics {
+#define _DYNAMICS_END }
 #define _GENERATOR_BEGIN namespace Generator {
 #define _GENERATOR_END }
 #define _GRAPHICS_BEGIN namespace Graphics {
@@ -48,6 +50,8 @@
 #define _NPGS_END }
 #define _RUNTIME_BEGIN namespace Runtime {
 #define _RUNTIME_END }
+#define _SIMULATION_BEGIN namespace Simulation {
+#define _SIMULATION_END }
 #define _SPATIAL_BEGIN namespace Spatial {
 #define _SPATIAL_END }
 #define _SYSTEM_BEGIN namespace System {
@@ -52,5 +52,6 @@ inline constexpr int   kDayToSecond              = 86400;
 inline constexpr int   kPascalToAtm              = 101325;
 inline constexpr std::uint64_t kAuToMeter        = 149597870700;
 inline constexpr std::uint64_t kLightYearToMeter = 9460730472580800;
+inline constexpr float kParsecToLightYear        = 3.2615638f;
 
 _NPGS_END
@@ -0,0 +1,68 @@
+#include "Uint128.h"
+
+#include <cmath>
+#include <limits>
+
+_NPGS_BEGIN
+_MATH_BEGIN
+
+// FUint128 implementations
+// ------------------------
+double FUint128::ToDouble() const
+{
+    return std::ldexp(static_cast<double>(_High), 64) + static_cast<double>(_Low);
+}
+
+FUint128 FUint128::FromDouble(double Value)
+{
+    if (!(Value >= 1.0))
+    {
+        return {};
+    }
+
+    if (Value >= std::ldexp(1.0, 128))
+    {
+        return { std::numeric_limits<std::uint64_t>::max(), std::numeric_limits<std::uint64_t>::max() };
+    }
+
+    Value = std::trunc(Value);
+    if (Value < std::ldexp(1.0, 64))
+    {
+        return { static_cast<std::uint64_t>(Value), 0 };
+    }
+
+    // 大于 2^64 的 double 尾数不足 64 位，拆分为高低两部分时都是精确的
+    double High = std::floor(std::ldexp(Value, -64));
+    double Low  = Value - std::ldexp(High, 64);
+    return { static_cast<std::uint64_t>(Low), static_cast<std::uint64_t>(High) };
+}
+
+FUint128 FUint128::DivideSlow(const FUint128& Dividend, const FUint128& Divisor)
+{
+    // 除数超过 64 位时商不超过 64 位，逐位移位相减
+    FUint128 Quotient;
+    FUint128 Remainder;
+    for (int i = 127; i >= 0; --i)
+    {
+        Remainder._High = (Remainder._High << 1) | (Remainder._Low >> 63);
+        Remainder._Low  = (Remainder._Low  << 1) | ((i >= 64 ? Dividend._High >> (i - 64) : Dividend._Low >> i) & 1);
+
+        if (Remainder >= Divisor)
+        {
+            Remainder -= Divisor;
+            if (i >= 64)
+            {
+                Quotient._High |= std::uint64_t(1) << (i - 64);
+            }
+            else
+            {
+                Quotient._Low |= std::uint64_t(1) << i;
+            }
+        }
+    }
+
+    return Quotient;
+}
+
+_MATH_END
+_NPGS_END
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <compare>
+#include <concepts>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_MATH_BEGIN
+
+// 定长 128 位无符号整数，用于替代 boost::multiprecision::uint128_t 存储质量
+// 固定为两个 64 位字，MSVC 下 16 字节（boost 为 24 字节），运算使用编译器原生 128 位整数或 x64 内建函数
+// 整数运算与 boost 的 unchecked uint128_t 一致：加减乘溢出时回绕，除零抛出 std::overflow_error
+// 从浮点数构造时向零截断并饱和，与 boost 不同：负数、NaN 和小于 1 的值得到 0，不小于 2^128 的值（含正无穷）得到最大值
+class FUint128
+{
+public:
+    constexpr FUint128() = default;
+    constexpr FUint128(std::uint64_t Low, std::uint64_t High);
+
+    template <std::integral IntegerType>
+    constexpr FUint128(IntegerType Value);
+
+    // 负数和 NaN 取 0，超出范围时取最大值
+    template <std::floating_point FloatType>
+    explicit FUint128(FloatType Value);
+
+    template <typename DigitalType>
+    DigitalType ConvertTo() const;
+
+    template <typename DigitalType>
+    explicit operator DigitalType() const;
+
+    FUint128& operator+=(const FUint128& Other);
+    FUint128& operator-=(const FUint128& Other);
+    FUint128& operator*=(const FUint128& Other);
+    FUint128& operator/=(const FUint128& Other);
+
+    friend FUint128 operator+(FUint128 Lhs, const FUint128& Rhs);
+    friend FUint128 operator-(FUint128 Lhs, const FUint128& Rhs);
+    friend FUint128 operator*(FUint128 Lhs, const FUint128& Rhs);
+    friend FUint128 operator/(FUint128 Lhs, const FUint128& Rhs);
+
+    friend constexpr bool operator==(const FUint128& Lhs, const FUint128& Rhs) = default;
+    friend constexpr std::strong_ordering operator<=>(const FUint128& Lhs, const FUint128& Rhs);
+
+    constexpr std::uint64_t GetLow() const;
+    constexpr std::uint64_t GetHigh() const;
+
+private:
+    double ToDouble() const;
+    static FUint128 FromDouble(double Value);
+    static FUint128 DivideSlow(const FUint128& Dividend, const FUint128& Divisor);
+
+private:
+    std::uint64_t _Low{};
+    std::uint64_t _High{};
+};
+
+_MATH_END
+_NPGS_END
+
+#include "Uint128.inl"
@@ -0,0 +1,164 @@
+#include "Uint128.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+#ifndef __SIZEOF_INT128__
+#include <intrin.h>
+#endif // __SIZEOF_INT128__
+
+_NPGS_BEGIN
+_MATH_BEGIN
+
+NPGS_INLINE constexpr FUint128::FUint128(std::uint64_t Low, std::uint64_t High)
+    : _Low(Low), _High(High)
+{
+}
+
+template <std::integral IntegerType>
+NPGS_INLINE constexpr FUint128::FUint128(IntegerType Value)
+    : _Low(static_cast<std::uint64_t>(Value)), _High(0)
+{
+    if constexpr (std::is_signed_v<IntegerType>)
+    {
+        _High = Value < 0 ? ~std::uint64_t(0) : 0; // 与 boost unchecked 一致，负数按补码回绕
+    }
+}
+
+template <std::floating_point FloatType>
+NPGS_INLINE FUint128::FUint128(FloatType Value)
+    : FUint128(FromDouble(static_cast<double>(Value)))
+{
+}
+
+template <typename DigitalType>
+NPGS_INLINE DigitalType FUint128::ConvertTo() const
+{
+    if constexpr (std::is_floating_point_v<DigitalType>)
+    {
+        return static_cast<DigitalType>(ToDouble());
+    }
+    else
+    {
+        return static_cast<DigitalType>(_Low);
+    }
+}
+
+template <typename DigitalType>
+NPGS_INLINE FUint128::operator DigitalType() const
+{
+    return ConvertTo<DigitalType>();
+}
+
+NPGS_INLINE FUint128& FUint128::operator+=(const FUint128& Other)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 Result = ((static_cast<unsigned __int128>(_High) << 64) | _Low) +
+                               ((static_cast<unsigned __int128>(Other._High) << 64) | Other._Low);
+    _Low  = static_cast<std::uint64_t>(Result);
+    _High = static_cast<std::uint64_t>(Result >> 64);
+#else
+    unsigned char Carry = _addcarry_u64(0, _Low, Other._Low, &_Low);
+    _addcarry_u64(Carry, _High, Other._High, &_High);
+#endif // __SIZEOF_INT128__
+    return *this;
+}
+
+NPGS_INLINE FUint128& FUint128::operator-=(const FUint128& Other)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 Result = ((static_cast<unsigned __int128>(_High) << 64) | _Low) -
+                               ((static_cast<unsigned __int128>(Other._High) << 64) | Other._Low);
+    _Low  = static_cast<std::uint64_t>(Result);
+    _High = static_cast<std::uint64_t>(Result >> 64);
+#else
+    unsigned char Borrow = _subborrow_u64(0, _Low, Other._Low, &_Low);
+    _subborrow_u64(Borrow, _High, Other._High, &_High);
+#endif // __SIZEOF_INT128__
+    return *this;
+}
+
+NPGS_INLINE FUint128& FUint128::operator*=(const FUint128& Other)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 Result = ((static_cast<unsigned __int128>(_High) << 64) | _Low) *
+                               ((static_cast<unsigned __int128>(Other._High) << 64) | Other._Low);
+    _Low  = static_cast<std::uint64_t>(Result);
+    _High = static_cast<std::uint64_t>(Result >> 64);
+#else
+    std::uint64_t CarryHigh = 0;
+    std::uint64_t Low       = _umul128(_Low, Other._Low, &CarryHigh);
+    _High = CarryHigh + _Low * Other._High + _High * Other._Low;
+    _Low  = Low;
+#endif // __SIZEOF_INT128__
+    return *this;
+}
+
+NPGS_INLINE FUint128& FUint128::operator/=(const FUint128& Other)
+{
+    if (Other._High == 0 && Other._Low == 0)
+    {
+        throw std::overflow_error("Division by zero.");
+    }
+
+    if (Other._High != 0)
+    {
+        *this = DivideSlow(*this, Other);
+        return *this;
+    }
+
+    // 除数只有低 64 位（常见情况），先除高位再用余数拼接低位
+    std::uint64_t Divisor      = Other._Low;
+    std::uint64_t QuotientHigh = _High / Divisor;
+    std::uint64_t Remainder    = _High % Divisor;
+#ifdef __SIZEOF_INT128__
+    _Low  = static_cast<std::uint64_t>(((static_cast<unsigned __int128>(Remainder) << 64) | _Low) / Divisor);
+#else
+    _Low  = _udiv128(Remainder, _Low, Divisor, &Remainder);
+#endif // __SIZEOF_INT128__
+    _High = QuotientHigh;
+    return *this;
+}
+
+NPGS_INLINE FUint128 operator+(FUint128 Lhs, const FUint128& Rhs)
+{
+    return Lhs += Rhs;
+}
+
+NPGS_INLINE FUint128 operator-(FUint128 Lhs, const FUint128& Rhs)
+{
+    return Lhs -= Rhs;
+}
+
+NPGS_INLINE FUint128 operator*(FUint128 Lhs, const FUint128& Rhs)
+{
+    return Lhs *= Rhs;
+}
+
+NPGS_INLINE FUint128 operator/(FUint128 Lhs, const FUint128& Rhs)
+{
+    return Lhs /= Rhs;
+}
+
+NPGS_INLINE constexpr std::strong_ordering operator<=>(const FUint128& Lhs, const FUint128& Rhs)
+{
+    if (auto Result = Lhs._High <=> Rhs._High; Result != 0)
+    {
+        return Result;
+    }
+
+    return Lhs._Low <=> Rhs._Low;
+}
+
+NPGS_INLINE constexpr std::uint64_t FUint128::GetLow() const
+{
+    return _Low;
+}
+
+NPGS_INLINE constexpr std::uint64_t FUint128::GetHigh() const
+{
+    return _High;
+}
+
+_MATH_END
+_NPGS_END
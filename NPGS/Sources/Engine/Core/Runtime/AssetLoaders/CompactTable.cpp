@@ -0,0 +1,370 @@
+#include "CompactTable.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::size_t kColumnAlignment = 8;
+
+    std::size_t AlignUp(std::size_t Size)
+    {
+        return (Size + kColumnAlignment - 1) & ~(kColumnAlignment - 1);
+    }
+
+    std::size_t GetEncodingSize(FCompactTable::EColumnEncoding Encoding)
+    {
+        switch (Encoding)
+        {
+        case FCompactTable::EColumnEncoding::kFloat32:
+            return sizeof(float);
+        case FCompactTable::EColumnEncoding::kQuantized16:
+            return sizeof(std::uint16_t);
+        default:
+            return sizeof(double);
+        }
+    }
+
+    double Quantize(double Value, double Scale, double Offset)
+    {
+        if (Scale == 0.0)
+        {
+            return Offset;
+        }
+
+        double Index = std::clamp(std::round((Value - Offset) / Scale), 0.0, 65535.0);
+        return Offset + Index * Scale;
+    }
+
+    std::vector<double> DecodeAs(const std::vector<double>& Column, const FCompactTable::FColumnInfo& Info)
+    {
+        std::vector<double> Decoded(Column.size());
+        for (std::size_t i = 0; i != Column.size(); ++i)
+        {
+            switch (Info.Encoding)
+            {
+            case FCompactTable::EColumnEncoding::kFloat32:
+                Decoded[i] = static_cast<double>(static_cast<float>(Column[i]));
+                break;
+            case FCompactTable::EColumnEncoding::kQuantized16:
+                Decoded[i] = Quantize(Column[i], Info.Scale, Info.Offset);
+                break;
+            default:
+                Decoded[i] = Column[i];
+                break;
+            }
+        }
+
+        return Decoded;
+    }
+
+    bool IsWithinTolerance(double Original, double Decoded, const FCompactTable::FColumnTolerance& Tolerance, double& MaxError)
+    {
+        if (std::isnan(Original) && std::isnan(Decoded))
+        {
+            return true;
+        }
+
+        double Error = std::abs(Decoded - Original);
+        if (!(Error <= Tolerance.Absolute + Tolerance.Relative * std::abs(Original)))
+        {
+            return false;
+        }
+
+        MaxError = std::max(MaxError, Error);
+        return true;
+    }
+
+    // 查表时先按关键列找到相邻两行，再按关键列的位置线性插值，因此误差来自两部分：该列本身的编码误差，
+    // 以及关键列的编码误差改变插值系数后被该列斜率放大的部分。在相邻两行之间按原始关键列取若干个采样点，
+    // 比较用解码数据与用原始数据插值的结果，返回最大绝对误差，任何一个采样点超出容差时返回 -1
+    double MeasureInterpolationError(const std::vector<double>& Column, const std::vector<double>& Decoded,
+                                     const std::vector<double>& Key, const std::vector<double>& DecodedKey,
+                                     const FCompactTable::FColumnTolerance& Tolerance)
+    {
+        constexpr std::array kSampleCoefficients{ 0.0, 0.25, 0.5, 0.75 };
+
+        double MaxError = 0.0;
+        if (Column.empty() || !IsWithinTolerance(Column.back(), Decoded.back(), Tolerance, MaxError))
+        {
+            return Column.empty() ? 0.0 : -1.0;
+        }
+
+        for (std::size_t i = 0; i + 1 < Column.size(); ++i)
+        {
+            for (double Coefficient : kSampleCoefficients)
+            {
+                double Target   = Key[i] + (Key[i + 1] - Key[i]) * Coefficient;
+                double Original = Column[i] + (Column[i + 1] - Column[i]) * Coefficient;
+
+                double KeySpan = DecodedKey[i + 1] - DecodedKey[i];
+                double DecodedCoefficient = KeySpan != 0.0 ? std::clamp((Target - DecodedKey[i]) / KeySpan, 0.0, 1.0) : 0.0;
+                double Interpolated = Decoded[i] + (Decoded[i + 1] - Decoded[i]) * DecodedCoefficient;
+
+                if (!IsWithinTolerance(Original, Interpolated, Tolerance, MaxError))
+                {
+                    return -1.0;
+                }
+            }
+        }
+
+        return MaxError;
+    }
+
+    // 按 16 位定点、float、double 的顺序尝试，取第一个插值误差在容差内的编码。关键列 Key 为空，只比较编码误差，
+    // 其容差即允许的查表位置误差；其余列传入原始和已选定编码后解码的关键列，按插值误差判断
+    FCompactTable::FColumnInfo ChooseEncoding(const std::vector<double>& Column, const FCompactTable::FColumnTolerance& Tolerance,
+                                              const std::vector<double>* Key, const std::vector<double>* DecodedKey)
+    {
+        std::vector<FCompactTable::FColumnInfo> Candidates;
+
+        bool bAllFinite  = std::all_of(Column.begin(), Column.end(), [](double Value) -> bool { return std::isfinite(Value); });
+        bool bAllInteger = bAllFinite && std::all_of(Column.begin(), Column.end(), [](double Value) -> bool { return Value == std::trunc(Value); });
+
+        if (bAllFinite && !Column.empty())
+        {
+            auto [MinIt, MaxIt] = std::minmax_element(Column.begin(), Column.end());
+            double Min   = *MinIt;
+            double Range = *MaxIt - Min;
+
+            // 整数列（如演化阶段）范围足够小时以步长 1 无损量化
+            double Scale = bAllInteger && Range <= 65535.0 ? 1.0 : Range / 65535.0;
+            Candidates.push_back({ FCompactTable::EColumnEncoding::kQuantized16, 0, Scale, Min, 0.0, 0 });
+        }
+
+        Candidates.push_back({ FCompactTable::EColumnEncoding::kFloat32, 0, 1.0, 0.0, 0.0, 0 });
+
+        for (auto& Info : Candidates)
+        {
+            std::vector<double> Decoded = DecodeAs(Column, Info);
+
+            double Error = 0.0;
+            if (Key == nullptr)
+            {
+                for (std::size_t i = 0; i != Column.size() && Error >= 0.0; ++i)
+                {
+                    Error = IsWithinTolerance(Column[i], Decoded[i], Tolerance, Error) ? Error : -1.0;
+                }
+            }
+            else
+            {
+                Error = MeasureInterpolationError(Column, Decoded, *Key, *DecodedKey, Tolerance);
+            }
+
+            if (Error >= 0.0)
+            {
+                Info.MaxError = Error;
+                return Info;
+            }
+        }
+
+        // double 无损，关键列的误差仍会通过插值系数传递过来，照实记录
+        FCompactTable::FColumnInfo Info{ FCompactTable::EColumnEncoding::kFloat64, 0, 1.0, 0.0, 0.0, 0 };
+        if (Key != nullptr)
+        {
+            FCompactTable::FColumnTolerance Unlimited{ std::numeric_limits<double>::infinity(), 0.0 };
+            Info.MaxError = std::max(0.0, MeasureInterpolationError(Column, Column, *Key, *DecodedKey, Unlimited));
+        }
+
+        return Info;
+    }
+
+    void EncodeColumn(const std::vector<double>& Column, const FCompactTable::FColumnInfo& Info, std::byte* Destination)
+    {
+        for (std::size_t i = 0; i != Column.size(); ++i)
+        {
+            switch (Info.Encoding)
+            {
+            case FCompactTable::EColumnEncoding::kFloat64:
+                std::memcpy(Destination + i * sizeof(double), &Column[i], sizeof(double));
+                break;
+            case FCompactTable::EColumnEncoding::kFloat32:
+            {
+                float Value = static_cast<float>(Column[i]);
+                std::memcpy(Destination + i * sizeof(float), &Value, sizeof(float));
+                break;
+            }
+            case FCompactTable::EColumnEncoding::kQuantized16:
+            {
+                double Index = Info.Scale == 0.0 ? 0.0 : std::clamp(std::round((Column[i] - Info.Offset) / Info.Scale), 0.0, 65535.0);
+                auto   Value = static_cast<std::uint16_t>(Index);
+                std::memcpy(Destination + i * sizeof(std::uint16_t), &Value, sizeof(std::uint16_t));
+                break;
+            }
+            }
+        }
+    }
+}
+
+// FCompactTable implementations
+// -----------------------------
+FCompactTable::FCompactTable(const std::vector<FRowArray>& Rows, const std::vector<std::string>& ColNames,
+                             const std::vector<FColumnTolerance>& Tolerances, const std::string& KeyHeader)
+{
+    if (Tolerances.size() != ColNames.size())
+    {
+        throw std::invalid_argument("Tolerance count does not match column count.");
+    }
+
+    auto KeyIt = std::find(ColNames.begin(), ColNames.end(), KeyHeader);
+    if (KeyIt == ColNames.end())
+    {
+        throw std::invalid_argument("Key header not found in the column names.");
+    }
+
+    std::size_t RowCount = Rows.size();
+    std::size_t ColCount = ColNames.size();
+
+    std::vector<FColumnInfo> ColumnInfos(ColCount);
+    std::vector<std::vector<double>> Columns(ColCount, std::vector<double>(RowCount));
+    for (std::size_t i = 0; i != RowCount; ++i)
+    {
+        for (std::size_t j = 0; j != ColCount; ++j)
+        {
+            Columns[j][i] = Rows[i][j];
+        }
+    }
+
+    // 先定关键列的编码，其余列按解码后的关键列计算插值误差
+    std::size_t KeyIndex = static_cast<std::size_t>(KeyIt - ColNames.begin());
+    const std::vector<double>& Key = Columns[KeyIndex];
+    ColumnInfos[KeyIndex] = ChooseEncoding(Key, Tolerances[KeyIndex], nullptr, nullptr);
+    std::vector<double> DecodedKey = DecodeAs(Key, ColumnInfos[KeyIndex]);
+
+    std::size_t BlobSize = AlignUp(sizeof(FBlobHeader) + ColCount * sizeof(FColumnInfo));
+    for (std::size_t j = 0; j != ColCount; ++j)
+    {
+        if (j != KeyIndex)
+        {
+            ColumnInfos[j] = ChooseEncoding(Columns[j], Tolerances[j], &Key, &DecodedKey);
+        }
+
+        ColumnInfos[j].DataOffset = BlobSize;
+        BlobSize += AlignUp(RowCount * GetEncodingSize(ColumnInfos[j].Encoding));
+    }
+
+    _Storage.resize(BlobSize);
+    _Blob = _Storage.data();
+
+    FBlobHeader Header{ RowCount, ColCount, BlobSize };
+    std::memcpy(_Storage.data(), &Header, sizeof(FBlobHeader));
+    std::memcpy(_Storage.data() + sizeof(FBlobHeader), ColumnInfos.data(), ColCount * sizeof(FColumnInfo));
+    for (std::size_t j = 0; j != ColCount; ++j)
+    {
+        EncodeColumn(Columns[j], ColumnInfos[j], _Storage.data() + ColumnInfos[j].DataOffset);
+    }
+
+    InitializeHeaderMap(ColNames);
+}
+
+FCompactTable::FCompactTable(const std::byte* Blob, const std::vector<std::string>& ColNames)
+    : _Blob(Blob)
+{
+    if (GetColCount() != ColNames.size())
+    {
+        throw std::invalid_argument("Column count of the blob does not match the header list.");
+    }
+
+    InitializeHeaderMap(ColNames);
+}
+
+std::pair<FCompactTable::FRowArray, FCompactTable::FRowArray>
+FCompactTable::FindSurroundingValues(const std::string& DataHeader, double TargetValue) const
+{
+    std::size_t DataIndex = GetHeaderIndex(DataHeader);
+
+    // 手动二分，等价于对该列做 lower_bound
+    std::size_t First = 0;
+    std::size_t Count = GetRowCount();
+    while (Count > 0)
+    {
+        std::size_t Step = Count / 2;
+        if (GetValue(First + Step, DataIndex) < TargetValue)
+        {
+            First += Step + 1;
+            Count -= Step + 1;
+        }
+        else
+        {
+            Count = Step;
+        }
+    }
+
+    if (First == GetRowCount())
+    {
+        throw std::out_of_range("Target value is out of range of the data.");
+    }
+
+    std::size_t LowerRow = First;
+    std::size_t UpperRow = First;
+    if (GetValue(First, DataIndex) != TargetValue && First != 0)
+    {
+        LowerRow = First - 1;
+    }
+
+    return { GetRow(LowerRow), GetRow(UpperRow) };
+}
+
+void FCompactTable::Rebind(const std::byte* Blob)
+{
+    if (CalculateBlobSize(Blob) != GetBlob().size())
+    {
+        throw std::invalid_argument("Blob size mismatch.");
+    }
+
+    _Blob = Blob;
+    _Storage.clear();
+    _Storage.shrink_to_fit();
+}
+
+FCompactTable::FRowArray FCompactTable::GetRow(std::size_t RowIndex) const
+{
+    std::size_t ColCount = GetColCount();
+    FRowArray Row(ColCount);
+    for (std::size_t j = 0; j != ColCount; ++j)
+    {
+        Row[j] = GetValue(RowIndex, j);
+    }
+
+    return Row;
+}
+
+std::size_t FCompactTable::CalculateBlobSize(const std::byte* Blob)
+{
+    FBlobHeader Header{};
+    std::memcpy(&Header, Blob, sizeof(FBlobHeader));
+    return static_cast<std::size_t>(Header.BlobSize);
+}
+
+void FCompactTable::InitializeHeaderMap(const std::vector<std::string>& ColNames)
+{
+    for (std::size_t i = 0; i < ColNames.size(); ++i)
+    {
+        _HeaderMap[ColNames[i]] = i;
+    }
+}
+
+std::size_t FCompactTable::GetHeaderIndex(const std::string& Header) const
+{
+    auto it = _HeaderMap.find(Header);
+    if (it != _HeaderMap.end())
+    {
+        return it->second;
+    }
+
+    throw std::out_of_range("Header not found.");
+}
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
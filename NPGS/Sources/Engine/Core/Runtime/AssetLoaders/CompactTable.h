@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+// 紧凑只读数据表，每列按沿关键列线性插值的实测误差在 double、float 和 16 位定点量化中选择最省内存的编码
+// 所有数据位于一块不含指针的连续内存中，可以直接放入共享内存供多个进程只读使用
+class FCompactTable
+{
+public:
+    using FRowArray = std::vector<double>;
+
+    enum class EColumnEncoding : std::uint32_t
+    {
+        kFloat64,
+        kFloat32,
+        kQuantized16
+    };
+
+    struct FColumnTolerance // 允许误差为 Absolute + Relative * |原值|
+    {
+        double Absolute{};
+        double Relative{};
+    };
+
+    struct FColumnInfo
+    {
+        EColumnEncoding Encoding;
+        std::uint32_t   Reserved;
+        double          Scale;
+        double          Offset;
+        double          MaxError;   // 沿关键列线性插值的实测最大绝对误差，关键列为编码误差
+        std::uint64_t   DataOffset; // 相对数据块起始的字节偏移
+    };
+
+public:
+    // 查表时按 KeyHeader 列查找相邻两行并插值，该列的误差会改变所有列的插值结果，编码按此选择
+    FCompactTable(const std::vector<FRowArray>& Rows, const std::vector<std::string>& ColNames,
+                  const std::vector<FColumnTolerance>& Tolerances, const std::string& KeyHeader);
+
+    FCompactTable(const std::byte* Blob, const std::vector<std::string>& ColNames); // 不持有数据，Blob 须保持有效
+    FCompactTable(const FCompactTable&) = delete;
+    FCompactTable(FCompactTable&&) noexcept = default;
+    ~FCompactTable() = default;
+
+    FCompactTable& operator=(const FCompactTable&) = delete;
+    FCompactTable& operator=(FCompactTable&&) noexcept = default;
+
+    std::pair<FRowArray, FRowArray> FindSurroundingValues(const std::string& DataHeader, double TargetValue) const;
+
+    void Rebind(const std::byte* Blob); // 切换到另一份相同内容的数据块（如共享内存），并释放自身存储
+
+    double GetValue(std::size_t RowIndex, std::size_t ColIndex) const;
+    FRowArray GetRow(std::size_t RowIndex) const;
+    std::size_t GetRowCount() const;
+    std::size_t GetColCount() const;
+    const FColumnInfo& GetColumnInfo(std::size_t ColIndex) const;
+    std::span<const std::byte> GetBlob() const;
+
+    static std::size_t CalculateBlobSize(const std::byte* Blob);
+
+private:
+    struct FBlobHeader
+    {
+        std::uint64_t RowCount;
+        std::uint64_t ColCount;
+        std::uint64_t BlobSize;
+    };
+
+    void InitializeHeaderMap(const std::vector<std::string>& ColNames);
+    std::size_t GetHeaderIndex(const std::string& Header) const;
+    const FBlobHeader* GetHeader() const;
+
+private:
+    std::unordered_map<std::string, std::size_t> _HeaderMap;
+    std::vector<std::byte>                       _Storage;
+    const std::byte*                             _Blob;
+};
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
+
+#include "CompactTable.inl"
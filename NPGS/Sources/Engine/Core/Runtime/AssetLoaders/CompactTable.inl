@@ -0,0 +1,66 @@
+#include "CompactTable.h"
+
+#include <cstring>
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+NPGS_INLINE double FCompactTable::GetValue(std::size_t RowIndex, std::size_t ColIndex) const
+{
+    const FColumnInfo& Info = GetColumnInfo(ColIndex);
+    const std::byte* ColumnData = _Blob + Info.DataOffset;
+
+    switch (Info.Encoding)
+    {
+    case EColumnEncoding::kFloat64:
+    {
+        double Value = 0.0;
+        std::memcpy(&Value, ColumnData + RowIndex * sizeof(double), sizeof(double));
+        return Value;
+    }
+    case EColumnEncoding::kFloat32:
+    {
+        float Value = 0.0f;
+        std::memcpy(&Value, ColumnData + RowIndex * sizeof(float), sizeof(float));
+        return Value;
+    }
+    case EColumnEncoding::kQuantized16:
+    {
+        std::uint16_t Value = 0;
+        std::memcpy(&Value, ColumnData + RowIndex * sizeof(std::uint16_t), sizeof(std::uint16_t));
+        return Info.Offset + Value * Info.Scale;
+    }
+    default:
+        return 0.0;
+    }
+}
+
+NPGS_INLINE std::size_t FCompactTable::GetRowCount() const
+{
+    return static_cast<std::size_t>(GetHeader()->RowCount);
+}
+
+NPGS_INLINE std::size_t FCompactTable::GetColCount() const
+{
+    return static_cast<std::size_t>(GetHeader()->ColCount);
+}
+
+NPGS_INLINE const FCompactTable::FColumnInfo& FCompactTable::GetColumnInfo(std::size_t ColIndex) const
+{
+    return reinterpret_cast<const FColumnInfo*>(_Blob + sizeof(FBlobHeader))[ColIndex];
+}
+
+NPGS_INLINE std::span<const std::byte> FCompactTable::GetBlob() const
+{
+    return { _Blob, static_cast<std::size_t>(GetHeader()->BlobSize) };
+}
+
+NPGS_INLINE const FCompactTable::FBlobHeader* FCompactTable::GetHeader() const
+{
+    return reinterpret_cast<const FBlobHeader*>(_Blob);
+}
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
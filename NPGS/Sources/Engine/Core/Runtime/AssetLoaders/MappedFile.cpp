@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+
+#include <utility>
+#include <Windows.h>
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+// FMappedFile implementations
+// ---------------------------
+FMappedFile::FMappedFile(void* File, void* Handle, const void* View, std::size_t Size)
+    : _File(File), _Handle(Handle), _View(View), _Size(Size)
+{
+}
+
+FMappedFile::FMappedFile(FMappedFile&& Other) noexcept
+    :
+    _File(std::exchange(Other._File, nullptr)),
+    _Handle(std::exchange(Other._Handle, nullptr)),
+    _View(std::exchange(Other._View, nullptr)),
+    _Size(std::exchange(Other._Size, 0))
+{
+}
+
+FMappedFile::~FMappedFile()
+{
+    if (_View != nullptr)
+    {
+        UnmapViewOfFile(_View);
+    }
+
+    if (_Handle != nullptr)
+    {
+        CloseHandle(_Handle);
+    }
+
+    if (_File != nullptr)
+    {
+        CloseHandle(_File);
+    }
+}
+
+FMappedFile& FMappedFile::operator=(FMappedFile&& Other) noexcept
+{
+    if (this != &Other)
+    {
+        std::swap(_File,   Other._File);
+        std::swap(_Handle, Other._Handle);
+        std::swap(_View,   Other._View);
+        std::swap(_Size,   Other._Size);
+    }
+
+    return *this;
+}
+
+std::unique_ptr<FMappedFile> FMappedFile::Open(const std::string& Filename)
+{
+    HANDLE File = CreateFileA(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (File == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0)
+    {
+        CloseHandle(File);
+        return nullptr;
+    }
+
+    HANDLE Handle = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (Handle == nullptr)
+    {
+        CloseHandle(File);
+        return nullptr;
+    }
+
+    const void* View = MapViewOfFile(Handle, FILE_MAP_READ, 0, 0, 0);
+    if (View == nullptr)
+    {
+        CloseHandle(Handle);
+        CloseHandle(File);
+        return nullptr;
+    }
+
+    return std::unique_ptr<FMappedFile>(
+        new FMappedFile(File, Handle, View, static_cast<std::size_t>(FileSize.QuadPart)));
+}
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
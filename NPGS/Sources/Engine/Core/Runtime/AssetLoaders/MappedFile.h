@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+// 只读映射整个文件，用于直接在映射的内存上使用不含指针的数据块
+class FMappedFile
+{
+public:
+    FMappedFile(const FMappedFile&) = delete;
+    FMappedFile(FMappedFile&&) noexcept;
+    ~FMappedFile();
+
+    FMappedFile& operator=(const FMappedFile&) = delete;
+    FMappedFile& operator=(FMappedFile&&) noexcept;
+
+    const std::byte* GetData() const;
+    std::size_t GetSize() const;
+
+    // 文件不存在、为空或映射失败时返回 nullptr
+    static std::unique_ptr<FMappedFile> Open(const std::string& Filename);
+
+private:
+    FMappedFile(void* File, void* Handle, const void* View, std::size_t Size);
+
+private:
+    void*       _File;
+    void*       _Handle;
+    const void* _View;
+    std::size_t _Size;
+};
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
+
+#include "MappedFile.inl"
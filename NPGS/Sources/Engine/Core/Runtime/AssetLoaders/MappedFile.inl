@@ -0,0 +1,19 @@
+#include "MappedFile.h"
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+NPGS_INLINE const std::byte* FMappedFile::GetData() const
+{
+    return static_cast<const std::byte*>(_View);
+}
+
+NPGS_INLINE std::size_t FMappedFile::GetSize() const
+{
+    return _Size;
+}
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
@@ -0,0 +1,133 @@
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <Windows.h>
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+// FSharedMemory implementations
+// -----------------------------
+FSharedMemory::FSharedMemory(void* Handle, void* View, bool bCreator)
+    : _Handle(Handle), _View(View), _bCreator(bCreator)
+{
+}
+
+FSharedMemory::FSharedMemory(FSharedMemory&& Other) noexcept
+    :
+    _Handle(std::exchange(Other._Handle, nullptr)),
+    _View(std::exchange(Other._View, nullptr)),
+    _bCreator(std::exchange(Other._bCreator, false))
+{
+}
+
+FSharedMemory::~FSharedMemory()
+{
+    if (_View != nullptr)
+    {
+        UnmapViewOfFile(_View);
+    }
+
+    if (_Handle != nullptr)
+    {
+        CloseHandle(_Handle);
+    }
+}
+
+FSharedMemory& FSharedMemory::operator=(FSharedMemory&& Other) noexcept
+{
+    if (this != &Other)
+    {
+        std::swap(_Handle,   Other._Handle);
+        std::swap(_View,     Other._View);
+        std::swap(_bCreator, Other._bCreator);
+    }
+
+    return *this;
+}
+
+void FSharedMemory::MarkReady()
+{
+    auto* Header = static_cast<FMappingHeader*>(_View);
+    std::atomic_ref<std::uint32_t>(Header->ReadyFlag).store(1, std::memory_order_release);
+}
+
+bool FSharedMemory::WaitReady(std::chrono::milliseconds Timeout) const
+{
+    // 创建者转换全部轨道需要数秒，先让出时间片，之后改为休眠，避免长时间占满一个核心
+    constexpr int kYieldCount = 1024;
+
+    auto* Header   = static_cast<FMappingHeader*>(_View);
+    auto  Deadline = std::chrono::steady_clock::now() + Timeout;
+    for (int i = 0; std::atomic_ref<std::uint32_t>(Header->ReadyFlag).load(std::memory_order_acquire) == 0; ++i)
+    {
+        if (std::chrono::steady_clock::now() >= Deadline)
+        {
+            return false;
+        }
+
+        if (i < kYieldCount)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<FSharedMemory> FSharedMemory::Create(const std::string& Name, std::size_t Size)
+{
+    std::uint64_t MappingSize = sizeof(FMappingHeader) + Size;
+    HANDLE Handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                       static_cast<DWORD>(MappingSize >> 32),
+                                       static_cast<DWORD>(MappingSize & 0xFFFFFFFF), Name.c_str());
+    if (Handle == nullptr)
+    {
+        return nullptr;
+    }
+
+    bool bCreator = GetLastError() != ERROR_ALREADY_EXISTS;
+    void* View = MapViewOfFile(Handle, bCreator ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0);
+    if (View == nullptr)
+    {
+        CloseHandle(Handle);
+        return nullptr;
+    }
+
+    if (bCreator)
+    {
+        // 新建的页面由系统清零，就绪标志初始为 0
+        static_cast<FMappingHeader*>(View)->DataSize = Size;
+    }
+
+    return std::unique_ptr<FSharedMemory>(new FSharedMemory(Handle, View, bCreator));
+}
+
+std::unique_ptr<FSharedMemory> FSharedMemory::Open(const std::string& Name)
+{
+    HANDLE Handle = OpenFileMappingA(FILE_MAP_READ, FALSE, Name.c_str());
+    if (Handle == nullptr)
+    {
+        return nullptr;
+    }
+
+    void* View = MapViewOfFile(Handle, FILE_MAP_READ, 0, 0, 0);
+    if (View == nullptr)
+    {
+        CloseHandle(Handle);
+        return nullptr;
+    }
+
+    return std::unique_ptr<FSharedMemory>(new FSharedMemory(Handle, View, false));
+}
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+// 命名共享内存，用于在多个进程间共享只读资产数据
+// 创建者写入数据后调用 MarkReady，其他进程通过 Open 打开并等待数据就绪，等待超时时应自行加载私有副本
+class FSharedMemory
+{
+public:
+    FSharedMemory(const FSharedMemory&) = delete;
+    FSharedMemory(FSharedMemory&&) noexcept;
+    ~FSharedMemory();
+
+    FSharedMemory& operator=(const FSharedMemory&) = delete;
+    FSharedMemory& operator=(FSharedMemory&&) noexcept;
+
+    void MarkReady();
+    // 等待创建者调用 MarkReady，超时返回 false，例如创建者在写入过程中崩溃
+    bool WaitReady(std::chrono::milliseconds Timeout) const;
+
+    std::byte* GetData();
+    const std::byte* GetData() const;
+    std::size_t GetSize() const;
+    bool IsCreator() const;
+
+    // 映射已存在时不会重新创建，IsCreator 返回 false
+    static std::unique_ptr<FSharedMemory> Create(const std::string& Name, std::size_t Size);
+    // 映射不存在时返回 nullptr
+    static std::unique_ptr<FSharedMemory> Open(const std::string& Name);
+
+private:
+    struct FMappingHeader
+    {
+        std::uint32_t ReadyFlag;
+        std::uint32_t Reserved;
+        std::uint64_t DataSize;
+    };
+
+    FSharedMemory(void* Handle, void* View, bool bCreator);
+
+private:
+    void* _Handle;
+    void* _View;
+    bool  _bCreator;
+};
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
+
+#include "SharedMemory.inl"
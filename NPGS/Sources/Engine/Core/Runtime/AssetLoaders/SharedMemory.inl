@@ -0,0 +1,29 @@
+#include "SharedMemory.h"
+
+_NPGS_BEGIN
+_RUNTIME_BEGIN
+_ASSET_BEGIN
+
+NPGS_INLINE std::byte* FSharedMemory::GetData()
+{
+    return static_cast<std::byte*>(_View) + sizeof(FMappingHeader);
+}
+
+NPGS_INLINE const std::byte* FSharedMemory::GetData() const
+{
+    return static_cast<const std::byte*>(_View) + sizeof(FMappingHeader);
+}
+
+NPGS_INLINE std::size_t FSharedMemory::GetSize() const
+{
+    return static_cast<std::size_t>(static_cast<const FMappingHeader*>(_View)->DataSize);
+}
+
+NPGS_INLINE bool FSharedMemory::IsCreator() const
+{
+    return _bCreator;
+}
+
+_ASSET_END
+_RUNTIME_END
+_NPGS_END
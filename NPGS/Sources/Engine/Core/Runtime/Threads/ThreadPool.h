@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <condition_variable>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
@@ -57,6 +58,12 @@ void MakeChunks(int MaxThread, std::vector<DataType>& Data, std::vector<std::vec
                 std::vector<std::promise<std::vector<ResultType>>>& Promises,
                 std::vector<std::future<std::vector<ResultType>>>& ChunkFutures);
 
+// 把 [0, Count) 按下标均分为 ChunkCount 个连续区间，在线程池中执行 Pred(Begin, End, ChunkIndex) 并等待全部完成
+// 区间划分只由 Count 和 ChunkCount 决定，多次调用时同一个 ChunkIndex 总是对应同一个区间
+// 不要在线程池任务内部调用，等待子任务可能占满所有工作线程而死锁
+template <typename Func>
+void ParallelFor(std::size_t Count, std::size_t ChunkCount, Func&& Pred);
+
 _THREAD_END
 _RUNTIME_END
 _NPGS_END
@@ -13,9 +13,16 @@ inline auto FThreadPool::Submit(Func&& Pred, Args&&... Params)
     std::future<ReturnType> Future = Task->get_future();
     {
         std::unique_lock<std::mutex> Mutex(_Mutex);
-        _Tasks.emplace([Task]() -> void { (*Task)(); });
+        if (!_Terminate)
+        {
+            _Tasks.emplace([Task]() -> void { (*Task)(); });
+            _Condition.notify_one();
+            return Future;
+        }
     }
-    _Condition.notify_one();
+
+    // 线程池已终止，工作线程不会再取任务，直接在调用线程执行，避免等待 Future 时永久阻塞
+    (*Task)();
     return Future;
 }
 
@@ -48,6 +55,57 @@ inline void MakeChunks(int MaxThread, std::vector<DataType>& Data, std::vector<s
     }
 }
 
+template <typename Func>
+inline void ParallelFor(std::size_t Count, std::size_t ChunkCount, Func&& Pred)
+{
+    if (ChunkCount <= 1 || Count <= 1)
+    {
+        Pred(static_cast<std::size_t>(0), Count, static_cast<std::size_t>(0));
+        return;
+    }
+
+    auto* ThreadPool = FThreadPool::GetInstance();
+    std::vector<std::future<void>> Futures;
+    Futures.reserve(ChunkCount);
+
+    std::exception_ptr Exception;
+    for (std::size_t i = 0; i != ChunkCount; ++i)
+    {
+        std::size_t Begin = Count * i / ChunkCount;
+        std::size_t End   = Count * (i + 1) / ChunkCount;
+        try
+        {
+            Futures.push_back(ThreadPool->Submit([&Pred, Begin, End, i]() -> void { Pred(Begin, End, i); }));
+        }
+        catch (...)
+        {
+            Exception = std::current_exception();
+            break;
+        }
+    }
+
+    // 已提交的任务都引用了 Pred，必须全部结束后才能返回，异常等到最后再抛出第一个
+    for (auto& Future : Futures)
+    {
+        try
+        {
+            Future.get();
+        }
+        catch (...)
+        {
+            if (!Exception)
+            {
+                Exception = std::current_exception();
+            }
+        }
+    }
+
+    if (Exception)
+    {
+        std::rethrow_exception(Exception);
+    }
+}
+
 _THREAD_END
 _RUNTIME_END
 _NPGS_END
@@ -0,0 +1,332 @@
+#include "KeplerPropagator.h"
+
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_DYNAMICS_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::size_t kBlockSize = 64;
+    constexpr double      kTwoPi     = 2.0 * std::numbers::pi;
+
+    // 加减 1.5 * 2^52 使小数部分被舍入掉，|Value| < 2^51 时等价于就近取整
+    // 不依赖 floor 和整数转换，循环可以直接向量化，要求浮点模型不重排运算（MSVC 默认的 /fp:precise）
+    NPGS_INLINE double RoundToNearest(double Value)
+    {
+        constexpr double kMagic = 6755399441055744.0;
+        return (Value + kMagic) - kMagic;
+    }
+
+    // 无分支的 sin/cos，按 pi/2 分段约减到 [-pi/4, pi/4] 后使用 fdlibm 的多项式，误差在 1 ulp 左右
+    NPGS_INLINE void SinCos(double Angle, double& Sin, double& Cos)
+    {
+        double Quadrant = RoundToNearest(Angle * (2.0 / std::numbers::pi));
+        double Reduced  = Angle - Quadrant * 1.57079632679489655800e+00;
+        Reduced        -= Quadrant * 6.12323399573676603587e-17;
+
+        double z = Reduced * Reduced;
+        double PolySin = Reduced + Reduced * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 +
+                         z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 +
+                         z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+        double PolyCos = 1.0 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 +
+                         z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07 +
+                         z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+
+        double QuadrantIndex = Quadrant - 4.0 * RoundToNearest(Quadrant * 0.25 - 0.375); // 象限号取模 4
+        bool   bSwap         = QuadrantIndex == 1.0 || QuadrantIndex == 3.0;
+        double SwapSin       = bSwap ? PolyCos : PolySin;
+        double SwapCos       = bSwap ? PolySin : PolyCos;
+
+        Sin = QuadrantIndex >= 2.0 ? -SwapSin : SwapSin;
+        Cos = QuadrantIndex == 1.0 || QuadrantIndex == 2.0 ? -SwapCos : SwapCos;
+    }
+
+    // 由升交点经度、倾角和近心点幅角得到近心点方向 P 和运动方向 Q，再转到法向量 (theta, phi) 指定的参考平面
+    std::pair<glm::dvec3, glm::dvec3> CalculatePerifocalBasis(const FKeplerBatch::FElements& Elements)
+    {
+        double CosNode = std::cos(Elements.LongitudeOfAscendingNode);
+        double SinNode = std::sin(Elements.LongitudeOfAscendingNode);
+        double CosInc  = std::cos(Elements.Inclination);
+        double SinInc  = std::sin(Elements.Inclination);
+        double CosArg  = std::cos(Elements.ArgumentOfPeriapsis);
+        double SinArg  = std::sin(Elements.ArgumentOfPeriapsis);
+
+        glm::dvec3 P(CosNode * CosArg - SinNode * SinArg * CosInc,
+                     SinNode * CosArg + CosNode * SinArg * CosInc,
+                     SinArg * SinInc);
+        glm::dvec3 Q(-CosNode * SinArg - SinNode * CosArg * CosInc,
+                     -SinNode * SinArg + CosNode * CosArg * CosInc,
+                     CosArg * SinInc);
+
+        // 先绕 y 轴转 phi 再绕 z 轴转 theta，把 z 轴转到法向量方向
+        double CosTheta = std::cos(static_cast<double>(Elements.Normal.x));
+        double SinTheta = std::sin(static_cast<double>(Elements.Normal.x));
+        double CosPhi   = std::cos(static_cast<double>(Elements.Normal.y));
+        double SinPhi   = std::sin(static_cast<double>(Elements.Normal.y));
+
+        auto Rotate = [&](glm::dvec3 Vector) -> glm::dvec3
+        {
+            double x = CosPhi * Vector.x + SinPhi * Vector.z;
+            double z = CosPhi * Vector.z - SinPhi * Vector.x;
+            return glm::dvec3(CosTheta * x - SinTheta * Vector.y, SinTheta * x + CosTheta * Vector.y, z);
+        };
+
+        return { Rotate(P), Rotate(Q) };
+    }
+}
+
+// FKeplerBatch implementations
+// ----------------------------
+std::uint32_t FKeplerBatch::AddFixed(glm::dvec3 Offset, std::uint32_t ParentIndex)
+{
+    return AddBody(0.0, 0.0, 0.0, Offset, glm::dvec3(0.0), ParentIndex);
+}
+
+std::uint32_t FKeplerBatch::AddOrbit(const FElements& Elements, std::uint32_t ParentIndex)
+{
+    if (!(Elements.Eccentricity >= 0.0 && Elements.Eccentricity < 1.0))
+    {
+        throw std::invalid_argument("Eccentricity must be in [0, 1).");
+    }
+
+    double Eccentricity  = Elements.Eccentricity;
+    double SemiMinorAxis = Elements.SemiMajorAxis * std::sqrt(1.0 - Eccentricity * Eccentricity);
+    double MeanMotion    = Elements.Period > 0.0 ? kTwoPi / Elements.Period : 0.0;
+
+    // 真近点角转平近点角
+    double HalfTrueAnomaly    = 0.5 * Elements.InitialTrueAnomaly;
+    double EccentricAnomaly   = 2.0 * std::atan2(std::sqrt(1.0 - Eccentricity) * std::sin(HalfTrueAnomaly),
+                                                 std::sqrt(1.0 + Eccentricity) * std::cos(HalfTrueAnomaly));
+    double InitialMeanAnomaly = EccentricAnomaly - Eccentricity * std::sin(EccentricAnomaly);
+
+    auto [P, Q] = CalculatePerifocalBasis(Elements);
+    return AddBody(MeanMotion, InitialMeanAnomaly, Eccentricity,
+                   P * Elements.SemiMajorAxis, Q * SemiMinorAxis, ParentIndex);
+}
+
+std::uint32_t FKeplerBatch::AppendHierarchy(const Astro::FOrbitalHierarchy& Hierarchy, glm::dvec3 Origin)
+{
+    auto BaseIndex = static_cast<std::uint32_t>(GetBodyCount());
+
+    // 容量不足时按倍数扩容，反复追加多个层级时总复制量保持线性
+    std::size_t RequiredCapacity = GetBodyCount() + Hierarchy.GetNodeCount();
+    if (RequiredCapacity > _MeanMotion.capacity())
+    {
+        Reserve(std::max(RequiredCapacity, 2 * _MeanMotion.capacity()));
+    }
+
+    for (const auto& Node : Hierarchy.GetNodes())
+    {
+        if (Node.ParentIndex == Astro::FOrbitalHierarchy::kNoIndex)
+        {
+            AddFixed(Origin);
+            continue;
+        }
+
+        FElements Elements
+        {
+            .SemiMajorAxis            = Node.Elements.SemiMajorAxis,
+            .Eccentricity             = Node.Elements.Eccentricity,
+            .Inclination              = Node.Elements.Inclination,
+            .LongitudeOfAscendingNode = Node.Elements.LongitudeOfAscendingNode,
+            .ArgumentOfPeriapsis      = Node.Elements.ArgumentOfPeriapsis,
+            .InitialTrueAnomaly       = Node.Elements.TrueAnomaly,
+            .Period                   = Node.Period,
+            .Normal                   = Node.Normal
+        };
+
+        AddOrbit(Elements, BaseIndex + Node.ParentIndex);
+    }
+
+    return BaseIndex;
+}
+
+void FKeplerBatch::Reserve(std::size_t Capacity)
+{
+    _MeanMotion.reserve(Capacity);
+    _InitialMeanAnomaly.reserve(Capacity);
+    _Eccentricity.reserve(Capacity);
+    _MajorAxisX.reserve(Capacity);
+    _MajorAxisY.reserve(Capacity);
+    _MajorAxisZ.reserve(Capacity);
+    _MinorAxisX.reserve(Capacity);
+    _MinorAxisY.reserve(Capacity);
+    _MinorAxisZ.reserve(Capacity);
+    _ParentIndices.reserve(Capacity);
+}
+
+void FKeplerBatch::Clear()
+{
+    _MeanMotion.clear();
+    _InitialMeanAnomaly.clear();
+    _Eccentricity.clear();
+    _MajorAxisX.clear();
+    _MajorAxisY.clear();
+    _MajorAxisZ.clear();
+    _MinorAxisX.clear();
+    _MinorAxisY.clear();
+    _MinorAxisZ.clear();
+    _ParentIndices.clear();
+}
+
+std::uint32_t FKeplerBatch::AddBody(double MeanMotion, double InitialMeanAnomaly, double Eccentricity,
+                                    glm::dvec3 MajorAxis, glm::dvec3 MinorAxis, std::uint32_t ParentIndex)
+{
+    if (ParentIndex != kNoParent && ParentIndex >= GetBodyCount())
+    {
+        throw std::invalid_argument("Parent body must be added before its children.");
+    }
+
+    _MeanMotion.push_back(MeanMotion);
+    _InitialMeanAnomaly.push_back(InitialMeanAnomaly);
+    _Eccentricity.push_back(Eccentricity);
+    _MajorAxisX.push_back(MajorAxis.x);
+    _MajorAxisY.push_back(MajorAxis.y);
+    _MajorAxisZ.push_back(MajorAxis.z);
+    _MinorAxisX.push_back(MinorAxis.x);
+    _MinorAxisY.push_back(MinorAxis.y);
+    _MinorAxisZ.push_back(MinorAxis.z);
+    _ParentIndices.push_back(ParentIndex);
+
+    return static_cast<std::uint32_t>(_ParentIndices.size() - 1);
+}
+
+// FKeplerPropagator implementations
+// ---------------------------------
+void FKeplerPropagator::FBodyStates::Resize(std::size_t Size)
+{
+    PositionX.resize(Size);
+    PositionY.resize(Size);
+    PositionZ.resize(Size);
+    VelocityX.resize(Size);
+    VelocityY.resize(Size);
+    VelocityZ.resize(Size);
+}
+
+FKeplerPropagator::FKeplerPropagator(int MaxIterations, double StepTolerance)
+    : _MaxIterations(MaxIterations), _StepTolerance(StepTolerance)
+{
+}
+
+void FKeplerPropagator::Propagate(const FKeplerBatch& Batch, double Time, FBodyStates& States) const
+{
+    std::size_t BodyCount = Batch.GetBodyCount();
+    States.Resize(BodyCount);
+
+    for (std::size_t Begin = 0; Begin < BodyCount; Begin += kBlockSize)
+    {
+        SolveBlock(Batch, Time, Begin, std::min(kBlockSize, BodyCount - Begin), States);
+    }
+
+    AccumulateHierarchy(Batch, States);
+}
+
+void FKeplerPropagator::PropagateRange(const FKeplerBatch& Batch, double BeginTime, double TimeStep, std::size_t StepCount,
+                                       std::vector<FBodyStates>& StatesList) const
+{
+    StatesList.resize(StepCount);
+    for (std::size_t i = 0; i != StepCount; ++i)
+    {
+        Propagate(Batch, BeginTime + static_cast<double>(i) * TimeStep, StatesList[i]);
+    }
+}
+
+void FKeplerPropagator::SolveBlock(const FKeplerBatch& Batch, double Time, std::size_t Begin, std::size_t Count,
+                                   FBodyStates& States) const
+{
+    alignas(64) double MeanAnomalies[kBlockSize];
+    alignas(64) double EccentricAnomalies[kBlockSize];
+    alignas(64) double SinValues[kBlockSize];
+    alignas(64) double CosValues[kBlockSize];
+
+    const double* Eccentricities = Batch._Eccentricity.data() + Begin;
+    const double* MeanMotions    = Batch._MeanMotion.data() + Begin;
+    const double* InitialMeans   = Batch._InitialMeanAnomaly.data() + Begin;
+
+    // 平近点角约减到 [-pi, pi]，以 Danby 的 M + 0.85 * e * sign(M) 作为初值
+    for (std::size_t i = 0; i != Count; ++i)
+    {
+        double MeanAnomaly = InitialMeans[i] + MeanMotions[i] * Time;
+        MeanAnomaly -= kTwoPi * RoundToNearest(MeanAnomaly * (1.0 / kTwoPi));
+
+        MeanAnomalies[i]      = MeanAnomaly;
+        EccentricAnomalies[i] = MeanAnomaly + 0.85 * Eccentricities[i] * std::copysign(1.0, MeanAnomaly);
+    }
+
+    for (int Iteration = 0; Iteration != _MaxIterations; ++Iteration)
+    {
+        for (std::size_t i = 0; i != Count; ++i)
+        {
+            SinCos(EccentricAnomalies[i], SinValues[i], CosValues[i]);
+        }
+
+        double MaxStep = 0.0;
+        for (std::size_t i = 0; i != Count; ++i)
+        {
+            double e          = Eccentricities[i];
+            double Function   = EccentricAnomalies[i] - e * SinValues[i] - MeanAnomalies[i];
+            double Derivative = 1.0 - e * CosValues[i];
+            double Step       = Function / (Derivative - 0.5 * Function * e * SinValues[i] / Derivative);
+
+            EccentricAnomalies[i] -= Step;
+            MaxStep = std::max(MaxStep, std::abs(Step));
+        }
+
+        if (MaxStep < _StepTolerance)
+        {
+            break;
+        }
+    }
+
+    for (std::size_t i = 0; i != Count; ++i)
+    {
+        SinCos(EccentricAnomalies[i], SinValues[i], CosValues[i]);
+    }
+
+    for (std::size_t i = 0; i != Count; ++i)
+    {
+        std::size_t Index   = Begin + i;
+        double      SinE    = SinValues[i];
+        double      CosE    = CosValues[i];
+        double      CosTerm = CosE - Eccentricities[i];
+        double      Rate    = MeanMotions[i] / (1.0 - Eccentricities[i] * CosE); // dE/dt
+
+        States.PositionX[Index] = Batch._MajorAxisX[Index] * CosTerm + Batch._MinorAxisX[Index] * SinE;
+        States.PositionY[Index] = Batch._MajorAxisY[Index] * CosTerm + Batch._MinorAxisY[Index] * SinE;
+        States.PositionZ[Index] = Batch._MajorAxisZ[Index] * CosTerm + Batch._MinorAxisZ[Index] * SinE;
+        States.VelocityX[Index] = Rate * (Batch._MinorAxisX[Index] * CosE - Batch._MajorAxisX[Index] * SinE);
+        States.VelocityY[Index] = Rate * (Batch._MinorAxisY[Index] * CosE - Batch._MajorAxisY[Index] * SinE);
+        States.VelocityZ[Index] = Rate * (Batch._MinorAxisZ[Index] * CosE - Batch._MajorAxisZ[Index] * SinE);
+    }
+}
+
+void FKeplerPropagator::AccumulateHierarchy(const FKeplerBatch& Batch, FBodyStates& States)
+{
+    for (std::size_t i = 0; i != Batch.GetBodyCount(); ++i)
+    {
+        std::uint32_t Parent = Batch._ParentIndices[i];
+        if (Parent == FKeplerBatch::kNoParent)
+        {
+            continue;
+        }
+
+        States.PositionX[i] += States.PositionX[Parent];
+        States.PositionY[i] += States.PositionY[Parent];
+        States.PositionZ[i] += States.PositionZ[Parent];
+        States.VelocityX[i] += States.VelocityX[Parent];
+        States.VelocityY[i] += States.VelocityY[Parent];
+        States.VelocityZ[i] += States.VelocityZ[Parent];
+    }
+}
+
+_DYNAMICS_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Types/Entries/Astro/OrbitalHierarchy.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_DYNAMICS_BEGIN
+
+// 扁平化的开普勒轨道批，按结构数组存储，每个天体只记录相对上级天体的轨道
+// 上级天体总是排在下级天体之前，传播时顺序遍历一次即可累加出绝对位置
+class FKeplerBatch
+{
+public:
+    static constexpr std::uint32_t kNoParent = std::numeric_limits<std::uint32_t>::max();
+
+    struct FElements
+    {
+        double    SemiMajorAxis{};            // 半长轴，单位 m
+        double    Eccentricity{};             // 离心率，须小于 1
+        double    Inclination{};              // 轨道倾角，单位 rad
+        double    LongitudeOfAscendingNode{}; // 升交点经度，单位 rad
+        double    ArgumentOfPeriapsis{};      // 近心点幅角，单位 rad
+        double    InitialTrueAnomaly{};       // 时刻 0 的真近点角，单位 rad
+        double    Period{};                   // 轨道周期，单位 s，为 0 时天体停留在初始位置
+        glm::vec2 Normal{};                   // 参考平面法向量 (theta, phi)，(0, 0) 即 z 轴
+    };
+
+public:
+    FKeplerBatch()  = default;
+    ~FKeplerBatch() = default;
+
+    std::uint32_t AddFixed(glm::dvec3 Offset, std::uint32_t ParentIndex = kNoParent);
+    std::uint32_t AddOrbit(const FElements& Elements, std::uint32_t ParentIndex);
+
+    // 按节点顺序追加整个轨道层级，根节点（质心）固定在 Origin，返回根节点在批中的下标
+    // 节点 i 对应批中下标为返回值 + i 的天体
+    std::uint32_t AppendHierarchy(const Astro::FOrbitalHierarchy& Hierarchy, glm::dvec3 Origin = glm::dvec3(0.0));
+
+    void Reserve(std::size_t Capacity);
+    void Clear();
+
+    std::size_t GetBodyCount() const;
+    std::uint32_t GetParentIndex(std::size_t Index) const;
+
+private:
+    friend class FKeplerPropagator;
+
+    std::uint32_t AddBody(double MeanMotion, double InitialMeanAnomaly, double Eccentricity,
+                          glm::dvec3 MajorAxis, glm::dvec3 MinorAxis, std::uint32_t ParentIndex);
+
+private:
+    // 相对位置 = MajorAxis * (cosE - e) + MinorAxis * sinE
+    // 相对速度 = dE/dt * (MinorAxis * cosE - MajorAxis * sinE)，dE/dt = n / (1 - e * cosE)
+    std::vector<double>        _MeanMotion;         // 平均角速度 n，单位 rad/s
+    std::vector<double>        _InitialMeanAnomaly; // 时刻 0 的平近点角，单位 rad
+    std::vector<double>        _Eccentricity;
+    std::vector<double>        _MajorAxisX;         // 指向近心点，长度为半长轴
+    std::vector<double>        _MajorAxisY;
+    std::vector<double>        _MajorAxisZ;
+    std::vector<double>        _MinorAxisX;         // 沿运动方向垂直于长轴，长度为半短轴
+    std::vector<double>        _MinorAxisY;
+    std::vector<double>        _MinorAxisZ;
+    std::vector<std::uint32_t> _ParentIndices;
+};
+
+// 批量求解开普勒方程，输出每个天体的绝对位置和速度
+// 以 64 个天体为一块做无分支的 Halley 迭代，整块的最大修正量足够小时提前结束
+class FKeplerPropagator
+{
+public:
+    struct FBodyStates // 结构数组，单位 m 和 m/s
+    {
+        std::vector<double> PositionX;
+        std::vector<double> PositionY;
+        std::vector<double> PositionZ;
+        std::vector<double> VelocityX;
+        std::vector<double> VelocityY;
+        std::vector<double> VelocityZ;
+
+        void Resize(std::size_t Size);
+        glm::dvec3 GetPosition(std::size_t Index) const;
+        glm::dvec3 GetVelocity(std::size_t Index) const;
+    };
+
+public:
+    explicit FKeplerPropagator(int MaxIterations = 8, double StepTolerance = 1e-6);
+    ~FKeplerPropagator() = default;
+
+    void Propagate(const FKeplerBatch& Batch, double Time, FBodyStates& States) const;
+    void PropagateRange(const FKeplerBatch& Batch, double BeginTime, double TimeStep, std::size_t StepCount,
+                        std::vector<FBodyStates>& StatesList) const;
+
+private:
+    void SolveBlock(const FKeplerBatch& Batch, double Time, std::size_t Begin, std::size_t Count, FBodyStates& States) const;
+    static void AccumulateHierarchy(const FKeplerBatch& Batch, FBodyStates& States);
+
+private:
+    int    _MaxIterations;
+    double _StepTolerance; // Halley 迭代三阶收敛，最后一步修正量为 d 时误差约为 d^3
+};
+
+_DYNAMICS_END
+_SYSTEM_END
+_NPGS_END
+
+#include "KeplerPropagator.inl"
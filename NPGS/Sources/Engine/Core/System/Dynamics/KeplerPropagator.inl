@@ -0,0 +1,29 @@
+#include "KeplerPropagator.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_DYNAMICS_BEGIN
+
+NPGS_INLINE std::size_t FKeplerBatch::GetBodyCount() const
+{
+    return _ParentIndices.size();
+}
+
+NPGS_INLINE std::uint32_t FKeplerBatch::GetParentIndex(std::size_t Index) const
+{
+    return _ParentIndices[Index];
+}
+
+NPGS_INLINE glm::dvec3 FKeplerPropagator::FBodyStates::GetPosition(std::size_t Index) const
+{
+    return glm::dvec3(PositionX[Index], PositionY[Index], PositionZ[Index]);
+}
+
+NPGS_INLINE glm::dvec3 FKeplerPropagator::FBodyStates::GetVelocity(std::size_t Index) const
+{
+    return glm::dvec3(VelocityX[Index], VelocityY[Index], VelocityZ[Index]);
+}
+
+_DYNAMICS_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,543 @@
+#include "SymplecticIntegrator.h"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/System/Dynamics/KeplerPropagator.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_DYNAMICS_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr double kGravityConstant    = 6.6743e-11; // NumericConstants.h 中的同名常量为 float，这里需要双精度
+    constexpr int    kMaxKeplerIterations = 32;
+
+    // Stumpff 函数 C(z) 和 S(z)，|z| 较小时用级数避免相消
+    void CalculateStumpff(double z, double& C, double& S)
+    {
+        if (z > 0.1)
+        {
+            double Root    = std::sqrt(z);
+            double HalfSin = std::sin(0.5 * Root);
+            C = 2.0 * HalfSin * HalfSin / z;
+            S = (Root - std::sin(Root)) / (z * Root);
+        }
+        else if (z < -0.1)
+        {
+            double Root = std::sqrt(-z);
+            C = (std::cosh(Root) - 1.0) / -z;
+            S = (std::sinh(Root) - Root) / (-z * Root);
+        }
+        else
+        {
+            C = 1.0 / 2.0 - z * (1.0 / 24.0 - z * (1.0 / 720.0 - z * (1.0 / 40320.0 - z * (1.0 / 3628800.0 - z / 479001600.0))));
+            S = 1.0 / 6.0 - z * (1.0 / 120.0 - z * (1.0 / 5040.0 - z * (1.0 / 362880.0 - z * (1.0 / 39916800.0 - z / 6227020800.0))));
+        }
+    }
+
+    // 用普适变量解开普勒问题，将相对中心天体的状态推进 TimeStep，椭圆、抛物线和双曲线轨道均适用
+    void DriftKepler(double Mu, double TimeStep, double& X, double& Y, double& Z, double& Vx, double& Vy, double& Vz)
+    {
+        double R0     = std::sqrt(X * X + Y * Y + Z * Z);
+        double V2     = Vx * Vx + Vy * Vy + Vz * Vz;
+        double Rv     = X * Vx + Y * Vy + Z * Vz;
+        double SqrtMu = std::sqrt(Mu);
+        double Alpha  = 2.0 / R0 - V2 / Mu; // 半长轴的倒数，双曲线时为负
+
+        double Chi = SqrtMu * TimeStep / R0; // dChi/dt = sqrt(mu) / r，步长远小于周期时已很接近解
+        double C   = 0.0;
+        double S   = 0.0;
+        double R   = R0;
+        for (int i = 0; i != kMaxKeplerIterations; ++i)
+        {
+            double Chi2 = Chi * Chi;
+            double z    = Alpha * Chi2;
+            CalculateStumpff(z, C, S);
+
+            double F = Rv / SqrtMu * Chi2 * C + (1.0 - Alpha * R0) * Chi2 * Chi * S + R0 * Chi - SqrtMu * TimeStep;
+            R        = Rv / SqrtMu * Chi * (1.0 - z * S) + (1.0 - Alpha * R0) * Chi2 * C + R0; // dF/dChi
+
+            double Delta = F / R;
+            Chi -= Delta;
+            if (std::abs(Delta) <= 1e-15 * std::abs(Chi))
+            {
+                break;
+            }
+        }
+
+        double Chi2 = Chi * Chi;
+        double z    = Alpha * Chi2;
+        CalculateStumpff(z, C, S);
+
+        double f = 1.0 - Chi2 / R0 * C;
+        double g = TimeStep - Chi2 * Chi * S / SqrtMu;
+
+        double NewX = f * X + g * Vx;
+        double NewY = f * Y + g * Vy;
+        double NewZ = f * Z + g * Vz;
+        R = std::sqrt(NewX * NewX + NewY * NewY + NewZ * NewZ);
+
+        double fDot = SqrtMu / (R * R0) * Chi * (z * S - 1.0);
+        double gDot = 1.0 - Chi2 / R * C;
+
+        double NewVx = fDot * X + gDot * Vx;
+        double NewVy = fDot * Y + gDot * Vy;
+        double NewVz = fDot * Z + gDot * Vz;
+
+        X  = NewX;
+        Y  = NewY;
+        Z  = NewZ;
+        Vx = NewVx;
+        Vy = NewVy;
+        Vz = NewVz;
+    }
+
+    // 两两引力加速度。外层遍历施力天体，内层遍历受力天体，内层各元素互不依赖且无分支，
+    // 不需要重排浮点加法也能直接向量化
+    void CalculateAccelerations(std::size_t Count, const double* Mu, const double* X, const double* Y, const double* Z,
+                                double* Ax, double* Ay, double* Az)
+    {
+        std::fill(Ax, Ax + Count, 0.0);
+        std::fill(Ay, Ay + Count, 0.0);
+        std::fill(Az, Az + Count, 0.0);
+
+        for (std::size_t j = 0; j != Count; ++j)
+        {
+            double Xj  = X[j];
+            double Yj  = Y[j];
+            double Zj  = Z[j];
+            double Muj = Mu[j];
+
+            for (std::size_t i = 0; i != Count; ++i)
+            {
+                double Dx   = Xj - X[i];
+                double Dy   = Yj - Y[i];
+                double Dz   = Zj - Z[i];
+                bool   bSelf = i == j;
+                double R2   = bSelf ? 1.0 : Dx * Dx + Dy * Dy + Dz * Dz;
+                double InvR = 1.0 / std::sqrt(R2);
+                double Factor = (bSelf ? 0.0 : Muj) * InvR * InvR * InvR;
+
+                Ax[i] += Factor * Dx;
+                Ay[i] += Factor * Dy;
+                Az[i] += Factor * Dz;
+            }
+        }
+    }
+}
+
+struct FSymplecticIntegrator::FScratch
+{
+    std::vector<double> Mu;
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+    std::vector<double> Vx;
+    std::vector<double> Vy;
+    std::vector<double> Vz;
+    std::vector<double> Ax;
+    std::vector<double> Ay;
+    std::vector<double> Az;
+
+    void Resize(std::size_t Size)
+    {
+        for (auto* Array : { &Mu, &X, &Y, &Z, &Vx, &Vy, &Vz, &Ax, &Ay, &Az })
+        {
+            Array->resize(Size);
+        }
+    }
+};
+
+// FNBodyBatch implementations
+// ---------------------------
+std::uint32_t FNBodyBatch::BeginSystem()
+{
+    _SystemOffsets.push_back(static_cast<std::uint32_t>(GetBodyCount()));
+    return static_cast<std::uint32_t>(GetSystemCount() - 1);
+}
+
+std::uint32_t FNBodyBatch::AddBody(double Mass, glm::dvec3 Position, glm::dvec3 Velocity, std::uint32_t NodeIndex)
+{
+    if (GetSystemCount() == 0)
+    {
+        throw std::logic_error("BeginSystem must be called before adding bodies.");
+    }
+    if (!(Mass >= 0.0))
+    {
+        throw std::invalid_argument("Body mass must be non-negative.");
+    }
+
+    _GravitationalParameters.push_back(kGravityConstant * Mass);
+    _PositionX.push_back(Position.x);
+    _PositionY.push_back(Position.y);
+    _PositionZ.push_back(Position.z);
+    _VelocityX.push_back(Velocity.x);
+    _VelocityY.push_back(Velocity.y);
+    _VelocityZ.push_back(Velocity.z);
+    _NodeIndices.push_back(NodeIndex);
+
+    ++_SystemOffsets.back();
+    return static_cast<std::uint32_t>(GetBodyCount() - 1);
+}
+
+std::uint32_t FNBodyBatch::AppendStellarSystem(Astro::FStellarSystem& System, const Astro::FOrbitalHierarchy& Hierarchy)
+{
+    FKeplerBatch KeplerBatch;
+    KeplerBatch.AppendHierarchy(Hierarchy);
+
+    FKeplerPropagator::FBodyStates States;
+    FKeplerPropagator().Propagate(KeplerBatch, 0.0, States);
+
+    std::uint32_t SystemIndex = BeginSystem();
+    for (std::size_t i = 0; i != Hierarchy.GetNodeCount(); ++i)
+    {
+        // 只加入恒星和行星，质心、小行星群、人造物和没有对应天体的节点都跳过
+        double Mass     = 0.0;
+        bool   bHasBody = false;
+        switch (Hierarchy.GetNode(i).Kind)
+        {
+        case Astro::FOrbit::EObjectType::kStar:
+            if (const auto* Star = Hierarchy.GetObject<Astro::AStar>(System, i))
+            {
+                Mass     = Star->GetMass();
+                bHasBody = true;
+            }
+            break;
+        case Astro::FOrbit::EObjectType::kPlanet:
+            if (const auto* Planet = Hierarchy.GetObject<Astro::APlanet>(System, i))
+            {
+                Mass     = Planet->GetMassDigital<double>();
+                bHasBody = true;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (!bHasBody)
+        {
+            continue;
+        }
+
+        AddBody(Mass, States.GetPosition(i), States.GetVelocity(i), static_cast<std::uint32_t>(i));
+    }
+
+    return SystemIndex;
+}
+
+void FNBodyBatch::Reserve(std::size_t SystemCount, std::size_t BodyCount)
+{
+    _SystemOffsets.reserve(SystemCount + 1);
+    for (auto* Array : { &_GravitationalParameters, &_PositionX, &_PositionY, &_PositionZ, &_VelocityX, &_VelocityY, &_VelocityZ })
+    {
+        Array->reserve(BodyCount);
+    }
+    _NodeIndices.reserve(BodyCount);
+}
+
+void FNBodyBatch::Clear()
+{
+    for (auto* Array : { &_GravitationalParameters, &_PositionX, &_PositionY, &_PositionZ, &_VelocityX, &_VelocityY, &_VelocityZ })
+    {
+        Array->clear();
+    }
+    _NodeIndices.clear();
+    _SystemOffsets.assign(1, 0);
+}
+
+double FNBodyBatch::GetMass(std::size_t BodyIndex) const
+{
+    return _GravitationalParameters[BodyIndex] / kGravityConstant;
+}
+
+double FNBodyBatch::CalculateEnergy(std::size_t SystemIndex) const
+{
+    auto [Begin, Count] = GetSystemBodyRange(SystemIndex);
+
+    double Kinetic   = 0.0;
+    double Potential = 0.0;
+    for (std::size_t i = Begin; i != Begin + Count; ++i)
+    {
+        double V2 = _VelocityX[i] * _VelocityX[i] + _VelocityY[i] * _VelocityY[i] + _VelocityZ[i] * _VelocityZ[i];
+        Kinetic += 0.5 * _GravitationalParameters[i] * V2;
+
+        for (std::size_t j = i + 1; j != Begin + Count; ++j)
+        {
+            double Dx = _PositionX[j] - _PositionX[i];
+            double Dy = _PositionY[j] - _PositionY[i];
+            double Dz = _PositionZ[j] - _PositionZ[i];
+            Potential -= _GravitationalParameters[i] * _GravitationalParameters[j] / std::sqrt(Dx * Dx + Dy * Dy + Dz * Dz);
+        }
+    }
+
+    return (Kinetic + Potential) / kGravityConstant; // 两项都以 GM 计，各差一个 G
+}
+
+// FSymplecticIntegrator implementations
+// -------------------------------------
+FSymplecticIntegrator::FSymplecticIntegrator(EScheme Scheme, double DominanceThreshold)
+    : _Scheme(Scheme), _DominanceThreshold(DominanceThreshold)
+{
+}
+
+void FSymplecticIntegrator::Integrate(FNBodyBatch& Batch, double TimeStep, std::size_t StepCount, int ThreadCount) const
+{
+    std::size_t SystemCount = Batch.GetSystemCount();
+    std::size_t ChunkCount  = std::min(static_cast<std::size_t>(std::max(ThreadCount, 1)), SystemCount);
+    if (ChunkCount <= 1)
+    {
+        IntegrateRange(Batch, 0, SystemCount, TimeStep, StepCount);
+        return;
+    }
+
+    Runtime::Thread::ParallelFor(SystemCount, ChunkCount, [&](std::size_t BeginSystem, std::size_t EndSystem, std::size_t) -> void
+    {
+        IntegrateRange(Batch, BeginSystem, EndSystem, TimeStep, StepCount);
+    });
+}
+
+void FSymplecticIntegrator::IntegrateSystem(FNBodyBatch& Batch, std::size_t SystemIndex, double TimeStep, std::size_t StepCount) const
+{
+    IntegrateRange(Batch, SystemIndex, SystemIndex + 1, TimeStep, StepCount);
+}
+
+FSymplecticIntegrator::EScheme FSymplecticIntegrator::SelectScheme(const FNBodyBatch& Batch, std::size_t SystemIndex) const
+{
+    if (_Scheme == EScheme::kLeapfrog)
+    {
+        return _Scheme;
+    }
+
+    auto [Begin, Count] = Batch.GetSystemBodyRange(SystemIndex);
+    if (Count == 0)
+    {
+        return EScheme::kLeapfrog;
+    }
+
+    // WH 的开普勒漂移和坐标变换都要除以中心天体的 GM，没有质量的系统即使指定了 WH 也只能用 leapfrog
+    auto   First     = Batch._GravitationalParameters.begin() + Begin;
+    double MaxMu     = *std::max_element(First, First + Count);
+    if (_Scheme == EScheme::kWisdomHolman)
+    {
+        return MaxMu > 0.0 ? EScheme::kWisdomHolman : EScheme::kLeapfrog;
+    }
+
+    double TotalMu   = 0.0;
+    for (std::size_t i = Begin; i != Begin + Count; ++i)
+    {
+        TotalMu += Batch._GravitationalParameters[i];
+    }
+
+    return MaxMu > 0.0 && (TotalMu - MaxMu) < _DominanceThreshold * MaxMu ? EScheme::kWisdomHolman : EScheme::kLeapfrog;
+}
+
+void FSymplecticIntegrator::IntegrateRange(FNBodyBatch& Batch, std::size_t BeginSystem, std::size_t EndSystem,
+                                           double TimeStep, std::size_t StepCount) const
+{
+    if (StepCount == 0)
+    {
+        return;
+    }
+
+    FScratch Scratch;
+    for (std::size_t SystemIndex = BeginSystem; SystemIndex != EndSystem; ++SystemIndex)
+    {
+        auto [Begin, Count] = Batch.GetSystemBodyRange(SystemIndex);
+        if (Count == 0)
+        {
+            continue;
+        }
+
+        if (SelectScheme(Batch, SystemIndex) == EScheme::kWisdomHolman)
+        {
+            StepWisdomHolman(Batch, Begin, Count, TimeStep, StepCount, Scratch);
+        }
+        else
+        {
+            StepLeapfrog(Batch, Begin, Count, TimeStep, StepCount, Scratch);
+        }
+    }
+}
+
+void FSymplecticIntegrator::StepWisdomHolman(FNBodyBatch& Batch, std::size_t Begin, std::size_t Count,
+                                             double TimeStep, std::size_t StepCount, FScratch& Scratch)
+{
+    const double* Mu = Batch._GravitationalParameters.data() + Begin;
+    double* Px = Batch._PositionX.data() + Begin;
+    double* Py = Batch._PositionY.data() + Begin;
+    double* Pz = Batch._PositionZ.data() + Begin;
+    double* Vx = Batch._VelocityX.data() + Begin;
+    double* Vy = Batch._VelocityY.data() + Begin;
+    double* Vz = Batch._VelocityZ.data() + Begin;
+
+    std::size_t Central   = static_cast<std::size_t>(std::max_element(Mu, Mu + Count) - Mu);
+    double      MuCentral = Mu[Central];
+
+    // 质心位置和速度
+    double     TotalMu = 0.0;
+    glm::dvec3 CenterPosition(0.0);
+    glm::dvec3 CenterVelocity(0.0);
+    for (std::size_t i = 0; i != Count; ++i)
+    {
+        TotalMu        += Mu[i];
+        CenterPosition += Mu[i] * glm::dvec3(Px[i], Py[i], Pz[i]);
+        CenterVelocity += Mu[i] * glm::dvec3(Vx[i], Vy[i], Vz[i]);
+    }
+    CenterPosition /= TotalMu;
+    CenterVelocity /= TotalMu;
+
+    // 转为民主日心坐标：位置相对中心天体，速度相对质心，中心天体本身不参与
+    std::size_t OrbiterCount = Count - 1;
+    Scratch.Resize(OrbiterCount);
+    for (std::size_t i = 0, k = 0; i != Count; ++i)
+    {
+        if (i == Central)
+        {
+            continue;
+        }
+
+        Scratch.Mu[k] = Mu[i];
+        Scratch.X[k]  = Px[i] - Px[Central];
+        Scratch.Y[k]  = Py[i] - Py[Central];
+        Scratch.Z[k]  = Pz[i] - Pz[Central];
+        Scratch.Vx[k] = Vx[i] - CenterVelocity.x;
+        Scratch.Vy[k] = Vy[i] - CenterVelocity.y;
+        Scratch.Vz[k] = Vz[i] - CenterVelocity.z;
+        ++k;
+    }
+
+    auto Kick = [&](double Step) -> void // 非中心天体之间的相互作用
+    {
+        CalculateAccelerations(OrbiterCount, Scratch.Mu.data(), Scratch.X.data(), Scratch.Y.data(), Scratch.Z.data(),
+                               Scratch.Ax.data(), Scratch.Ay.data(), Scratch.Az.data());
+
+        for (std::size_t k = 0; k != OrbiterCount; ++k)
+        {
+            Scratch.Vx[k] += Step * Scratch.Ax[k];
+            Scratch.Vy[k] += Step * Scratch.Ay[k];
+            Scratch.Vz[k] += Step * Scratch.Az[k];
+        }
+    };
+
+    auto Jump = [&](double Step) -> void // 中心天体随总动量的平移
+    {
+        glm::dvec3 Momentum(0.0);
+        for (std::size_t k = 0; k != OrbiterCount; ++k)
+        {
+            Momentum += Scratch.Mu[k] * glm::dvec3(Scratch.Vx[k], Scratch.Vy[k], Scratch.Vz[k]);
+        }
+
+        glm::dvec3 Shift = Step / MuCentral * Momentum;
+        for (std::size_t k = 0; k != OrbiterCount; ++k)
+        {
+            Scratch.X[k] += Shift.x;
+            Scratch.Y[k] += Shift.y;
+            Scratch.Z[k] += Shift.z;
+        }
+    };
+
+    auto Drift = [&](double Step) -> void // 绕中心天体的开普勒运动
+    {
+        for (std::size_t k = 0; k != OrbiterCount; ++k)
+        {
+            DriftKepler(MuCentral, Step, Scratch.X[k], Scratch.Y[k], Scratch.Z[k], Scratch.Vx[k], Scratch.Vy[k], Scratch.Vz[k]);
+        }
+    };
+
+    // 踢-跳-漂-跳-踢，相邻两步的半步踢动合并为一次
+    double HalfStep = 0.5 * TimeStep;
+    Kick(HalfStep);
+    for (std::size_t Step = 0; Step != StepCount; ++Step)
+    {
+        Jump(HalfStep);
+        Drift(TimeStep);
+        Jump(HalfStep);
+        Kick(Step + 1 == StepCount ? HalfStep : TimeStep);
+    }
+
+    // 转回质心坐标，质心本身匀速运动
+    double     TotalTime = TimeStep * static_cast<double>(StepCount);
+    glm::dvec3 WeightedOffset(0.0);
+    glm::dvec3 Momentum(0.0);
+    for (std::size_t k = 0; k != OrbiterCount; ++k)
+    {
+        WeightedOffset += Scratch.Mu[k] * glm::dvec3(Scratch.X[k], Scratch.Y[k], Scratch.Z[k]);
+        Momentum       += Scratch.Mu[k] * glm::dvec3(Scratch.Vx[k], Scratch.Vy[k], Scratch.Vz[k]);
+    }
+
+    glm::dvec3 CentralPosition = CenterPosition + TotalTime * CenterVelocity - WeightedOffset / TotalMu;
+    glm::dvec3 CentralVelocity = CenterVelocity - Momentum / MuCentral;
+
+    Px[Central] = CentralPosition.x;
+    Py[Central] = CentralPosition.y;
+    Pz[Central] = CentralPosition.z;
+    Vx[Central] = CentralVelocity.x;
+    Vy[Central] = CentralVelocity.y;
+    Vz[Central] = CentralVelocity.z;
+
+    for (std::size_t i = 0, k = 0; i != Count; ++i)
+    {
+        if (i == Central)
+        {
+            continue;
+        }
+
+        Px[i] = Scratch.X[k]  + CentralPosition.x;
+        Py[i] = Scratch.Y[k]  + CentralPosition.y;
+        Pz[i] = Scratch.Z[k]  + CentralPosition.z;
+        Vx[i] = Scratch.Vx[k] + CenterVelocity.x;
+        Vy[i] = Scratch.Vy[k] + CenterVelocity.y;
+        Vz[i] = Scratch.Vz[k] + CenterVelocity.z;
+        ++k;
+    }
+}
+
+void FSymplecticIntegrator::StepLeapfrog(FNBodyBatch& Batch, std::size_t Begin, std::size_t Count,
+                                         double TimeStep, std::size_t StepCount, FScratch& Scratch)
+{
+    const double* Mu = Batch._GravitationalParameters.data() + Begin;
+    double* Px = Batch._PositionX.data() + Begin;
+    double* Py = Batch._PositionY.data() + Begin;
+    double* Pz = Batch._PositionZ.data() + Begin;
+    double* Vx = Batch._VelocityX.data() + Begin;
+    double* Vy = Batch._VelocityY.data() + Begin;
+    double* Vz = Batch._VelocityZ.data() + Begin;
+
+    Scratch.Resize(Count);
+
+    auto Kick = [&](double Step) -> void
+    {
+        CalculateAccelerations(Count, Mu, Px, Py, Pz, Scratch.Ax.data(), Scratch.Ay.data(), Scratch.Az.data());
+        for (std::size_t i = 0; i != Count; ++i)
+        {
+            Vx[i] += Step * Scratch.Ax[i];
+            Vy[i] += Step * Scratch.Ay[i];
+            Vz[i] += Step * Scratch.Az[i];
+        }
+    };
+
+    // 踢-漂-踢，相邻两步的半步踢动合并为一次
+    double HalfStep = 0.5 * TimeStep;
+    Kick(HalfStep);
+    for (std::size_t Step = 0; Step != StepCount; ++Step)
+    {
+        for (std::size_t i = 0; i != Count; ++i)
+        {
+            Px[i] += TimeStep * Vx[i];
+            Py[i] += TimeStep * Vy[i];
+            Pz[i] += TimeStep * Vz[i];
+        }
+
+        Kick(Step + 1 == StepCount ? HalfStep : TimeStep);
+    }
+}
+
+_DYNAMICS_END
+_SYSTEM_END
+_NPGS_END
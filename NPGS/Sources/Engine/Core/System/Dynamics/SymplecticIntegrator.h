@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Types/Entries/Astro/OrbitalHierarchy.h"
+#include "Engine/Core/Types/Entries/Astro/StellarSystem.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_DYNAMICS_BEGIN
+
+// 多个相互独立的 N 体系统，按结构数组存储，同一系统的天体在数组中连续存放
+// 质量以引力参数 GM 保存，单位 m^3/s^2；位置和速度为国际单位制
+class FNBodyBatch
+{
+public:
+    static constexpr std::uint32_t kNoNode = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    FNBodyBatch()  = default;
+    ~FNBodyBatch() = default;
+
+    std::uint32_t BeginSystem(); // 开始一个新系统，之后 AddBody 添加的天体都属于它
+    std::uint32_t AddBody(double Mass, glm::dvec3 Position, glm::dvec3 Velocity, std::uint32_t NodeIndex = kNoNode);
+
+    // 以系统质心为原点，用轨道层级在时刻 0 的开普勒位置和速度初始化一个新系统，返回系统编号
+    // 恒星和行星（含卫星）按各自质量参与计算，质心和人造物不加入
+    // 小行星带、特洛伊群和行星环是弥散的天体群，特洛伊群还与所在行星共用轨道和近点角，不作为质点加入
+    std::uint32_t AppendStellarSystem(Astro::FStellarSystem& System, const Astro::FOrbitalHierarchy& Hierarchy);
+
+    void Reserve(std::size_t SystemCount, std::size_t BodyCount);
+    void Clear();
+
+    std::size_t GetSystemCount() const;
+    std::size_t GetBodyCount() const;
+    std::pair<std::size_t, std::size_t> GetSystemBodyRange(std::size_t SystemIndex) const; // (首个天体下标, 天体数量)
+
+    double GetMass(std::size_t BodyIndex) const; // 单位 kg
+    glm::dvec3 GetPosition(std::size_t BodyIndex) const;
+    glm::dvec3 GetVelocity(std::size_t BodyIndex) const;
+    std::uint32_t GetNodeIndex(std::size_t BodyIndex) const; // 天体在轨道层级中的节点下标，手动添加的天体为 kNoNode
+
+    double CalculateEnergy(std::size_t SystemIndex) const; // 系统总机械能，单位 J，用于检验积分误差
+
+private:
+    friend class FSymplecticIntegrator;
+
+private:
+    std::vector<double>        _GravitationalParameters;
+    std::vector<double>        _PositionX;
+    std::vector<double>        _PositionY;
+    std::vector<double>        _PositionZ;
+    std::vector<double>        _VelocityX;
+    std::vector<double>        _VelocityY;
+    std::vector<double>        _VelocityZ;
+    std::vector<std::uint32_t> _NodeIndices;
+    std::vector<std::uint32_t> _SystemOffsets{ 0 }; // 第 i 个系统的天体为 [_SystemOffsets[i], _SystemOffsets[i + 1])
+};
+
+// 二阶辛积分器，所有系统相互独立，可按系统分块多线程推进
+// Wisdom-Holman 使用民主日心坐标：开普勒漂移绕质量最大的天体解析求解，其余天体之间的引力作为踢动，
+// 只适用于中心天体占绝对主导的系统；双星等质量相当的系统改用质心坐标下的 leapfrog（踢-漂-踢）
+// 两种格式的步长都须远小于系统中最短的轨道周期（含卫星），WH 的误差还与非中心天体的质量占比成正比
+class FSymplecticIntegrator
+{
+public:
+    enum class EScheme
+    {
+        kAutomatic,    // 按 DominanceThreshold 为每个系统选择格式
+        kWisdomHolman, // 最大 GM 为 0 的系统仍使用 leapfrog
+        kLeapfrog
+    };
+
+public:
+    explicit FSymplecticIntegrator(EScheme Scheme = EScheme::kAutomatic, double DominanceThreshold = 1e-2);
+    ~FSymplecticIntegrator() = default;
+
+    // 所有系统各推进 StepCount 步，ThreadCount 大于 1 时使用线程池按系统分块并行
+    void Integrate(FNBodyBatch& Batch, double TimeStep, std::size_t StepCount, int ThreadCount = 1) const;
+    void IntegrateSystem(FNBodyBatch& Batch, std::size_t SystemIndex, double TimeStep, std::size_t StepCount) const;
+
+    EScheme SelectScheme(const FNBodyBatch& Batch, std::size_t SystemIndex) const;
+
+private:
+    struct FScratch; // 单个系统积分时使用的结构数组，按线程复用
+
+    void IntegrateRange(FNBodyBatch& Batch, std::size_t BeginSystem, std::size_t EndSystem,
+                        double TimeStep, std::size_t StepCount) const;
+
+    static void StepWisdomHolman(FNBodyBatch& Batch, std::size_t Begin, std::size_t Count,
+                                 double TimeStep, std::size_t StepCount, FScratch& Scratch);
+
+    static void StepLeapfrog(FNBodyBatch& Batch, std::size_t Begin, std::size_t Count,
+                             double TimeStep, std::size_t StepCount, FScratch& Scratch);
+
+private:
+    EScheme _Scheme;
+    double  _DominanceThreshold; // 非中心天体总质量与中心天体质量之比低于该值时使用 WH
+};
+
+_DYNAMICS_END
+_SYSTEM_END
+_NPGS_END
+
+#include "SymplecticIntegrator.inl"
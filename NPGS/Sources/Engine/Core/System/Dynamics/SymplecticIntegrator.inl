@@ -0,0 +1,39 @@
+#include "SymplecticIntegrator.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_DYNAMICS_BEGIN
+
+NPGS_INLINE std::size_t FNBodyBatch::GetSystemCount() const
+{
+    return _SystemOffsets.size() - 1;
+}
+
+NPGS_INLINE std::size_t FNBodyBatch::GetBodyCount() const
+{
+    return _GravitationalParameters.size();
+}
+
+NPGS_INLINE std::pair<std::size_t, std::size_t> FNBodyBatch::GetSystemBodyRange(std::size_t SystemIndex) const
+{
+    return { _SystemOffsets[SystemIndex], _SystemOffsets[SystemIndex + 1] - _SystemOffsets[SystemIndex] };
+}
+
+NPGS_INLINE glm::dvec3 FNBodyBatch::GetPosition(std::size_t BodyIndex) const
+{
+    return glm::dvec3(_PositionX[BodyIndex], _PositionY[BodyIndex], _PositionZ[BodyIndex]);
+}
+
+NPGS_INLINE glm::dvec3 FNBodyBatch::GetVelocity(std::size_t BodyIndex) const
+{
+    return glm::dvec3(_VelocityX[BodyIndex], _VelocityY[BodyIndex], _VelocityZ[BodyIndex]);
+}
+
+NPGS_INLINE std::uint32_t FNBodyBatch::GetNodeIndex(std::size_t BodyIndex) const
+{
+    return _NodeIndices[BodyIndex];
+}
+
+_DYNAMICS_END
+_SYSTEM_END
+_NPGS_END
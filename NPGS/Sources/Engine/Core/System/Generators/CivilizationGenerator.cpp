@@ -1,25 +1,118 @@
 #include "CivilizationGenerator.h"
 
 #include <cmath>
-#include <print>
+#include <algorithm>
+#include <future>
 #include <utility>
 
 #include "Engine/Core/Math/NumericConstants.h"
-#include "Engine/Core/Types/Properties/Intelli/Civilization.h"
-
-#define DEBUG_OUTPUT
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Utils/Diagnostics.h"
 
 _NPGS_BEGIN
 _SYSTEM_BEGIN
 _GENERATOR_BEGIN
 
+// Tool functions
+// --------------
+namespace
+{
+    constexpr double kMinLifeStarAge = 2.4e9;
+
+    void AddCrustMineralMass(float CrustMineralIncrement, Astro::APlanet* Planet)
+    {
+        if (CrustMineralIncrement > 0.0f)
+        {
+            Planet->SetCrustMineralMass(CrustMineralIncrement + Planet->GetCrustMineralMassDigital<float>());
+        }
+    }
+
+    // 与 AddCrustMineralMass 写回后 GetMassDigital<double>() 的结果逐位一致，但不修改行星
+    double CalculateMassWithCrust(float CrustMineralIncrement, const Astro::APlanet* Planet)
+    {
+        if (CrustMineralIncrement <= 0.0f)
+        {
+            return Planet->GetMassDigital<double>();
+        }
+
+        Math::FUint128 CrustMineralMass(CrustMineralIncrement + Planet->GetCrustMineralMassDigital<float>());
+        Math::FUint128 Mass = Planet->GetAtmosphereMass() + Planet->GetOceanMass() + Planet->GetCoreMass() + CrustMineralMass;
+        return Mass.ConvertTo<double>();
+    }
+}
+
+// FBatchInput implementations
+// ---------------------------
+void FCivilizationGenerator::FBatchInput::Push(double StarAge, float PoyntingVector, Astro::APlanet* Planet)
+{
+    StarAges.push_back(StarAge);
+    PoyntingVectors.push_back(PoyntingVector);
+    Planets.push_back(Planet);
+}
+
+void FCivilizationGenerator::FBatchInput::Reserve(std::size_t Count)
+{
+    StarAges.reserve(Count);
+    PoyntingVectors.reserve(Count);
+    Planets.reserve(Count);
+}
+
+void FCivilizationGenerator::FBatchInput::Clear()
+{
+    StarAges.clear();
+    PoyntingVectors.clear();
+    Planets.clear();
+}
+
+std::size_t FCivilizationGenerator::FBatchInput::Size() const
+{
+    return Planets.size();
+}
+
+// FCivilizationTable implementations
+// ----------------------------------
+const Intelli::FStandard* FCivilizationGenerator::FCivilizationTable::Find(std::size_t InputIndex) const
+{
+    auto It = std::lower_bound(InputIndices.begin(), InputIndices.end(), InputIndex);
+    if (It == InputIndices.end() || *It != InputIndex)
+    {
+        return nullptr;
+    }
+
+    return &Civilizations[It - InputIndices.begin()];
+}
+
+void FCivilizationGenerator::FCivilizationTable::Clear()
+{
+    InputIndices.clear();
+    Civilizations.clear();
+    CrustMineralIncrements.clear();
+}
+
+std::size_t FCivilizationGenerator::FCivilizationTable::Size() const
+{
+    return InputIndices.size();
+}
+
+void FCivilizationGenerator::FCivilizationTable::ApplyTo(const FBatchInput& Input) const
+{
+    for (std::size_t i = 0; i != InputIndices.size(); ++i)
+    {
+        Astro::APlanet* Planet = Input.Planets[InputIndices[i]];
+        AddCrustMineralMass(CrustMineralIncrements[i], Planet);
+        Planet->SetCivilizationData(std::make_unique<Intelli::FStandard>(Civilizations[i]));
+    }
+}
+
+// FCivilizationGenerator implementations
+// --------------------------------------
 FCivilizationGenerator::FCivilizationGenerator(const FGenerationInfo& GenerationInfo)
     :
     _RandomEngine(*GenerationInfo.SeedSequence),
     _CommonGenerator(0.0f, 1.0f),
     _AsiFiltedProbability(static_cast<double>(GenerationInfo.bEnableAsiFilter) * 0.2),
     _DestroyedByDisasterProbability(GenerationInfo.DestroyedByDisasterProbability),
-    _LifeOccurrenceProbability(GenerationInfo.LifeOccurrenceProbability)
+    _LifeOccurrenceSampler(GenerationInfo.LifeOccurrenceProbability)
 {
 }
 
@@ -29,7 +122,7 @@ FCivilizationGenerator::FCivilizationGenerator(const FCivilizationGenerator& Oth
     _CommonGenerator(Other._CommonGenerator),
     _AsiFiltedProbability(Other._AsiFiltedProbability),
     _DestroyedByDisasterProbability(Other._DestroyedByDisasterProbability),
-    _LifeOccurrenceProbability(Other._LifeOccurrenceProbability)
+    _LifeOccurrenceSampler(Other._LifeOccurrenceSampler)
 {
 }
 
@@ -39,7 +132,7 @@ FCivilizationGenerator::FCivilizationGenerator(FCivilizationGenerator&& Other) n
     _CommonGenerator(std::move(Other._CommonGenerator)),
     _AsiFiltedProbability(std::move(Other._AsiFiltedProbability)),
     _DestroyedByDisasterProbability(std::move(Other._DestroyedByDisasterProbability)),
-    _LifeOccurrenceProbability(std::move(Other._LifeOccurrenceProbability))
+    _LifeOccurrenceSampler(std::move(Other._LifeOccurrenceSampler))
 {
 }
 
@@ -51,7 +144,7 @@ FCivilizationGenerator& FCivilizationGenerator::operator=(const FCivilizationGen
         _CommonGenerator                = Other._CommonGenerator;
         _AsiFiltedProbability           = Other._AsiFiltedProbability;
         _DestroyedByDisasterProbability = Other._DestroyedByDisasterProbability;
-        _LifeOccurrenceProbability      = Other._LifeOccurrenceProbability;
+        _LifeOccurrenceSampler          = Other._LifeOccurrenceSampler;
     }
 
     return *this;
@@ -65,7 +158,7 @@ FCivilizationGenerator& FCivilizationGenerator::operator=(FCivilizationGenerator
         _CommonGenerator                = std::move(Other._CommonGenerator);
         _AsiFiltedProbability           = std::move(Other._AsiFiltedProbability);
         _DestroyedByDisasterProbability = std::move(Other._DestroyedByDisasterProbability);
-        _LifeOccurrenceProbability      = std::move(Other._LifeOccurrenceProbability);
+        _LifeOccurrenceSampler          = std::move(Other._LifeOccurrenceSampler);
     }
 
     return *this;
@@ -73,47 +166,116 @@ FCivilizationGenerator& FCivilizationGenerator::operator=(FCivilizationGenerator
 
 void FCivilizationGenerator::GenerateCivilization(const Astro::AStar* Star, float PoyntingVector, Astro::APlanet* Planet)
 {
-    if (Star->GetAge() < 2.4e9 || !_LifeOccurrenceProbability(_RandomEngine))
+    if (Star->GetAge() < kMinLifeStarAge || !_LifeOccurrenceSampler(_RandomEngine))
     {
         return;
     }
 
     Planet->SetCivilizationData(std::make_unique<Intelli::FStandard>());
 
-    GenerateLife(Star->GetAge(), PoyntingVector, Planet);
-    GenerateCivilizationDetails(Star, PoyntingVector, Planet);
-
-#ifdef DEBUG_OUTPUT
-    std::println("");
-    std::println("Life details:");
-    std::println("Life phase: {}",                                                std::to_underlying(Planet->CivilizationData().GetLifePhase()));
-    std::println("Organism biomass: {:.2E} kg",                                   Planet->CivilizationData().GetOrganismBiomassDigital<float>());
-    std::println("Organism used power: {:.2E} W",                                 Planet->CivilizationData().GetOrganismUsedPower());
-    std::println("Standard civilization details:");
-    std::println("Civilization progress: {}",                                     Planet->CivilizationData().GetCivilizationProgress());
-    std::println("Atrifical structure mass: {:.2E} kg",                           Planet->CivilizationData().GetAtrificalStructureMassDigital<float>());
-    std::println("Citizen biomass: {:.2E} kg",                                    Planet->CivilizationData().GetCitizenBiomassDigital<float>());
-    std::println("Useable energetic nuclide: {:.2E} kg",                          Planet->CivilizationData().GetUseableEnergeticNuclideDigital<float>());
-    std::println("Orbit assets mass: {:.2E} kg",                                  Planet->CivilizationData().GetOrbitAssetsMassDigital<float>());
-    std::println("General intelligence count: {}",                                Planet->CivilizationData().GetGeneralintelligenceCount());
-    std::println("General intelligence average synapse activation count: {} o/s", Planet->CivilizationData().GetGeneralIntelligenceAverageSynapseActivationCount());
-    std::println("General intelligence synapse count: {}",                        Planet->CivilizationData().GetGeneralIntelligenceSynapseCount());
-    std::println("General intelligence average lifetime: {} yr",                  Planet->CivilizationData().GetGeneralIntelligenceAverageLifetime());
-    std::println("Storaged history data size: {:.2E} bit",                        Planet->CivilizationData().GetStoragedHistoryDataSize());
-    std::println("Citizen used power: {:.2E} W",                                  Planet->CivilizationData().GetCitizenUsedPower());
-    std::println("Teamwork coefficient: {}",                                      Planet->CivilizationData().GetTeamworkCoefficient());
-    std::println("Is independent individual: {}",                                 Planet->CivilizationData().IsIndependentIndividual());
-    std::println("");
-#endif // DEBUG_OUTPUT
+    float CrustMineralIncrement = GenerateLife(Star->GetAge(), PoyntingVector, Planet, Planet->CivilizationData());
+    AddCrustMineralMass(CrustMineralIncrement, Planet);
+    GenerateCivilizationDetails(Star->GetAge(), PoyntingVector, Planet, Planet->CivilizationData(), 0.0f);
+
+    if (Util::FDiagnostics::IsTracing())
+    {
+        const auto& CivilizationData = Planet->CivilizationData();
+        NpgsDiagnostic("civilization", "Life phase: {}",                                                std::to_underlying(CivilizationData.GetLifePhase()));
+        NpgsDiagnostic("civilization", "Organism biomass: {:.2E} kg",                                   CivilizationData.GetOrganismBiomassDigital<float>());
+        NpgsDiagnostic("civilization", "Organism used power: {:.2E} W",                                 CivilizationData.GetOrganismUsedPower());
+        NpgsDiagnostic("civilization", "Civilization progress: {}",                                     CivilizationData.GetCivilizationProgress());
+        NpgsDiagnostic("civilization", "Atrifical structure mass: {:.2E} kg",                           CivilizationData.GetAtrificalStructureMassDigital<float>());
+        NpgsDiagnostic("civilization", "Citizen biomass: {:.2E} kg",                                    CivilizationData.GetCitizenBiomassDigital<float>());
+        NpgsDiagnostic("civilization", "Useable energetic nuclide: {:.2E} kg",                          CivilizationData.GetUseableEnergeticNuclideDigital<float>());
+        NpgsDiagnostic("civilization", "Orbit assets mass: {:.2E} kg",                                  CivilizationData.GetOrbitAssetsMassDigital<float>());
+        NpgsDiagnostic("civilization", "General intelligence count: {}",                                CivilizationData.GetGeneralintelligenceCount());
+        NpgsDiagnostic("civilization", "General intelligence average synapse activation count: {} o/s", CivilizationData.GetGeneralIntelligenceAverageSynapseActivationCount());
+        NpgsDiagnostic("civilization", "General intelligence synapse count: {}",                        CivilizationData.GetGeneralIntelligenceSynapseCount());
+        NpgsDiagnostic("civilization", "General intelligence average lifetime: {} yr",                  CivilizationData.GetGeneralIntelligenceAverageLifetime());
+        NpgsDiagnostic("civilization", "Storaged history data size: {:.2E} bit",                        CivilizationData.GetStoragedHistoryDataSize());
+        NpgsDiagnostic("civilization", "Citizen used power: {:.2E} W",                                  CivilizationData.GetCitizenUsedPower());
+        NpgsDiagnostic("civilization", "Teamwork coefficient: {}",                                      CivilizationData.GetTeamworkCoefficient());
+        NpgsDiagnostic("civilization", "Is independent individual: {}",                                 CivilizationData.IsIndependentIndividual());
+    }
+}
+
+void FCivilizationGenerator::GenerateCivilizations(const FBatchInput& Input, std::uint32_t Seed,
+                                                   FCivilizationTable& Table, int ThreadCount) const
+{
+    Table.Clear();
+
+    // 先串行筛出产生生命的输入，几何跳跃采样只为命中的输入抽取随机数
+    std::mt19937 OccurrenceEngine(Seed);
+    auto LifeOccurrenceSampler = _LifeOccurrenceSampler;
+    LifeOccurrenceSampler.Reset();
+
+    for (std::size_t i = 0; i != Input.Size(); ++i)
+    {
+        if (Input.StarAges[i] >= kMinLifeStarAge && LifeOccurrenceSampler(OccurrenceEngine))
+        {
+            Table.InputIndices.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    std::size_t HitCount = Table.InputIndices.size();
+    Table.Civilizations.resize(HitCount);
+    Table.CrustMineralIncrements.resize(HitCount);
+
+    // 命中的输入之间互不依赖，按块分给线程池
+    auto GenerateRange = [this, &Input, &Table, Seed](std::size_t Begin, std::size_t End) -> void
+    {
+        FCivilizationGenerator Generator(*this);
+        for (std::size_t k = Begin; k != End; ++k)
+        {
+            std::uint32_t InputIndex = Table.InputIndices[k];
+            std::seed_seq SeedSequence{ Seed, InputIndex };
+            Generator._RandomEngine.seed(SeedSequence);
+
+            auto&           CivilizationData = Table.Civilizations[k];
+            double          StarAge          = Input.StarAges[InputIndex];
+            float           PoyntingVector   = Input.PoyntingVectors[InputIndex];
+            Astro::APlanet* Planet           = Input.Planets[InputIndex];
+
+            CivilizationData = Intelli::FStandard();
+            Table.CrustMineralIncrements[k] = Generator.GenerateLife(StarAge, PoyntingVector, Planet, CivilizationData);
+            Generator.GenerateCivilizationDetails(StarAge, PoyntingVector, Planet, CivilizationData,
+                                                  Table.CrustMineralIncrements[k]);
+        }
+    };
+
+    std::size_t ChunkCount = std::min(static_cast<std::size_t>(std::max(ThreadCount, 1)), HitCount);
+    if (ChunkCount <= 1)
+    {
+        GenerateRange(0, HitCount);
+        return;
+    }
+
+    auto* ThreadPool = Runtime::Thread::FThreadPool::GetInstance();
+    std::vector<std::future<void>> Futures;
+    Futures.reserve(ChunkCount);
+
+    std::size_t Begin = 0;
+    for (std::size_t i = 0; i != ChunkCount; ++i)
+    {
+        std::size_t End = Begin + HitCount / ChunkCount + (i < HitCount % ChunkCount ? 1 : 0);
+        Futures.push_back(ThreadPool->Submit(GenerateRange, Begin, End));
+        Begin = End;
+    }
+
+    for (auto& Future : Futures)
+    {
+        Future.get();
+    }
 }
 
-void FCivilizationGenerator::GenerateLife(double StarAge, float PoyntingVector, Astro::APlanet* Planet)
+float FCivilizationGenerator::GenerateLife(double StarAge, float PoyntingVector, const Astro::APlanet* Planet,
+                                           Intelli::FStandard& CivilizationData)
 {
     // 计算生命演化阶段
-    float Random           = 0.5f + _CommonGenerator(_RandomEngine) + 1.5f;
-    auto  LifePhase        =
+    float Random                = 0.5f + _CommonGenerator(_RandomEngine) + 1.5f;
+    auto  LifePhase             =
         static_cast<Intelli::FStandard::ELifePhase>(std::min(4, std::max(1, static_cast<int>(Random * StarAge / (5e8)))));
-    auto& CivilizationData = Planet->CivilizationData();
+    float CrustMineralIncrement = 0.0f;
 
     // 处理生命成矿机制以及 ASI 大过滤器
     if (LifePhase == Intelli::FStandard::ELifePhase::kCenoziocEra)
@@ -122,7 +284,7 @@ void FCivilizationGenerator::GenerateLife(double StarAge, float PoyntingVector,
         if (_AsiFiltedProbability(_RandomEngine))
         {
             LifePhase = Intelli::FStandard::ELifePhase::kSatTeeTouyButByAsi; // 被 ASI 去城市化了
-            Planet->SetCrustMineralMass(Random * 1e16f + Planet->GetCrustMineralMassDigital<float>());
+            CrustMineralIncrement = Random * 1e16f;
         }
         else
         {
@@ -132,7 +294,7 @@ void FCivilizationGenerator::GenerateLife(double StarAge, float PoyntingVector,
             }
             else
             {
-                Planet->SetCrustMineralMass(Random * 1e15f + Planet->GetCrustMineralMassDigital<float>());
+                CrustMineralIncrement = Random * 1e15f;
             }
         }
     }
@@ -188,15 +350,17 @@ void FCivilizationGenerator::GenerateLife(double StarAge, float PoyntingVector,
         OrganismUsedPower *= CommonRandom;
     }
 
-    CivilizationData.SetOrganismBiomass(boost::multiprecision::uint128_t(OrganismBiomass));
+    CivilizationData.SetOrganismBiomass(Math::FUint128(OrganismBiomass));
     CivilizationData.SetOrganismUsedPower(static_cast<float>(OrganismUsedPower));
+
+    return CrustMineralIncrement;
 }
 
-void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Star, float PoyntingVector, Astro::APlanet* Planet)
+void FCivilizationGenerator::GenerateCivilizationDetails(double StarAge, float PoyntingVector, const Astro::APlanet* Planet,
+                                                         Intelli::FStandard& CivilizationData, float CrustMineralIncrement)
 {
     const std::array<float, 7>* ProbabilityListPtr = nullptr;
-    auto& CivilizationData = Planet->CivilizationData();
-    auto  LifePhase        = Planet->CivilizationData().GetLifePhase();
+    auto LifePhase = CivilizationData.GetLifePhase();
 
     int   PrimaryLevel      = 0;
     float LevelProgress     = 0.0f;
@@ -268,7 +432,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
     float Random2 = GenerateRandom2();
 
     // 文明生物的总生物量（CitizenBiomass）
-    boost::multiprecision::uint128_t CitizenBiomass;
+    Math::FUint128 CitizenBiomass;
     if (CivilizationLevel >= Intelli::FStandard::_kDigitalAge && CivilizationLevel <= Intelli::FStandard::_kEarlyAsiAge)
     {
         double Base        = Random1 * 4e11;
@@ -276,7 +440,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kAtomicAge && CivilizationLevel < Intelli::FStandard::_kDigitalAge)
     {
@@ -285,7 +449,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kElectricAge && CivilizationLevel < Intelli::FStandard::_kAtomicAge)
     {
@@ -294,7 +458,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kSteamAge && CivilizationLevel < Intelli::FStandard::_kElectricAge)
     {
@@ -303,7 +467,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kEarlyIndustrielle && CivilizationLevel < Intelli::FStandard::_kSteamAge)
     {
@@ -312,7 +476,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kUrgesellschaft && CivilizationLevel < Intelli::FStandard::_kEarlyIndustrielle)
     {
@@ -321,7 +485,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kInitialGeneralIntelligence && CivilizationLevel < Intelli::FStandard::_kUrgesellschaft)
     {
@@ -330,7 +494,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result      = Base * Coefficient;
         float  Random      = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result            *= Random;
-        CitizenBiomass     = boost::multiprecision::uint128_t(Result);
+        CitizenBiomass     = Math::FUint128(Result);
     }
     else
     {
@@ -339,7 +503,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
     CivilizationData.SetCitizenBiomass(CitizenBiomass);
 
     // 文明造物总质量（AtrificalStructureMass）
-    boost::multiprecision::uint128_t AtrificalStructureMass;
+    Math::FUint128 AtrificalStructureMass;
     if (CivilizationLevel >= Intelli::FStandard::_kDigitalAge && CivilizationLevel <= Intelli::FStandard::_kEarlyAsiAge)
     {
         double Base            = Random1 * 1e15;
@@ -347,7 +511,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result          = Base * Coefficient;
         float  Random          = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result                *= Random;
-        AtrificalStructureMass = boost::multiprecision::uint128_t(Result);
+        AtrificalStructureMass = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kAtomicAge && CivilizationLevel < Intelli::FStandard::_kDigitalAge)
     {
@@ -356,7 +520,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result          = Base * Coefficient;
         float  Random          = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result                *= Random;
-        AtrificalStructureMass = boost::multiprecision::uint128_t(Result);
+        AtrificalStructureMass = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kElectricAge && CivilizationLevel < Intelli::FStandard::_kAtomicAge)
     {
@@ -365,7 +529,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result          = Base * Coefficient;
         float  Random          = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result                *= Random;
-        AtrificalStructureMass = boost::multiprecision::uint128_t(Result);
+        AtrificalStructureMass = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kSteamAge && CivilizationLevel < Intelli::FStandard::_kElectricAge)
     {
@@ -374,7 +538,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result          = Base * Coefficient;
         float  Random          = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result                *= Random;
-        AtrificalStructureMass = boost::multiprecision::uint128_t(Result);
+        AtrificalStructureMass = Math::FUint128(Result);
     }
     else if (CivilizationLevel >= Intelli::FStandard::_kEarlyIndustrielle && CivilizationLevel < Intelli::FStandard::_kSteamAge)
     {
@@ -383,7 +547,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         double Result          = Base * Coefficient;
         float  Random          = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Result                *= Random;
-        AtrificalStructureMass = boost::multiprecision::uint128_t(Result);
+        AtrificalStructureMass = Math::FUint128(Result);
     }
     else
     {
@@ -524,7 +688,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
     float AverageWeight = Random1 * Random2 * 1e4f;
 
     // 通用智能个体的数量（GeneralIntelligenceCount）
-    std::uint64_t TotalCount = static_cast<std::uint64_t>(CitizenBiomass.convert_to<float>() / AverageWeight);
+    std::uint64_t TotalCount = static_cast<std::uint64_t>(CitizenBiomass.ConvertTo<float>() / AverageWeight);
     CivilizationData.SetGeneralintelligenceCount(TotalCount);
 
     // 通用智能个体平均突触数量（GeneralIntelligenceSynapseCount）
@@ -545,10 +709,9 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
     CivilizationData.SetTeamworkCoefficient(TeamworkCoefficient);
 
     // 可用含能核素（UseableEnergeticNuclide）
-    boost::multiprecision::uint128_t UseableEnergeticNuclide;
+    Math::FUint128 UseableEnergeticNuclide;
     if (CivilizationLevel >= Intelli::FStandard::_kAtomicAge && CivilizationLevel <= Intelli::FStandard::_kEarlyAsiAge)
     {
-        double StarAge = Star->GetAge();
         double Base    = Random1 * LevelProgress * 1e9 * 0.63 * std::pow(0.5, StarAge / (8e8));
 
         if (CivilizationLevel >= Intelli::FStandard::_kDigitalAge)
@@ -560,7 +723,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
         float Random = 0.9f + 0.2f * _CommonGenerator(_RandomEngine);
         Base *= Random;
 
-        UseableEnergeticNuclide = static_cast<boost::multiprecision::uint128_t>(Base);
+        UseableEnergeticNuclide = static_cast<Math::FUint128>(Base);
         CivilizationData.SetUseableEnergeticNuclide(UseableEnergeticNuclide);
     }
 
@@ -568,7 +731,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
     double LaunchCapability = 0.0;
     if (CivilizationLevel >= Intelli::FStandard::_kAtomicAge && CivilizationLevel <= Intelli::FStandard::_kEarlyAsiAge)
     {
-        double PlanetMass   = Planet->GetMassDigital<double>();
+        double PlanetMass   = CalculateMassWithCrust(CrustMineralIncrement, Planet);
         double PlanetRadius = Planet->GetRadius();
         double Base         = 5e-6;
 
@@ -582,12 +745,7 @@ void FCivilizationGenerator::GenerateCivilizationDetails(const Astro::AStar* Sta
     {
         OrbitAssetsMass = std::sqrt(GenerateRandom1()) * LaunchCapability * (CivilizationLevel - 6) / TeamworkCoefficient;
     }
-    CivilizationData.SetOrbitAssetsMass(boost::multiprecision::uint128_t(OrbitAssetsMass));
-
-#ifdef DEBUG_OUTPUT
-    std::println("");
-    std::println("");
-#endif // DEBUG_OUTPUT
+    CivilizationData.SetOrbitAssetsMass(Math::FUint128(OrbitAssetsMass));
 }
 
 const std::array<float, 7> FCivilizationGenerator::_kProbabilityListForCenoziocEra
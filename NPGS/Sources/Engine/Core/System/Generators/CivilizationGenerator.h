@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <array>
 #include <memory>
 #include <random>
+#include <vector>
 
 #include "Engine/Core/Base/Base.h"
 #include "Engine/Core/Types/Entries/Astro/Planet.h"
 #include "Engine/Core/Types/Entries/Astro/Star.h"
+#include "Engine/Core/Types/Properties/Intelli/Civilization.h"
 #include "Engine/Utils/Random.hpp"
 
 _NPGS_BEGIN
@@ -24,6 +28,34 @@ public:
         float                DestroyedByDisasterProbability{ 0.001f };
     };
 
+    // 批量生成的输入，按结构数组收集自任意多个恒星系统
+    struct FBatchInput
+    {
+        std::vector<double>          StarAges;        // 单位 yr
+        std::vector<float>           PoyntingVectors; // 单位 W/m^2
+        std::vector<Astro::APlanet*> Planets;         // 只读取，不修改，直到调用 FCivilizationTable::ApplyTo
+
+        void Push(double StarAge, float PoyntingVector, Astro::APlanet* Planet);
+        void Reserve(std::size_t Count);
+        void Clear();
+        std::size_t Size() const;
+    };
+
+    // 批量生成的结果，只记录产生了生命的输入，按输入下标升序排列
+    struct FCivilizationTable
+    {
+        std::vector<std::uint32_t>      InputIndices;
+        std::vector<Intelli::FStandard> Civilizations;
+        std::vector<float>              CrustMineralIncrements; // 生命成矿增加的地壳矿物质量，单位 kg
+
+        const Intelli::FStandard* Find(std::size_t InputIndex) const;
+        void Clear();
+        std::size_t Size() const;
+
+        // 写回行星：设置文明数据并累加地壳矿物质量，同一张表只应写回一次
+        void ApplyTo(const FBatchInput& Input) const;
+    };
+
 public:
     FCivilizationGenerator() = delete;
     FCivilizationGenerator(const FGenerationInfo& GenerationInfo);
@@ -36,16 +68,23 @@ public:
 
     void GenerateCivilization(const Astro::AStar* Star, float PoyntingVector, Astro::APlanet* Planet);
 
+    // 批量生成，结果只写入 Table，不修改输入的行星，因此可以换一组参数对同一批输入重新生成
+    // 每个命中的输入使用由 (Seed, 输入下标) 决定的独立随机数引擎，结果与 ThreadCount 无关
+    void GenerateCivilizations(const FBatchInput& Input, std::uint32_t Seed, FCivilizationTable& Table, int ThreadCount = 1) const;
+
 private:
-    void GenerateLife(double StarAge, float PoyntingVector, Astro::APlanet* Planet);
-    void GenerateCivilizationDetails(const Astro::AStar* Star, float PoyntingVector, Astro::APlanet* Planet);
+    // 返回生命成矿增加的地壳矿物质量，由调用者决定何时写回行星
+    float GenerateLife(double StarAge, float PoyntingVector, const Astro::APlanet* Planet, Intelli::FStandard& CivilizationData);
+    // CrustMineralIncrement 为 GenerateLife 返回的、尚未写回行星的地壳矿物增量
+    void GenerateCivilizationDetails(double StarAge, float PoyntingVector, const Astro::APlanet* Planet,
+                                     Intelli::FStandard& CivilizationData, float CrustMineralIncrement);
 
 private:
     std::mt19937                     _RandomEngine;
     Util::TUniformRealDistribution<> _CommonGenerator;
     Util::TBernoulliDistribution<>   _AsiFiltedProbability;
     Util::TBernoulliDistribution<>   _DestroyedByDisasterProbability;
-    Util::TBernoulliDistribution<>   _LifeOccurrenceProbability;
+    Util::TGeometricSkipSampler<>    _LifeOccurrenceSampler;
 
     static const std::array<float, 7> _kProbabilityListForCenoziocEra;
     static const std::array<float, 7> _kProbabilityListForSatTeeTouyButAsi;
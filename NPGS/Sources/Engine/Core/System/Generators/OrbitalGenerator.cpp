@@ -5,21 +5,21 @@
 #include <cstdint>
 #include <algorithm>
 #include <limits>
-#include <print>
+#include <memory_resource>
 #include <ranges>
 #include <utility>
 
-#include <boost/multiprecision/cpp_int.hpp>
 #include <glm/glm.hpp>
 
 #include "Engine/Core/Base/Assert.h"
 #include "Engine/Core/Base/Base.h"
 #include "Engine/Core/Math/NumericConstants.h"
+#include "Engine/Core/Math/Uint128.h"
 #include "Engine/Core/Types/Properties/StellarClass.h"
+#include "Engine/Utils/Diagnostics.h"
+#include "Engine/Utils/Profiler.h"
 #include "Engine/Utils/Utils.h"
 
-#define DEBUG_OUTPUT
-
 _NPGS_BEGIN
 _SYSTEM_BEGIN
 _GENERATOR_BEGIN
@@ -71,6 +71,37 @@ namespace
 
         return std::make_unique<Astro::AAsteroidCluster>(AsteroidCluster);
     }
+
+    // 线程局部暂存区，生成行星系统期间的临时数组都从这里分配，每个恒星系统开始生成时整体重置
+    std::pmr::monotonic_buffer_resource& GetScratchResource()
+    {
+        thread_local std::array<std::byte, 64 * 1024> kScratchBuffer;
+        thread_local std::pmr::monotonic_buffer_resource kScratchResource(kScratchBuffer.data(), kScratchBuffer.size());
+        return kScratchResource;
+    }
+
+    // 按标记一次性压实数组的前 RejectedFlags.size() 个元素，其后追加的元素（卫星、行星环等）保持不变
+    // 返回保留下来的元素数量
+    template <typename ElementType>
+    std::size_t CompactRejected(std::pmr::vector<ElementType>& Elements, const std::pmr::vector<bool>& RejectedFlags)
+    {
+        std::size_t KeptCount = 0;
+        for (std::size_t i = 0; i != RejectedFlags.size(); ++i)
+        {
+            if (!RejectedFlags[i])
+            {
+                if (KeptCount != i)
+                {
+                    Elements[KeptCount] = std::move(Elements[i]);
+                }
+
+                ++KeptCount;
+            }
+        }
+
+        Elements.erase(Elements.begin() + KeptCount, Elements.begin() + RejectedFlags.size());
+        return KeptCount;
+    }
 }
 
 // OrbitalGenerator implementations
@@ -87,6 +118,7 @@ FOrbitalGenerator::FOrbitalGenerator(const FGenerationInfo& GenerationInfo)
     _WalkInProbability(0.8),
 
     _CivilizationGenerator(nullptr),
+    _CivilizationCandidates(GenerationInfo.CivilizationCandidates),
 
     _AsteroidUpperLimit(GenerationInfo.AsteroidUpperLimit),
     _CoilTemperatureLimit(GenerationInfo.CoilTemperatureLimit),
@@ -119,6 +151,7 @@ FOrbitalGenerator::FOrbitalGenerator(const FOrbitalGenerator& Other)
     _MigrationProbability(Other._MigrationProbability),
     _ScatteringProbability(Other._ScatteringProbability),
     _WalkInProbability(Other._WalkInProbability),
+    _CivilizationCandidates(nullptr),
     _AsteroidUpperLimit(Other._AsteroidUpperLimit),
     _CoilTemperatureLimit(Other._CoilTemperatureLimit),
     _RingsParentLowerLimit(Other._RingsParentLowerLimit),
@@ -142,6 +175,7 @@ FOrbitalGenerator::FOrbitalGenerator(FOrbitalGenerator&& Other) noexcept
     _ScatteringProbability(std::move(Other._ScatteringProbability)),
     _WalkInProbability(std::move(Other._WalkInProbability)),
     _CivilizationGenerator(std::move(Other._CivilizationGenerator)),
+    _CivilizationCandidates(std::exchange(Other._CivilizationCandidates, nullptr)),
     _AsteroidUpperLimit(std::exchange(Other._AsteroidUpperLimit, 0.0f)),
     _CoilTemperatureLimit(std::exchange(Other._CoilTemperatureLimit, 0.0f)),
     _RingsParentLowerLimit(std::exchange(Other._RingsParentLowerLimit, 0.0f)),
@@ -163,6 +197,7 @@ FOrbitalGenerator& FOrbitalGenerator::operator=(const FOrbitalGenerator& Other)
         _MigrationProbability             = Other._MigrationProbability;
         _ScatteringProbability            = Other._ScatteringProbability;
         _WalkInProbability                = Other._WalkInProbability;
+        _CivilizationCandidates           = nullptr;
         _AsteroidUpperLimit               = Other._AsteroidUpperLimit;
         _CoilTemperatureLimit             = Other._CoilTemperatureLimit;
         _RingsParentLowerLimit            = Other._RingsParentLowerLimit;
@@ -192,6 +227,7 @@ FOrbitalGenerator& FOrbitalGenerator::operator=(FOrbitalGenerator&& Other) noexc
         _ScatteringProbability            = std::move(Other._ScatteringProbability);
         _WalkInProbability                = std::move(Other._WalkInProbability);
         _CivilizationGenerator            = std::move(Other._CivilizationGenerator);
+        _CivilizationCandidates           = std::exchange(Other._CivilizationCandidates, nullptr);
         _AsteroidUpperLimit               = std::exchange(Other._AsteroidUpperLimit, 0.0f);
         _CoilTemperatureLimit             = std::exchange(Other._CoilTemperatureLimit, 0.0f);
         _RingsParentLowerLimit            = std::exchange(Other._RingsParentLowerLimit, 0.0f);
@@ -204,6 +240,11 @@ FOrbitalGenerator& FOrbitalGenerator::operator=(FOrbitalGenerator&& Other) noexc
 
 void FOrbitalGenerator::GenerateOrbitals(Astro::FStellarSystem& System)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateOrbitals);
+
+    Util::FDiagnostics::FScopedSystem DiagnosticScope(System.GetBaryDistanceRank());
+    GetScratchResource().release();
+
     if (System.StarsData().size() == 2)
     {
         GenerateBinaryOrbit(System);
@@ -274,11 +315,7 @@ void FOrbitalGenerator::GenerateOrbitals(Astro::FStellarSystem& System)
         NearStarOrbit->SetSemiMajorAxis(NearStarSemiMajorAxis);
         System.OrbitsData().push_back(std::move(NearStarOrbit));
 
-#ifdef DEBUG_OUTPUT
-        std::println("");
-        std::println("Near star orbit: {} AU", NearStarSemiMajorAxis / kAuToMeter);
-        std::println("");
-#endif // DEBUG_OUTPUT
+        NpgsDiagnostic("orbits", "Near star orbit: {} AU", NearStarSemiMajorAxis / kAuToMeter);
 
         if (Star->GetMass() > 12 * kSolarMass)
         {
@@ -308,6 +345,8 @@ void FOrbitalGenerator::GenerateOrbitals(Astro::FStellarSystem& System)
 
 void FOrbitalGenerator::GenerateBinaryOrbit(Astro::FStellarSystem& System)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateBinaryOrbit);
+
     auto* SystemBaryCenter = System.GetBaryCenter();
 
     std::array<Astro::FOrbit, 2> OrbitData;
@@ -457,26 +496,26 @@ void FOrbitalGenerator::GenerateBinaryOrbit(Astro::FStellarSystem& System)
         System.OrbitsData().push_back(std::move(NearStarOrbit));
     }
 
-#ifdef DEBUG_OUTPUT
-    std::println("Semi-major axis of binary stars: {} AU",          BinarySemiMajorAxis / kAuToMeter);
-    std::println("Semi-major axis of binary first star: {} AU",     OrbitData[0].GetSemiMajorAxis() / kAuToMeter);
-    std::println("Semi-major axis of binary second star: {} AU",    OrbitData[1].GetSemiMajorAxis() / kAuToMeter);
-    std::println("Period of binary: {} days",                       Period / kDayToSecond);
-    std::println("Eccentricity of binary: {}",                      Eccentricity);
-    std::println("Argument of periapsis of binary first star: {}",  ArgumentOfPeriapsis1);
-    std::println("Argument of periapsis of binary second star: {}", ArgumentOfPeriapsis2);
-    std::println("Initial true anomaly of binary first star: {}",   InitialTrueAnomaly1);
-    std::println("Initial true anomaly of binary second star: {}",  InitialTrueAnomaly2);
-    std::println("Normal of binary first star: ({}, {})",           StarNormals[0].x, StarNormals[1].y);
-    std::println("Normal of binary second star: ({}, {})",          StarNormals[0].x, StarNormals[1].y);
-    std::println("Near star semi-major axis of first star: {} AU",  NearStarOrbits[0].GetSemiMajorAxis() / kAuToMeter);
-    std::println("Near star semi-major axis of second star: {} AU", NearStarOrbits[1].GetSemiMajorAxis() / kAuToMeter);
-    std::println("");
-#endif // DEBUG_OUTPUT
+    NpgsDiagnostic("binary", "Semi-major axis of binary stars: {} AU",          BinarySemiMajorAxis / kAuToMeter);
+    NpgsDiagnostic("binary", "Semi-major axis of binary first star: {} AU",     OrbitData[0].GetSemiMajorAxis() / kAuToMeter);
+    NpgsDiagnostic("binary", "Semi-major axis of binary second star: {} AU",    OrbitData[1].GetSemiMajorAxis() / kAuToMeter);
+    NpgsDiagnostic("binary", "Period of binary: {} days",                       Period / kDayToSecond);
+    NpgsDiagnostic("binary", "Eccentricity of binary: {}",                      Eccentricity);
+    NpgsDiagnostic("binary", "Argument of periapsis of binary first star: {}",  ArgumentOfPeriapsis1);
+    NpgsDiagnostic("binary", "Argument of periapsis of binary second star: {}", ArgumentOfPeriapsis2);
+    NpgsDiagnostic("binary", "Initial true anomaly of binary first star: {}",   InitialTrueAnomaly1);
+    NpgsDiagnostic("binary", "Initial true anomaly of binary second star: {}",  InitialTrueAnomaly2);
+    NpgsDiagnostic("binary", "Normal of binary first star: ({}, {})",           StarNormals[0].x, StarNormals[1].y);
+    NpgsDiagnostic("binary", "Normal of binary second star: ({}, {})",          StarNormals[0].x, StarNormals[1].y);
+    NpgsDiagnostic("binary", "Near star semi-major axis of first star: {} AU",  NearStarOrbits[0].GetSemiMajorAxis() / kAuToMeter);
+    NpgsDiagnostic("binary", "Near star semi-major axis of second star: {} AU", NearStarOrbits[1].GetSemiMajorAxis() / kAuToMeter);
 }
 
 void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FOrbitalDetails& ParentStar, Astro::FStellarSystem& System)
 {
+    NpgsProfileStage(EGenerationStage::kGeneratePlanets);
+    NpgsProfileSequence();
+
     // 变量名未标注单位均为国际单位制
     Astro::AStar* Star = System.StarsData()[StarIndex].get();
     if (Star->GetFeH() < -2.0f)
@@ -491,6 +530,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
     }
 
     // 生成原行星盘数据
+    NpgsProfileSequenceSwitch(EGenerationStage::kPlanetaryDisk);
     FPlanetaryDisk PlanetaryDisk;
     float DiskBase           = 1.0f + _CommonGenerator(_RandomEngine); // 基准随机数，1-2 之间
     float StarInitialMassSol = Star->GetInitialMass() / kSolarMass;
@@ -557,15 +597,13 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
         return;
     }
 
-#ifdef DEBUG_OUTPUT
-    std::println("Planetary disk inner radius: {} AU", PlanetaryDisk.InnerRadiusAu);
-    std::println("Planetary disk outer radius: {} AU", PlanetaryDisk.OuterRadiusAu);
-    std::println("Planetary disk mass: {} solar",      PlanetaryDisk.DiskMassSol);
-    std::println("Planetary disk dust mass: {} solar", PlanetaryDisk.DustMassSol);
-    std::println("");
-#endif // DEUB_OUTPUT
+    NpgsDiagnostic("disk", "Planetary disk inner radius: {} AU", PlanetaryDisk.InnerRadiusAu);
+    NpgsDiagnostic("disk", "Planetary disk outer radius: {} AU", PlanetaryDisk.OuterRadiusAu);
+    NpgsDiagnostic("disk", "Planetary disk mass: {} solar",      PlanetaryDisk.DiskMassSol);
+    NpgsDiagnostic("disk", "Planetary disk dust mass: {} solar", PlanetaryDisk.DustMassSol);
 
     // 生成行星们
+    NpgsProfileSequenceSwitch(EGenerationStage::kCoreMasses);
     std::size_t PlanetCount = 0;
     if (StellarType != Astro::FStellarClass::EStellarType::kNeutronStar &&
         StellarType != Astro::FStellarClass::EStellarType::kBlackHole)
@@ -592,8 +630,10 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
         PlanetCount = static_cast<std::size_t>(2.0f + _CommonGenerator(_RandomEngine) * 2.0f);
     }
 
-    std::vector<std::unique_ptr<Astro::APlanet>> Planets;
-    std::vector<std::unique_ptr<Astro::AAsteroidCluster>> AsteroidClusters;
+    std::pmr::memory_resource* Scratch = &GetScratchResource();
+
+    TScratchArray<std::unique_ptr<Astro::APlanet>> Planets(Scratch);
+    TScratchArray<std::unique_ptr<Astro::AAsteroidCluster>> AsteroidClusters(Scratch);
 
     Planets.reserve(PlanetCount);
     for (std::size_t i = 0; i < PlanetCount; ++i)
@@ -602,7 +642,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
     }
 
     // 生成行星初始核心质量
-    std::vector<float> CoreBase(PlanetCount, 0.0f);
+    TScratchArray<float> CoreBase(PlanetCount, 0.0f, Scratch);
     for (float& Num : CoreBase)
     {
         Num = _CommonGenerator(_RandomEngine) * 3.0f;
@@ -615,23 +655,19 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
     }
 
     Astro::FComplexMass CoreMass;
-    std::vector<float> CoreMassesSol(PlanetCount); // 初始核心质量，单位太阳
+    TScratchArray<float> CoreMassesSol(PlanetCount, Scratch); // 初始核心质量，单位太阳
     for (std::size_t i = 0; i < PlanetCount; ++i)
     {
         CoreMassesSol[i] = PlanetaryDisk.DustMassSol * std::pow(10.0f, CoreBase[i]) / CoreBaseSum;
 
-#ifdef DEBUG_OUTPUT
-        std::println("Generate initial core mass: planet {} initial core mass: {} earth",
-                     i + 1, CoreMassesSol[i] * kSolarMassToEarth);
-#endif // DEBUG_OUTPUT
+        NpgsDiagnostic("planets", "Generate initial core mass: planet {} initial core mass: {} earth",
+                                  i + 1, CoreMassesSol[i] * kSolarMassToEarth);
     }
 
-#ifdef DEBUG_OUTPUT
-    std::println("");
-#endif // DEBUG_OUTPUT
-
     // 初始化轨道
-    std::vector<std::unique_ptr<Astro::FOrbit>> Orbits;
+    NpgsProfileSequenceSwitch(EGenerationStage::kSemiMajorAxes);
+    TScratchArray<std::unique_ptr<Astro::FOrbit>> Orbits(Scratch);
+    Orbits.reserve(PlanetCount);
     for (std::size_t i = 0; i != PlanetCount; ++i)
     {
         Orbits.push_back(std::make_unique<Astro::FOrbit>());
@@ -643,7 +679,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
     }
 
     // 生成初始轨道半长轴
-    std::vector<float> DiskBoundariesAu(PlanetCount + 1);
+    TScratchArray<float> DiskBoundariesAu(PlanetCount + 1, Scratch);
     DiskBoundariesAu[0] = PlanetaryDisk.InnerRadiusAu;
 
     float CoreMassSum = 0.0f;
@@ -652,7 +688,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
         CoreMassSum += std::pow(Num, 0.1f);
     }
 
-    std::vector<float> PartCoreMassSums(PlanetCount + 1, 0.0f);
+    TScratchArray<float> PartCoreMassSums(PlanetCount + 1, 0.0f, Scratch);
     for (std::size_t i = 1; i <= PlanetCount; ++i)
     {
         PartCoreMassSums[i] = PartCoreMassSums[i - 1] + std::pow(CoreMassesSol[i - 1], 0.1f);
@@ -667,17 +703,12 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
         float SemiMajorAxis = kAuToMeter * (DiskBoundariesAu[i] + DiskBoundariesAu[i + 1]) / 2.0f;
         Orbits[i]->SetSemiMajorAxis(SemiMajorAxis);
         GenerateOrbitElements(*Orbits[i].get()); // 生成剩余的根数
-#ifdef DEBUG_OUTPUT
-        std::println("Generate initial semi-major axis: planet {} initial semi-major axis: {} AU",
-                     i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter);
-#endif // DEBUG_OUTPUT
+        NpgsDiagnostic("planets", "Generate initial semi-major axis: planet {} initial semi-major axis: {} AU",
+                                  i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter);
     }
 
-#ifdef DEBUG_OUTPUT
-    std::println("");
-#endif // DEBUG_OUTPUT
-
     // 计算原行星盘年龄
+    NpgsProfileSequenceSwitch(EGenerationStage::kDiskAge);
     float DiskAge = 8.15e6f + 8.3e5f * StarInitialMassSol - 33854 *
                     std::pow(StarInitialMassSol, 2.0f) - 5.031e6f * std::log(StarInitialMassSol);
 
@@ -707,6 +738,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
     }
 
     // 抹掉位于（双星）稳定区域以外的行星
+    NpgsProfileSequenceSwitch(EGenerationStage::kBinaryStability);
     if (System.StarsData().size() > 1)
     {
         const Astro::AStar* Current  = System.StarsData()[StarIndex].get();
@@ -730,24 +762,34 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
         }
     }
 
-    std::vector<float> NewCoreMassesSol(PlanetCount); // 吸积核心质量，单位太阳
-    float MigratedOriginSemiMajorAxisAu = 0.0f;       // 原有的半长轴，用于计算内迁行星
+    TScratchArray<float> NewCoreMassesSol(PlanetCount, Scratch); // 吸积核心质量，单位太阳
+    float MigratedOriginSemiMajorAxisAu = 0.0f;                   // 原有的半长轴，用于计算内迁行星
 
     // Short Lambda functions
     // ----------------------
     auto ErasePlanets = [&](float Limit) -> void // 抹掉位于临界线以内的行星
     {
-        for (std::size_t i = 0; i < PlanetCount; ++i)
+        // 每次至多抹掉靠内的一半（向上取整）行星，先数出数量再一次性删除
+        std::size_t EraseCount = 0;
+        while (EraseCount < (PlanetCount + 1) / 2 && Orbits[EraseCount]->GetSemiMajorAxis() < Limit)
         {
-            if (Orbits[0]->GetSemiMajorAxis() < Limit)
-            {
-                Planets.erase(Planets.begin());
-                Orbits.erase(Orbits.begin());
-                NewCoreMassesSol.erase(NewCoreMassesSol.begin());
-                CoreMassesSol.erase(CoreMassesSol.begin());
-                --PlanetCount;
-            }
+            ++EraseCount;
         }
+
+        Planets.erase(Planets.begin(), Planets.begin() + EraseCount);
+        Orbits.erase(Orbits.begin(), Orbits.begin() + EraseCount);
+        NewCoreMassesSol.erase(NewCoreMassesSol.begin(), NewCoreMassesSol.begin() + EraseCount);
+        CoreMassesSol.erase(CoreMassesSol.begin(), CoreMassesSol.begin() + EraseCount);
+        PlanetCount -= EraseCount;
+    };
+
+    // 被烧毁的行星先做标记，循环结束后统一压实，避免在循环中逐个删除
+    auto EraseBurnedPlanets = [&](const TScratchArray<bool>& BurnedFlags) -> void
+    {
+        CompactRejected(Planets, BurnedFlags);
+        CompactRejected(Orbits, BurnedFlags);
+        CompactRejected(NewCoreMassesSol, BurnedFlags);
+        PlanetCount = CompactRejected(CoreMassesSol, BurnedFlags);
     };
 
     StellarType = Star->GetStellarClass().GetStellarType();
@@ -755,6 +797,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
         StellarType != Astro::FStellarClass::EStellarType::kBlackHole)
     {
         // 宜居带半径，单位 AU
+        NpgsProfileSequenceSwitch(EGenerationStage::kZones);
         std::pair<float, float> HabitableZoneAu;
 
         if (System.StarsData().size() > 1)
@@ -777,10 +820,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
             HabitableZoneAu.second = std::sqrt(StarLuminosity / (4 * Math::kPi * 600))  / kAuToMeter;
         }
 
-#ifdef DEBUG_OUTPUT
-        std::println("Circumstellar habitable zone: {} - {} AU", HabitableZoneAu.first, HabitableZoneAu.second);
-        std::println("");
-#endif // DEBUG_OUTPUT
+        NpgsDiagnostic("zones", "Circumstellar habitable zone: {} - {} AU", HabitableZoneAu.first, HabitableZoneAu.second);
 
         // 冻结线半径，单位 AU
         float FrostLineAu        = 0.0f;
@@ -807,25 +847,23 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
 
         FrostLineAu = std::sqrt(FrostLineAuSquared) / kAuToMeter;
 
-#ifdef DEBUG_OUTPUT
-        std::println("Frost line: {} AU", FrostLineAu);
-        std::println("");
-#endif // DEBUG_OUTPUT
+        NpgsDiagnostic("zones", "Frost line: {} AU", FrostLineAu);
 
         // 判断大行星
+        NpgsProfileSequenceStop();
         PlanetCount = JudgeLargePlanets(StarIndex, System.StarsData(), BinarySemiMajorAxis, HabitableZoneAu.first,
                                         FrostLineAu, CoreMassesSol, NewCoreMassesSol, Orbits, Planets);
+        NpgsProfileSequenceSwitch(EGenerationStage::kMigration);
 
-#ifdef DEBUG_OUTPUT
-        for (std::size_t i = 0; i < PlanetCount; ++i)
+        if (Util::FDiagnostics::IsTracing())
         {
-            std::println("Before migration: planet {} semi-major axis: {} AU, initial core mass: {} earth, new core mass: {} earth, core radius: {} earth, type: {}",
-                         i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter, CoreMassesSol[i] * kSolarMassToEarth, NewCoreMassesSol[i] * kSolarMassToEarth, Planets[i]->GetRadius() / kEarthRadius, std::to_underlying(Planets[i]->GetPlanetType()));
+            for (std::size_t i = 0; i < PlanetCount; ++i)
+            {
+                Util::FDiagnostics::Record("planets", "Before migration: planet {} semi-major axis: {} AU, initial core mass: {} earth, new core mass: {} earth, core radius: {} earth, type: {}",
+                                                      i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter, CoreMassesSol[i] * kSolarMassToEarth, NewCoreMassesSol[i] * kSolarMassToEarth, Planets[i]->GetRadius() / kEarthRadius, std::to_underlying(Planets[i]->GetPlanetType()));
+            }
         }
 
-        std::println("");
-#endif // DEBUG_OUTPUT
-
         // 巨行星内迁
         for (std::size_t i = 1; i < PlanetCount; ++i)
         {
@@ -902,10 +940,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
                 StarRadiusMaxSol = 400 * std::pow(StarInitialMassSol - 0.75f, 1.0f / 3.0f);
             }
 
-#ifdef DEBUG_OUTPUT
-            std::println("Max star radius: {} solar", StarRadiusMaxSol);
-            std::println("");
-#endif // DEBUG_OUTPUT
+            NpgsDiagnostic("planets", "Max star radius: {} solar", StarRadiusMaxSol);
 
             ErasePlanets(StarRadiusMaxSol * kSolarRadius);
         }
@@ -942,21 +977,22 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
             }
         }
 
-#ifdef DEBUG_OUTPUT
-        for (std::size_t i = 0; i < PlanetCount; ++i)
+        if (Util::FDiagnostics::IsTracing())
         {
-            std::println("Final orbits: planet {} semi-major axis: {} AU, initial core mass: {} earth, new core mass: {} earth, core radius: {} earth, type: {}",
-                         i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter, CoreMassesSol[i] * kSolarMassToEarth, NewCoreMassesSol[i] * kSolarMassToEarth, Planets[i]->GetRadius() / kEarthRadius, std::to_underlying(Planets[i]->GetPlanetType()));
+            for (std::size_t i = 0; i < PlanetCount; ++i)
+            {
+                Util::FDiagnostics::Record("planets", "Final orbits: planet {} semi-major axis: {} AU, initial core mass: {} earth, new core mass: {} earth, core radius: {} earth, type: {}",
+                                                      i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter, CoreMassesSol[i] * kSolarMassToEarth, NewCoreMassesSol[i] * kSolarMassToEarth, Planets[i]->GetRadius() / kEarthRadius, std::to_underlying(Planets[i]->GetPlanetType()));
+            }
         }
 
-        std::println("");
-#endif // DEBUG_OUTPUT
-
+        NpgsProfileSequenceSwitch(EGenerationStage::kPlanetDetails);
         for (std::size_t i = 0; i < PlanetCount; ++i)
         {
             Planets[i]->SetAge(DiskAge);
         }
 
+        TScratchArray<bool> BurnedFlags(PlanetCount, false, Scratch);
         for (std::size_t i = 0; i < PlanetCount; ++i)
         {
             float PlanetMassEarth = 0.0f;
@@ -1000,9 +1036,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
                     static_cast<float>(Star->GetLuminosity()) / (4 * Math::kPi * std::pow(Orbits[i]->GetSemiMajorAxis(), 2.0f));
             }
 
-#ifdef DEBUG_OUTPUT
-            std::println("Planet {} poynting vector: {} W/m^2", i + 1, PoyntingVector);
-#endif // DEBUG_OUTPUT
+            NpgsDiagnostic("planets", "Planet {} poynting vector: {} W/m^2", i + 1, PoyntingVector);
             // 判断热木星
             if (PoyntingVector >= 10000)
             {
@@ -1054,12 +1088,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
                 ((PlanetType == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
                   PlanetType == Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster) && PoyntingVector > 1e6f))
             {
-                Planets.erase(Planets.begin() + i);
-                CoreMassesSol.erase(CoreMassesSol.begin() + i);
-                NewCoreMassesSol.erase(NewCoreMassesSol.begin() + i);
-                Orbits.erase(Orbits.begin() + i);
-                --PlanetCount;
-                --i;
+                BurnedFlags[i] = true;
                 continue;
             }
 
@@ -1087,7 +1116,10 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
             GenerateTrojan(Star, FrostLineAu, Orbits[i].get(), Planet, AsteroidClusters);
         }
 
+        EraseBurnedPlanets(BurnedFlags);
+
         // 生成柯伊伯带
+        NpgsProfileSequenceSwitch(EGenerationStage::kKuiperBelt);
         if (System.StarsData().size() == 1)
         {
             AsteroidClusters.push_back(std::make_unique<Astro::AAsteroidCluster>());
@@ -1122,37 +1154,37 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
 
             GenerateOrbitElements(*KuiperBeltOrbit);
 
-#ifdef DEBUG_OUTPUT
-            std::println("");
-            std::println("Kuiper belt details:");
-            std::println("semi-major axis: {} AU, mass: {} moon, type: {}",
-                         KuiperBeltOrbit->GetSemiMajorAxis() / kAuToMeter, KuiperBeltMass / kMoonMass, std::to_underlying(AsteroidClusters.back()->GetAsteroidType()));
-            std::println("mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
-                         KuiperBeltMassZ, KuiperBeltMassVolatiles, KuiperBeltMassEnergeticNuclide);
-            std::println("");
-#endif // DEBUG_OUTPUT
+            NpgsDiagnostic("asteroids", "Kuiper belt details:");
+            NpgsDiagnostic("asteroids", "semi-major axis: {} AU, mass: {} moon, type: {}",
+                                        KuiperBeltOrbit->GetSemiMajorAxis() / kAuToMeter, KuiperBeltMass / kMoonMass, std::to_underlying(AsteroidClusters.back()->GetAsteroidType()));
+            NpgsDiagnostic("asteroids", "mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
+                                        KuiperBeltMassZ, KuiperBeltMassVolatiles, KuiperBeltMassEnergeticNuclide);
 
             Orbits.push_back(std::move(KuiperBeltOrbit));
         }
     }
     else
     {
+        NpgsProfileSequenceStop();
         PlanetCount = JudgeLargePlanets(StarIndex, System.StarsData(), BinarySemiMajorAxis,
                                         std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
                                         CoreMassesSol, NewCoreMassesSol, Orbits, Planets);
+        NpgsProfileSequenceSwitch(EGenerationStage::kPlanetDetails);
 
         for (std::size_t i = 0; i < PlanetCount; ++i)
         {
             Planets[i]->SetAge(Star->GetAge());
         }
 
+        TScratchArray<bool> BurnedFlags(PlanetCount, false, Scratch);
         for (std::size_t i = 0; i < PlanetCount; ++i)
         {
-#ifdef DEBUG_OUTPUT
-            float PlanetMassEarth = Planets[i]->GetMassDigital<float>() / kEarthMass;
-            std::println("Final system: planet {} semi-major axis: {} AU, mass: {} earth, radius: {} earth, type: {}",
-                         i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter, PlanetMassEarth, Planets[i]->GetRadius() / kEarthRadius, std::to_underlying(Planets[i]->GetPlanetType()));
-#endif // DEBUG_OUTPUT
+            if (Util::FDiagnostics::IsTracing())
+            {
+                float PlanetMassEarth = Planets[i]->GetMassDigital<float>() / kEarthMass;
+                Util::FDiagnostics::Record("planets", "Final system: planet {} semi-major axis: {} AU, mass: {} earth, radius: {} earth, type: {}",
+                                                      i + 1, Orbits[i]->GetSemiMajorAxis() / kAuToMeter, PlanetMassEarth, Planets[i]->GetRadius() / kEarthRadius, std::to_underlying(Planets[i]->GetPlanetType()));
+            }
             CalculatePlanetRadius(CoreMassesSol[i] * kSolarMassToEarth, Planets[i].get());
 
             Astro::FOrbit::FOrbitalDetails Parent(Star, Astro::FOrbit::EObjectType::kStar, Orbits[i].get());
@@ -1169,12 +1201,7 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
                 ((PlanetType == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
                   PlanetType == Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster) && PoyntingVector > 1e6f))
             {
-                Planets.erase(Planets.begin() + i);
-                CoreMassesSol.erase(CoreMassesSol.begin() + i);
-                NewCoreMassesSol.erase(NewCoreMassesSol.begin() + i);
-                Orbits.erase(Orbits.begin() + i);
-                --PlanetCount;
-                --i;
+                BurnedFlags[i] = true;
                 continue;
             }
 
@@ -1193,9 +1220,12 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
             // 生成特洛伊带
             GenerateTrojan(Star, std::numeric_limits<float>::infinity(), Orbits[i].get(), Planet, AsteroidClusters);
         }
+
+        EraseBurnedPlanets(BurnedFlags);
     }
 
     // 将被开除的行星移动到小行星带数组
+    NpgsProfileSequenceSwitch(EGenerationStage::kFinalizePlanets);
     for (auto& Orbit : Orbits)
     {
         auto& OrbitalDetail = Orbit->ObjectsData().front();
@@ -1222,72 +1252,69 @@ void FOrbitalGenerator::GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FO
 
     CalculateOrbitalPeriods(Orbits);
 
-#ifdef DEBUG_OUTPUT
-    std::println("");
-
-    for (std::size_t i = 0; i != PlanetCount; ++i)
+    if (Util::FDiagnostics::IsTracing())
     {
-        auto& Planet                         = Planets[i];
-        auto  PlanetType                     = Planet->GetPlanetType();
-        float PlanetMass                     = Planet->GetMassDigital<float>();
-        float PlanetMassEarth                = PlanetMass / kEarthMass;
-        float PlanetRadius                   = Planet->GetRadius();
-        float PlanetRadiusEarth              = PlanetRadius / kEarthRadius;
-        float AtmosphereMassZ                = Planet->GetAtmosphereMassZDigital<float>();
-        float AtmosphereMassVolatiles        = Planet->GetAtmosphereMassVolatilesDigital<float>();
-        float AtmosphereMassEnergeticNuclide = Planet->GetAtmosphereMassEnergeticNuclideDigital<float>();
-        float CoreMassZ                      = Planet->GetCoreMassZDigital<float>();
-        float CoreMassVolatiles              = Planet->GetCoreMassVolatilesDigital<float>();
-        float CoreMassEnergeticNuclide       = Planet->GetCoreMassEnergeticNuclideDigital<float>();
-        float OceanMassZ                     = Planet->GetOceanMassZDigital<float>();;
-        float OceanMassVolatiles             = Planet->GetOceanMassVolatilesDigital<float>();
-        float OceanMassEnergeticNuclide      = Planet->GetOceanMassEnergeticNuclideDigital<float>();
-        float CrustMineralMass               = Planet->GetCrustMineralMassDigital<float>();
-        float AtmospherePressure             = (kGravityConstant * PlanetMass * (AtmosphereMassZ + AtmosphereMassVolatiles + AtmosphereMassEnergeticNuclide)) / (4 * Math::kPi * std::pow(Planets[i]->GetRadius(), 4.0f));
-        float Oblateness                     = Planet->GetOblateness();
-        float Spin                           = Planet->GetSpin();
-        float BalanceTemperature             = Planet->GetBalanceTemperature();
-
-        if (PlanetType != Astro::APlanet::EPlanetType::kRockyAsteroidCluster &&
-            PlanetType != Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster)
-        {
-            std::println("Planet {} details:", i + 1);
-            std::println("semi-major axis: {} AU, period: {} days, mass: {} earth, radius: {} earth, type: {}",
-                         Orbits[i]->GetSemiMajorAxis() / kAuToMeter, Orbits[i]->GetPeriod() / kDayToSecond, PlanetMassEarth, PlanetRadiusEarth, std::to_underlying(PlanetType));
-            std::println("rotation period: {} h, oblateness: {}, balance temperature: {} K",
-                         Spin / 3600, Oblateness, BalanceTemperature);
-            std::println("atmo  mass z: {:.2E} kg, atmo  mass vol: {:.2E} kg, atmo  mass nuc: {:.2E} kg",
-                         AtmosphereMassZ, AtmosphereMassVolatiles, AtmosphereMassEnergeticNuclide);
-            std::println("core  mass z: {:.2E} kg, core  mass vol: {:.2E} kg, core  mass nuc: {:.2E} kg",
-                         CoreMassZ, CoreMassVolatiles, CoreMassEnergeticNuclide);
-            std::println("ocean mass z: {:.2E} kg, ocean mass vol: {:.2E} kg, ocean mass nuc: {:.2E} kg",
-                         OceanMassZ, OceanMassVolatiles, OceanMassEnergeticNuclide);
-            std::println("crust mineral mass : {:.2E} kg, atmo pressure : {:.2f} atm",
-                         CrustMineralMass, AtmospherePressure / kPascalToAtm);
-        }
-        else
+        for (std::size_t i = 0; i != PlanetCount; ++i)
         {
-            std::println("Asteroid belt (origin planet {}) details:", i + 1);
-            std::println("semi-major axis: {} AU, period: {} days, mass: {} moon, type: {}",
-                         Orbits[i]->GetSemiMajorAxis() / kAuToMeter, Orbits[i]->GetPeriod() / kDayToSecond, PlanetMass / kMoonMass, std::to_underlying(PlanetType));
-            std::println("mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
-                         CoreMassZ, CoreMassVolatiles, CoreMassEnergeticNuclide);
+            auto& Planet                         = Planets[i];
+            auto  PlanetType                     = Planet->GetPlanetType();
+            float PlanetMass                     = Planet->GetMassDigital<float>();
+            float PlanetMassEarth                = PlanetMass / kEarthMass;
+            float PlanetRadius                   = Planet->GetRadius();
+            float PlanetRadiusEarth              = PlanetRadius / kEarthRadius;
+            float AtmosphereMassZ                = Planet->GetAtmosphereMassZDigital<float>();
+            float AtmosphereMassVolatiles        = Planet->GetAtmosphereMassVolatilesDigital<float>();
+            float AtmosphereMassEnergeticNuclide = Planet->GetAtmosphereMassEnergeticNuclideDigital<float>();
+            float CoreMassZ                      = Planet->GetCoreMassZDigital<float>();
+            float CoreMassVolatiles              = Planet->GetCoreMassVolatilesDigital<float>();
+            float CoreMassEnergeticNuclide       = Planet->GetCoreMassEnergeticNuclideDigital<float>();
+            float OceanMassZ                     = Planet->GetOceanMassZDigital<float>();;
+            float OceanMassVolatiles             = Planet->GetOceanMassVolatilesDigital<float>();
+            float OceanMassEnergeticNuclide      = Planet->GetOceanMassEnergeticNuclideDigital<float>();
+            float CrustMineralMass               = Planet->GetCrustMineralMassDigital<float>();
+            float AtmospherePressure             = (kGravityConstant * PlanetMass * (AtmosphereMassZ + AtmosphereMassVolatiles + AtmosphereMassEnergeticNuclide)) / (4 * Math::kPi * std::pow(Planets[i]->GetRadius(), 4.0f));
+            float Oblateness                     = Planet->GetOblateness();
+            float Spin                           = Planet->GetSpin();
+            float BalanceTemperature             = Planet->GetBalanceTemperature();
+
+            if (PlanetType != Astro::APlanet::EPlanetType::kRockyAsteroidCluster &&
+                PlanetType != Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster)
+            {
+                Util::FDiagnostics::Record("planets", "Planet {} details:", i + 1);
+                Util::FDiagnostics::Record("planets", "semi-major axis: {} AU, period: {} days, mass: {} earth, radius: {} earth, type: {}",
+                                                      Orbits[i]->GetSemiMajorAxis() / kAuToMeter, Orbits[i]->GetPeriod() / kDayToSecond, PlanetMassEarth, PlanetRadiusEarth, std::to_underlying(PlanetType));
+                Util::FDiagnostics::Record("planets", "rotation period: {} h, oblateness: {}, balance temperature: {} K",
+                                                      Spin / 3600, Oblateness, BalanceTemperature);
+                Util::FDiagnostics::Record("planets", "atmo  mass z: {:.2E} kg, atmo  mass vol: {:.2E} kg, atmo  mass nuc: {:.2E} kg",
+                                                      AtmosphereMassZ, AtmosphereMassVolatiles, AtmosphereMassEnergeticNuclide);
+                Util::FDiagnostics::Record("planets", "core  mass z: {:.2E} kg, core  mass vol: {:.2E} kg, core  mass nuc: {:.2E} kg",
+                                                      CoreMassZ, CoreMassVolatiles, CoreMassEnergeticNuclide);
+                Util::FDiagnostics::Record("planets", "ocean mass z: {:.2E} kg, ocean mass vol: {:.2E} kg, ocean mass nuc: {:.2E} kg",
+                                                      OceanMassZ, OceanMassVolatiles, OceanMassEnergeticNuclide);
+                Util::FDiagnostics::Record("planets", "crust mineral mass : {:.2E} kg, atmo pressure : {:.2f} atm",
+                                                      CrustMineralMass, AtmospherePressure / kPascalToAtm);
+            }
+            else
+            {
+                Util::FDiagnostics::Record("planets", "Asteroid belt (origin planet {}) details:", i + 1);
+                Util::FDiagnostics::Record("planets", "semi-major axis: {} AU, period: {} days, mass: {} moon, type: {}",
+                                                      Orbits[i]->GetSemiMajorAxis() / kAuToMeter, Orbits[i]->GetPeriod() / kDayToSecond, PlanetMass / kMoonMass, std::to_underlying(PlanetType));
+                Util::FDiagnostics::Record("planets", "mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
+                                                      CoreMassZ, CoreMassVolatiles, CoreMassEnergeticNuclide);
+            }
         }
-
-        std::println("");
     }
-#endif // DEBUG_OUTPUT
 
-    for (std::size_t i = 0; i < PlanetCount; ++i) // 删除被移动到小行星数组的行星
+    // 删除被移动到小行星数组的行星，卫星位于数组末尾，不参与压实
+    auto PlanetsEnd = Planets.begin() + PlanetCount;
+    auto KeptEnd    = std::remove_if(Planets.begin(), PlanetsEnd, [](const std::unique_ptr<Astro::APlanet>& Planet) -> bool
     {
-        if (Planets[i]->GetPlanetType() == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
-            Planets[i]->GetPlanetType() == Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster)
-        {
-            Planets.erase(Planets.begin() + i);
-            --i;
-            --PlanetCount;
-        }
-    }
+        return Planet->GetPlanetType() == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
+               Planet->GetPlanetType() == Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster;
+    });
+
+    PlanetCount = static_cast<std::size_t>(KeptEnd - Planets.begin());
+    Planets.erase(KeptEnd, PlanetsEnd);
 
     for (auto& Orbit : Orbits)
     {
@@ -1337,14 +1364,18 @@ void FOrbitalGenerator::GenerateOrbitElements(Astro::FOrbit& Orbit)
 
 std::size_t FOrbitalGenerator::JudgeLargePlanets(std::size_t StarIndex, const std::vector<std::unique_ptr<Astro::AStar>>& StarData,
                                                  float BinarySemiMajorAxis, float InnerHabitableZoneRadiusAu, float FrostLineAu,
-                                                 std::vector<float>& CoreMassesSol, std::vector<float>& NewCoreMassesSol,
-                                                 std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits,
-                                                 std::vector<std::unique_ptr<Astro::APlanet>>& Planets)
+                                                 TScratchArray<float>& CoreMassesSol, TScratchArray<float>& NewCoreMassesSol,
+                                                 TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits,
+                                                 TScratchArray<std::unique_ptr<Astro::APlanet>>& Planets)
 {
+    NpgsProfileStage(EGenerationStage::kJudgeLargePlanets);
+
     const Astro::AStar* Star        = StarData[StarIndex].get();
     auto                StellarType = Star->GetStellarClass().GetStellarType();
     std::size_t         PlanetCount = CoreMassesSol.size();
 
+    // 质量过小的行星直接抹掉，先做标记，循环结束后统一压实
+    TScratchArray<bool> ExpelledFlags(PlanetCount, false, CoreMassesSol.get_allocator());
     for (std::size_t i = 0; i < PlanetCount; ++i)
     {
         if (Planets[i]->GetPlanetType() != Astro::APlanet::EPlanetType::kRockyAsteroidCluster &&
@@ -1391,12 +1422,7 @@ std::size_t FOrbitalGenerator::JudgeLargePlanets(std::size_t StarIndex, const st
         {
             if (NewCoreMassesSol[i] * kSolarMass < 1e19f)
             {
-                Orbits.erase(Orbits.begin() + i);
-                Planets.erase(Planets.begin() + i);
-                NewCoreMassesSol.erase(NewCoreMassesSol.begin() + i);
-                CoreMassesSol.erase(CoreMassesSol.begin() + i);
-                --i;
-                --PlanetCount;
+                ExpelledFlags[i] = true;
                 continue;
             }
 
@@ -1485,7 +1511,10 @@ std::size_t FOrbitalGenerator::JudgeLargePlanets(std::size_t StarIndex, const st
         }
     }
 
-    return PlanetCount;
+    CompactRejected(Orbits, ExpelledFlags);
+    CompactRejected(Planets, ExpelledFlags);
+    CompactRejected(NewCoreMassesSol, ExpelledFlags);
+    return CompactRejected(CoreMassesSol, ExpelledFlags);
 }
 
 float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass, float SemiMajorAxisAu,
@@ -1516,9 +1545,9 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = CoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         return (CoreMassVolatiles + CoreMassEnergeticNuclide + CoreMassZ) / kEarthMass;
@@ -1545,15 +1574,15 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = CoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetOceanMass({
-            boost::multiprecision::uint128_t(OceanMassZ),
-            boost::multiprecision::uint128_t(OceanMassVolatiles),
-            boost::multiprecision::uint128_t(OceanMassEnergeticNuclide)
+            Math::FUint128(OceanMassZ),
+            Math::FUint128(OceanMassVolatiles),
+            Math::FUint128(OceanMassEnergeticNuclide)
         });
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         return (OceanMassVolatiles + OceanMassEnergeticNuclide + OceanMassZ +
@@ -1582,15 +1611,15 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = CoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetOceanMass({
-            boost::multiprecision::uint128_t(OceanMassZ),
-            boost::multiprecision::uint128_t(OceanMassVolatiles),
-            boost::multiprecision::uint128_t(OceanMassEnergeticNuclide)
+            Math::FUint128(OceanMassZ),
+            Math::FUint128(OceanMassVolatiles),
+            Math::FUint128(OceanMassEnergeticNuclide)
         });
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         return (OceanMassVolatiles + OceanMassEnergeticNuclide + OceanMassZ +
@@ -1616,15 +1645,15 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = CoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetAtmosphereMass({
-            boost::multiprecision::uint128_t(AtmosphereMassZ),
-            boost::multiprecision::uint128_t(AtmosphereMassVolatiles),
-            boost::multiprecision::uint128_t(AtmosphereMassEnergeticNuclide)
+            Math::FUint128(AtmosphereMassZ),
+            Math::FUint128(AtmosphereMassVolatiles),
+            Math::FUint128(AtmosphereMassEnergeticNuclide)
         });
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         Planet->SetPlanetType(Astro::APlanet::EPlanetType::kIceGiant);
@@ -1653,15 +1682,15 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = CoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetAtmosphereMass({
-            boost::multiprecision::uint128_t(AtmosphereMassZ),
-            boost::multiprecision::uint128_t(AtmosphereMassVolatiles),
-            boost::multiprecision::uint128_t(AtmosphereMassEnergeticNuclide)
+            Math::FUint128(AtmosphereMassZ),
+            Math::FUint128(AtmosphereMassVolatiles),
+            Math::FUint128(AtmosphereMassEnergeticNuclide)
         });
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         Planet->SetPlanetType(Astro::APlanet::EPlanetType::kGasGiant);
@@ -1679,9 +1708,9 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = CoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         return (CoreMassVolatiles + CoreMassEnergeticNuclide + CoreMassZ) / kEarthMass;
@@ -1697,9 +1726,9 @@ float FOrbitalGenerator::CalculatePlanetMass(float CoreMass, float NewCoreMass,
         CoreMassZ                = NewCoreMass - CoreMassVolatiles - CoreMassEnergeticNuclide;
 
         Planet->SetCoreMass({
-            boost::multiprecision::uint128_t(CoreMassZ),
-            boost::multiprecision::uint128_t(CoreMassVolatiles),
-            boost::multiprecision::uint128_t(CoreMassEnergeticNuclide)
+            Math::FUint128(CoreMassZ),
+            Math::FUint128(CoreMassVolatiles),
+            Math::FUint128(CoreMassEnergeticNuclide)
         });
 
         return (CoreMassVolatiles + CoreMassEnergeticNuclide + CoreMassZ) / kEarthMass;
@@ -1978,9 +2007,11 @@ void FOrbitalGenerator::CalculateTemperature(const Astro::FOrbit::EObjectType Pa
 
 void FOrbitalGenerator::GenerateMoons(std::size_t PlanetIndex, float FrostLineAu, const Astro::AStar* Star, float PoyntingVector,
                                       const std::pair<float, float>& HabitableZoneAu, Astro::FOrbit::FOrbitalDetails& ParentPlanet,
-                                      std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits,
-                                      std::vector<std::unique_ptr<Astro::APlanet>>& Planets)
+                                      TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits,
+                                      TScratchArray<std::unique_ptr<Astro::APlanet>>& Planets)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateMoons);
+
     auto* Planet     = ParentPlanet.GetOrbitalObject().GetObject<Astro::APlanet>();
     auto  PlanetType = Planet->GetPlanetType();
     if (PlanetType == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
@@ -2017,7 +2048,7 @@ void FOrbitalGenerator::GenerateMoons(std::size_t PlanetIndex, float FrostLineAu
         }
     }
 
-    std::vector<std::unique_ptr<Astro::FOrbit>> MoonOrbits;
+    TScratchArray<std::unique_ptr<Astro::FOrbit>> MoonOrbits(Orbits.get_allocator());
 
     if (MoonCount == 0)
     {
@@ -2128,7 +2159,7 @@ void FOrbitalGenerator::GenerateMoons(std::size_t PlanetIndex, float FrostLineAu
     float LogCoreMassLowerLimit = std::log10(std::max(_AsteroidUpperLimit, ParentCoreMass / 600));
     float LogCoreMassUpperLimit = std::log10(ParentCoreMass / 30.0f);
 
-    std::vector<std::unique_ptr<Astro::APlanet>> Moons;
+    TScratchArray<std::unique_ptr<Astro::APlanet>> Moons(Planets.get_allocator());
     Moons.reserve(MoonCount);
 
     for (std::size_t i = 0; i != MoonCount; ++i)
@@ -2136,7 +2167,7 @@ void FOrbitalGenerator::GenerateMoons(std::size_t PlanetIndex, float FrostLineAu
         Moons.push_back(std::make_unique<Astro::APlanet>());
 
         float Exponent = LogCoreMassLowerLimit + _CommonGenerator(_RandomEngine) * (LogCoreMassUpperLimit - LogCoreMassLowerLimit);
-        boost::multiprecision::uint128_t InitialCoreMass(std::pow(10.0f, Exponent));
+        Math::FUint128 InitialCoreMass(std::pow(10.0f, Exponent));
 
         int VolatilesRate        = 9000 + static_cast<int>(_CommonGenerator(_RandomEngine)) + 2000;
         int EnergeticNuclideRate = 4500000 + static_cast<int>(_CommonGenerator(_RandomEngine)) * 1000000;
@@ -2186,50 +2217,48 @@ void FOrbitalGenerator::GenerateMoons(std::size_t PlanetIndex, float FrostLineAu
 
     CalculateOrbitalPeriods(MoonOrbits);
 
-#ifdef DEBUG_OUTPUT
-    std::println("");
-
-    for (std::size_t i = 0; i != MoonCount; ++i)
-    {
-        auto& Moon                           = Moons[i];
-        auto  MoonType                       = Moon->GetPlanetType();
-        float MoonMass                       = Moon->GetMassDigital<float>();
-        float MoonMassEarth                  = MoonMass / kEarthMass;
-        float MoonMassMoon                   = MoonMass / kMoonMass;
-        float MoonRadius                     = Moons[i]->GetRadius();
-        float MoonRadiusEarth                = MoonRadius / kEarthRadius;
-        float MoonRadiusMoon                 = MoonRadius / kMoonRadius;
-        float AtmosphereMassZ                = Moon->GetAtmosphereMassZDigital<float>();
-        float AtmosphereMassVolatiles        = Moon->GetAtmosphereMassVolatilesDigital<float>();
-        float AtmosphereMassEnergeticNuclide = Moon->GetAtmosphereMassEnergeticNuclideDigital<float>();
-        float CoreMassZ                      = Moon->GetCoreMassZDigital<float>();
-        float CoreMassVolatiles              = Moon->GetCoreMassVolatilesDigital<float>();
-        float CoreMassEnergeticNuclide       = Moon->GetCoreMassEnergeticNuclideDigital<float>();
-        float OceanMassZ                     = Moon->GetOceanMassZDigital<float>();;
-        float OceanMassVolatiles             = Moon->GetOceanMassVolatilesDigital<float>();
-        float OceanMassEnergeticNuclide      = Moon->GetOceanMassEnergeticNuclideDigital<float>();
-        float CrustMineralMass               = Moon->GetCrustMineralMassDigital<float>();
-        float AtmospherePressure             = (kGravityConstant * MoonMass * (AtmosphereMassZ + AtmosphereMassVolatiles + AtmosphereMassEnergeticNuclide)) / (4 * Math::kPi * std::pow(Moons[i]->GetRadius(), 4.0f));
-        float Oblateness                     = Moon->GetOblateness();
-        float Spin                           = Moon->GetSpin();
-        float BalanceTemperature             = Moon->GetBalanceTemperature();
-        std::println("Moon generated, details:");
-        std::println("parent planet: {}", PlanetIndex + 1);
-        std::println("semi-major axis: {} km, period: {} days, mass: {} earth ({} moon), radius: {} earth ({} moon), type: {}",
-                     MoonOrbits[i]->GetSemiMajorAxis() / 1000, MoonOrbits[i]->GetPeriod() / kDayToSecond, MoonMassEarth, MoonMassMoon, MoonRadiusEarth, MoonRadiusMoon, std::to_underlying(MoonType));
-        std::println("rotation period: {} h, oblateness: {}, balance temperature: {} K",
-                     Spin / 3600, Oblateness, BalanceTemperature);
-        std::println("atmo  mass z: {:.2E} kg, atmo  mass vol: {:.2E} kg, atmo  mass nuc: {:.2E} kg",
-                     AtmosphereMassZ, AtmosphereMassVolatiles, AtmosphereMassEnergeticNuclide);
-        std::println("core  mass z: {:.2E} kg, core  mass vol: {:.2E} kg, core  mass nuc: {:.2E} kg",
-                     CoreMassZ, CoreMassVolatiles, CoreMassEnergeticNuclide);
-        std::println("ocean mass z: {:.2E} kg, ocean mass vol: {:.2E} kg, ocean mass nuc: {:.2E} kg",
-                     OceanMassZ, OceanMassVolatiles, OceanMassEnergeticNuclide);
-        std::println("crust mineral mass : {:.2E} kg, atmo pressure : {:.2f} atm",
-                     CrustMineralMass, AtmospherePressure / kPascalToAtm);
-        std::println("");
-    }
-#endif // DEBUG_OUTPUT
+    if (Util::FDiagnostics::IsTracing())
+    {
+        for (std::size_t i = 0; i != MoonCount; ++i)
+        {
+            auto& Moon                           = Moons[i];
+            auto  MoonType                       = Moon->GetPlanetType();
+            float MoonMass                       = Moon->GetMassDigital<float>();
+            float MoonMassEarth                  = MoonMass / kEarthMass;
+            float MoonMassMoon                   = MoonMass / kMoonMass;
+            float MoonRadius                     = Moons[i]->GetRadius();
+            float MoonRadiusEarth                = MoonRadius / kEarthRadius;
+            float MoonRadiusMoon                 = MoonRadius / kMoonRadius;
+            float AtmosphereMassZ                = Moon->GetAtmosphereMassZDigital<float>();
+            float AtmosphereMassVolatiles        = Moon->GetAtmosphereMassVolatilesDigital<float>();
+            float AtmosphereMassEnergeticNuclide = Moon->GetAtmosphereMassEnergeticNuclideDigital<float>();
+            float CoreMassZ                      = Moon->GetCoreMassZDigital<float>();
+            float CoreMassVolatiles              = Moon->GetCoreMassVolatilesDigital<float>();
+            float CoreMassEnergeticNuclide       = Moon->GetCoreMassEnergeticNuclideDigital<float>();
+            float OceanMassZ                     = Moon->GetOceanMassZDigital<float>();;
+            float OceanMassVolatiles             = Moon->GetOceanMassVolatilesDigital<float>();
+            float OceanMassEnergeticNuclide      = Moon->GetOceanMassEnergeticNuclideDigital<float>();
+            float CrustMineralMass               = Moon->GetCrustMineralMassDigital<float>();
+            float AtmospherePressure             = (kGravityConstant * MoonMass * (AtmosphereMassZ + AtmosphereMassVolatiles + AtmosphereMassEnergeticNuclide)) / (4 * Math::kPi * std::pow(Moons[i]->GetRadius(), 4.0f));
+            float Oblateness                     = Moon->GetOblateness();
+            float Spin                           = Moon->GetSpin();
+            float BalanceTemperature             = Moon->GetBalanceTemperature();
+            Util::FDiagnostics::Record("moons", "Moon generated, details:");
+            Util::FDiagnostics::Record("moons", "parent planet: {}", PlanetIndex + 1);
+            Util::FDiagnostics::Record("moons", "semi-major axis: {} km, period: {} days, mass: {} earth ({} moon), radius: {} earth ({} moon), type: {}",
+                                                MoonOrbits[i]->GetSemiMajorAxis() / 1000, MoonOrbits[i]->GetPeriod() / kDayToSecond, MoonMassEarth, MoonMassMoon, MoonRadiusEarth, MoonRadiusMoon, std::to_underlying(MoonType));
+            Util::FDiagnostics::Record("moons", "rotation period: {} h, oblateness: {}, balance temperature: {} K",
+                                                Spin / 3600, Oblateness, BalanceTemperature);
+            Util::FDiagnostics::Record("moons", "atmo  mass z: {:.2E} kg, atmo  mass vol: {:.2E} kg, atmo  mass nuc: {:.2E} kg",
+                                                AtmosphereMassZ, AtmosphereMassVolatiles, AtmosphereMassEnergeticNuclide);
+            Util::FDiagnostics::Record("moons", "core  mass z: {:.2E} kg, core  mass vol: {:.2E} kg, core  mass nuc: {:.2E} kg",
+                                                CoreMassZ, CoreMassVolatiles, CoreMassEnergeticNuclide);
+            Util::FDiagnostics::Record("moons", "ocean mass z: {:.2E} kg, ocean mass vol: {:.2E} kg, ocean mass nuc: {:.2E} kg",
+                                                OceanMassZ, OceanMassVolatiles, OceanMassEnergeticNuclide);
+            Util::FDiagnostics::Record("moons", "crust mineral mass : {:.2E} kg, atmo pressure : {:.2f} atm",
+                                                CrustMineralMass, AtmospherePressure / kPascalToAtm);
+        }
+    }
 
     for (std::size_t i = 0; i != MoonCount; ++i)
     {
@@ -2247,9 +2276,11 @@ void FOrbitalGenerator::GenerateMoons(std::size_t PlanetIndex, float FrostLineAu
 
 void FOrbitalGenerator::GenerateRings(std::size_t PlanetIndex, float FrostLineAu, const Astro::AStar* Star,
                                       Astro::FOrbit::FOrbitalDetails& ParentPlanet,
-                                      std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits,
-                                      std::vector<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters)
+                                      TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits,
+                                      TScratchArray<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateRings);
+
     auto* Planet     = ParentPlanet.GetOrbitalObject().GetObject<Astro::APlanet>();
     auto  PlanetType = Planet->GetPlanetType();
     if (PlanetType == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
@@ -2325,22 +2356,20 @@ void FOrbitalGenerator::GenerateRings(std::size_t PlanetIndex, float FrostLineAu
     ParentPlanet.DirectOrbitsData().push_back(RingsOrbit.get());
     Orbits.push_back(std::move(RingsOrbit));
 
-#ifdef DEBUG_OUTPUT
-    std::println("");
-    std::println("Rings generated, details:");
-    std::println("parent planet: {}", PlanetIndex + 1);
-    std::println("semi-major axis: {} km, mass: {} kg, type: {}",
-                 SemiMajorAxis / 1000, RingsMass, std::to_underlying(RingsPtr->GetAsteroidType()));
-    std::println("mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
-                 RingsMassZ, RingsMassVolatiles, RingsMassEnergeticNuclide);
-    std::println("");
-#endif // DEBUG_OUTPUT
+    NpgsDiagnostic("rings", "Rings generated, details:");
+    NpgsDiagnostic("rings", "parent planet: {}", PlanetIndex + 1);
+    NpgsDiagnostic("rings", "semi-major axis: {} km, mass: {} kg, type: {}",
+                            SemiMajorAxis / 1000, RingsMass, std::to_underlying(RingsPtr->GetAsteroidType()));
+    NpgsDiagnostic("rings", "mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
+                            RingsMassZ, RingsMassVolatiles, RingsMassEnergeticNuclide);
 }
 
 void FOrbitalGenerator::GenerateTerra(const Astro::AStar* Star, float PoyntingVector,
                                       const std::pair<float, float>& HabitableZoneAu,
                                       const Astro::FOrbit* Orbit, Astro::APlanet* Planet)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateTerra);
+
     auto PlanetType = Planet->GetPlanetType();
     if (PlanetType == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
         PlanetType == Astro::APlanet::EPlanetType::kRockyIceAsteroidCluster)
@@ -2373,9 +2402,9 @@ void FOrbitalGenerator::GenerateTerra(const Astro::AStar* Star, float PoyntingVe
         float NewOceanMassZ                = NewOceanMass - NewOceanMassVolatiles - NewOceanMassEnergeticNuclide;
 
         Planet->SetOceanMass({
-            boost::multiprecision::uint128_t(NewOceanMassZ),
-            boost::multiprecision::uint128_t(NewOceanMassVolatiles),
-            boost::multiprecision::uint128_t(NewOceanMassEnergeticNuclide)
+            Math::FUint128(NewOceanMassZ),
+            Math::FUint128(NewOceanMassVolatiles),
+            Math::FUint128(NewOceanMassEnergeticNuclide)
         });
     }
 
@@ -2449,8 +2478,10 @@ void FOrbitalGenerator::GenerateTerra(const Astro::AStar* Star, float PoyntingVe
 
 void FOrbitalGenerator::GenerateTrojan(const Astro::AStar* Star, float FrostLineAu, Astro::FOrbit* Orbit,
                                        Astro::FOrbit::FOrbitalDetails& ParentPlanet,
-                                       std::vector<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters)
+                                       TScratchArray<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateTrojan);
+
     auto* Planet     = ParentPlanet.GetOrbitalObject().GetObject<Astro::APlanet>();
     auto  PlanetType = Planet->GetPlanetType();
     if (PlanetType == Astro::APlanet::EPlanetType::kRockyAsteroidCluster ||
@@ -2526,15 +2557,11 @@ void FOrbitalGenerator::GenerateTrojan(const Astro::AStar* Star, float FrostLine
         TrojanBelt->SetMassZ(TrojanMassZ);
     }
 
-#ifdef DEBUG_OUTPUT
-    std::println("");
-    std::println("Trojan belt details:");
-    std::println("semi-major axis: {} AU, mass: {} moon, type: {}",
-                 Orbit->GetSemiMajorAxis() / kAuToMeter, TrojanMass / kMoonMass, std::to_underlying(TrojanBelt->GetAsteroidType()));
-    std::println("mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
-                 TrojanBelt->GetMassZDigital<float>(), TrojanBelt->GetMassVolatilesDigital<float>(), TrojanBelt->GetMassEnergeticNuclideDigital<float>());
-    std::println("");
-#endif // DEBUG_OUTPUT
+    NpgsDiagnostic("asteroids", "Trojan belt details:");
+    NpgsDiagnostic("asteroids", "semi-major axis: {} AU, mass: {} moon, type: {}",
+                                Orbit->GetSemiMajorAxis() / kAuToMeter, TrojanMass / kMoonMass, std::to_underlying(TrojanBelt->GetAsteroidType()));
+    NpgsDiagnostic("asteroids", "mass z: {:.2E} kg, mass vol: {:.2E} kg, mass nuc: {:.2E} kg",
+                                TrojanBelt->GetMassZDigital<float>(), TrojanBelt->GetMassVolatilesDigital<float>(), TrojanBelt->GetMassEnergeticNuclideDigital<float>());
 
     Astro::FOrbit::FOrbitalDetails MyBelt(TrojanBelt.get(), Astro::FOrbit::EObjectType::kAsteroidCluster, Orbit);
     Orbit->ObjectsData().push_back(MyBelt);
@@ -2546,6 +2573,8 @@ void FOrbitalGenerator::GenerateCivilization(const Astro::AStar* Star, float Poy
                                              const std::pair<float, float>& HabitableZoneAu,
                                              const Astro::FOrbit* Orbit, Astro::APlanet* Planet)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateCivilization);
+
     bool bHasLife = false;
     if (Star->GetAge() > 5e8)
     {
@@ -2569,12 +2598,21 @@ void FOrbitalGenerator::GenerateCivilization(const Astro::AStar* Star, float Poy
 
     if (bHasLife)
     {
-        _CivilizationGenerator->GenerateCivilization(Star, PoyntingVector, Planet);
+        if (_CivilizationCandidates != nullptr)
+        {
+            _CivilizationCandidates->Push(Star->GetAge(), PoyntingVector, Planet);
+        }
+        else
+        {
+            _CivilizationGenerator->GenerateCivilization(Star, PoyntingVector, Planet);
+        }
     }
 }
 
-void FOrbitalGenerator::CalculateOrbitalPeriods(std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits)
+void FOrbitalGenerator::CalculateOrbitalPeriods(TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits)
 {
+    NpgsProfileStage(EGenerationStage::kCalculateOrbitalPeriods);
+
     for (auto& Orbit : Orbits)
     {
         if (Orbit->GetPeriod())
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <array>
 #include <memory>
+#include <memory_resource>
 #include <random>
 #include <tuple>
 #include <vector>
@@ -32,6 +33,36 @@ public:
         float LifeOccurrenceProbability{ 0.0114514f };
         bool  bContainUltravioletHabitableZone{ false };
         bool  bEnableAsiFilter{ true };
+
+        // 非空时不再逐颗行星生成文明，而是把通过宜居带筛选的行星追加到这里，
+        // 之后用 FCivilizationGenerator::GenerateCivilizations 批量生成；多个生成器并行时不可共用同一个，
+        // 因此复制生成器时不复制该指针，副本逐颗行星生成文明
+        FCivilizationGenerator::FBatchInput* CivilizationCandidates{ nullptr };
+    };
+
+    enum class EGenerationStage : std::size_t // 分段计时使用的阶段编号，见 Util::FStageProfiler
+    {
+        kGenerateOrbitals,
+        kGenerateBinaryOrbit,
+        kGeneratePlanets,
+        kPlanetaryDisk,           // 以下至 kFinalizePlanets 为 GeneratePlanets 内首尾相接的阶段
+        kCoreMasses,
+        kSemiMajorAxes,
+        kDiskAge,
+        kBinaryStability,
+        kZones,
+        kMigration,
+        kPlanetDetails,
+        kKuiperBelt,
+        kFinalizePlanets,
+        kJudgeLargePlanets,
+        kGenerateMoons,
+        kGenerateRings,
+        kGenerateTerra,
+        kGenerateTrojan,
+        kGenerateCivilization,
+        kCalculateOrbitalPeriods,
+        kCount
     };
 
 private:
@@ -56,15 +87,18 @@ public:
     void GenerateOrbitals(Astro::FStellarSystem& System);
 
 private:
+    template <typename Type>
+    using TScratchArray = std::pmr::vector<Type>; // 单个恒星系统生成期间使用的临时数组，内存来自线程局部暂存区
+
     void GenerateBinaryOrbit(Astro::FStellarSystem& System);
     void GeneratePlanets(std::size_t StarIndex, Astro::FOrbit::FOrbitalDetails& ParentStar, Astro::FStellarSystem& System);
     void GenerateOrbitElements(Astro::FOrbit& Orbit);
 
     std::size_t JudgeLargePlanets(std::size_t StarIndex, const std::vector<std::unique_ptr<Astro::AStar>>& StarData,
                                   float BinarySemiMajorAxis, float InnerHabitableZoneRadiusAu, float FrostLineAu,
-                                  std::vector<float>& CoreMassesSol, std::vector<float>& NewCoreMassesSol,
-                                  std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits,
-                                  std::vector<std::unique_ptr<Astro::APlanet>>& Planets);
+                                  TScratchArray<float>& CoreMassesSol, TScratchArray<float>& NewCoreMassesSol,
+                                  TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits,
+                                  TScratchArray<std::unique_ptr<Astro::APlanet>>& Planets);
 
     float CalculatePlanetMass(float CoreMass, float NewCoreMass, float SemiMajorAxisAu,
                               const FPlanetaryDisk& PlanetaryDiskTempData, const Astro::AStar* Star, Astro::APlanet* Planet);
@@ -75,24 +109,24 @@ private:
 
     void GenerateMoons(std::size_t PlanetIndex, float FrostLineAu, const Astro::AStar* Star, float PoyntingVector,
                        const std::pair<float, float>& HabitableZoneAu, Astro::FOrbit::FOrbitalDetails& ParentPlanet,
-                       std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits,
-                       std::vector<std::unique_ptr<Astro::APlanet>>& Planets);
+                       TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits,
+                       TScratchArray<std::unique_ptr<Astro::APlanet>>& Planets);
 
     void GenerateRings(std::size_t PlanetIndex, float FrostLineAu, const Astro::AStar* Star,
-                       Astro::FOrbit::FOrbitalDetails& ParentPlanet, std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits,
-                       std::vector<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters);
+                       Astro::FOrbit::FOrbitalDetails& ParentPlanet, TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits,
+                       TScratchArray<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters);
 
     void GenerateTerra(const Astro::AStar* Star, float PoyntingVector, const std::pair<float, float>& HabitableZoneAu,
                        const Astro::FOrbit* Orbit, Astro::APlanet* Planet);
 
     void GenerateTrojan(const Astro::AStar* Star, float FrostLineAu, Astro::FOrbit* Orbit,
                         Astro::FOrbit::FOrbitalDetails& ParentPlanet,
-                        std::vector<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters);
+                        TScratchArray<std::unique_ptr<Astro::AAsteroidCluster>>& AsteroidClusters);
 
     void GenerateCivilization(const Astro::AStar* Star, float PoyntingVector, const std::pair<float, float>& HabitableZoneAu,
                               const Astro::FOrbit* Orbit, Astro::APlanet* Planet);
 
-    void CalculateOrbitalPeriods(std::vector<std::unique_ptr<Astro::FOrbit>>& Orbits);
+    void CalculateOrbitalPeriods(TScratchArray<std::unique_ptr<Astro::FOrbit>>& Orbits);
 
 private:
     std::mt19937                                  _RandomEngine;
@@ -105,6 +139,7 @@ private:
     Util::TBernoulliDistribution<>                _WalkInProbability;
 
     std::unique_ptr<FCivilizationGenerator> _CivilizationGenerator;
+    FCivilizationGenerator::FBatchInput*    _CivilizationCandidates;
 
     float _AsteroidUpperLimit;
     float _CoilTemperatureLimit;
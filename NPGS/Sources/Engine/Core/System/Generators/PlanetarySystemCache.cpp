@@ -0,0 +1,179 @@
+#include "PlanetarySystemCache.h"
+
+#include <random>
+#include <stdexcept>
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_GENERATOR_BEGIN
+
+FPlanetarySystemCache::FPlanetarySystemCache(const FOrbitalGenerator::FGenerationInfo& GenerationInfo, std::size_t Capacity)
+    : _GenerationInfo(GenerationInfo), _Capacity(Capacity)
+{
+    _GenerationInfo.SeedSequence = nullptr;
+}
+
+std::size_t FPlanetarySystemCache::Register(Astro::FStellarSystem* Source, std::uint32_t Seed)
+{
+    if (Source == nullptr)
+    {
+        throw std::invalid_argument("Source stellar system must not be null.");
+    }
+
+    std::lock_guard Lock(_Mutex);
+    _Descriptors.push_back({ Source, Seed });
+    _Revisions.push_back(0);
+    return _Descriptors.size() - 1;
+}
+
+void FPlanetarySystemCache::Reserve(std::size_t Count)
+{
+    std::lock_guard Lock(_Mutex);
+    _Descriptors.reserve(Count);
+    _Revisions.reserve(Count);
+}
+
+std::shared_ptr<Astro::FStellarSystem> FPlanetarySystemCache::Acquire(std::size_t SystemIndex)
+{
+    std::shared_ptr<Astro::FStellarSystem> System;
+    std::uint32_t Seed     = 0;
+    std::uint32_t Revision = 0;
+
+    {
+        std::lock_guard Lock(_Mutex);
+        if (SystemIndex >= _Descriptors.size())
+        {
+            throw std::out_of_range("Stellar system index out of range.");
+        }
+
+        auto It = _Entries.find(SystemIndex);
+        if (It != _Entries.end())
+        {
+            _LruList.splice(_LruList.begin(), _LruList, It->second.LruIterator);
+            ++_Statistics.Hits;
+            return It->second.System;
+        }
+
+        ++_Statistics.Misses;
+        // 源系统可能被 UpdateSource 修改，复制必须持锁；复制的只有几颗恒星，代价远小于生成行星
+        System   = CopySource(*_Descriptors[SystemIndex].Source);
+        Seed     = _Descriptors[SystemIndex].Seed;
+        Revision = _Revisions[SystemIndex];
+    }
+
+    // 生成不持锁，其他线程可以同时访问或展开别的系统
+    Expand(*System, Seed);
+
+    std::lock_guard Lock(_Mutex);
+    if (Revision != _Revisions[SystemIndex])
+    {
+        return System; // 生成期间系统被标记失效，结果只交给本次调用者，不放入缓存
+    }
+
+    auto It = _Entries.find(SystemIndex);
+    if (It != _Entries.end())
+    {
+        // 其他线程已经放入了同一个系统，两者逐位一致，沿用已有的以保证共享
+        _LruList.splice(_LruList.begin(), _LruList, It->second.LruIterator);
+        return It->second.System;
+    }
+
+    _LruList.push_front(SystemIndex);
+    _Entries.emplace(SystemIndex, FCacheEntry{ System, _LruList.begin() });
+    EvictExcess();
+
+    return System;
+}
+
+void FPlanetarySystemCache::UpdateSource(std::size_t SystemIndex, const std::function<void(Astro::FStellarSystem&)>& Updater)
+{
+    std::lock_guard Lock(_Mutex);
+    if (SystemIndex >= _Descriptors.size())
+    {
+        throw std::out_of_range("Stellar system index out of range.");
+    }
+
+    Updater(*_Descriptors[SystemIndex].Source);
+    Discard(SystemIndex);
+}
+
+void FPlanetarySystemCache::Invalidate(std::size_t SystemIndex)
+{
+    std::lock_guard Lock(_Mutex);
+    if (SystemIndex >= _Descriptors.size())
+    {
+        return;
+    }
+
+    Discard(SystemIndex);
+}
+
+void FPlanetarySystemCache::Clear()
+{
+    std::lock_guard Lock(_Mutex);
+    for (auto& Revision : _Revisions)
+    {
+        ++Revision;
+    }
+
+    _Entries.clear();
+    _LruList.clear();
+}
+
+void FPlanetarySystemCache::SetCapacity(std::size_t Capacity)
+{
+    std::lock_guard Lock(_Mutex);
+    _Capacity = Capacity;
+    EvictExcess();
+}
+
+std::shared_ptr<Astro::FStellarSystem> FPlanetarySystemCache::CopySource(Astro::FStellarSystem& Source)
+{
+    // 只复制质心和恒星，轨道和行星全部重新生成，源系统中的其他内容不参与
+    auto System = std::make_shared<Astro::FStellarSystem>(*Source.GetBaryCenter());
+    System->StarsData().reserve(Source.StarsData().size());
+    for (const auto& Star : Source.StarsData())
+    {
+        System->StarsData().push_back(std::make_unique<Astro::AStar>(*Star));
+    }
+
+    return System;
+}
+
+void FPlanetarySystemCache::Expand(Astro::FStellarSystem& System, std::uint32_t Seed) const
+{
+    // 每次新建生成器，随机数引擎和分布的内部状态都只由种子决定
+    std::seed_seq SeedSequence{ Seed };
+    FOrbitalGenerator::FGenerationInfo GenerationInfo = _GenerationInfo;
+    GenerationInfo.SeedSequence = &SeedSequence;
+    GenerationInfo.CivilizationCandidates = nullptr; // 多个系统可能同时展开，不能共用候选列表
+
+    FOrbitalGenerator Generator(GenerationInfo);
+    Generator.GenerateOrbitals(System);
+}
+
+void FPlanetarySystemCache::Discard(std::size_t SystemIndex)
+{
+    ++_Revisions[SystemIndex];
+
+    auto It = _Entries.find(SystemIndex);
+    if (It != _Entries.end())
+    {
+        _LruList.erase(It->second.LruIterator);
+        _Entries.erase(It);
+    }
+}
+
+void FPlanetarySystemCache::EvictExcess()
+{
+    while (_Entries.size() > _Capacity)
+    {
+        _Entries.erase(_LruList.back());
+        _LruList.pop_back();
+        ++_Statistics.Evictions;
+    }
+}
+
+_GENERATOR_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Generators/OrbitalGenerator.h"
+#include "Engine/Core/Types/Entries/Astro/StellarSystem.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_GENERATOR_BEGIN
+
+// 按需展开的行星系统缓存。每个恒星系统常驻的只有源系统指针和一个种子，
+// 第一次访问时在锁内复制源系统的质心和恒星，用该种子新建 FOrbitalGenerator 生成行星，结果放入容量有限的 LRU 缓存
+// 同一个系统无论被淘汰重建多少次，生成结果都逐位一致；调用者对展开系统的修改不会保留
+class FPlanetarySystemCache
+{
+public:
+    struct FStatistics
+    {
+        std::size_t Hits{};
+        std::size_t Misses{};
+        std::size_t Evictions{};
+    };
+
+public:
+    FPlanetarySystemCache() = delete;
+    // GenerationInfo.SeedSequence 会被忽略，每个系统使用自己的种子
+    FPlanetarySystemCache(const FOrbitalGenerator::FGenerationInfo& GenerationInfo, std::size_t Capacity);
+    FPlanetarySystemCache(const FPlanetarySystemCache&) = delete;
+    FPlanetarySystemCache(FPlanetarySystemCache&&)      = delete;
+    ~FPlanetarySystemCache()                            = default;
+
+    FPlanetarySystemCache& operator=(const FPlanetarySystemCache&) = delete;
+    FPlanetarySystemCache& operator=(FPlanetarySystemCache&&)      = delete;
+
+    // 登记一个源系统，返回其编号；源系统须在缓存的整个生命周期内保持地址不变
+    std::size_t Register(Astro::FStellarSystem* Source, std::uint32_t Seed);
+    void Reserve(std::size_t Count);
+
+    // 取得展开后的系统，未命中时在调用线程上生成；返回的指针在系统被淘汰后依然有效
+    std::shared_ptr<Astro::FStellarSystem> Acquire(std::size_t SystemIndex);
+
+    // 在缓存锁内修改源系统并丢弃已展开的结果，与 Acquire 复制源系统互斥；修改恒星应通过此函数进行
+    void UpdateSource(std::size_t SystemIndex, const std::function<void(Astro::FStellarSystem&)>& Updater);
+    // 源系统的恒星被修改后调用，丢弃已展开的结果
+    void Invalidate(std::size_t SystemIndex);
+    void Clear();
+
+    void SetCapacity(std::size_t Capacity);
+    std::size_t GetCapacity() const;
+    std::size_t GetResidentCount() const;
+    std::size_t GetSystemCount() const;
+    FStatistics GetStatistics() const;
+
+private:
+    struct FDescriptor
+    {
+        Astro::FStellarSystem* Source;
+        std::uint32_t          Seed;
+    };
+
+    struct FCacheEntry
+    {
+        std::shared_ptr<Astro::FStellarSystem> System;
+        std::list<std::size_t>::iterator       LruIterator;
+    };
+
+    static std::shared_ptr<Astro::FStellarSystem> CopySource(Astro::FStellarSystem& Source);
+    void Expand(Astro::FStellarSystem& System, std::uint32_t Seed) const;
+    void Discard(std::size_t SystemIndex); // 须持锁调用
+    void EvictExcess();
+
+private:
+    FOrbitalGenerator::FGenerationInfo           _GenerationInfo;
+    std::vector<FDescriptor>                     _Descriptors;
+    std::vector<std::uint32_t>                   _Revisions; // 每次 Invalidate 递增，用于丢弃失效期间生成的结果
+    std::unordered_map<std::size_t, FCacheEntry> _Entries;
+    std::list<std::size_t>                       _LruList;   // 表头为最近使用
+    mutable std::mutex                           _Mutex;
+    FStatistics                                  _Statistics;
+    std::size_t                                  _Capacity;
+};
+
+_GENERATOR_END
+_SYSTEM_END
+_NPGS_END
+
+#include "PlanetarySystemCache.inl"
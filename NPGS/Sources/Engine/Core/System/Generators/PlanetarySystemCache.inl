@@ -0,0 +1,33 @@
+#include "PlanetarySystemCache.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_GENERATOR_BEGIN
+
+NPGS_INLINE std::size_t FPlanetarySystemCache::GetCapacity() const
+{
+    std::lock_guard Lock(_Mutex);
+    return _Capacity;
+}
+
+NPGS_INLINE std::size_t FPlanetarySystemCache::GetResidentCount() const
+{
+    std::lock_guard Lock(_Mutex);
+    return _Entries.size();
+}
+
+NPGS_INLINE std::size_t FPlanetarySystemCache::GetSystemCount() const
+{
+    std::lock_guard Lock(_Mutex);
+    return _Descriptors.size();
+}
+
+NPGS_INLINE FPlanetarySystemCache::FStatistics FPlanetarySystemCache::GetStatistics() const
+{
+    std::lock_guard Lock(_Mutex);
+    return _Statistics;
+}
+
+_GENERATOR_END
+_SYSTEM_END
+_NPGS_END
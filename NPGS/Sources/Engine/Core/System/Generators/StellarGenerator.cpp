@@ -2,8 +2,10 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <charconv>
+#include <chrono>
 #include <filesystem>
 #include <format>
 #include <iomanip>
@@ -19,6 +21,7 @@
 #include "Engine/Core/Runtime/AssetLoaders/AssetManager.h"
 #include "Engine/Core/Runtime/AssetLoaders/CommaSeparatedValues.hpp"
 #include "Engine/Utils/Logger.h"
+#include "Engine/Utils/Profiler.h"
 #include "Engine/Utils/Utils.h"
 
 _NPGS_BEGIN
@@ -48,6 +51,66 @@ throw DeathStar;
 // --------------
 namespace
 {
+    const std::array kPresetFeH{ -4.0f, -3.0f, -2.0f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f };
+
+    // 创建者转换全部轨道通常只需数十秒，超时多半是创建者已经退出
+    constexpr std::chrono::seconds kSharedMistWaitTimeout(120);
+
+    std::size_t FindClosestFeHIndex(float TargetFeH)
+    {
+        auto it = std::min_element(kPresetFeH.begin(), kPresetFeH.end(), [TargetFeH](float Lhs, float Rhs) -> bool
+        {
+            return std::abs(Lhs - TargetFeH) < std::abs(Rhs - TargetFeH);
+        });
+
+        return static_cast<std::size_t>(std::distance(kPresetFeH.begin(), it));
+    }
+
+    // CSV 表和紧凑表的统一行访问
+    template <typename BaseType, std::size_t ColSize>
+    std::size_t GetRowCount(const Runtime::Asset::TCommaSeparatedValues<BaseType, ColSize>* Data)
+    {
+        return Data->Data()->size();
+    }
+
+    std::size_t GetRowCount(const Runtime::Asset::FCompactTable* Data)
+    {
+        return Data->GetRowCount();
+    }
+
+    template <typename BaseType, std::size_t ColSize>
+    double GetValue(const Runtime::Asset::TCommaSeparatedValues<BaseType, ColSize>* Data, std::size_t RowIndex, std::size_t ColIndex)
+    {
+        return (*Data->Data())[RowIndex][ColIndex];
+    }
+
+    double GetValue(const Runtime::Asset::FCompactTable* Data, std::size_t RowIndex, std::size_t ColIndex)
+    {
+        return Data->GetValue(RowIndex, ColIndex);
+    }
+
+    template <typename BaseType, std::size_t ColSize>
+    std::vector<double> GetRow(const Runtime::Asset::TCommaSeparatedValues<BaseType, ColSize>* Data, std::size_t RowIndex)
+    {
+        return (*Data->Data())[RowIndex];
+    }
+
+    std::vector<double> GetRow(const Runtime::Asset::FCompactTable* Data, std::size_t RowIndex)
+    {
+        return Data->GetRow(RowIndex);
+    }
+
+    // 低于最小质量轨道的恒星，相变时间和寿命以该轨道为基准按质量幂律外推
+    double ExtrapolateLowMassAge(double AnchorAge, double AnchorMassSol, double TargetMassSol)
+    {
+        return AnchorAge * std::pow(TargetMassSol / AnchorMassSol, -1.3);
+    }
+
+    std::size_t AlignBlobSize(std::size_t Size)
+    {
+        return (Size + 7) & ~std::size_t(7);
+    }
+
     float DefaultAgePdf(glm::vec3, float Age, float UniverseAge)
     {
         float Probability = 0.0f;
@@ -153,7 +216,8 @@ FStellarGenerator::FStellarGenerator(const FGenerationInfo& GenerationInfo)
     _FeHDistribution(GenerationInfo.FeHDistribution),
     _MassDistribution(GenerationInfo.MassDistribution),
     _StellarTypeOption(GenerationInfo.StellarTypeOption),
-    _MultiplicityOption(GenerationInfo.MultiplicityOption)
+    _MultiplicityOption(GenerationInfo.MultiplicityOption),
+    _MistRegistry(nullptr)
 {
     InitializeMistData();
     InitializePdfs();
@@ -183,7 +247,8 @@ FStellarGenerator::FStellarGenerator(const FStellarGenerator& Other)
     _FeHDistribution(Other._FeHDistribution),
     _MassDistribution(Other._MassDistribution),
     _StellarTypeOption(Other._StellarTypeOption),
-    _MultiplicityOption(Other._MultiplicityOption)
+    _MultiplicityOption(Other._MultiplicityOption),
+    _MistRegistry(Other._MistRegistry)
 {
     if (Other._LogMassGenerator != nullptr)
     {
@@ -242,7 +307,8 @@ FStellarGenerator::FStellarGenerator(FStellarGenerator&& Other) noexcept
     _FeHDistribution(std::exchange(Other._FeHDistribution, {})),
     _MassDistribution(std::exchange(Other._MassDistribution, {})),
     _StellarTypeOption(std::exchange(Other._StellarTypeOption, {})),
-    _MultiplicityOption(std::exchange(Other._MultiplicityOption, {}))
+    _MultiplicityOption(std::exchange(Other._MultiplicityOption, {})),
+    _MistRegistry(Other._MistRegistry)
 {
 }
 
@@ -273,6 +339,7 @@ FStellarGenerator& FStellarGenerator::operator=(const FStellarGenerator& Other)
         _MassDistribution     = Other._MassDistribution;
         _StellarTypeOption    = Other._StellarTypeOption;
         _MultiplicityOption   = Other._MultiplicityOption;
+        _MistRegistry         = Other._MistRegistry;
         _LogMassGenerator     = Other._LogMassGenerator
                               ? std::make_unique<Util::TUniformRealDistribution<>>(
                                   std::log10(Other._MassLowerLimit), std::log10(Other._MassUpperLimit))
@@ -335,6 +402,7 @@ FStellarGenerator& FStellarGenerator::operator=(FStellarGenerator&& Other) noexc
         _MassDistribution     = std::exchange(Other._MassDistribution, {});
         _StellarTypeOption    = std::exchange(Other._StellarTypeOption, {});
         _MultiplicityOption   = std::exchange(Other._MultiplicityOption, {});
+        _MistRegistry         = Other._MistRegistry;
     }
 
     return *this;
@@ -342,6 +410,8 @@ FStellarGenerator& FStellarGenerator::operator=(FStellarGenerator&& Other) noexc
 
 FStellarGenerator::FBasicProperties FStellarGenerator::GenerateBasicProperties(float Age, float FeH)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateBasicProperties);
+
     FBasicProperties Properties{};
     Properties.StellarTypeOption = _StellarTypeOption;
 
@@ -525,13 +595,32 @@ Astro::AStar FStellarGenerator::GenerateStar(FBasicProperties& Properties)
     {
     case EStellarTypeGenerationOption::kRandom:
     {
+        // 先查寿命表，已经死亡的恒星直接进入致密星流程，跳过完整的演化轨迹插值
+        double Lifetime = CalculateLifetime(Properties.FeH, Properties.InitialMassSol).second;
+        if (Properties.Age > Lifetime)
+        {
+            Star.SetLifetime(Lifetime);
+            ProcessDeathStar(EStellarTypeGenerationOption::kRandom, Star);
+            if (Star.GetEvolutionPhase() == Astro::AStar::EEvolutionPhase::kNull)
+            {
+                // 如果爆了，削一半质量
+                Properties.InitialMassSol /= 2;
+                Star = GenerateStar(Properties);
+            }
+
+            return Star;
+        }
+
         try
         {
             StarData = GetFullMistData(Properties, false, true);
         }
         catch (Astro::AStar& DeathStar)
         {
+            // 寿命表边界附近的恒星仍可能在插值时被判定死亡，保留抛出的寿命
+            Lifetime  = DeathStar.GetLifetime();
             DeathStar = static_cast<Astro::AStar>(Properties);
+            DeathStar.SetLifetime(Lifetime);
             ProcessDeathStar(EStellarTypeGenerationOption::kRandom, DeathStar);
             if (DeathStar.GetEvolutionPhase() == Astro::AStar::EEvolutionPhase::kNull)
             {
@@ -653,21 +742,95 @@ Astro::AStar FStellarGenerator::GenerateStar(FBasicProperties& Properties)
     return Star;
 }
 
+std::pair<double, double> FStellarGenerator::CalculateLifetime(float FeH, float InitialMassSol) const
+{
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+    const auto& Table = _MistRegistry->LifetimeTables[FindClosestFeHIndex(FeH)];
+    if (Table.InitialMassesSol.empty())
+    {
+        return { kNaN, kNaN };
+    }
+
+    const auto& Masses = Table.InitialMassesSol;
+    if (InitialMassSol < Masses.front())
+    {
+        // 与 InterpolateMistTracks 使用相同的外推基准
+        return { ExtrapolateLowMassAge(Table.MainSequenceLifetimes.front(), Masses.front(), InitialMassSol),
+                 ExtrapolateLowMassAge(Table.Lifetimes.front(), Masses.front(), InitialMassSol) };
+    }
+
+    auto it = std::lower_bound(Masses.begin(), Masses.end(), InitialMassSol);
+    if (it == Masses.end())
+    {
+        return { kNaN, kNaN };
+    }
+
+    std::size_t UpperIndex = std::distance(Masses.begin(), it);
+    if (*it == InitialMassSol)
+    {
+        return { Table.MainSequenceLifetimes[UpperIndex], Table.Lifetimes[UpperIndex] };
+    }
+
+    std::size_t LowerIndex      = UpperIndex - 1;
+    double      MassCoefficient = (InitialMassSol - Masses[LowerIndex]) / (Masses[UpperIndex] - Masses[LowerIndex]);
+
+    double MainSequenceLifetime = Table.MainSequenceLifetimes[LowerIndex] +
+        (Table.MainSequenceLifetimes[UpperIndex] - Table.MainSequenceLifetimes[LowerIndex]) * MassCoefficient;
+    double Lifetime = Table.Lifetimes[LowerIndex] + (Table.Lifetimes[UpperIndex] - Table.Lifetimes[LowerIndex]) * MassCoefficient;
+
+    return { MainSequenceLifetime, Lifetime };
+}
+
+void FStellarGenerator::EnableCompactMistData(const std::string& SharedMemoryName)
+{
+    // 注册表构建期间持有同一把锁，这里要么在构建前修改配置，要么等构建完成后报错
+    std::lock_guard<std::mutex> Lock(_kMistConfigMutex);
+    if (_kMistRegistry.load(std::memory_order_acquire) != nullptr)
+    {
+        NpgsCoreError("MIST data already initialized, compact storage must be enabled before creating any stellar generator.");
+        return;
+    }
+
+    _kPendingMistConfig.bCompactData     = true;
+    _kPendingMistConfig.SharedMemoryName = SharedMemoryName;
+}
+
+const FStellarGenerator::FCompactMistReport& FStellarGenerator::GetCompactMistReport()
+{
+    static const FCompactMistReport kEmptyReport;
+    const FMistRegistry* Registry = _kMistRegistry.load(std::memory_order_acquire);
+    return Registry != nullptr ? Registry->CompactMistReport : kEmptyReport;
+}
+
+FStellarGenerator& FStellarGenerator::UseAlternateMistData()
+{
+    // 构造函数已发布全局注册表，其配置不再改变
+    const FMistRegistry* GlobalRegistry = _kMistRegistry.load(std::memory_order_acquire);
+    std::call_once(_kAlternateMistRegistryOnce, [GlobalRegistry]() -> void
+    {
+        // 构建时会向 FAssetManager 添加资产，与全局注册表的构建共用一把锁
+        std::lock_guard<std::mutex> Lock(_kMistConfigMutex);
+        FMistConfig Config{ .bCompactData = !GlobalRegistry->Config.bCompactData };
+        _kAlternateMistRegistryOwner = BuildMistRegistry(Config);
+    });
+
+    _MistRegistry = _kAlternateMistRegistryOwner.get();
+    return *this;
+}
+
 template <typename CsvType>
 requires std::is_class_v<CsvType>
 CsvType* FStellarGenerator::LoadCsvAsset(const std::string& Filename, const std::vector<std::string>& Headers)
 {
+    // 先查后加不是原子的，只在 BuildMistRegistry 中持有 _kMistConfigMutex 时调用
     auto* AssetManager = Runtime::Asset::FAssetManager::GetInstance();
+    auto* Asset = AssetManager->GetAsset<CsvType>(Filename);
+    if (Asset != nullptr)
     {
-        std::shared_lock Lock(_kCacheMutex);
-        auto* Asset = AssetManager->GetAsset<CsvType>(Filename);
-        if (Asset != nullptr)
-        {
-            return Asset;
-        }
+        return Asset;
     }
 
-    std::unique_lock Lock(_kCacheMutex);
     AssetManager->AddAsset<CsvType>(Filename, CsvType(Filename, Headers));
 
     return AssetManager->GetAsset<CsvType>(Filename);
@@ -675,11 +838,28 @@ CsvType* FStellarGenerator::LoadCsvAsset(const std::string& Filename, const std:
 
 void FStellarGenerator::InitializeMistData()
 {
-    if (_kbMistDataInitiated)
+    // 快速路径只有一次 acquire 读取，注册表发布后不再修改
+    _MistRegistry = _kMistRegistry.load(std::memory_order_acquire);
+    if (_MistRegistry != nullptr) [[likely]]
     {
         return;
     }
 
+    std::call_once(_kMistRegistryOnce, []() -> void
+    {
+        std::lock_guard<std::mutex> Lock(_kMistConfigMutex);
+        _kMistRegistryOwner = BuildMistRegistry(_kPendingMistConfig);
+        _kMistRegistry.store(_kMistRegistryOwner.get(), std::memory_order_release);
+    });
+
+    _MistRegistry = _kMistRegistry.load(std::memory_order_acquire);
+}
+
+std::unique_ptr<FStellarGenerator::FMistRegistry> FStellarGenerator::BuildMistRegistry(const FMistConfig& Config)
+{
+    auto Registry = std::make_unique<FMistRegistry>();
+    Registry->Config = Config;
+
     const std::array kPresetPrefix
     {
         Runtime::Asset::GetAssetFullPath(Runtime::Asset::EAssetType::kDataTable, "StellarParameters/MIST/[Fe_H]=-4.0"),
@@ -695,9 +875,11 @@ void FStellarGenerator::InitializeMistData()
     };
 
     std::vector<float> Masses;
+    std::vector<std::string> CompactFiles;
 
-    for (const auto& PrefixDirectory : kPresetPrefix)
+    for (std::size_t i = 0; i != kPresetPrefix.size(); ++i)
     {
+        const auto& PrefixDirectory = kPresetPrefix[i];
         for (const auto& Entry : std::filesystem::directory_iterator(PrefixDirectory))
         {
             std::string Filename = Entry.path().filename().string();
@@ -707,21 +889,176 @@ void FStellarGenerator::InitializeMistData()
 
             Masses.push_back(Mass);
 
+            std::string FullPath = PrefixDirectory + "/" + Filename;
             if (PrefixDirectory.find("WhiteDwarfs") != std::string::npos)
             {
-                LoadCsvAsset<FWdMistData>(PrefixDirectory + "/" + Filename, _kWdMistHeaders);
+                Registry->WdMistTracks.emplace(FullPath, LoadCsvAsset<FWdMistData>(FullPath, _kWdMistHeaders));
+            }
+            else if (Config.bCompactData)
+            {
+                CompactFiles.push_back(std::move(FullPath));
             }
             else
             {
-                LoadCsvAsset<FMistData>(PrefixDirectory + "/" + Filename, _kMistHeaders);
+                FMistData* MistData = LoadCsvAsset<FMistData>(FullPath, _kMistHeaders);
+                CachePhaseChanges(*Registry, MistData);
+                Registry->MistTracks.emplace(std::move(FullPath), MistData);
             }
         }
 
-        _kMassFilesCache.emplace(PrefixDirectory, Masses);
+        Registry->MassFiles.emplace(PrefixDirectory, std::move(Masses));
         Masses.clear();
     }
 
-    _kbMistDataInitiated = true;
+    if (Config.bCompactData)
+    {
+        InitializeCompactMistData(*Registry, CompactFiles);
+    }
+
+    for (std::size_t i = 0; i != kPresetFeH.size(); ++i)
+    {
+        InitializeLifetimeTable(*Registry, i, kPresetPrefix[i]);
+    }
+
+    std::string HrDiagramDataFilePath =
+        Runtime::Asset::GetAssetFullPath(Runtime::Asset::EAssetType::kDataTable, "StellarParameters/H-R Diagram/H-R Diagram.csv");
+    Registry->HrDiagram = LoadCsvAsset<FHrDiagram>(HrDiagramDataFilePath, _kHrDiagramHeaders);
+
+    return Registry;
+}
+
+void FStellarGenerator::InitializeCompactMistData(FMistRegistry& Registry, std::vector<std::string>& Filenames)
+{
+    // 排序保证各进程按相同顺序排列共享内存中的表
+    std::sort(Filenames.begin(), Filenames.end());
+
+    const std::string& SharedMemoryName = Registry.Config.SharedMemoryName;
+    if (!SharedMemoryName.empty())
+    {
+        auto SharedMemory = Runtime::Asset::FSharedMemory::Open(SharedMemoryName);
+        if (SharedMemory != nullptr && !SharedMemory->WaitReady(kSharedMistWaitTimeout))
+        {
+            NpgsCoreError("Timed out waiting for shared MIST data \"{}\", fall back to private storage.", SharedMemoryName);
+        }
+        else if (SharedMemory != nullptr)
+        {
+            const std::byte* Blob = SharedMemory->GetData();
+            std::uint64_t TableCount = 0;
+            std::memcpy(&TableCount, Blob, sizeof(std::uint64_t));
+            if (TableCount == Filenames.size())
+            {
+                Blob += sizeof(std::uint64_t);
+                for (const auto& Filename : Filenames)
+                {
+                    auto [it, bInserted] = Registry.CompactMistTracks.emplace(Filename, FCompactMistData(Blob, _kMistHeaders));
+                    CachePhaseChanges(Registry, &it->second);
+                    Blob += AlignBlobSize(FCompactMistData::CalculateBlobSize(Blob));
+                }
+
+                Registry.CompactMistReport.CompactBytes = SharedMemory->GetSize();
+                Registry.SharedMemory = std::move(SharedMemory);
+                NpgsCoreInfo("Attached to shared MIST data \"{}\", {} tracks, {} bytes.",
+                             SharedMemoryName, TableCount, Registry.CompactMistReport.CompactBytes);
+                return;
+            }
+
+            NpgsCoreError("Shared MIST data \"{}\" does not match local track files, fall back to private storage.", SharedMemoryName);
+        }
+    }
+
+    std::size_t PayloadSize = sizeof(std::uint64_t);
+    for (const auto& Filename : Filenames)
+    {
+        // 临时读取 CSV，不注册到资产管理器，转换后即释放
+        FMistData CsvData(Filename, _kMistHeaders);
+        const auto* Rows = CsvData.Data();
+
+        auto [it, bInserted] = Registry.CompactMistTracks.emplace(Filename, FCompactMistData(*Rows, _kMistHeaders, _kCompactMistTolerances, "x"));
+        const auto& CompactData = it->second;
+        CachePhaseChanges(Registry, &CompactData);
+
+        Registry.CompactMistReport.OriginalBytes += Rows->size() * (sizeof(FDataArray) + _kMistHeaders.size() * sizeof(double));
+        Registry.CompactMistReport.CompactBytes  += CompactData.GetBlob().size();
+        for (std::size_t i = 0; i != Registry.CompactMistReport.MaxColumnErrors.size(); ++i)
+        {
+            Registry.CompactMistReport.MaxColumnErrors[i] =
+                std::max(Registry.CompactMistReport.MaxColumnErrors[i], CompactData.GetColumnInfo(i).MaxError);
+        }
+
+        PayloadSize += AlignBlobSize(CompactData.GetBlob().size());
+    }
+
+    NpgsCoreInfo("Compact MIST data: {} tracks, {} bytes -> {} bytes.", Filenames.size(),
+                 Registry.CompactMistReport.OriginalBytes, Registry.CompactMistReport.CompactBytes);
+    for (std::size_t i = 0; i != _kMistHeaders.size(); ++i)
+    {
+        NpgsCoreInfo("    {}: max error {:.3e}", _kMistHeaders[i], Registry.CompactMistReport.MaxColumnErrors[i]);
+    }
+
+    if (SharedMemoryName.empty())
+    {
+        return;
+    }
+
+    auto SharedMemory = Runtime::Asset::FSharedMemory::Create(SharedMemoryName, PayloadSize);
+    if (SharedMemory == nullptr || !SharedMemory->IsCreator())
+    {
+        // 创建失败或在此期间被其他进程抢先创建时保留私有副本
+        return;
+    }
+
+    std::byte* Destination = SharedMemory->GetData();
+    std::uint64_t TableCount = Filenames.size();
+    std::memcpy(Destination, &TableCount, sizeof(std::uint64_t));
+    Destination += sizeof(std::uint64_t);
+
+    for (const auto& Filename : Filenames)
+    {
+        auto& CompactData = Registry.CompactMistTracks.at(Filename);
+        auto  Blob        = CompactData.GetBlob();
+        std::memcpy(Destination, Blob.data(), Blob.size());
+        CompactData.Rebind(Destination);
+        Destination += AlignBlobSize(Blob.size());
+    }
+
+    SharedMemory->MarkReady();
+    Registry.SharedMemory = std::move(SharedMemory);
+    NpgsCoreInfo("Published compact MIST data to shared memory \"{}\".", SharedMemoryName);
+}
+
+void FStellarGenerator::InitializeLifetimeTable(FMistRegistry& Registry, std::size_t FeHIndex, const std::string& PrefixDirectory)
+{
+    const auto& Masses = Registry.MassFiles.at(PrefixDirectory);
+
+    FLifetimeTable Table;
+    Table.InitialMassesSol.reserve(Masses.size());
+    Table.MainSequenceLifetimes.reserve(Masses.size());
+    Table.Lifetimes.reserve(Masses.size());
+
+    std::stringstream MassStream;
+    for (float Mass : Masses)
+    {
+        MassStream.str("");
+        MassStream.clear();
+        MassStream << std::fixed << std::setfill('0') << std::setw(6) << std::setprecision(2) << Mass;
+        std::string Filename = PrefixDirectory + "/" + MassStream.str() + "0" + "Ms_track.csv";
+
+        const void* DataSheet = Registry.Config.bCompactData ? static_cast<const void*>(&Registry.CompactMistTracks.at(Filename))
+                                                             : static_cast<const void*>(Registry.MistTracks.at(Filename));
+        const auto& PhaseChanges = Registry.PhaseChanges.at(DataSheet);
+
+        // 第一个进入主序之后阶段的相变点作为主序寿命，没有后主序阶段的小质量恒星主序寿命即总寿命
+        auto PostMainSequence = std::find_if(PhaseChanges.begin(), std::prev(PhaseChanges.end()), [](const FDataArray& Row) -> bool
+        {
+            return Row[_kPhaseIndex] > 0.0;
+        });
+
+        Table.InitialMassesSol.push_back(Mass);
+        Table.MainSequenceLifetimes.push_back((*PostMainSequence)[_kStarAgeIndex]);
+        Table.Lifetimes.push_back(PhaseChanges.back()[_kStarAgeIndex]);
+    }
+
+    Registry.LifetimeTables[FeHIndex] = std::move(Table);
 }
 
 void FStellarGenerator::InitializePdfs()
@@ -781,6 +1118,8 @@ float FStellarGenerator::GenerateMass(float MaxPdf, auto& LogMassPdf)
 FStellarGenerator::FDataArray
 FStellarGenerator::GetFullMistData(const FBasicProperties& Properties, bool bIsWhiteDwarf, bool bIsSingleWhiteDwarf)
 {
+    NpgsProfileStage(EGenerationStage::kGetFullMistData);
+
     float TargetAge  = Properties.Age;
     float TargetFeH  = Properties.FeH;
     float TargetMass = Properties.InitialMassSol;
@@ -792,14 +1131,7 @@ FStellarGenerator::GetFullMistData(const FBasicProperties& Properties, bool bIsW
 
     if (!bIsWhiteDwarf)
     {
-        const std::array kPresetFeH{ -4.0f, -3.0f, -2.0f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f };
-
-        float ClosestFeH = *std::min_element(kPresetFeH.begin(), kPresetFeH.end(), [TargetFeH](float Lhs, float Rhs) -> bool
-        {
-            return std::abs(Lhs - TargetFeH) < std::abs(Rhs - TargetFeH);
-        });
-
-        TargetFeH = ClosestFeH;
+        TargetFeH = kPresetFeH[FindClosestFeHIndex(TargetFeH)];
 
         MassStream << std::fixed << std::setfill('0') << std::setw(6) << std::setprecision(2) << TargetMass;
         MassString = MassStream.str() + "0";
@@ -828,11 +1160,7 @@ FStellarGenerator::GetFullMistData(const FBasicProperties& Properties, bool bIsW
         }
     }
 
-    std::vector<float> Masses;
-    {
-        std::shared_lock Lock(_kCacheMutex);
-        Masses = _kMassFilesCache[PrefixDirectory];
-    }
+    const auto& Masses = _MistRegistry->MassFiles.at(PrefixDirectory);
 
     auto it = std::lower_bound(Masses.begin(), Masses.end(), TargetMass);
     if (it == Masses.end())
@@ -880,108 +1208,41 @@ FStellarGenerator::GetFullMistData(const FBasicProperties& Properties, bool bIsW
 
     Files = std::make_pair(LowerMassFile, UpperMassFile);
 
-    FDataArray Result = InterpolateMistData(Files, TargetAge, TargetMass, MassCoefficient);
+    FDataArray Result = InterpolateMistData(Files, TargetAge, TargetMass, LowerMass, MassCoefficient);
     Result.push_back(TargetFeH); // 加入插值使用的金属丰度，用于计算光谱类型
 
     return Result;
 }
 
 FStellarGenerator::FDataArray
-FStellarGenerator::InterpolateMistData(const std::pair<std::string, std::string>& Files, double TargetAge, double TargetMass, double MassCoefficient)
+FStellarGenerator::InterpolateMistData(const std::pair<std::string, std::string>& Files, double TargetAge, double TargetMass,
+                                       double LowerMass, double MassCoefficient)
 {
+    NpgsProfileStage(EGenerationStage::kInterpolateMistData);
+
     FDataArray Result;
 
     if (Files.first.find("WhiteDwarfs") == std::string::npos)
     {
-        if (Files.first != Files.second) [[likely]]
+        if (_MistRegistry->Config.bCompactData)
         {
-            FMistData* LowerData = LoadCsvAsset<FMistData>(Files.first,  _kMistHeaders);
-            FMistData* UpperData = LoadCsvAsset<FMistData>(Files.second, _kMistHeaders);
-
-            auto LowerPhaseChanges = FindPhaseChanges(LowerData);
-            auto UpperPhaseChanges = FindPhaseChanges(UpperData);
-
-            if (std::isnan(TargetAge)) // 年龄为 NaN 在这里代表要生成濒死恒星
-            {
-                double LowerLifetime = LowerPhaseChanges.back()[_kStarAgeIndex];
-                double UpperLifetime = UpperPhaseChanges.back()[_kStarAgeIndex];
-                double Lifetime = LowerLifetime + (UpperLifetime - LowerLifetime) * MassCoefficient;
-                TargetAge = Lifetime - 500000;
-            }
-
-            std::pair<std::vector<FDataArray>, std::vector<FDataArray>> PhaseChangePair
-            {
-                LowerPhaseChanges,
-                UpperPhaseChanges
-            };
-
-            double EvolutionProgress = CalculateEvolutionProgress(PhaseChangePair, TargetAge, MassCoefficient);
-
-            double LowerLifetime = PhaseChangePair.first.back()[_kStarAgeIndex];
-            double UpperLifetime = PhaseChangePair.second.back()[_kStarAgeIndex];
-
-            FDataArray LowerRows = InterpolateStarData(LowerData, EvolutionProgress);
-            FDataArray UpperRows = InterpolateStarData(UpperData, EvolutionProgress);
-
-            LowerRows.push_back(LowerLifetime);
-            UpperRows.push_back(UpperLifetime);
-
-            Result = InterpolateFinalData(std::make_pair(LowerRows, UpperRows), MassCoefficient, false);
+            const FCompactMistData* LowerData = &_MistRegistry->CompactMistTracks.at(Files.first);
+            const FCompactMistData* UpperData = &_MistRegistry->CompactMistTracks.at(Files.second);
+            Result = InterpolateMistTracks(LowerData, UpperData, TargetAge, TargetMass, LowerMass, MassCoefficient);
         }
-        else [[unlikely]]
+        else
         {
-            FMistData* StarData = LoadCsvAsset<FMistData>(Files.first, _kMistHeaders);
-            auto PhaseChanges = FindPhaseChanges(StarData);
-
-            if (std::isnan(TargetAge))
-            {
-                double Lifetime = PhaseChanges.back()[_kStarAgeIndex];
-                TargetAge = Lifetime - 500000;
-            }
-
-            double EvolutionProgress = 0.0;
-            double Lifetime = 0.0;
-            if (TargetMass >= 0.1)
-            {
-                std::pair<std::vector<FDataArray>, std::vector<FDataArray>> PhaseChangePair{ PhaseChanges, {} };
-                EvolutionProgress = CalculateEvolutionProgress(PhaseChangePair, TargetAge, MassCoefficient);
-                Lifetime          = PhaseChanges.back()[_kStarAgeIndex];
-                Result            = InterpolateStarData(StarData, EvolutionProgress);
-                Result.push_back(Lifetime);
-            }
-            else
-            {
-                // 外推小质量恒星的数据
-                double OriginalLowerPhaseChangePoint = PhaseChanges[1][_kStarAgeIndex];
-                double OriginalUpperPhaseChangePoint = PhaseChanges[2][_kStarAgeIndex];
-                double LowerPhaseChangePoint = OriginalLowerPhaseChangePoint * std::pow(TargetMass / 0.1, -1.3);
-                double UpperPhaseChangePoint = OriginalUpperPhaseChangePoint * std::pow(TargetMass / 0.1, -1.3);
-                Lifetime = UpperPhaseChangePoint;
-                if (TargetAge < LowerPhaseChangePoint)
-                {
-                    EvolutionProgress = TargetAge / LowerPhaseChangePoint - 1;
-                }
-                else if (LowerPhaseChangePoint <= TargetAge && TargetAge <= UpperPhaseChangePoint)
-                {
-                    EvolutionProgress = (TargetAge - LowerPhaseChangePoint) / (UpperPhaseChangePoint - LowerPhaseChangePoint);
-                }
-                else if (TargetAge > UpperPhaseChangePoint)
-                {
-                    GenerateDeathStarPlaceholder(Lifetime);
-                }
-
-                Result = InterpolateStarData(StarData, EvolutionProgress);
-                Result.push_back(Lifetime);
-                ExpandMistData(TargetMass, Result);
-            }
+            FMistData* LowerData = _MistRegistry->MistTracks.at(Files.first);
+            FMistData* UpperData = _MistRegistry->MistTracks.at(Files.second);
+            Result = InterpolateMistTracks(LowerData, UpperData, TargetAge, TargetMass, LowerMass, MassCoefficient);
         }
     }
     else
     {
         if (Files.first != Files.second) [[likely]]
         {
-            FWdMistData* LowerData = LoadCsvAsset<FWdMistData>(Files.first,  _kWdMistHeaders);
-            FWdMistData* UpperData = LoadCsvAsset<FWdMistData>(Files.second, _kWdMistHeaders);
+            FWdMistData* LowerData = _MistRegistry->WdMistTracks.at(Files.first);
+            FWdMistData* UpperData = _MistRegistry->WdMistTracks.at(Files.second);
 
             FDataArray LowerRows = InterpolateStarData(LowerData, TargetAge);
             FDataArray UpperRows = InterpolateStarData(UpperData, TargetAge);
@@ -990,7 +1251,7 @@ FStellarGenerator::InterpolateMistData(const std::pair<std::string, std::string>
         }
         else [[unlikely]]
         {
-            FWdMistData* StarData = LoadCsvAsset<FWdMistData>(Files.first, _kWdMistHeaders);
+            FWdMistData* StarData = _MistRegistry->WdMistTracks.at(Files.first);
             Result = InterpolateStarData(StarData, TargetAge);
         }
     }
@@ -998,43 +1259,115 @@ FStellarGenerator::InterpolateMistData(const std::pair<std::string, std::string>
     return Result;
 }
 
-std::vector<FStellarGenerator::FDataArray> FStellarGenerator::FindPhaseChanges(const FMistData* DataSheet)
+FStellarGenerator::FDataArray
+FStellarGenerator::InterpolateMistTracks(auto* LowerData, auto* UpperData, double TargetAge, double TargetMass,
+                                         double LowerMass, double MassCoefficient)
 {
-    std::vector<FDataArray> Result;
+    FDataArray Result;
+
+    if (LowerData != UpperData) [[likely]]
     {
-        std::shared_lock Lock(_kCacheMutex);
-        if (_kPhaseChangesCache.contains(DataSheet))
+        auto LowerPhaseChanges = FindPhaseChanges(LowerData);
+        auto UpperPhaseChanges = FindPhaseChanges(UpperData);
+
+        if (std::isnan(TargetAge)) // 年龄为 NaN 在这里代表要生成濒死恒星
         {
-            return _kPhaseChangesCache[DataSheet];
+            double LowerLifetime = LowerPhaseChanges.back()[_kStarAgeIndex];
+            double UpperLifetime = UpperPhaseChanges.back()[_kStarAgeIndex];
+            double Lifetime = LowerLifetime + (UpperLifetime - LowerLifetime) * MassCoefficient;
+            TargetAge = Lifetime - 500000;
         }
-    }
 
-    const auto* const CsvData = DataSheet->Data();
-    int CurrentPhase = -2;
-    for (const auto& Row : *CsvData)
+        std::pair<std::vector<FDataArray>, std::vector<FDataArray>> PhaseChangePair
+        {
+            LowerPhaseChanges,
+            UpperPhaseChanges
+        };
+
+        double EvolutionProgress = CalculateEvolutionProgress(PhaseChangePair, TargetAge, MassCoefficient);
+
+        double LowerLifetime = PhaseChangePair.first.back()[_kStarAgeIndex];
+        double UpperLifetime = PhaseChangePair.second.back()[_kStarAgeIndex];
+
+        FDataArray LowerRows = InterpolateStarData(LowerData, EvolutionProgress);
+        FDataArray UpperRows = InterpolateStarData(UpperData, EvolutionProgress);
+
+        LowerRows.push_back(LowerLifetime);
+        UpperRows.push_back(UpperLifetime);
+
+        Result = InterpolateFinalData(std::make_pair(LowerRows, UpperRows), MassCoefficient, false);
+    }
+    else [[unlikely]]
     {
-        if (Row[_kPhaseIndex] != CurrentPhase || Row[_kXIndex] == 10.0)
+        auto PhaseChanges = FindPhaseChanges(LowerData);
+
+        if (std::isnan(TargetAge))
         {
-            CurrentPhase = static_cast<int>(Row[_kPhaseIndex]);
-            Result.push_back(Row);
+            double Lifetime = PhaseChanges.back()[_kStarAgeIndex];
+            TargetAge = Lifetime - 500000;
         }
-    }
 
-    {
-        std::unique_lock Lock(_kCacheMutex);
-        if (!_kPhaseChangesCache.contains(DataSheet))
+        double EvolutionProgress = 0.0;
+        double Lifetime = 0.0;
+        if (TargetMass >= LowerMass)
         {
-            _kPhaseChangesCache.emplace(DataSheet, Result);
+            std::pair<std::vector<FDataArray>, std::vector<FDataArray>> PhaseChangePair{ PhaseChanges, {} };
+            EvolutionProgress = CalculateEvolutionProgress(PhaseChangePair, TargetAge, MassCoefficient);
+            Lifetime          = PhaseChanges.back()[_kStarAgeIndex];
+            Result            = InterpolateStarData(LowerData, EvolutionProgress);
+            Result.push_back(Lifetime);
         }
         else
         {
-            Result = _kPhaseChangesCache[DataSheet];
+            // 外推小质量恒星的数据，寿命与 CalculateLifetime 一样取最小质量轨道的最后一个相变点
+            double LowerPhaseChangePoint = ExtrapolateLowMassAge(PhaseChanges[1][_kStarAgeIndex], LowerMass, TargetMass);
+            double UpperPhaseChangePoint = ExtrapolateLowMassAge(PhaseChanges.back()[_kStarAgeIndex], LowerMass, TargetMass);
+            Lifetime = UpperPhaseChangePoint;
+            if (TargetAge < LowerPhaseChangePoint)
+            {
+                EvolutionProgress = TargetAge / LowerPhaseChangePoint - 1;
+            }
+            else if (LowerPhaseChangePoint <= TargetAge && TargetAge <= UpperPhaseChangePoint)
+            {
+                EvolutionProgress = (TargetAge - LowerPhaseChangePoint) / (UpperPhaseChangePoint - LowerPhaseChangePoint);
+            }
+            else if (TargetAge > UpperPhaseChangePoint)
+            {
+                GenerateDeathStarPlaceholder(Lifetime);
+            }
+
+            Result = InterpolateStarData(LowerData, EvolutionProgress);
+            Result.push_back(Lifetime);
+            ExpandMistData(TargetMass, Result);
         }
     }
 
     return Result;
 }
 
+const std::vector<FStellarGenerator::FDataArray>& FStellarGenerator::FindPhaseChanges(const void* DataSheet) const
+{
+    return _MistRegistry->PhaseChanges.at(DataSheet);
+}
+
+void FStellarGenerator::CachePhaseChanges(FMistRegistry& Registry, const auto* DataSheet)
+{
+    std::vector<FDataArray> Result;
+
+    int CurrentPhase = -2;
+    for (std::size_t i = 0; i != GetRowCount(DataSheet); ++i)
+    {
+        double Phase = GetValue(DataSheet, i, _kPhaseIndex);
+        if (Phase != CurrentPhase || GetValue(DataSheet, i, _kXIndex) == 10.0)
+        {
+            CurrentPhase = static_cast<int>(Phase);
+            Result.push_back(GetRow(DataSheet, i));
+        }
+    }
+
+    Registry.PhaseChanges.emplace(DataSheet, std::move(Result));
+}
+
 double FStellarGenerator::CalculateEvolutionProgress(std::pair<std::vector<FDataArray>, std::vector<FDataArray>>& PhaseChanges,
                                                      double TargetAge, double MassCoefficient)
 {
@@ -1313,6 +1646,12 @@ FStellarGenerator::FDataArray FStellarGenerator::InterpolateStarData(FStellarGen
     return InterpolateStarData(Data, TargetAge, "star_age", FStellarGenerator::_kWdStarAgeIndex, true);
 }
 
+FStellarGenerator::FDataArray
+FStellarGenerator::InterpolateStarData(const FStellarGenerator::FCompactMistData* Data, double EvolutionProgress)
+{
+    return InterpolateStarData(Data, EvolutionProgress, "x", FStellarGenerator::_kXIndex, false);
+}
+
 FStellarGenerator::FDataArray
 FStellarGenerator::InterpolateStarData(auto* Data, double Target, const std::string& Header, int Index, bool bIsWhiteDwarf)
 {
@@ -1332,8 +1671,8 @@ FStellarGenerator::InterpolateStarData(auto* Data, double Target, const std::str
         }
         else
         {
-            SurroundingRows.first  = Data->Data()->back();
-            SurroundingRows.second = Data->Data()->back();
+            SurroundingRows.first  = GetRow(Data, GetRowCount(Data) - 1);
+            SurroundingRows.second = SurroundingRows.first;
         }
     }
 
@@ -1399,6 +1738,8 @@ FStellarGenerator::InterpolateFinalData(const std::pair<FDataArray, FDataArray>&
 
 void FStellarGenerator::CalculateSpectralType(float FeH, Astro::AStar& StarData)
 {
+    NpgsProfileStage(EGenerationStage::kCalculateSpectralType);
+
     float Teff = StarData.GetTeff();
     auto EvolutionPhase = StarData.GetEvolutionPhase();
 
@@ -1668,9 +2009,7 @@ Astro::FStellarClass::ELuminosityClass FStellarGenerator::CalculateLuminosityCla
         return LuminosityClass;
     }
 
-    std::string HrDiagramDataFilePath =
-        Runtime::Asset::GetAssetFullPath(Runtime::Asset::EAssetType::kDataTable, "StellarParameters/H-R Diagram/H-R Diagram.csv");
-    FHrDiagram* HrDiagramData = LoadCsvAsset<FHrDiagram>(HrDiagramDataFilePath, _kHrDiagramHeaders);
+    FHrDiagram* HrDiagramData = _MistRegistry->HrDiagram;
 
     float Teff = StarData.GetTeff();
     float BvColorIndex = 0.0f;
@@ -1771,6 +2110,8 @@ Astro::FStellarClass::ELuminosityClass FStellarGenerator::CalculateLuminosityCla
 
 void FStellarGenerator::ProcessDeathStar(EStellarTypeGenerationOption DeathStarTypeOption, Astro::AStar& DeathStar)
 {
+    NpgsProfileStage(EGenerationStage::kProcessDeathStar);
+
     double InputAge     = DeathStar.GetAge();
     float  InputFeH     = DeathStar.GetFeH();
     float  InputMassSol = DeathStar.GetInitialMass();
@@ -2180,6 +2521,8 @@ void FStellarGenerator::ProcessDeathStar(EStellarTypeGenerationOption DeathStarT
 
 void FStellarGenerator::GenerateMagnetic(Astro::AStar& StarData)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateMagnetic);
+
     Util::TDistribution<>* MagneticGenerator = nullptr;
 
     Astro::FStellarClass::EStellarType StellarType = StarData.GetStellarClass().GetStellarType();
@@ -2268,6 +2611,8 @@ void FStellarGenerator::GenerateMagnetic(Astro::AStar& StarData)
 
 void FStellarGenerator::GenerateSpin(Astro::AStar& StarData)
 {
+    NpgsProfileStage(EGenerationStage::kGenerateSpin);
+
     Astro::FStellarClass::EStellarType StellarType = StarData.GetStellarClass().GetStellarType();
     float StarAge   = static_cast<float>(StarData.GetAge());
     float MassSol   = static_cast<float>(StarData.GetMass() / kSolarMass);
@@ -2397,10 +2742,29 @@ const std::vector<std::string> FStellarGenerator::_kWdMistHeaders
 };
 
 const std::vector<std::string> FStellarGenerator::_kHrDiagramHeaders{ "B-V", "Ia", "Ib", "II", "III", "IV", "V" };
-std::unordered_map<std::string, std::vector<float>> FStellarGenerator::_kMassFilesCache;
-std::unordered_map<const FStellarGenerator::FMistData*, std::vector<FStellarGenerator::FDataArray>> FStellarGenerator::_kPhaseChangesCache;
-std::shared_mutex FStellarGenerator::_kCacheMutex;
-bool FStellarGenerator::_kbMistDataInitiated = false;
+const std::vector<FStellarGenerator::FCompactMistData::FColumnTolerance> FStellarGenerator::_kCompactMistTolerances
+{
+    { 1.0,  0.0  }, // star_age
+    { 1e-5, 0.0  }, // star_mass
+    { 0.0,  1e-6 }, // star_mdot
+    { 1e-4, 0.0  }, // log_Teff
+    { 1e-4, 0.0  }, // log_R
+    { 1e-4, 0.0  }, // log_surf_z
+    { 1e-5, 0.0  }, // surface_h1
+    { 0.0,  1e-4 }, // surface_he3
+    { 1e-4, 0.0  }, // log_center_T
+    { 1e-4, 0.0  }, // log_center_Rho
+    { 0.0,  0.0  }, // phase
+    { 0.0,  0.0  }  // x，需与 10.0 等精确比较
+};
+
+std::atomic<const FStellarGenerator::FMistRegistry*> FStellarGenerator::_kMistRegistry{ nullptr };
+std::unique_ptr<const FStellarGenerator::FMistRegistry> FStellarGenerator::_kMistRegistryOwner;
+std::once_flag FStellarGenerator::_kMistRegistryOnce;
+std::mutex FStellarGenerator::_kMistConfigMutex;
+FStellarGenerator::FMistConfig FStellarGenerator::_kPendingMistConfig;
+std::unique_ptr<const FStellarGenerator::FMistRegistry> FStellarGenerator::_kAlternateMistRegistryOwner;
+std::once_flag FStellarGenerator::_kAlternateMistRegistryOnce;
 
 _GENERATOR_END
 _SYSTEM_END
@@ -2,11 +2,13 @@
 
 #include <cstddef>
 #include <array>
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <random>
-#include <shared_mutex>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -16,6 +18,8 @@
 
 #include "Engine/Core/Base/Base.h"
 #include "Engine/Core/Runtime/AssetLoaders/CommaSeparatedValues.hpp"
+#include "Engine/Core/Runtime/AssetLoaders/CompactTable.h"
+#include "Engine/Core/Runtime/AssetLoaders/SharedMemory.h"
 #include "Engine/Core/Types/Entries/Astro/Star.h"
 #include "Engine/Core/Types/Properties/StellarClass.h"
 #include "Engine/Utils/Random.hpp"
@@ -32,6 +36,8 @@ public:
     using FHrDiagram  = Runtime::Asset::TCommaSeparatedValues<double, 7>;
     using FDataArray  = std::vector<double>;
 
+    using FCompactMistData = Runtime::Asset::FCompactTable;
+
     enum class EGenerationDistribution
     {
         kFromPdf,
@@ -54,6 +60,18 @@ public:
         kBinarySecondStar
     };
 
+    enum class EGenerationStage : std::size_t // 分段计时使用的阶段编号，见 Util::FStageProfiler
+    {
+        kGenerateBasicProperties,
+        kGetFullMistData,
+        kInterpolateMistData,
+        kCalculateSpectralType,
+        kGenerateMagnetic,
+        kGenerateSpin,
+        kProcessDeathStar,
+        kCount
+    };
+
     struct FBasicProperties
     {
         // 用于保存生成选项，类的生成选项仅影响该属性。生成的恒星完整信息也将根据该属性决定。该选项用于防止多线程生成恒星时属性和生成器胡乱匹配
@@ -100,6 +118,13 @@ public:
         std::array<glm::vec2, 2> MassMaxPdfs{ glm::vec2(), glm::vec2() };
     };
 
+    struct FCompactMistReport
+    {
+        std::size_t            OriginalBytes{};   // CSV 表按 vector<vector<double>> 驻留时的估算内存
+        std::size_t            CompactBytes{};
+        std::array<double, 12> MaxColumnErrors{}; // 各列沿 x 线性插值的实测最大绝对误差，顺序与 MIST 表头一致
+    };
+
 public:
     FStellarGenerator() = delete;
     FStellarGenerator(const FGenerationInfo& GenerationInfo);
@@ -116,6 +141,9 @@ public:
     Astro::AStar GenerateStar();
     Astro::AStar GenerateStar(FBasicProperties& Properties);
 
+    // 根据寿命表估算主序寿命和总寿命，单位 yr，超出 MIST 质量范围时返回 NaN
+    std::pair<double, double> CalculateLifetime(float FeH, float InitialMassSol) const;
+
     FStellarGenerator& SetLogMassSuggestDistribution(std::unique_ptr<Util::TDistribution<>>&& Distribution);
     FStellarGenerator& SetUniverseAge(float Age);
     FStellarGenerator& SetAgeLowerLimit(float Limit);
@@ -135,18 +163,37 @@ public:
     FStellarGenerator& SetMassDistribution(EGenerationDistribution Distribution);
     FStellarGenerator& SetStellarTypeGenerationOption(EStellarTypeGenerationOption Option);
 
+    // 以紧凑格式驻留 MIST 演化轨迹，须在构造第一个生成器前调用
+    // SharedMemoryName 非空时，同名共享内存已存在则直接映射使用，否则创建并发布给其他进程
+    static void EnableCompactMistData(const std::string& SharedMemoryName = {});
+    static const FCompactMistReport& GetCompactMistReport();
+
+    // 改用与全局注册表驻留方式相反的私有 MIST 数据（完整与紧凑互换），首次调用时构建，用于对比两种数据生成的恒星
+    FStellarGenerator& UseAlternateMistData();
+
 private:
+    struct FMistConfig;
+    struct FMistRegistry;
+
     template <typename CsvType>
     requires std::is_class_v<CsvType>
-    CsvType* LoadCsvAsset(const std::string& Filename, const std::vector<std::string>& Headers);
+    static CsvType* LoadCsvAsset(const std::string& Filename, const std::vector<std::string>& Headers);
+
+    static std::unique_ptr<FMistRegistry> BuildMistRegistry(const FMistConfig& Config);
+    static void InitializeCompactMistData(FMistRegistry& Registry, std::vector<std::string>& Filenames);
+    static void InitializeLifetimeTable(FMistRegistry& Registry, std::size_t FeHIndex, const std::string& PrefixDirectory);
+    static void CachePhaseChanges(FMistRegistry& Registry, const auto* DataSheet);
 
     void InitializeMistData();
     void InitializePdfs();
     float GenerateAge(float MaxPdf);
     float GenerateMass(float MaxPdf, auto& LogMassPdf);
     FDataArray GetFullMistData(const FBasicProperties& Properties, bool bIsWhiteDwarf, bool bIsSingleWhiteDwarf);
-    FDataArray InterpolateMistData(const std::pair<std::string, std::string>& Files, double TargetAge, double TargetMass, double MassCoefficient);
-    std::vector<FDataArray> FindPhaseChanges(const FMistData* DataSheet);
+    FDataArray InterpolateMistData(const std::pair<std::string, std::string>& Files, double TargetAge, double TargetMass,
+                                   double LowerMass, double MassCoefficient);
+    FDataArray InterpolateMistTracks(auto* LowerData, auto* UpperData, double TargetAge, double TargetMass,
+                                     double LowerMass, double MassCoefficient);
+    const std::vector<FDataArray>& FindPhaseChanges(const void* DataSheet) const;
 
     double CalculateEvolutionProgress(std::pair<std::vector<FDataArray>, std::vector<FDataArray>>& PhaseChanges,
                                       double TargetAge, double MassCoefficient);
@@ -161,6 +208,7 @@ private:
     FDataArray InterpolateHrDiagram(FHrDiagram* Data, double BvColorIndex);
     FDataArray InterpolateStarData(FMistData* Data, double EvolutionProgress);
     FDataArray InterpolateStarData(FWdMistData* Data, double TargetAge);
+    FDataArray InterpolateStarData(const FCompactMistData* Data, double EvolutionProgress);
     FDataArray InterpolateStarData(auto* Data, double Target, const std::string& Header, int Index, bool bIsWhiteDwarf);
     FDataArray InterpolateArray(const std::pair<FDataArray, FDataArray>& DataArrays, double Coefficient);
     FDataArray InterpolateFinalData(const std::pair<FDataArray, FDataArray>& DataArrays, double Coefficient, bool bIsWhiteDwarf);
@@ -193,6 +241,36 @@ public:
     static const int _kWdLogCenterTIndex;
     static const int _kWdLogCenterRhoIndex;
 
+private:
+    struct FLifetimeTable // 某一金属丰度下寿命随初始质量变化的表，质量升序排列
+    {
+        std::vector<float>  InitialMassesSol;
+        std::vector<double> MainSequenceLifetimes;
+        std::vector<double> Lifetimes;
+    };
+
+    // MIST 数据的驻留方式，构建注册表时复制进去，之后只通过已发布的注册表读取
+    struct FMistConfig
+    {
+        std::string SharedMemoryName;
+        bool        bCompactData{ false };
+    };
+
+    // 初始化完成后只读的 MIST 数据注册表，由第一个生成器构建并通过原子指针发布，之后所有读取无需加锁
+    struct FMistRegistry
+    {
+        FMistConfig                                              Config;
+        std::unordered_map<std::string, std::vector<float>>      MassFiles;
+        std::unordered_map<std::string, FMistData*>              MistTracks;
+        std::unordered_map<std::string, FWdMistData*>            WdMistTracks;
+        std::unordered_map<std::string, FCompactMistData>        CompactMistTracks;
+        std::unordered_map<const void*, std::vector<FDataArray>> PhaseChanges;
+        std::array<FLifetimeTable, 8>                            LifetimeTables;
+        FHrDiagram*                                              HrDiagram{ nullptr };
+        FCompactMistReport                                       CompactMistReport;
+        std::unique_ptr<Runtime::Asset::FSharedMemory>           SharedMemory;
+    };
+
 private:
     std::mt19937                                          _RandomEngine;
     std::array<Util::TUniformRealDistribution<>,       8> _MagneticGenerators;
@@ -223,13 +301,19 @@ private:
     EStellarTypeGenerationOption  _StellarTypeOption;
     EMultiplicityGenerationOption _MultiplicityOption;
 
-    static const std::vector<std::string>                                _kMistHeaders;
-    static const std::vector<std::string>                                _kWdMistHeaders;
-    static const std::vector<std::string>                                _kHrDiagramHeaders;
-    static std::unordered_map<std::string, std::vector<float>>           _kMassFilesCache;
-    static std::unordered_map<const FMistData*, std::vector<FDataArray>> _kPhaseChangesCache;
-    static std::shared_mutex                                             _kCacheMutex;
-    static bool                                                          _kbMistDataInitiated;
+    const FMistRegistry* _MistRegistry;
+
+    static const std::vector<std::string>                        _kMistHeaders;
+    static const std::vector<std::string>                        _kWdMistHeaders;
+    static const std::vector<std::string>                        _kHrDiagramHeaders;
+    static const std::vector<FCompactMistData::FColumnTolerance> _kCompactMistTolerances;
+    static std::atomic<const FMistRegistry*>                     _kMistRegistry;
+    static std::unique_ptr<const FMistRegistry>                  _kMistRegistryOwner;
+    static std::once_flag                                        _kMistRegistryOnce;
+    static std::mutex                                            _kMistConfigMutex; // 保护 _kPendingMistConfig 和 FAssetManager 中的 MIST 资产，构建任一注册表期间一直持有
+    static FMistConfig                                           _kPendingMistConfig;
+    static std::unique_ptr<const FMistRegistry>                  _kAlternateMistRegistryOwner;
+    static std::once_flag                                        _kAlternateMistRegistryOnce;
 };
 
 _GENERATOR_END
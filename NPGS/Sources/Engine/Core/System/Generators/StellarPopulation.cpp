@@ -0,0 +1,138 @@
+#include "StellarPopulation.h"
+
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <print>
+#include <utility>
+
+#include "Engine/Core/Math/NumericConstants.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_GENERATOR_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    // 落在范围外或为 NaN 时返回 BinCount
+    std::size_t CalculateBinIndex(double Value, float Lower, float Step, std::size_t BinCount)
+    {
+        if (!(Value >= Lower))
+        {
+            return BinCount;
+        }
+
+        auto Index = static_cast<std::size_t>((Value - Lower) / Step);
+        return Index < BinCount ? Index : BinCount;
+    }
+}
+
+// FStellarCensus implementations
+// ------------------------------
+void FStellarCensus::operator()(const Astro::AStar& Star)
+{
+    ++TotalStars;
+
+    std::size_t MassBin = CalculateBinIndex(std::log10(Star.GetInitialMass() / kSolarMass), kLogMassLower, kLogMassStep, kMassBinCount);
+    if (MassBin != kMassBinCount)
+    {
+        ++InitialMassFunction[MassBin];
+    }
+
+    const auto& Class = Star.GetStellarClass();
+    switch (Class.GetStellarType())
+    {
+    case Astro::FStellarClass::EStellarType::kWhiteDwarf:
+        ++WhiteDwarfs;
+        return;
+    case Astro::FStellarClass::EStellarType::kNeutronStar:
+        ++NeutronStars;
+        return;
+    case Astro::FStellarClass::EStellarType::kBlackHole:
+        ++BlackHoles;
+        return;
+    case Astro::FStellarClass::EStellarType::kNormalStar:
+        break;
+    default:
+        return;
+    }
+
+    auto SpectralClass = Class.Data().HSpectralClass;
+    if (SpectralClass >= Astro::FStellarClass::ESpectralClass::kSpectral_WC &&
+        SpectralClass <= Astro::FStellarClass::ESpectralClass::kSpectral_WO)
+    {
+        ++WolfRayet;
+    }
+    else if (SpectralClass >= Astro::FStellarClass::ESpectralClass::kSpectral_O &&
+             SpectralClass <= Astro::FStellarClass::ESpectralClass::kSpectral_M)
+    {
+        ++SpectralClasses[std::to_underlying(SpectralClass) - std::to_underlying(Astro::FStellarClass::ESpectralClass::kSpectral_O)];
+    }
+
+    std::size_t TeffBin = CalculateBinIndex(std::log10(Star.GetTeff()), kLogTeffLower, kLogTeffStep, kTeffBinCount);
+    std::size_t LumBin  = CalculateBinIndex(std::log10(Star.GetLuminosity() / kSolarLuminosity), kLogLumLower, kLogLumStep, kLumBinCount);
+    if (TeffBin != kTeffBinCount && LumBin != kLumBinCount)
+    {
+        ++HrDiagram[LumBin * kTeffBinCount + (kTeffBinCount - 1 - TeffBin)];
+    }
+}
+
+void FStellarCensus::Merge(const FStellarCensus& Other)
+{
+    auto MergeArray = [](auto& Lhs, const auto& Rhs) -> void
+    {
+        std::transform(Lhs.begin(), Lhs.end(), Rhs.begin(), Lhs.begin(), std::plus<>());
+    };
+
+    MergeArray(InitialMassFunction, Other.InitialMassFunction);
+    MergeArray(SpectralClasses,     Other.SpectralClasses);
+    MergeArray(HrDiagram,           Other.HrDiagram);
+
+    TotalStars   += Other.TotalStars;
+    WolfRayet    += Other.WolfRayet;
+    WhiteDwarfs  += Other.WhiteDwarfs;
+    NeutronStars += Other.NeutronStars;
+    BlackHoles   += Other.BlackHoles;
+}
+
+void FStellarCensus::Print() const
+{
+    auto Fraction = [this](std::size_t Count) -> double
+    {
+        return TotalStars == 0 ? 0.0 : 100.0 * static_cast<double>(Count) / static_cast<double>(TotalStars);
+    };
+
+    std::println("Stellar census results:");
+    std::println("Total: {}", TotalStars);
+    std::println("");
+
+    const char* kClassNames[] = { "O", "B", "A", "F", "G", "K", "M" };
+    for (std::size_t i = 0; i != SpectralClasses.size(); ++i)
+    {
+        std::println("{}: {:>12} ({:8.4f}%)", kClassNames[i], SpectralClasses[i], Fraction(SpectralClasses[i]));
+    }
+
+    std::println("");
+    std::println("Wolf-Rayet:    {:>12} ({:8.4f}%)", WolfRayet,    Fraction(WolfRayet));
+    std::println("White dwarfs:  {:>12} ({:8.4f}%)", WhiteDwarfs,  Fraction(WhiteDwarfs));
+    std::println("Neutron stars: {:>12} ({:8.4f}%)", NeutronStars, Fraction(NeutronStars));
+    std::println("Black holes:   {:>12} ({:8.4f}%)", BlackHoles,   Fraction(BlackHoles));
+    std::println("");
+
+    std::println("Initial mass function (log10 M, count):");
+    for (std::size_t i = 0; i != InitialMassFunction.size(); ++i)
+    {
+        if (InitialMassFunction[i] != 0)
+        {
+            std::println("{:6.2f} {:>12}", kLogMassLower + (i + 0.5f) * kLogMassStep, InitialMassFunction[i]);
+        }
+    }
+
+    std::println("");
+}
+
+_GENERATOR_END
+_SYSTEM_END
+_NPGS_END
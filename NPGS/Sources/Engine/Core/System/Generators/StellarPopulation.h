@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <concepts>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/System/Generators/StellarGenerator.h"
+#include "Engine/Core/Types/Entries/Astro/Star.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_GENERATOR_BEGIN
+
+// 流式恒星族群统计，生成的恒星直接送入归约器后丢弃，内存占用与恒星数量无关
+// 归约器需要可复制（每个线程一份），提供 operator()(const Astro::AStar&) 和 Merge(const ReducerType&)
+template <typename ReducerType>
+concept CStellarReducer = std::copy_constructible<ReducerType> &&
+requires(ReducerType Reducer, const ReducerType& Other, const Astro::AStar& Star)
+{
+    Reducer(Star);
+    Reducer.Merge(Other);
+};
+
+// 每个生成器占用一个线程，共生成 StarCount 颗恒星。Reducer 作为空白初始状态复制到各线程，结束后按线程序号顺序合并
+template <CStellarReducer ReducerType>
+ReducerType StreamStellarPopulation(std::vector<FStellarGenerator>& Generators, std::size_t StarCount, const ReducerType& Reducer);
+
+// 内置的族群统计，覆盖初始质量函数、光谱型比例、赫罗图密度和致密星计数
+// 流中的恒星都按单星生成，没有经过 FUniverse 的双星配对，因此不统计单星和双星数量
+struct FStellarCensus
+{
+    static constexpr std::size_t kMassBinCount = 74;   // log10(M/Msun)，-1.2 到 2.5，步长 0.05 dex
+    static constexpr float       kLogMassLower = -1.2f;
+    static constexpr float       kLogMassStep  = 0.05f;
+
+    static constexpr std::size_t kTeffBinCount = 50;   // log10(Teff)，3.0 到 5.5，步长 0.05 dex
+    static constexpr float       kLogTeffLower = 3.0f;
+    static constexpr float       kLogTeffStep  = 0.05f;
+
+    static constexpr std::size_t kLumBinCount  = 60;   // log10(L/Lsun)，-5.0 到 7.0，步长 0.2 dex
+    static constexpr float       kLogLumLower  = -5.0f;
+    static constexpr float       kLogLumStep   = 0.2f;
+
+    std::array<std::size_t, kMassBinCount>                InitialMassFunction{};
+    std::array<std::size_t, 7>                            SpectralClasses{}; // O B A F G K M
+    std::array<std::size_t, kTeffBinCount * kLumBinCount> HrDiagram{};       // 行为光度，列为温度，温度从高到低
+
+    std::size_t TotalStars{};
+    std::size_t WolfRayet{};
+    std::size_t WhiteDwarfs{};
+    std::size_t NeutronStars{};
+    std::size_t BlackHoles{};
+
+    void operator()(const Astro::AStar& Star);
+    void Merge(const FStellarCensus& Other);
+    void Print() const;
+};
+
+_GENERATOR_END
+_SYSTEM_END
+_NPGS_END
+
+#include "StellarPopulation.inl"
@@ -0,0 +1,50 @@
+#include "StellarPopulation.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_GENERATOR_BEGIN
+
+template <CStellarReducer ReducerType>
+ReducerType StreamStellarPopulation(std::vector<FStellarGenerator>& Generators, std::size_t StarCount, const ReducerType& Reducer)
+{
+    auto* ThreadPool = Runtime::Thread::FThreadPool::GetInstance();
+
+    std::size_t ThreadCount = Generators.size();
+    if (ThreadCount == 0)
+    {
+        return Reducer;
+    }
+
+    std::vector<std::future<ReducerType>> Futures;
+    Futures.reserve(ThreadCount);
+
+    for (std::size_t i = 0; i != ThreadCount; ++i)
+    {
+        // 余数分给前几个线程，保证总数精确
+        std::size_t ChunkSize = StarCount / ThreadCount + (i < StarCount % ThreadCount ? 1 : 0);
+        Futures.push_back(ThreadPool->Submit([&Generators, &Reducer, ChunkSize, i]() -> ReducerType
+        {
+            ReducerType LocalReducer(Reducer);
+            auto& Generator = Generators[i];
+            for (std::size_t j = 0; j != ChunkSize; ++j)
+            {
+                auto Properties = Generator.GenerateBasicProperties();
+                LocalReducer(Generator.GenerateStar(Properties));
+            }
+
+            return LocalReducer;
+        }));
+    }
+
+    ReducerType Result(Reducer);
+    for (auto& Future : Futures)
+    {
+        Result.Merge(Future.get());
+    }
+
+    return Result;
+}
+
+_GENERATOR_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,271 @@
+#include "ProbeExpansion.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SIMULATION_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::size_t kMinArrivalsPerChunk = 64; // 抵达事件太少时不值得分发到线程池
+
+    std::size_t ResolveChunkCount(int ThreadCount)
+    {
+        if (ThreadCount <= 0)
+        {
+            ThreadCount = Runtime::Thread::FThreadPool::GetInstance()->GetMaxThreadCount();
+        }
+
+        return static_cast<std::size_t>(std::max(ThreadCount, 1));
+    }
+}
+
+// FProbeExpansionSimulator implementations
+// ----------------------------------------
+FProbeExpansionSimulator::FProbeExpansionSimulator(const Spatial::FNeighbourGraph& Graph, const FSimulationInfo& SimulationInfo,
+                                                   FTraitsEvaluator Evaluator)
+    :
+    _Graph(&Graph),
+    _SimulationInfo(SimulationInfo),
+    _Evaluator(std::move(Evaluator)),
+    _ArrivalTimes(Graph.GetSystemCount(), std::numeric_limits<double>::infinity()),
+    _Parents(Graph.GetSystemCount(), kInvalidIndex),
+    _States(Graph.GetSystemCount(), ESystemState::kUnreached),
+    _ChunkCount(ResolveChunkCount(SimulationInfo.ThreadCount))
+{
+    if (SimulationInfo.HomeSystem >= Graph.GetSystemCount())
+    {
+        throw std::out_of_range("Home system is not in the neighbour graph.");
+    }
+
+    if (!(SimulationInfo.ProbeSpeed > 0.0f) || !(SimulationInfo.MinReplicationTime >= 0.0f))
+    {
+        throw std::invalid_argument("Probe speed must be positive and replication time must be non-negative.");
+    }
+
+    if (!_Evaluator)
+    {
+        throw std::invalid_argument("Traits evaluator is empty.");
+    }
+
+    // 抵达到发射至少间隔 MinReplicationTime，一个窗口内的发射事件在窗口开始时就已全部确定
+    _WindowLength = SimulationInfo.MinReplicationTime;
+    _ChunkOutputs.resize(_ChunkCount);
+
+    _ArrivalTimes[SimulationInfo.HomeSystem] = 0.0;
+    _States[SimulationInfo.HomeSystem]       = ESystemState::kTargeted;
+    _Queue.Push({ 0.0, SimulationInfo.HomeSystem, EEventType::kArrival, 0 });
+}
+
+bool FProbeExpansionSimulator::Advance(double EndTime)
+{
+    while (!_Queue.Empty() && _Queue.Top().Time <= EndTime)
+    {
+        // 窗口长度为 0 时只取时间相同的事件
+        double WindowBegin = _Queue.Top().Time;
+        double WindowEnd   = WindowBegin + _WindowLength;
+
+        _Arrivals.clear();
+        _Launches.clear();
+        PopWindowEvents(WindowBegin, WindowEnd, EndTime);
+
+        // 先处理发射，窗口内新派出的探测器也可能在窗口内抵达，一并取出；之后窗口内所有抵达事件的有效性都已确定
+        ProcessLaunches();
+        PopWindowEvents(WindowBegin, WindowEnd, EndTime);
+        ProcessArrivals();
+
+        _Statistics.ProcessedEventCount += _Arrivals.size() + _Launches.size();
+        ++_Statistics.WindowCount;
+    }
+
+    return !_Queue.Empty();
+}
+
+void FProbeExpansionSimulator::PopWindowEvents(double WindowBegin, double WindowEnd, double EndTime)
+{
+    while (!_Queue.Empty())
+    {
+        const FEvent& Event = _Queue.Top();
+        if (Event.Time > EndTime || (Event.Time >= WindowEnd && Event.Time != WindowBegin))
+        {
+            break;
+        }
+
+        FEvent Popped = _Queue.Pop();
+        (Popped.Type == EEventType::kArrival ? _Arrivals : _Launches).push_back(Popped);
+        _Statistics.LastEventTime = std::max(_Statistics.LastEventTime, Popped.Time);
+    }
+}
+
+void FProbeExpansionSimulator::ProcessArrivals()
+{
+    if (_Arrivals.empty())
+    {
+        return;
+    }
+
+    std::size_t ChunkCount = std::min(_ChunkCount, _Arrivals.size() / kMinArrivalsPerChunk + 1);
+
+    // 每个系统至多有一个有效的抵达事件，各分块只写自己负责的系统；抵达引发的发射都在窗口之后
+    Runtime::Thread::ParallelFor(_Arrivals.size(), ChunkCount,
+                                 [&](std::size_t Begin, std::size_t End, std::size_t Chunk) -> void
+    {
+        FChunkOutput& Output = _ChunkOutputs[Chunk];
+        Output.Launches.clear();
+        Output.Statistics = FStatistics();
+
+        for (std::size_t i = Begin; i != End; ++i)
+        {
+            const FEvent& Event = _Arrivals[i];
+
+            // 之后又有更早的探测器被派往该系统，这个探测器抵达时系统已被占据
+            if (Event.Time != _ArrivalTimes[Event.System])
+            {
+                ++Output.Statistics.SupersededProbeCount;
+                continue;
+            }
+
+            FSystemTraits Traits = _Evaluator(Event.System);
+            if (Traits.ProbeCount == 0)
+            {
+                _States[Event.System] = ESystemState::kBarren;
+                ++Output.Statistics.BarrenCount;
+                continue;
+            }
+
+            _States[Event.System] = ESystemState::kColonized;
+            ++Output.Statistics.ColonizedCount;
+
+            double ReplicationTime = std::max(Traits.ReplicationTime, _SimulationInfo.MinReplicationTime);
+            auto   ProbeCount      = static_cast<std::uint16_t>(
+                std::min(Traits.ProbeCount, static_cast<std::uint32_t>(std::numeric_limits<std::uint16_t>::max())));
+
+            Output.Launches.push_back({ Event.Time + ReplicationTime, Event.System, EEventType::kLaunch, ProbeCount });
+        }
+    });
+
+    for (std::size_t Chunk = 0; Chunk != ChunkCount; ++Chunk)
+    {
+        const FChunkOutput& Output = _ChunkOutputs[Chunk];
+        for (const FEvent& Launch : Output.Launches)
+        {
+            _Queue.Push(Launch);
+        }
+
+        _Statistics.ColonizedCount       += Output.Statistics.ColonizedCount;
+        _Statistics.BarrenCount          += Output.Statistics.BarrenCount;
+        _Statistics.SupersededProbeCount += Output.Statistics.SupersededProbeCount;
+    }
+}
+
+void FProbeExpansionSimulator::ProcessLaunches()
+{
+    // 按出堆顺序串行处理，后发射的系统能看到先发射的系统刚派出的探测器；发射只读写抵达时间，不受窗口内抵达事件的影响
+    for (const FEvent& Launch : _Launches)
+    {
+        auto Neighbours = _Graph->GetNeighbours(Launch.System);
+        auto Distances  = _Graph->GetJumpDistances(Launch.System);
+
+        std::uint16_t LaunchedCount = 0;
+        for (std::size_t j = 0; j != Neighbours.size() && LaunchedCount != Launch.ProbeCount; ++j)
+        {
+            if (Distances[j] > _SimulationInfo.MaxJumpDistance)
+            {
+                break;
+            }
+
+            // 已占据、已荒废或已有不晚于此的探测器在途的系统都会被跳过
+            std::uint32_t Target      = Neighbours[j];
+            double        ArrivalTime = Launch.Time + Distances[j] / _SimulationInfo.ProbeSpeed;
+            if (ArrivalTime >= _ArrivalTimes[Target])
+            {
+                continue;
+            }
+
+            _ArrivalTimes[Target] = ArrivalTime;
+            _Parents[Target]      = Launch.System;
+            _States[Target]       = ESystemState::kTargeted;
+            _Queue.Push({ ArrivalTime, Target, EEventType::kArrival, 0 });
+            ++LaunchedCount;
+        }
+
+        _Statistics.LaunchedProbeCount += LaunchedCount;
+    }
+}
+
+// FEventQueue implementations
+// ---------------------------
+void FProbeExpansionSimulator::FEventQueue::Push(const FEvent& Event)
+{
+    std::size_t Index = _Events.size();
+    _Events.push_back(Event);
+
+    while (Index != 0)
+    {
+        std::size_t Parent = (Index - 1) / 4;
+        if (!Less(Event, _Events[Parent]))
+        {
+            break;
+        }
+
+        _Events[Index] = _Events[Parent];
+        Index          = Parent;
+    }
+
+    _Events[Index] = Event;
+}
+
+FProbeExpansionSimulator::FEvent FProbeExpansionSimulator::FEventQueue::Pop()
+{
+    FEvent Top  = _Events.front();
+    FEvent Last = _Events.back();
+    _Events.pop_back();
+
+    std::size_t Size = _Events.size();
+    if (Size == 0)
+    {
+        return Top;
+    }
+
+    std::size_t Index = 0;
+    while (true)
+    {
+        std::size_t FirstChild = Index * 4 + 1;
+        if (FirstChild >= Size)
+        {
+            break;
+        }
+
+        std::size_t LastChild = std::min(FirstChild + 4, Size);
+        std::size_t MinChild  = FirstChild;
+        for (std::size_t Child = FirstChild + 1; Child < LastChild; ++Child)
+        {
+            if (Less(_Events[Child], _Events[MinChild]))
+            {
+                MinChild = Child;
+            }
+        }
+
+        if (!Less(_Events[MinChild], Last))
+        {
+            break;
+        }
+
+        _Events[Index] = _Events[MinChild];
+        Index          = MinChild;
+    }
+
+    _Events[Index] = Last;
+    return Top;
+}
+
+_SIMULATION_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Spatial/NeighbourGraph.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SIMULATION_BEGIN
+
+// 自我复制探测器扩张的离散事件模拟，时间单位为 yr，距离单位为 ly。探测器沿邻接图的边飞行，抵达空闲系统后占据它，
+// 经过复制时间向最近的若干个尚无更早探测器抵达的系统发射新探测器
+// 事件按长度为 MinReplicationTime 的时间窗口成批处理：窗口内的发射事件按时间顺序串行处理，之后窗口内的抵达事件
+// 互不影响，并行求系统性质。结果与逐个处理事件完全相同，与线程数无关
+class FProbeExpansionSimulator
+{
+public:
+    static constexpr std::uint32_t kInvalidIndex = Spatial::FNeighbourGraph::kInvalidIndex;
+
+    enum class ESystemState : std::uint8_t
+    {
+        kUnreached = 0, // 没有探测器前往
+        kTargeted  = 1, // 已有探测器在途
+        kColonized = 2, // 已占据并参与复制
+        kBarren    = 3  // 已抵达但无法复制
+    };
+
+    // 由调用方根据恒星和行星性质给出，会被多个线程同时调用
+    struct FSystemTraits
+    {
+        float         ReplicationTime{}; // 从抵达到发射下一批探测器的时间，单位 yr，低于 MinReplicationTime 时取后者
+        std::uint32_t ProbeCount{};      // 发射的探测器数，0 表示无法复制
+    };
+
+    using FTraitsEvaluator = std::function<FSystemTraits(std::uint32_t SystemIndex)>;
+
+    struct FSimulationInfo
+    {
+        std::uint32_t HomeSystem{};                // 邻接图中的系统编号
+        float         ProbeSpeed{ 0.01f };         // 单位 c
+        float         MaxJumpDistance{ std::numeric_limits<float>::infinity() }; // 只在图中边的基础上进一步收紧
+        float         MinReplicationTime{ 100.0f }; // 单位 yr，同时是时间窗口的长度，越长并行度越高
+        int           ThreadCount{};               // 0 表示使用线程池的全部线程
+    };
+
+    struct FStatistics
+    {
+        std::size_t ColonizedCount{};
+        std::size_t BarrenCount{};
+        std::size_t LaunchedProbeCount{};
+        std::size_t SupersededProbeCount{}; // 抵达前已被更早的探测器抢先
+        std::size_t ProcessedEventCount{};
+        std::size_t WindowCount{};
+        double      LastEventTime{};
+    };
+
+public:
+    FProbeExpansionSimulator() = delete;
+    FProbeExpansionSimulator(const Spatial::FNeighbourGraph& Graph, const FSimulationInfo& SimulationInfo,
+                             FTraitsEvaluator Evaluator);
+
+    FProbeExpansionSimulator(const FProbeExpansionSimulator&) = delete;
+    FProbeExpansionSimulator(FProbeExpansionSimulator&&) noexcept = default;
+    ~FProbeExpansionSimulator() = default;
+
+    FProbeExpansionSimulator& operator=(const FProbeExpansionSimulator&) = delete;
+    FProbeExpansionSimulator& operator=(FProbeExpansionSimulator&&) noexcept = default;
+
+    // 处理时间不晚于 EndTime 的全部事件，返回是否还有待处理的事件
+    bool Advance(double EndTime);
+    bool Run();
+
+    ESystemState GetSystemState(std::uint32_t SystemIndex) const;
+    double GetArrivalTime(std::uint32_t SystemIndex) const; // 最早的已抵达或在途探测器的抵达时间，没有时为无穷大
+    std::uint32_t GetParent(std::uint32_t SystemIndex) const; // 发射该探测器的系统，家园和无探测器前往的系统为 kInvalidIndex
+    std::size_t GetPendingEventCount() const;
+    double GetWindowLength() const;
+    const FStatistics& GetStatistics() const;
+    const FSimulationInfo& GetSimulationInfo() const;
+
+private:
+    enum class EEventType : std::uint16_t
+    {
+        kArrival = 0,
+        kLaunch  = 1
+    };
+
+    struct FEvent
+    {
+        double        Time;
+        std::uint32_t System;
+        EEventType    Type;
+        std::uint16_t ProbeCount;
+    };
+
+    // 四叉最小堆，事件只有 16 字节，同一节点的 4 个子节点相邻，下沉时比较的数据基本位于同一缓存行
+    // 按 (Time, Type, System) 排序，所有事件的键互不相同，出堆顺序与入堆顺序无关
+    class FEventQueue
+    {
+    public:
+        void Push(const FEvent& Event);
+        FEvent Pop();
+        const FEvent& Top() const;
+        bool Empty() const;
+        std::size_t Size() const;
+
+    private:
+        static bool Less(const FEvent& Lhs, const FEvent& Rhs);
+
+    private:
+        std::vector<FEvent> _Events;
+    };
+
+    // 每个分块的输出，合并时按分块顺序读取
+    struct FChunkOutput
+    {
+        std::vector<FEvent> Launches;
+        FStatistics         Statistics;
+    };
+
+    void PopWindowEvents(double WindowBegin, double WindowEnd, double EndTime);
+    void ProcessArrivals();
+    void ProcessLaunches();
+
+private:
+    const Spatial::FNeighbourGraph* _Graph;
+    FSimulationInfo                 _SimulationInfo;
+    FTraitsEvaluator                _Evaluator;
+    FEventQueue                     _Queue;
+    std::vector<double>             _ArrivalTimes;
+    std::vector<std::uint32_t>      _Parents;
+    std::vector<ESystemState>       _States;
+    std::vector<FEvent>             _Arrivals;     // 当前窗口的抵达事件
+    std::vector<FEvent>             _Launches;     // 当前窗口的发射事件
+    std::vector<FChunkOutput>       _ChunkOutputs;
+    FStatistics                     _Statistics;
+    double                          _WindowLength;
+    std::size_t                     _ChunkCount;
+};
+
+_SIMULATION_END
+_SYSTEM_END
+_NPGS_END
+
+#include "ProbeExpansion.inl"
@@ -0,0 +1,81 @@
+#include "ProbeExpansion.h"
+
+#include <limits>
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SIMULATION_BEGIN
+
+NPGS_INLINE bool FProbeExpansionSimulator::Run()
+{
+    return Advance(std::numeric_limits<double>::infinity());
+}
+
+NPGS_INLINE FProbeExpansionSimulator::ESystemState FProbeExpansionSimulator::GetSystemState(std::uint32_t SystemIndex) const
+{
+    return _States[SystemIndex];
+}
+
+NPGS_INLINE double FProbeExpansionSimulator::GetArrivalTime(std::uint32_t SystemIndex) const
+{
+    return _ArrivalTimes[SystemIndex];
+}
+
+NPGS_INLINE std::uint32_t FProbeExpansionSimulator::GetParent(std::uint32_t SystemIndex) const
+{
+    return _Parents[SystemIndex];
+}
+
+NPGS_INLINE std::size_t FProbeExpansionSimulator::GetPendingEventCount() const
+{
+    return _Queue.Size();
+}
+
+NPGS_INLINE double FProbeExpansionSimulator::GetWindowLength() const
+{
+    return _WindowLength;
+}
+
+NPGS_INLINE const FProbeExpansionSimulator::FStatistics& FProbeExpansionSimulator::GetStatistics() const
+{
+    return _Statistics;
+}
+
+NPGS_INLINE const FProbeExpansionSimulator::FSimulationInfo& FProbeExpansionSimulator::GetSimulationInfo() const
+{
+    return _SimulationInfo;
+}
+
+NPGS_INLINE const FProbeExpansionSimulator::FEvent& FProbeExpansionSimulator::FEventQueue::Top() const
+{
+    return _Events.front();
+}
+
+NPGS_INLINE bool FProbeExpansionSimulator::FEventQueue::Empty() const
+{
+    return _Events.empty();
+}
+
+NPGS_INLINE std::size_t FProbeExpansionSimulator::FEventQueue::Size() const
+{
+    return _Events.size();
+}
+
+NPGS_INLINE bool FProbeExpansionSimulator::FEventQueue::Less(const FEvent& Lhs, const FEvent& Rhs)
+{
+    if (Lhs.Time != Rhs.Time)
+    {
+        return Lhs.Time < Rhs.Time;
+    }
+
+    if (Lhs.Type != Rhs.Type)
+    {
+        return Lhs.Type < Rhs.Type;
+    }
+
+    return Lhs.System < Rhs.System;
+}
+
+_SIMULATION_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,86 @@
+#include "Culling.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Engine/Core/Math/NumericConstants.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// FFrustum implementations
+// ------------------------
+FFrustum::FFrustum(const glm::mat4x4& ViewProjection)
+{
+    // Gribb-Hartmann 平面提取，glm 矩阵按列存储，第 i 行为 (M[0][i], M[1][i], M[2][i], M[3][i])
+    auto Row = [&ViewProjection](int Index) -> glm::vec4
+    {
+        return glm::vec4(ViewProjection[0][Index], ViewProjection[1][Index], ViewProjection[2][Index], ViewProjection[3][Index]);
+    };
+
+    _Planes[0] = Row(3) + Row(0); // 左
+    _Planes[1] = Row(3) - Row(0); // 右
+    _Planes[2] = Row(3) + Row(1); // 下，投影矩阵翻转了 y 时与上交换，不影响结果
+    _Planes[3] = Row(3) - Row(1); // 上
+
+    for (auto& Plane : _Planes)
+    {
+        Plane /= glm::length(glm::vec3(Plane));
+    }
+}
+
+// FViewCone implementations
+// -------------------------
+FViewCone::FViewCone(glm::vec3 Apex, glm::vec3 Direction, float HalfAngle)
+    :
+    _Apex(Apex),
+    _Direction(glm::normalize(Direction)),
+    _CosHalfAngle(std::cos(std::clamp(HalfAngle, 0.0f, Math::kPi))),
+    _SinHalfAngle(std::sin(std::clamp(HalfAngle, 0.0f, Math::kPi)))
+{
+}
+
+bool FViewCone::IntersectBox(glm::vec3 Center, float Radius) const
+{
+    // 用外接球近似盒子，球与圆锥相交当且仅当球心偏离轴线的角度不超过半顶角加球的角半径
+    glm::vec3 Offset       = Center - _Apex;
+    float     Distance     = glm::length(Offset);
+    float     SphereRadius = Radius * std::sqrt(3.0f);
+    if (Distance <= SphereRadius)
+    {
+        return true;
+    }
+
+    float SinSphereAngle = SphereRadius / Distance;
+    float CosSphereAngle = std::sqrt(1.0f - SinSphereAngle * SinSphereAngle);
+
+    // 半顶角加角半径超过 pi 时任何方向都相交
+    if (_CosHalfAngle < 0.0f && SinSphereAngle >= _SinHalfAngle)
+    {
+        return true;
+    }
+
+    float CosLimit = _CosHalfAngle * CosSphereAngle - _SinHalfAngle * SinSphereAngle;
+    return glm::dot(Offset, _Direction) >= Distance * CosLimit;
+}
+
+// FVisibilityCriteria implementations
+// -----------------------------------
+FVisibilityCriteria FVisibilityCriteria::FromLimitMagnitude(glm::vec3 Observer, float LimitMagnitude, float MinSolidAngle)
+{
+    // m = M_sun - 2.5 lg(L / L_sun) + 5 lg(d / 10 pc)，m <= LimitMagnitude 等价于 L / d^2 >= MinFlux
+    float TenParsecs = 10.0f * kParsecToLightYear;
+    float MinFlux    = std::pow(10.0f, -0.4f * (LimitMagnitude - kSolarAbsoluteMagnitude)) / (TenParsecs * TenParsecs);
+
+    return { Observer, MinFlux, MinSolidAngle };
+}
+
+float CalculateApparentMagnitude(float LuminositySol, float DistanceLy)
+{
+    return kSolarAbsoluteMagnitude - 2.5f * std::log10(LuminositySol) + 5.0f * std::log10(DistanceLy / (10.0f * kParsecToLightYear));
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
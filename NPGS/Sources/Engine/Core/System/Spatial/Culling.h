@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// 视锥体，只保留左右上下四个侧面。星图使用无限远投影，近平面在光年尺度上可以忽略，
+// 四个过视点的侧面已经把视点后方排除在外
+class FFrustum
+{
+public:
+    FFrustum() = default;
+    explicit FFrustum(const glm::mat4x4& ViewProjection); // 如 FCamera::GetProjectionMatrix() * FCamera::GetViewMatrix()
+    ~FFrustum() = default;
+
+    bool Contains(glm::vec3 Point) const;
+    bool IntersectBox(glm::vec3 Center, float Radius) const; // 立方体，Radius 为半边长
+
+    const std::array<glm::vec4, 4>& GetPlanes() const;
+
+private:
+    std::array<glm::vec4, 4> _Planes{}; // 法向量指向视锥体内侧，xyz 已归一化
+};
+
+// 以 Apex 为顶点、沿 Direction 张开 HalfAngle 的无限长圆锥，HalfAngle 取 pi 时等价于全天
+class FViewCone
+{
+public:
+    FViewCone() = default;
+    FViewCone(glm::vec3 Apex, glm::vec3 Direction, float HalfAngle);
+    ~FViewCone() = default;
+
+    bool Contains(glm::vec3 Point) const;
+    bool IntersectBox(glm::vec3 Center, float Radius) const;
+
+    glm::vec3 GetApex() const;
+    glm::vec3 GetDirection() const;
+
+private:
+    glm::vec3 _Apex{};
+    glm::vec3 _Direction{ 0.0f, 0.0f, -1.0f };
+    float     _CosHalfAngle{ -1.0f };
+    float     _SinHalfAngle{};
+};
+
+// 可见性判据。Luminosity / Distance^2 不低于 MinFlux 的光源可见，单位与调用方提供的光度和距离一致；
+// 张角小于 MinSolidAngle（立体角，sr）的子树合并为一个汇总光源
+struct FVisibilityCriteria
+{
+    glm::vec3 Observer{};
+    float     MinFlux{};
+    float     MinSolidAngle{};
+
+    // 光度以太阳光度、距离以光年为单位时，由极限视星等换算 MinFlux
+    static FVisibilityCriteria FromLimitMagnitude(glm::vec3 Observer, float LimitMagnitude, float MinSolidAngle);
+};
+
+// 光度以太阳光度、距离以光年为单位
+float CalculateApparentMagnitude(float LuminositySol, float DistanceLy);
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
+
+#include "Culling.inl"
@@ -0,0 +1,61 @@
+#include "Culling.h"
+
+#include <cmath>
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+NPGS_INLINE bool FFrustum::Contains(glm::vec3 Point) const
+{
+    for (const auto& Plane : _Planes)
+    {
+        if (glm::dot(glm::vec3(Plane), Point) + Plane.w < 0.0f)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+NPGS_INLINE bool FFrustum::IntersectBox(glm::vec3 Center, float Radius) const
+{
+    // 盒子在法向量上的投影半径，中心到平面的距离小于负的投影半径时整个盒子在平面外侧
+    for (const auto& Plane : _Planes)
+    {
+        glm::vec3 Normal(Plane);
+        float Extent = Radius * (std::abs(Normal.x) + std::abs(Normal.y) + std::abs(Normal.z));
+        if (glm::dot(Normal, Center) + Plane.w < -Extent)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+NPGS_INLINE const std::array<glm::vec4, 4>& FFrustum::GetPlanes() const
+{
+    return _Planes;
+}
+
+NPGS_INLINE bool FViewCone::Contains(glm::vec3 Point) const
+{
+    glm::vec3 Offset = Point - _Apex;
+    return glm::dot(Offset, _Direction) >= glm::length(Offset) * _CosHalfAngle;
+}
+
+NPGS_INLINE glm::vec3 FViewCone::GetApex() const
+{
+    return _Apex;
+}
+
+NPGS_INLINE glm::vec3 FViewCone::GetDirection() const
+{
+    return _Direction;
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,480 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/System/Spatial/MortonCode.hpp"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// 线性八叉树。点按 Morton 码排序后连续存放，任一节点子树中的点都是点数组中的一段连续区间
+// 节点按层序存放在一个数组中，子节点相邻且只保留非空卦限，叶子节点只出现在 MaxDepth 层，与 TOctree 的插入语义一致
+// 与 TOctree 的区别：
+// 1. Insert 和 Delete 先进入缓冲区，Flush 后才对查询可见；Flush 会整体重建
+// 2. 不存在空的子节点，Traverse 按存储顺序（逐层）而不是深度优先访问节点
+template <typename LinkTargetType>
+class TLinearOctree
+{
+public:
+    static constexpr std::uint32_t kNoIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct FNode
+    {
+        glm::vec3     Center;
+        float         Radius;
+        std::uint32_t Parent;
+        std::uint32_t FirstChild; // 子节点按卦限升序连续存放
+        std::uint32_t PointBegin;
+        std::uint32_t PointCount; // 子树中的点数
+        std::uint8_t  ChildMask;  // 第 i 位表示卦限 i 的子节点存在
+        std::uint8_t  Depth;
+
+        bool Contains(glm::vec3 Point) const
+        {
+            return (Point.x >= Center.x - Radius && Point.x <= Center.x + Radius &&
+                    Point.y >= Center.y - Radius && Point.y <= Center.y + Radius &&
+                    Point.z >= Center.z - Radius && Point.z <= Center.z + Radius);
+        }
+
+        int CalculateOctant(glm::vec3 Point) const
+        {
+            int Octant = 0;
+
+            if (Point.x >= Center.x) Octant |= 4;
+            if (Point.y >= Center.y) Octant |= 2;
+            if (Point.z >= Center.z) Octant |= 1;
+
+            return Octant;
+        }
+
+        std::uint32_t GetChildIndex(int Octant) const
+        {
+            if (!(ChildMask >> Octant & 1))
+            {
+                return kNoIndex;
+            }
+
+            return FirstChild + std::popcount(static_cast<unsigned>(ChildMask & ((1u << Octant) - 1)));
+        }
+
+        glm::vec3 GetCenter() const
+        {
+            return Center;
+        }
+
+        float GetRadius() const
+        {
+            return Radius;
+        }
+
+        bool IsLeafNode() const
+        {
+            return ChildMask == 0;
+        }
+    };
+
+public:
+    TLinearOctree(glm::vec3 Center, float Radius, int MaxDepth = 8)
+        : _Center(Center), _Radius(Radius), _MaxDepth(std::clamp(MaxDepth, 0, kMortonBitsPerAxis))
+    {
+        Build({});
+    }
+
+    // 用一组点（和与之一一对应的链接）重建整棵树，落在根节点范围外的点被丢弃
+    // ThreadCount 为 0 时使用线程池的全部线程
+    void Build(std::span<const glm::vec3> Points, std::span<LinkTargetType* const> Links = {}, int ThreadCount = 0)
+    {
+        std::size_t ChunkCount = ResolveChunkCount(ThreadCount);
+        std::size_t InputCount = Points.size();
+
+        // 计算 Morton 码，范围外的点使用哨兵值，排序后落在末尾
+        std::uint64_t Sentinel = GetSentinelCode();
+
+        std::vector<std::uint64_t> Codes(InputCount);
+        std::vector<std::uint32_t> Order(InputCount);
+        Runtime::Thread::ParallelFor(InputCount, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                Order[i] = static_cast<std::uint32_t>(i);
+                Codes[i] = CalculateMortonCode(Points[i]);
+            }
+        });
+
+        RadixSortPairs(Codes, Order, 3 * _MaxDepth + 1, ChunkCount);
+
+        std::size_t Count = std::lower_bound(Codes.begin(), Codes.end(), Sentinel) - Codes.begin();
+        Codes.resize(Count);
+
+        // 输入可能就是本树的点数组（例如 GetPointData），先写入新数组再交换
+        std::vector<glm::vec3>       SortedPoints(Count);
+        std::vector<LinkTargetType*> SortedLinks(Count);
+        Runtime::Thread::ParallelFor(Count, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                SortedPoints[i] = Points[Order[i]];
+                SortedLinks[i]  = Links.empty() ? nullptr : Links[Order[i]];
+            }
+        });
+
+        _Points.swap(SortedPoints);
+        _Links.swap(SortedLinks);
+
+        BuildNodes(Codes, ChunkCount);
+
+        _PendingInserts.clear();
+        _PendingInsertLinks.clear();
+        _PendingDeletes.clear();
+    }
+
+    // 缓冲一次插入，Flush 后生效
+    void Insert(glm::vec3 Point, LinkTargetType* Link = nullptr)
+    {
+        _PendingInserts.push_back(Point);
+        _PendingInsertLinks.push_back(Link);
+    }
+
+    // 缓冲一次删除，Flush 时删除一个坐标相同的点
+    void Delete(glm::vec3 Point)
+    {
+        _PendingDeletes.push_back(Point);
+    }
+
+    // 合并缓冲区中的插入和删除并重建
+    void Flush(int ThreadCount = 0)
+    {
+        if (_PendingInserts.empty() && _PendingDeletes.empty())
+        {
+            return;
+        }
+
+        std::vector<bool> DeletedFlags(_Points.size(), false);
+        for (glm::vec3 Point : _PendingDeletes)
+        {
+            const FNode* Leaf = Find(Point, [](const FNode& Node) -> bool { return Node.IsLeafNode(); });
+            if (Leaf == nullptr)
+            {
+                continue;
+            }
+
+            for (std::size_t i = Leaf->PointBegin; i != Leaf->PointBegin + Leaf->PointCount; ++i)
+            {
+                if (!DeletedFlags[i] && _Points[i] == Point)
+                {
+                    DeletedFlags[i] = true;
+                    break;
+                }
+            }
+        }
+
+        std::vector<glm::vec3>       Points;
+        std::vector<LinkTargetType*> Links;
+        Points.reserve(_Points.size() + _PendingInserts.size());
+        Links.reserve(_Points.size() + _PendingInserts.size());
+        for (std::size_t i = 0; i != _Points.size(); ++i)
+        {
+            if (!DeletedFlags[i])
+            {
+                Points.push_back(_Points[i]);
+                Links.push_back(_Links[i]);
+            }
+        }
+
+        Points.insert(Points.end(), _PendingInserts.begin(), _PendingInserts.end());
+        Links.insert(Links.end(), _PendingInsertLinks.begin(), _PendingInsertLinks.end());
+
+        Build(Points, Links, ThreadCount);
+    }
+
+    // 沿包含 Point 的路径自上而下查找第一个满足 Pred 的节点，复杂度 O(MaxDepth)
+    // 路径由与 Build 相同的量化 Morton 码决定，位于卦限边界上的点也能找到插入时所在的叶子
+    template <typename Func = std::function<bool(const FNode&)>>
+    const FNode* Find(glm::vec3 Point, Func&& Pred = [](const FNode&) -> bool { return true; }) const
+    {
+        std::uint64_t Code = CalculateMortonCode(Point);
+        if (Code == GetSentinelCode())
+        {
+            return nullptr;
+        }
+
+        std::uint32_t Index = 0;
+        while (true)
+        {
+            const FNode& Node = _Nodes[Index];
+            if (Pred(Node))
+            {
+                return &Node;
+            }
+
+            if (Node.IsLeafNode())
+            {
+                return nullptr;
+            }
+
+            Index = Node.GetChildIndex(static_cast<int>((Code >> (3 * (_MaxDepth - 1 - Node.Depth))) & 7));
+            if (Index == kNoIndex)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    template <typename Func>
+    void Traverse(Func&& Pred) const
+    {
+        for (const FNode& Node : _Nodes)
+        {
+            Pred(Node);
+        }
+    }
+
+    // 叶子节点中存储的点，非叶子节点返回空区间，与 TOctreeNode::GetPoints 一致
+    std::span<const glm::vec3> GetPoints(const FNode& Node) const
+    {
+        return Node.IsLeafNode() ? GetSubtreePoints(Node) : std::span<const glm::vec3>();
+    }
+
+    std::span<const glm::vec3> GetSubtreePoints(const FNode& Node) const
+    {
+        return std::span<const glm::vec3>(_Points.data() + Node.PointBegin, Node.PointCount);
+    }
+
+    // 与 GetPoints 一一对应的链接
+    std::span<LinkTargetType* const> GetLinks(const FNode& Node) const
+    {
+        return Node.IsLeafNode()
+             ? std::span<LinkTargetType* const>(_Links.data() + Node.PointBegin, Node.PointCount)
+             : std::span<LinkTargetType* const>();
+    }
+
+    std::span<LinkTargetType* const> GetSubtreeLinks(const FNode& Node) const
+    {
+        return std::span<LinkTargetType* const>(_Links.data() + Node.PointBegin, Node.PointCount);
+    }
+
+    template <typename Func>
+    LinkTargetType* GetLink(const FNode& Node, Func&& Pred) const
+    {
+        for (LinkTargetType* Target : GetLinks(Node))
+        {
+            if (Target != nullptr && Pred(Target))
+            {
+                return Target;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::size_t GetCapacity() const
+    {
+        return _LeafCount;
+    }
+
+    std::size_t GetSize() const
+    {
+        return _Points.size();
+    }
+
+    std::size_t GetMemoryUsage() const
+    {
+        return _Nodes.capacity() * sizeof(FNode) + _Points.capacity() * sizeof(glm::vec3) +
+               _Links.capacity() * sizeof(LinkTargetType*);
+    }
+
+    const FNode* GetRoot() const
+    {
+        return &_Nodes.front();
+    }
+
+    const FNode& GetNode(std::size_t Index) const
+    {
+        return _Nodes[Index];
+    }
+
+    const std::vector<FNode>& GetNodes() const
+    {
+        return _Nodes;
+    }
+
+    const std::vector<glm::vec3>& GetPointData() const
+    {
+        return _Points;
+    }
+
+    int GetMaxDepth() const
+    {
+        return _MaxDepth;
+    }
+
+private:
+    std::size_t ResolveChunkCount(int ThreadCount) const
+    {
+        if (ThreadCount <= 0)
+        {
+            ThreadCount = Runtime::Thread::FThreadPool::GetInstance()->GetMaxThreadCount();
+        }
+
+        return static_cast<std::size_t>(std::max(ThreadCount, 1));
+    }
+
+    std::uint64_t GetSentinelCode() const
+    {
+        return std::uint64_t(1) << (3 * _MaxDepth);
+    }
+
+    // 点在最深一层网格中的 Morton 码，落在根节点范围外时返回哨兵值；插入和查找必须使用同一套量化，
+    // 浮点的 CalculateOctant 在卦限边界附近可能与量化结果不同
+    std::uint64_t CalculateMortonCode(glm::vec3 Point) const
+    {
+        FNode Root{ _Center, _Radius };
+        if (!Root.Contains(Point))
+        {
+            return GetSentinelCode();
+        }
+
+        std::uint32_t CellCount = 1u << _MaxDepth;
+        float         Scale     = static_cast<float>(CellCount) / (2.0f * _Radius);
+        glm::vec3     Cell      = (Point - (_Center - glm::vec3(_Radius))) * Scale;
+        auto Quantize = [CellCount](float Value) -> std::uint32_t
+        {
+            return std::min(static_cast<std::uint32_t>(std::max(Value, 0.0f)), CellCount - 1);
+        };
+
+        return EncodeMorton(Quantize(Cell.x), Quantize(Cell.y), Quantize(Cell.z));
+    }
+
+    // 由已排序的 Morton 码逐层生成节点。每层先并行求出每个节点各卦限的点区间，
+    // 再对子节点数求前缀和得到 FirstChild，最后并行写入下一层
+    void BuildNodes(const std::vector<std::uint64_t>& Codes, std::size_t ChunkCount)
+    {
+        _Nodes.clear();
+        _Nodes.push_back({ _Center, _Radius, kNoIndex, kNoIndex, 0, static_cast<std::uint32_t>(Codes.size()), 0, 0 });
+        _LeafCount = 0;
+
+        std::size_t LevelBegin = 0;
+        std::size_t LevelEnd   = 1;
+        std::vector<std::array<std::uint32_t, 9>> Bounds;
+        std::vector<std::uint32_t>                ChildOffsets;
+
+        for (int Depth = 0; Depth != _MaxDepth; ++Depth)
+        {
+            std::size_t LevelCount = LevelEnd - LevelBegin;
+            int         Shift      = 3 * (_MaxDepth - 1 - Depth);
+            Bounds.resize(LevelCount);
+            ChildOffsets.resize(LevelCount + 1);
+
+            std::size_t LevelChunkCount = std::min(ChunkCount, LevelCount / 4096 + 1);
+            Runtime::Thread::ParallelFor(LevelCount, LevelChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+            {
+                for (std::size_t i = Begin; i != End; ++i)
+                {
+                    FNode& Node  = _Nodes[LevelBegin + i];
+                    auto&  Bound = Bounds[i];
+                    auto   First = Codes.begin() + Node.PointBegin;
+                    auto   Last  = First + Node.PointCount;
+
+                    Bound[0] = Node.PointBegin;
+                    for (int Octant = 0; Octant != 8; ++Octant)
+                    {
+                        auto It = std::partition_point(First, Last, [Shift, Octant](std::uint64_t Code) -> bool
+                        {
+                            return static_cast<int>((Code >> Shift) & 7) <= Octant;
+                        });
+
+                        Bound[Octant + 1] = static_cast<std::uint32_t>(It - Codes.begin());
+                        if (Bound[Octant + 1] != Bound[Octant])
+                        {
+                            Node.ChildMask |= static_cast<std::uint8_t>(1u << Octant);
+                        }
+
+                        First = It;
+                    }
+
+                    ChildOffsets[i] = std::popcount(static_cast<unsigned>(Node.ChildMask));
+                }
+            });
+
+            std::uint32_t Offset = static_cast<std::uint32_t>(LevelEnd);
+            for (std::size_t i = 0; i != LevelCount; ++i)
+            {
+                std::uint32_t ChildCount = ChildOffsets[i];
+                ChildOffsets[i] = Offset;
+                Offset += ChildCount;
+            }
+
+            _Nodes.resize(Offset);
+            Runtime::Thread::ParallelFor(LevelCount, LevelChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+            {
+                for (std::size_t i = Begin; i != End; ++i)
+                {
+                    FNode&        Node       = _Nodes[LevelBegin + i];
+                    std::uint32_t ChildIndex = ChildOffsets[i];
+                    float         NextRadius = Node.Radius * 0.5f;
+
+                    Node.FirstChild = ChildIndex;
+                    for (int Octant = 0; Octant != 8; ++Octant)
+                    {
+                        if (!(Node.ChildMask >> Octant & 1))
+                        {
+                            continue;
+                        }
+
+                        glm::vec3 NewCenter = Node.Center;
+                        NewCenter.x += (Octant & 4) ? NextRadius : -NextRadius;
+                        NewCenter.y += (Octant & 2) ? NextRadius : -NextRadius;
+                        NewCenter.z += (Octant & 1) ? NextRadius : -NextRadius;
+
+                        _Nodes[ChildIndex++] =
+                        {
+                            NewCenter, NextRadius, static_cast<std::uint32_t>(LevelBegin + i), kNoIndex,
+                            Bounds[i][Octant], Bounds[i][Octant + 1] - Bounds[i][Octant], 0, static_cast<std::uint8_t>(Depth + 1)
+                        };
+                    }
+                }
+            });
+
+            LevelBegin = LevelEnd;
+            LevelEnd   = _Nodes.size();
+            if (LevelBegin == LevelEnd)
+            {
+                break;
+            }
+        }
+
+        // 空树只有根节点，它本身就是叶子
+        _LeafCount = _MaxDepth == 0 || Codes.empty() ? 1 : LevelEnd - LevelBegin;
+    }
+
+private:
+    std::vector<FNode>           _Nodes;
+    std::vector<glm::vec3>       _Points;
+    std::vector<LinkTargetType*> _Links;
+    std::vector<glm::vec3>       _PendingInserts;
+    std::vector<LinkTargetType*> _PendingInsertLinks;
+    std::vector<glm::vec3>       _PendingDeletes;
+    glm::vec3                    _Center;
+    float                        _Radius;
+    int                          _MaxDepth;
+    std::size_t                  _LeafCount{};
+};
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// 三维 Morton 编码，每轴最多 21 位。每 3 位从高到低依次为 x、y、z，
+// 卦限编号规则与 TOctreeNode::CalculateOctant 相同，第 d 层的卦限就是从最高层数起第 d 组 3 位
+// 量化后的网格边界与浮点的节点中心比较在边界附近可能不一致，定位已插入的点时应使用同一量化得到的编码
+inline constexpr int kMortonBitsPerAxis = 21;
+
+inline std::uint64_t SpreadMortonBits(std::uint32_t Value)
+{
+    std::uint64_t Bits = Value & 0x1FFFFF;
+    Bits = (Bits | Bits << 32) & 0x001F00000000FFFFull;
+    Bits = (Bits | Bits << 16) & 0x001F0000FF0000FFull;
+    Bits = (Bits | Bits << 8)  & 0x100F00F00F00F00Full;
+    Bits = (Bits | Bits << 4)  & 0x10C30C30C30C30C3ull;
+    Bits = (Bits | Bits << 2)  & 0x1249249249249249ull;
+    return Bits;
+}
+
+inline std::uint32_t CompactMortonBits(std::uint64_t Bits)
+{
+    Bits &= 0x1249249249249249ull;
+    Bits = (Bits ^ (Bits >> 2))  & 0x10C30C30C30C30C3ull;
+    Bits = (Bits ^ (Bits >> 4))  & 0x100F00F00F00F00Full;
+    Bits = (Bits ^ (Bits >> 8))  & 0x001F0000FF0000FFull;
+    Bits = (Bits ^ (Bits >> 16)) & 0x001F00000000FFFFull;
+    Bits = (Bits ^ (Bits >> 32)) & 0x1FFFFF;
+    return static_cast<std::uint32_t>(Bits);
+}
+
+inline std::uint64_t EncodeMorton(std::uint32_t X, std::uint32_t Y, std::uint32_t Z)
+{
+    return SpreadMortonBits(X) << 2 | SpreadMortonBits(Y) << 1 | SpreadMortonBits(Z);
+}
+
+inline glm::uvec3 DecodeMorton(std::uint64_t Code)
+{
+    return glm::uvec3(CompactMortonBits(Code >> 2), CompactMortonBits(Code >> 1), CompactMortonBits(Code));
+}
+
+// 按键的低 KeyBits 位对 (Key, Value) 做稳定的 LSD 基数排序，每趟 8 位
+// ChunkCount 大于 1 时每趟的计数和分发都按块并行，每块先统计自己的直方图，再按 (桶, 块) 的顺序求前缀和，保证稳定
+template <typename ValueType>
+void RadixSortPairs(std::vector<std::uint64_t>& Keys, std::vector<ValueType>& Values, int KeyBits, std::size_t ChunkCount)
+{
+    constexpr int         kDigitBits  = 8;
+    constexpr std::size_t kBucketCount = std::size_t(1) << kDigitBits;
+
+    std::size_t Count = Keys.size();
+    ChunkCount = std::max<std::size_t>(1, std::min(ChunkCount, Count / 65536 + 1)); // 小数组不值得分块
+
+    std::vector<std::uint64_t> KeyBuffer(Count);
+    std::vector<ValueType>     ValueBuffer(Count);
+    std::vector<std::array<std::size_t, kBucketCount>> Histograms(ChunkCount);
+
+    for (int Shift = 0; Shift < KeyBits; Shift += kDigitBits)
+    {
+        Runtime::Thread::ParallelFor(Count, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t Chunk) -> void
+        {
+            auto& Histogram = Histograms[Chunk];
+            Histogram.fill(0);
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                ++Histogram[(Keys[i] >> Shift) & (kBucketCount - 1)];
+            }
+        });
+
+        // 把直方图就地改写为每块在每个桶中的起始位置
+        std::size_t Offset = 0;
+        for (std::size_t Bucket = 0; Bucket != kBucketCount; ++Bucket)
+        {
+            for (auto& Histogram : Histograms)
+            {
+                std::size_t BucketCount = Histogram[Bucket];
+                Histogram[Bucket] = Offset;
+                Offset += BucketCount;
+            }
+        }
+
+        Runtime::Thread::ParallelFor(Count, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t Chunk) -> void
+        {
+            auto& Positions = Histograms[Chunk];
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                std::size_t Position = Positions[(Keys[i] >> Shift) & (kBucketCount - 1)]++;
+                KeyBuffer[Position]   = Keys[i];
+                ValueBuffer[Position] = std::move(Values[i]);
+            }
+        });
+
+        Keys.swap(KeyBuffer);
+        Values.swap(ValueBuffer);
+    }
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
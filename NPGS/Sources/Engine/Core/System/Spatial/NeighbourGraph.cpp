@@ -0,0 +1,450 @@
+#include "NeighbourGraph.h"
+
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#include "Engine/Core/Math/NumericConstants.h"
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/System/Spatial/LinearOctree.hpp"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    using FNeighbour = std::pair<float, std::uint32_t>; // 距离平方（或距离）和系统编号，按字典序比较保证结果与线程数无关
+
+    std::size_t ResolveChunkCount(int ThreadCount)
+    {
+        if (ThreadCount <= 0)
+        {
+            ThreadCount = Runtime::Thread::FThreadPool::GetInstance()->GetMaxThreadCount();
+        }
+
+        return static_cast<std::size_t>(std::max(ThreadCount, 1));
+    }
+
+    // 两个立方体之间的最短距离平方，Radius 为半边长
+    float CalculateBoxGapSquared(glm::vec3 Center1, float Radius1, glm::vec3 Center2, float Radius2)
+    {
+        glm::vec3 Gap = glm::max(glm::abs(Center1 - Center2) - glm::vec3(Radius1 + Radius2), glm::vec3(0.0f));
+        return glm::dot(Gap, Gap);
+    }
+}
+
+// FNeighbourGraph implementations
+// -------------------------------
+void FNeighbourGraph::Build(std::span<const glm::vec3> Positions, const FBuildInfo& BuildInfo, int ThreadCount)
+{
+    if (BuildInfo.MaxNeighbours == 0)
+    {
+        throw std::invalid_argument("MaxNeighbours must be positive.");
+    }
+
+    if (Positions.size() >= kInvalidIndex)
+    {
+        throw std::length_error("Too many systems for a neighbour graph.");
+    }
+
+    _BuildInfo = BuildInfo;
+    _Positions.assign(Positions.begin(), Positions.end());
+    _Offsets.assign(1, 0);
+    _Targets.clear();
+    _Distances.clear();
+
+    std::size_t SystemCount = _Positions.size();
+    if (SystemCount == 0)
+    {
+        return;
+    }
+
+    std::size_t ChunkCount = ResolveChunkCount(ThreadCount);
+    std::size_t K          = BuildInfo.MaxNeighbours;
+
+    std::vector<std::uint32_t> Slots;
+    std::vector<float>         SlotDistances;
+    std::vector<std::uint32_t> SlotCounts;
+    FindNearestNeighbours(_Positions, Slots, SlotDistances, SlotCounts, ChunkCount);
+
+    // 对称模式下，u -> v 不是互为近邻时需要给 v 补一条反向边
+    auto IsMutual = [&](std::uint32_t From, std::uint32_t To) -> bool
+    {
+        auto First = Slots.begin() + To * K;
+        return std::find(First, First + SlotCounts[To], From) != First + SlotCounts[To];
+    };
+
+    std::vector<std::atomic<std::uint32_t>> ReverseCounts(BuildInfo.bSymmetric ? SystemCount : 0);
+    if (BuildInfo.bSymmetric)
+    {
+        Runtime::Thread::ParallelFor(SystemCount, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                for (std::size_t j = 0; j != SlotCounts[i]; ++j)
+                {
+                    std::uint32_t Target = Slots[i * K + j];
+                    if (!IsMutual(static_cast<std::uint32_t>(i), Target))
+                    {
+                        ReverseCounts[Target].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+
+    // 前缀和得到行偏移，反向边计数清零后复用为写入游标
+    _Offsets.resize(SystemCount + 1);
+    for (std::size_t i = 0; i != SystemCount; ++i)
+    {
+        std::uint32_t ReverseCount = BuildInfo.bSymmetric ? ReverseCounts[i].exchange(0, std::memory_order_relaxed) : 0;
+        _Offsets[i + 1] = _Offsets[i] + SlotCounts[i] + ReverseCount;
+    }
+
+    _Targets.resize(_Offsets.back());
+    _Distances.resize(_Offsets.back());
+
+    Runtime::Thread::ParallelFor(SystemCount, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+    {
+        for (std::size_t i = Begin; i != End; ++i)
+        {
+            for (std::size_t j = 0; j != SlotCounts[i]; ++j)
+            {
+                std::uint32_t Target   = Slots[i * K + j];
+                float         Distance = SlotDistances[i * K + j];
+
+                _Targets[_Offsets[i] + j]   = Target;
+                _Distances[_Offsets[i] + j] = Distance;
+
+                if (BuildInfo.bSymmetric && !IsMutual(static_cast<std::uint32_t>(i), Target))
+                {
+                    std::uint64_t Position = _Offsets[Target] + SlotCounts[Target] +
+                                             ReverseCounts[Target].fetch_add(1, std::memory_order_relaxed);
+                    _Targets[Position]   = static_cast<std::uint32_t>(i);
+                    _Distances[Position] = Distance;
+                }
+            }
+        }
+    });
+
+    // 反向边的写入顺序取决于线程调度，按距离重新排序，使结果确定并允许查询时按距离提前结束
+    if (BuildInfo.bSymmetric)
+    {
+        Runtime::Thread::ParallelFor(SystemCount, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            std::vector<FNeighbour> Neighbours;
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                Neighbours.clear();
+                for (std::uint64_t j = _Offsets[i]; j != _Offsets[i + 1]; ++j)
+                {
+                    Neighbours.emplace_back(_Distances[j], _Targets[j]);
+                }
+
+                std::sort(Neighbours.begin(), Neighbours.end());
+                for (std::size_t j = 0; j != Neighbours.size(); ++j)
+                {
+                    _Distances[_Offsets[i] + j] = Neighbours[j].first;
+                    _Targets[_Offsets[i] + j]   = Neighbours[j].second;
+                }
+            }
+        });
+    }
+}
+
+FNeighbourGraph::FRoute FNeighbourGraph::FindRoute(const FRouteRequest& Request) const
+{
+    FRouteScratch Scratch;
+    FRoute Route;
+    FindRouteImpl(Request, Scratch, Route);
+    return Route;
+}
+
+void FNeighbourGraph::FindRoutes(std::span<const FRouteRequest> Requests, std::vector<FRoute>& Results, int ThreadCount) const
+{
+    Results.resize(Requests.size());
+
+    // 路径长短差异很大，切成多于线程数的块以平衡负载
+    std::size_t ChunkCount = std::min(Requests.size(), ResolveChunkCount(ThreadCount) * 4);
+    Runtime::Thread::ParallelFor(Requests.size(), ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+    {
+        FRouteScratch Scratch;
+        for (std::size_t i = Begin; i != End; ++i)
+        {
+            FindRouteImpl(Requests[i], Scratch, Results[i]);
+        }
+    });
+}
+
+void FNeighbourGraph::FindNearestNeighbours(std::span<const glm::vec3> Positions, std::vector<std::uint32_t>& Slots,
+                                            std::vector<float>& SlotDistances, std::vector<std::uint32_t>& SlotCounts,
+                                            std::size_t ChunkCount) const
+{
+    std::size_t SystemCount = Positions.size();
+    std::size_t K           = _BuildInfo.MaxNeighbours;
+
+    glm::vec3 MinBound(std::numeric_limits<float>::max());
+    glm::vec3 MaxBound(std::numeric_limits<float>::lowest());
+    for (glm::vec3 Position : Positions)
+    {
+        MinBound = glm::min(MinBound, Position);
+        MaxBound = glm::max(MaxBound, Position);
+    }
+
+    glm::vec3 Extent = MaxBound - MinBound;
+    float     Radius = std::max(0.5f * std::max({ Extent.x, Extent.y, Extent.z }) * 1.0001f, 1e-3f);
+
+    // 均匀分布时最深一层每个节点不到一个点，密集的星团也能细分到每桶几十个点
+    int MaxDepth = _BuildInfo.MaxDepth;
+    if (MaxDepth <= 0)
+    {
+        MaxDepth = static_cast<int>(std::floor(std::log2(std::max(static_cast<double>(SystemCount) / K, 1.0)) / 3.0)) + 2;
+        MaxDepth = std::clamp(MaxDepth, 1, kMortonBitsPerAxis);
+    }
+
+    // 链接指向 Positions 本身，由地址差得到系统编号
+    std::vector<const glm::vec3*> Links(SystemCount);
+    for (std::size_t i = 0; i != SystemCount; ++i)
+    {
+        Links[i] = &Positions[i];
+    }
+
+    TLinearOctree<const glm::vec3> Octree(0.5f * (MinBound + MaxBound), Radius, MaxDepth);
+    Octree.Build(Positions, Links, static_cast<int>(ChunkCount));
+    Links.clear();
+    Links.shrink_to_fit();
+
+    // 点数不超过 BucketSize 的最高层节点（或点数更多的叶子）作为桶，桶互不重叠且覆盖所有点；
+    // 节点按层序、同层按 Morton 序存放，相邻的桶在空间上也相近
+    std::size_t BucketSize = 4 * K;
+    std::vector<std::uint32_t> Buckets;
+    Octree.Traverse([&](const auto& Node) -> void
+    {
+        bool bSmall = Node.PointCount <= BucketSize || Node.IsLeafNode();
+        bool bRoot  = Node.Parent == Octree.kNoIndex;
+        if (Node.PointCount != 0 && bSmall && (bRoot || Octree.GetNode(Node.Parent).PointCount > BucketSize))
+        {
+            Buckets.push_back(static_cast<std::uint32_t>(&Node - &Octree.GetNode(0)));
+        }
+    });
+
+    Slots.assign(SystemCount * K, kInvalidIndex);
+    SlotDistances.assign(SystemCount * K, 0.0f);
+    SlotCounts.assign(SystemCount, 0);
+
+    float MaxJumpSquared = _BuildInfo.MaxJumpDistance * _BuildInfo.MaxJumpDistance;
+
+    // 同一桶中的点共享候选集：取出与桶的盒子距离不超过 Margin 的所有点，若某点在 Margin 内已有 K 个近邻
+    // （或跳跃距离上限不超过 Margin），候选集之外不可能有更近的点，结果即为精确解；其余的点把 Margin 加倍后重新收集
+    float       RootSide       = 2.0f * Octree.GetRoot()->Radius;
+    float       FullMargin     = RootSide * std::sqrt(3.0f);
+    std::size_t BucketChunkCount = std::min(Buckets.size(), ChunkCount * 8);
+    Runtime::Thread::ParallelFor(Buckets.size(), BucketChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+    {
+        std::vector<FNeighbour>    Best;
+        std::vector<glm::vec3>     CandidatePoints;
+        std::vector<std::uint32_t> CandidateIndices;
+        std::vector<std::uint32_t> NodeStack;
+        std::vector<std::uint32_t> Pending;
+
+        for (std::size_t BucketIndex = Begin; BucketIndex != End; ++BucketIndex)
+        {
+            const auto& Bucket       = Octree.GetNode(Buckets[BucketIndex]);
+            auto        BucketPoints = Octree.GetSubtreePoints(Bucket);
+            auto        BucketLinks  = Octree.GetSubtreeLinks(Bucket);
+
+            Pending.resize(BucketPoints.size());
+            for (std::size_t i = 0; i != Pending.size(); ++i)
+            {
+                Pending[i] = static_cast<std::uint32_t>(i);
+            }
+
+            // 按桶内的点密度估计第 K 近距离，放大一些使大多数点一次即可确定
+            float BucketSide = 2.0f * Bucket.Radius;
+            float Margin     = 1.3f * BucketSide * std::cbrt(3.0f * K / (4.0f * Math::kPi * BucketPoints.size()));
+
+            for (; !Pending.empty(); Margin *= 2.0f)
+            {
+                bool bComplete = Margin >= FullMargin; // 候选集已包含所有点
+
+                CandidatePoints.clear();
+                CandidateIndices.clear();
+                NodeStack.assign(1, 0);
+                while (!NodeStack.empty())
+                {
+                    const auto& Node = Octree.GetNode(NodeStack.back());
+                    NodeStack.pop_back();
+
+                    if (CalculateBoxGapSquared(Node.Center, Node.Radius, Bucket.Center, Bucket.Radius) > Margin * Margin)
+                    {
+                        continue;
+                    }
+
+                    if (Node.PointCount > BucketSize && !Node.IsLeafNode())
+                    {
+                        for (int Octant = 0; Octant != 8; ++Octant)
+                        {
+                            std::uint32_t Child = Node.GetChildIndex(Octant);
+                            if (Child != Octree.kNoIndex)
+                            {
+                                NodeStack.push_back(Child);
+                            }
+                        }
+
+                        continue;
+                    }
+
+                    auto Points = Octree.GetSubtreePoints(Node);
+                    auto Links  = Octree.GetSubtreeLinks(Node);
+                    for (std::size_t i = 0; i != Points.size(); ++i)
+                    {
+                        CandidatePoints.push_back(Points[i]);
+                        CandidateIndices.push_back(static_cast<std::uint32_t>(Links[i] - Positions.data()));
+                    }
+                }
+
+                // 只有 Margin 以内的点可能进入结果，候选集包含所有点时只受跳跃距离限制
+                float       Threshold      = bComplete ? MaxJumpSquared : std::min(Margin * Margin, MaxJumpSquared);
+                std::size_t RemainingCount = 0;
+                for (std::uint32_t PointIndex : Pending)
+                {
+                    glm::vec3     Point = BucketPoints[PointIndex];
+                    std::uint32_t Self  = static_cast<std::uint32_t>(BucketLinks[PointIndex] - Positions.data());
+
+                    Best.clear();
+                    for (std::size_t i = 0; i != CandidatePoints.size(); ++i)
+                    {
+                        glm::vec3 Delta           = CandidatePoints[i] - Point;
+                        float     DistanceSquared = glm::dot(Delta, Delta);
+                        if (DistanceSquared <= Threshold && CandidateIndices[i] != Self)
+                        {
+                            Best.emplace_back(DistanceSquared, CandidateIndices[i]);
+                        }
+                    }
+
+                    // 受 Margin 限制且不足 K 个时，Margin 之外可能还有更近的点
+                    if (Best.size() < K && Threshold < MaxJumpSquared)
+                    {
+                        Pending[RemainingCount++] = PointIndex;
+                        continue;
+                    }
+
+                    if (Best.size() > K)
+                    {
+                        std::nth_element(Best.begin(), Best.begin() + K, Best.end());
+                        Best.resize(K);
+                    }
+
+                    std::sort(Best.begin(), Best.end());
+                    for (std::size_t i = 0; i != Best.size(); ++i)
+                    {
+                        Slots[Self * K + i]         = Best[i].second;
+                        SlotDistances[Self * K + i] = std::sqrt(Best[i].first);
+                    }
+
+                    SlotCounts[Self] = static_cast<std::uint32_t>(Best.size());
+                }
+
+                Pending.resize(RemainingCount);
+            }
+        }
+    });
+}
+
+void FNeighbourGraph::FindRouteImpl(const FRouteRequest& Request, FRouteScratch& Scratch, FRoute& Route) const
+{
+    if (Request.Source >= _Positions.size() || Request.Target >= _Positions.size())
+    {
+        throw std::out_of_range("Route endpoint out of range of the neighbour graph.");
+    }
+
+    Route.Systems.clear();
+    Route.Distance      = 0.0f;
+    Route.ExpandedCount = 0;
+
+    auto& Visits   = Scratch.Visits;
+    auto& OpenList = Scratch.OpenList;
+    Visits.clear();
+    OpenList.clear();
+
+    glm::vec3 Goal   = _Positions[Request.Target];
+    float     Weight = std::max(Request.HeuristicWeight, 1.0f);
+    auto Heuristic = [&](std::uint32_t Index) -> float
+    {
+        return Weight * glm::length(_Positions[Index] - Goal);
+    };
+
+    auto Compare = [](const FOpenEntry& Lhs, const FOpenEntry& Rhs) -> bool
+    {
+        return Lhs.Estimate > Rhs.Estimate;
+    };
+
+    Visits.emplace(Request.Source, FVisit{ 0.0f, kInvalidIndex });
+    OpenList.push_back({ Heuristic(Request.Source), 0.0f, Request.Source });
+
+    while (!OpenList.empty())
+    {
+        std::pop_heap(OpenList.begin(), OpenList.end(), Compare);
+        FOpenEntry Entry = OpenList.back();
+        OpenList.pop_back();
+
+        // 同一节点可能多次入堆，只处理代价最新的一次
+        if (Entry.Cost > Visits.find(Entry.Index)->second.Cost)
+        {
+            continue;
+        }
+
+        if (Request.MaxExpandedCount != 0 && Route.ExpandedCount == Request.MaxExpandedCount)
+        {
+            return;
+        }
+
+        ++Route.ExpandedCount;
+        if (Entry.Index == Request.Target)
+        {
+            for (std::uint32_t Index = Entry.Index; Index != kInvalidIndex; Index = Visits.find(Index)->second.Parent)
+            {
+                Route.Systems.push_back(Index);
+            }
+
+            std::reverse(Route.Systems.begin(), Route.Systems.end());
+            Route.Distance = Entry.Cost;
+            return;
+        }
+
+        auto Neighbours = GetNeighbours(Entry.Index);
+        auto Distances  = GetJumpDistances(Entry.Index);
+        for (std::size_t i = 0; i != Neighbours.size(); ++i)
+        {
+            // 边按距离升序存放，超出跳跃距离后的边都不可用
+            if (Distances[i] > Request.MaxJumpDistance)
+            {
+                break;
+            }
+
+            float Cost = Entry.Cost + Distances[i];
+            auto [It, bInserted] = Visits.try_emplace(Neighbours[i], FVisit{ Cost, Entry.Index });
+            if (!bInserted)
+            {
+                if (Cost >= It->second.Cost)
+                {
+                    continue;
+                }
+
+                It->second = { Cost, Entry.Index };
+            }
+
+            OpenList.push_back({ Cost + Heuristic(Neighbours[i]), Cost, Neighbours[i] });
+            std::push_heap(OpenList.begin(), OpenList.end(), Compare);
+        }
+    }
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// 恒星系统邻接图，以压缩稀疏行（CSR）格式存储。每个系统连向最近的 MaxNeighbours 个、距离不超过 MaxJumpDistance 的系统，
+// 边权为欧氏距离；对称模式下补上反向边，使图成为无向图。系统编号即构建时 Positions 中的下标
+class FNeighbourGraph
+{
+public:
+    static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct FBuildInfo
+    {
+        std::size_t MaxNeighbours{ 8 };
+        float       MaxJumpDistance{ std::numeric_limits<float>::infinity() };
+        bool        bSymmetric{ true };
+        int         MaxDepth{};  // 线性八叉树深度，0 表示按点数自动选择
+    };
+
+    struct FRouteRequest
+    {
+        std::uint32_t Source{};
+        std::uint32_t Target{};
+        float         MaxJumpDistance{ std::numeric_limits<float>::infinity() }; // 只在图中边的基础上进一步收紧
+        float         HeuristicWeight{ 1.0f };  // 大于 1 时为加权 A*，路径长度不超过最短路径的该倍数，展开的节点少得多
+        std::size_t   MaxExpandedCount{};       // 展开节点数上限，超出后视为不可达，0 表示不限制
+    };
+
+    struct FRoute
+    {
+        std::vector<std::uint32_t> Systems;  // 含起点和终点，不可达时为空
+        float                      Distance{};
+        std::size_t                ExpandedCount{};
+    };
+
+public:
+    FNeighbourGraph() = default;
+    FNeighbourGraph(const FNeighbourGraph&) = delete;
+    FNeighbourGraph(FNeighbourGraph&&) noexcept = default;
+    ~FNeighbourGraph() = default;
+
+    FNeighbourGraph& operator=(const FNeighbourGraph&) = delete;
+    FNeighbourGraph& operator=(FNeighbourGraph&&) noexcept = default;
+
+    // 用线性八叉树并行求 k 近邻后重建整张图，ThreadCount 为 0 时使用线程池的全部线程
+    void Build(std::span<const glm::vec3> Positions, const FBuildInfo& BuildInfo, int ThreadCount = 0);
+
+    // A* 最短路径，启发函数为到终点的直线距离
+    FRoute FindRoute(const FRouteRequest& Request) const;
+    void FindRoutes(std::span<const FRouteRequest> Requests, std::vector<FRoute>& Results, int ThreadCount = 0) const;
+
+    std::span<const std::uint32_t> GetNeighbours(std::uint32_t Index) const;
+    std::span<const float> GetJumpDistances(std::uint32_t Index) const; // 与 GetNeighbours 一一对应，升序
+    glm::vec3 GetPosition(std::uint32_t Index) const;
+    std::size_t GetSystemCount() const;
+    std::size_t GetEdgeCount() const;
+    std::size_t GetMemoryUsage() const;
+    const FBuildInfo& GetBuildInfo() const;
+
+private:
+    struct FVisit
+    {
+        float         Cost;
+        std::uint32_t Parent;
+    };
+
+    struct FOpenEntry
+    {
+        float         Estimate;
+        float         Cost;
+        std::uint32_t Index;
+    };
+
+    // 批量查询时每个线程复用，避免每条路径重新分配
+    struct FRouteScratch
+    {
+        std::unordered_map<std::uint32_t, FVisit> Visits;
+        std::vector<FOpenEntry>                   OpenList;
+    };
+
+    void FindNearestNeighbours(std::span<const glm::vec3> Positions, std::vector<std::uint32_t>& Slots,
+                               std::vector<float>& SlotDistances, std::vector<std::uint32_t>& SlotCounts,
+                               std::size_t ChunkCount) const;
+
+    void FindRouteImpl(const FRouteRequest& Request, FRouteScratch& Scratch, FRoute& Route) const;
+
+private:
+    std::vector<std::uint64_t> _Offsets;   // 系统 i 的边位于 [_Offsets[i], _Offsets[i + 1])
+    std::vector<std::uint32_t> _Targets;
+    std::vector<float>         _Distances;
+    std::vector<glm::vec3>     _Positions;
+    FBuildInfo                 _BuildInfo;
+};
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
+
+#include "NeighbourGraph.inl"
@@ -0,0 +1,45 @@
+#include "NeighbourGraph.h"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+NPGS_INLINE std::span<const std::uint32_t> FNeighbourGraph::GetNeighbours(std::uint32_t Index) const
+{
+    return { _Targets.data() + _Offsets[Index], static_cast<std::size_t>(_Offsets[Index + 1] - _Offsets[Index]) };
+}
+
+NPGS_INLINE std::span<const float> FNeighbourGraph::GetJumpDistances(std::uint32_t Index) const
+{
+    return { _Distances.data() + _Offsets[Index], static_cast<std::size_t>(_Offsets[Index + 1] - _Offsets[Index]) };
+}
+
+NPGS_INLINE glm::vec3 FNeighbourGraph::GetPosition(std::uint32_t Index) const
+{
+    return _Positions[Index];
+}
+
+NPGS_INLINE std::size_t FNeighbourGraph::GetSystemCount() const
+{
+    return _Positions.size();
+}
+
+NPGS_INLINE std::size_t FNeighbourGraph::GetEdgeCount() const
+{
+    return _Targets.size();
+}
+
+NPGS_INLINE std::size_t FNeighbourGraph::GetMemoryUsage() const
+{
+    return _Offsets.capacity() * sizeof(std::uint64_t) + _Targets.capacity() * sizeof(std::uint32_t) +
+           _Distances.capacity() * sizeof(float) + _Positions.capacity() * sizeof(glm::vec3);
+}
+
+NPGS_INLINE const FNeighbourGraph::FBuildInfo& FNeighbourGraph::GetBuildInfo() const
+{
+    return _BuildInfo;
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
@@ -1,22 +1,61 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <future>
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include <glm/glm.hpp>
 
 #include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Math/NumericConstants.h"
 #include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/System/Spatial/Culling.h"
 
 _NPGS_BEGIN
 _SYSTEM_BEGIN
 _SPATIAL_BEGIN
 
+// 节点子树中所有光源的汇总，单个链接对象也用它描述（Count 为 1）
+struct FNodeAggregate
+{
+    glm::vec3     Centroid{};      // 光度加权的位置
+    float         Luminosity{};    // 总光度
+    float         MaxLuminosity{}; // 子树中最亮的单个光源
+    float         Teff{};          // 光度加权的有效温度，用于着色
+    std::uint32_t Count{};
+
+    // 合并另一组光源，位置和温度按光度加权，两边都不发光时按数量加权
+    void Merge(const FNodeAggregate& Other)
+    {
+        float Weight      = Luminosity;
+        float OtherWeight = Other.Luminosity;
+        if (Weight + OtherWeight <= 0.0f)
+        {
+            Weight      = static_cast<float>(Count);
+            OtherWeight = static_cast<float>(Other.Count);
+        }
+
+        if (Weight + OtherWeight > 0.0f)
+        {
+            float InverseWeight = 1.0f / (Weight + OtherWeight);
+            Centroid = (Centroid * Weight + Other.Centroid * OtherWeight) * InverseWeight;
+            Teff     = (Teff * Weight + Other.Teff * OtherWeight) * InverseWeight;
+        }
+
+        Luminosity   += Other.Luminosity;
+        MaxLuminosity = std::max(MaxLuminosity, Other.MaxLuminosity);
+        Count        += Other.Count;
+    }
+};
+
 template <typename LinkTargetType>
 class TOctreeNode
 {
@@ -55,11 +94,37 @@ public:
         return Distance <= Radius;
     }
 
+    // 点到节点包围盒的距离平方，点在盒内时为 0
+    float CalculateDistanceSquared(glm::vec3 Point) const
+    {
+        glm::vec3 Delta = glm::max(glm::abs(Point - _Center) - glm::vec3(_Radius), glm::vec3(0.0f));
+        return glm::dot(Delta, Delta);
+    }
+
+    // 点到节点包围盒最远角的距离平方
+    float CalculateMaxDistanceSquared(glm::vec3 Point) const
+    {
+        glm::vec3 Delta = glm::abs(Point - _Center) + glm::vec3(_Radius);
+        return glm::dot(Delta, Delta);
+    }
+
     const bool IsValid() const
     {
         return _bIsValid;
     }
 
+    // 子树中的点数，由 AddPoint、DeletePoint 和 RemoveStorage 沿父节点链增量维护
+    std::size_t GetPointCount() const
+    {
+        return _PointCount;
+    }
+
+    // 子树中有效叶子节点的数量
+    std::size_t GetValidLeafCount() const
+    {
+        return _ValidLeafCount;
+    }
+
     glm::vec3 GetCenter() const
     {
         return _Center;
@@ -93,22 +158,70 @@ public:
     void AddPoint(glm::vec3 Point)
     {
         _Points.push_back(Point);
+        AdjustCounts(1, 0);
     }
 
-    void DeletePoint(glm::vec3 Point)
+    bool DeletePoint(glm::vec3 Point)
     {
         auto it = std::find(_Points.begin(), _Points.end(), Point);
-        if (it != _Points.end())
+        if (it == _Points.end())
         {
-            _Points.erase(it);
+            return false;
         }
+
+        _Points.erase(it);
+        AdjustCounts(-1, 0);
+        return true;
     }
 
     void RemoveStorage()
     {
+        AdjustCounts(-static_cast<std::ptrdiff_t>(_Points.size()), 0);
         _Points.clear();
     }
 
+    // 把增量加到本节点和所有祖先节点的计数上，遇到设置了计数屏障的节点时停止
+    void AdjustCounts(std::ptrdiff_t PointDelta, std::ptrdiff_t ValidLeafDelta)
+    {
+        for (TOctreeNode* Node = this; Node != nullptr; Node = Node->_Previous)
+        {
+            Node->_PointCount     += static_cast<std::size_t>(PointDelta);
+            Node->_ValidLeafCount += static_cast<std::size_t>(ValidLeafDelta);
+            if (Node->_bCountBarrier)
+            {
+                break;
+            }
+        }
+    }
+
+    // 并行遍历时在各任务子树的根上设置，避免不同线程同时修改共同祖先的计数，遍历结束后由树重算上层
+    void SetCountBarrier(bool bBarrier)
+    {
+        _bCountBarrier = bBarrier;
+    }
+
+    // 只根据自身和直接子节点重算计数，不向上传播，供并行自底向上建树使用
+    void RecalculateCounts()
+    {
+        if (IsLeafNode())
+        {
+            _PointCount     = _Points.size();
+            _ValidLeafCount = _bIsValid ? 1 : 0;
+            return;
+        }
+
+        _PointCount     = _Points.size();
+        _ValidLeafCount = 0;
+        for (const auto& Next : _Next)
+        {
+            if (Next != nullptr)
+            {
+                _PointCount     += Next->_PointCount;
+                _ValidLeafCount += Next->_ValidLeafCount;
+            }
+        }
+    }
+
     void AddLink(LinkTargetType* Target)
     {
         _DataLink.push_back(Target);
@@ -133,9 +246,19 @@ public:
         _DataLink.clear();
     }
 
-    std::vector<glm::vec3>& GetPoints()
+    const std::vector<LinkTargetType*>& GetLinks() const
     {
-        return _Points;
+        return _DataLink;
+    }
+
+    const FNodeAggregate& GetAggregate() const
+    {
+        return _Aggregate;
+    }
+
+    void SetAggregate(const FNodeAggregate& Aggregate)
+    {
+        _Aggregate = Aggregate;
     }
 
     const std::vector<glm::vec3>& GetPoints() const
@@ -145,6 +268,11 @@ public:
 
     void SetValidation(bool bValidation)
     {
+        if (_bIsValid != bValidation && IsLeafNode())
+        {
+            AdjustCounts(0, bValidation ? 1 : -1);
+        }
+
         _bIsValid = bValidation;
     }
 
@@ -166,10 +294,27 @@ private:
     TOctreeNode* _Previous;
     float        _Radius;
     bool         _bIsValid{ true };
+    bool         _bCountBarrier{ false };
+    std::size_t  _PointCount{};
+    std::size_t  _ValidLeafCount{ 1 };
 
     std::array<std::unique_ptr<TOctreeNode>, 8> _Next;
     std::vector<glm::vec3>                      _Points;
     std::vector<LinkTargetType*>                _DataLink;
+    FNodeAggregate                              _Aggregate;
+};
+
+// 可见性查询的结果。Target 为空时表示整棵子树合并成的一个汇总光源
+template <typename LinkTargetType>
+struct TVisibleSource
+{
+    const TOctreeNode<LinkTargetType>* Node{};
+    LinkTargetType*                    Target{};
+    glm::vec3                          Position{};
+    float                              Luminosity{};
+    float                              Flux{};  // Luminosity / Distance^2
+    float                              Teff{};
+    std::uint32_t                      Count{};
 };
 
 template <typename LinkTargetType>
@@ -178,6 +323,8 @@ class TOctree
 public:
     using FNodeType = TOctreeNode<LinkTargetType>;
 
+    static constexpr std::size_t kLeafBlockSize = 16; // 叶子节点中的点按块计算距离
+
 public:
     TOctree(glm::vec3 Center, float Radius, int MaxDepth = 8)
         :
@@ -190,7 +337,7 @@ public:
     void BuildEmptyTree(float LeafRadius)
     {
         int Depth = static_cast<int>(std::ceil(std::log2(_Root->GetRadius() / LeafRadius)));
-        BuildEmptyTreeImpl(_Root.get(), LeafRadius, Depth);
+        _NodeCount += BuildEmptyTreeImpl(_Root.get(), LeafRadius, Depth);
     }
 
     void Insert(glm::vec3 Point)
@@ -198,20 +345,157 @@ public:
         InsertImpl(_Root.get(), Point, 0);
     }
 
-    void Delete(glm::vec3 Point)
+    bool Delete(glm::vec3 Point)
     {
-        DeleteImpl(_Root.get(), Point);
+        return DeleteImpl(_Root.get(), Point);
     }
 
+    // 在 Node 的第 Index 个位置创建半径减半的子节点，已存在时直接返回，用于按保存的结构重建
+    FNodeType* CreateChild(FNodeType* Node, int Index, glm::vec3 Center)
+    {
+        auto& Next = Node->GetNext(Index);
+        if (Next != nullptr)
+        {
+            return Next.get();
+        }
+
+        // 第一个子节点使原来的叶子变为内部节点
+        std::ptrdiff_t ValidLeafDelta = Node->IsLeafNode() && Node->IsValid() ? 0 : 1;
+        Next = std::make_unique<FNodeType>(Center, Node->GetRadius() * 0.5f, Node);
+        Node->AdjustCounts(0, ValidLeafDelta);
+        ++_NodeCount;
+
+        return Next.get();
+    }
+
+    // 收集与 Point 距离不超过 Radius 的点，与 Point 坐标完全相同的点不计入
     void Query(glm::vec3 Point, float Radius, std::vector<glm::vec3>& Results) const
     {
-        QueryImpl(_Root.get(), Point, Radius, Results);
+        QueryImpl(_Root.get(), Point, Radius * Radius, Results);
+    }
+
+    // 按距离升序收集离 Point 最近的 K 个点，与 Point 坐标完全相同的点不计入
+    // 按节点包围盒距离由近到远访问，当前第 K 近的距离小于下一个节点的距离时停止
+    void QueryNearest(glm::vec3 Point, std::size_t K, std::vector<glm::vec3>& Results) const
+    {
+        Results.clear();
+        if (K == 0)
+        {
+            return;
+        }
+
+        using FNodeEntry  = std::pair<float, const FNodeType*>;
+        using FPointEntry = std::pair<float, glm::vec3>;
+        auto CompareNode  = [](const FNodeEntry& Lhs, const FNodeEntry& Rhs) -> bool { return Lhs.first > Rhs.first; };
+        auto ComparePoint = [](const FPointEntry& Lhs, const FPointEntry& Rhs) -> bool { return Lhs.first < Rhs.first; };
+
+        std::vector<FNodeEntry>  NodeHeap;  // 最小堆，待访问的节点
+        std::vector<FPointEntry> PointHeap; // 最大堆，当前最近的 K 个点
+        std::array<float, kLeafBlockSize> DistanceSquared{};
+
+        NodeHeap.emplace_back(_Root->CalculateDistanceSquared(Point), _Root.get());
+        while (!NodeHeap.empty())
+        {
+            std::pop_heap(NodeHeap.begin(), NodeHeap.end(), CompareNode);
+            auto [NodeDistanceSquared, Node] = NodeHeap.back();
+            NodeHeap.pop_back();
+
+            if (PointHeap.size() == K && NodeDistanceSquared > PointHeap.front().first)
+            {
+                break;
+            }
+
+            const auto& Points = Node->GetPoints();
+            for (std::size_t Begin = 0; Begin < Points.size(); Begin += kLeafBlockSize)
+            {
+                std::size_t Count = CalculateBlockDistances(Points, Begin, Point, DistanceSquared);
+                for (std::size_t i = 0; i != Count; ++i)
+                {
+                    if (Points[Begin + i] == Point)
+                    {
+                        continue;
+                    }
+
+                    if (PointHeap.size() < K)
+                    {
+                        PointHeap.emplace_back(DistanceSquared[i], Points[Begin + i]);
+                        std::push_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+                    }
+                    else if (DistanceSquared[i] < PointHeap.front().first)
+                    {
+                        std::pop_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+                        PointHeap.back() = { DistanceSquared[i], Points[Begin + i] };
+                        std::push_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+                    }
+                }
+            }
+
+            for (int i = 0; i != 8; ++i)
+            {
+                const FNodeType* NextNode = Node->GetNext(i).get();
+                if (NextNode == nullptr || NextNode->GetPointCount() == 0)
+                {
+                    continue;
+                }
+
+                float NextDistanceSquared = NextNode->CalculateDistanceSquared(Point);
+                if (PointHeap.size() < K || NextDistanceSquared <= PointHeap.front().first)
+                {
+                    NodeHeap.emplace_back(NextDistanceSquared, NextNode);
+                    std::push_heap(NodeHeap.begin(), NodeHeap.end(), CompareNode);
+                }
+            }
+        }
+
+        std::sort_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+        Results.reserve(PointHeap.size());
+        for (const auto& [Distance, StoredPoint] : PointHeap)
+        {
+            Results.push_back(StoredPoint);
+        }
+    }
+
+    // 批量查询，按查询点分块在线程池中并行，Results[i] 对应 Points[i]；ThreadCount 为 0 时使用全部线程
+    void QueryBatch(std::span<const glm::vec3> Points, float Radius, std::vector<std::vector<glm::vec3>>& Results,
+                    int ThreadCount = 0) const
+    {
+        Results.resize(Points.size());
+        Runtime::Thread::ParallelFor(Points.size(), CalculateQueryChunkCount(Points.size(), ThreadCount),
+        [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                Results[i].clear();
+                Query(Points[i], Radius, Results[i]);
+            }
+        });
+    }
+
+    void QueryNearestBatch(std::span<const glm::vec3> Points, std::size_t K, std::vector<std::vector<glm::vec3>>& Results,
+                           int ThreadCount = 0) const
+    {
+        Results.resize(Points.size());
+        Runtime::Thread::ParallelFor(Points.size(), CalculateQueryChunkCount(Points.size(), ThreadCount),
+        [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                QueryNearest(Points[i], K, Results[i]);
+            }
+        });
     }
 
+    // 从根节点开始只沿包含 Point 的节点向下查找，返回路径上第一个满足 Pred 的节点
+    // 点落在分割面上时相邻的几个子节点都包含它，这些子节点会依次尝试
     template <typename Func = std::function<bool(const FNodeType&)>>
     FNodeType* Find(glm::vec3 Point, Func&& Pred = [](const FNodeType&) -> bool { return true; }) const
     {
-        return FindImpl(_Root.get(), Point, std::forward<Func>(Pred));
+        if (!_Root->Contains(Point))
+        {
+            return nullptr;
+        }
+
+        return FindImpl(_Root.get(), Point, Pred);
     }
 
     template <typename Func>
@@ -220,14 +504,288 @@ public:
         TraverseImpl(_Root.get(), std::forward<Func>(Pred));
     }
 
+    // 并行先序遍历。按子树的点数加有效叶子数把树切成若干子树，连续的子树分成负载相近的块在线程池中执行，
+    // 块间的共同祖先先在调用线程中访问。Pred 只能修改传入的节点，其中 AddPoint 等对祖先计数的修改在遍历结束后统一重算
+    // 遍历期间会临时设置子树根的计数屏障并在结束后重算祖先计数，因此不是 const
+    template <typename Func>
+    void ParallelTraverse(Func&& Pred, int ThreadCount = 0)
+    {
+        struct FEmpty {};
+        ParallelReduce(FEmpty{}, [&Pred](FNodeType& Node, FEmpty&) -> void { Pred(Node); },
+                       [](FEmpty&, FEmpty&&) -> void {}, ThreadCount);
+    }
+
+    // 带归约的并行遍历，Pred(FNodeType&, AccumulatorType&)。每块使用一个以 Identity 初始化的累加器，
+    // 结束后按块的先后顺序用 Merge(AccumulatorType& Target, AccumulatorType&& Source) 合并，
+    // 叶子节点的合并顺序与 Traverse 的访问顺序相同
+    template <typename AccumulatorType, typename Func, typename MergeFunc>
+    AccumulatorType ParallelReduce(const AccumulatorType& Identity, Func&& Pred, MergeFunc&& Merge, int ThreadCount = 0)
+    {
+        if (ThreadCount <= 0)
+        {
+            ThreadCount = _ThreadPool->GetMaxThreadCount();
+        }
+
+        std::size_t ChunkCount  = static_cast<std::size_t>(ThreadCount) * 4;
+        std::size_t TotalWeight = CalculateTraverseWeight(_Root.get());
+
+        std::vector<FNodeType*> Upper;
+        std::vector<FNodeType*> Subtrees;
+        SplitTraverseTasks(_Root.get(), std::max<std::size_t>(1, TotalWeight / (ChunkCount * 2)), ThreadCount > 1, Upper, Subtrees);
+
+        AccumulatorType Result = Identity;
+        for (FNodeType* Node : Upper)
+        {
+            Pred(*Node, Result);
+        }
+
+        // 按权重前缀和把连续的子树划分成块
+        ChunkCount = std::min(ChunkCount, Subtrees.size());
+        std::vector<std::size_t> ChunkOffsets(ChunkCount + 1, Subtrees.size());
+        ChunkOffsets[0] = 0;
+        std::size_t Weight = 0;
+        std::size_t Chunk  = 1;
+        for (std::size_t i = 0; i != Subtrees.size() && Chunk != ChunkCount; ++i)
+        {
+            Weight += CalculateTraverseWeight(Subtrees[i]);
+            if (Weight * ChunkCount >= TotalWeight * Chunk)
+            {
+                ChunkOffsets[Chunk++] = i + 1;
+            }
+        }
+
+        for (FNodeType* Node : Subtrees)
+        {
+            Node->SetCountBarrier(true);
+        }
+
+        std::vector<AccumulatorType> Accumulators(ChunkCount, Identity);
+        Runtime::Thread::ParallelFor(ChunkCount, ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t Index = Begin; Index != End; ++Index)
+            {
+                AccumulatorType& Accumulator = Accumulators[Index];
+                for (std::size_t i = ChunkOffsets[Index]; i != ChunkOffsets[Index + 1]; ++i)
+                {
+                    TraverseImpl(Subtrees[i], [&](FNodeType& Node) -> void { Pred(Node, Accumulator); });
+                }
+            }
+        });
+
+        for (FNodeType* Node : Subtrees)
+        {
+            Node->SetCountBarrier(false);
+        }
+
+        // Upper 为先序，逆序重算保证子节点先于父节点
+        for (auto it = Upper.rbegin(); it != Upper.rend(); ++it)
+        {
+            (*it)->RecalculateCounts();
+        }
+
+        for (auto& Accumulator : Accumulators)
+        {
+            Merge(Result, std::move(Accumulator));
+        }
+
+        return Result;
+    }
+
+    // 自底向上汇总每个节点子树中的光源，Pred(LinkTargetType&) 返回单个链接对象的 FNodeAggregate
+    // 先按层展开到足够多的子树，各子树在线程池中并行汇总，再串行补齐上层节点；Pred 需要可以并发调用
+    template <typename Func>
+    void BuildAggregates(Func&& Pred, int ThreadCount = 0)
+    {
+        if (ThreadCount <= 0)
+        {
+            ThreadCount = _ThreadPool->GetMaxThreadCount();
+        }
+
+        // 广度优先展开，Upper 中父节点总在子节点之前
+        std::vector<FNodeType*> Upper;
+        std::vector<FNodeType*> Frontier{ _Root.get() };
+        std::size_t TargetSubtreeCount = static_cast<std::size_t>(ThreadCount) * 8;
+        while (ThreadCount > 1 && Frontier.size() < TargetSubtreeCount)
+        {
+            std::vector<FNodeType*> NextFrontier;
+            for (FNodeType* Node : Frontier)
+            {
+                for (int i = 0; i != 8; ++i)
+                {
+                    if (Node->GetNext(i) != nullptr)
+                    {
+                        NextFrontier.push_back(Node->GetNext(i).get());
+                    }
+                }
+            }
+
+            if (NextFrontier.empty())
+            {
+                break;
+            }
+
+            Upper.insert(Upper.end(), Frontier.begin(), Frontier.end());
+            Frontier = std::move(NextFrontier);
+        }
+
+        Runtime::Thread::ParallelFor(Frontier.size(), std::min(Frontier.size(), static_cast<std::size_t>(ThreadCount)),
+        [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                BuildAggregatesImpl(Frontier[i], Pred);
+            }
+        });
+
+        for (auto it = Upper.rbegin(); it != Upper.rend(); ++it)
+        {
+            RecalculateAggregate(*it, Pred);
+        }
+    }
+
+    // 链接对象的光度或位置变化后，重算 Node 及其所有祖先节点的汇总，代价与深度成正比
+    template <typename Func>
+    void UpdateAggregates(FNodeType* Node, Func&& Pred)
+    {
+        for (; Node != nullptr; Node = Node->GetPrevious())
+        {
+            RecalculateAggregate(Node, Pred);
+        }
+    }
+
+    // 汇总以 Point 为中心、Radius 为半径的球内的光源。完全在球内的节点直接取其汇总，
+    // 只有与球面相交的叶子节点才逐个检查链接对象，需要先调用 BuildAggregates
+    template <typename Func>
+    FNodeAggregate QueryAggregate(glm::vec3 Point, float Radius, Func&& Pred) const
+    {
+        FNodeAggregate Result;
+        float RadiusSquared = Radius * Radius;
+
+        std::vector<const FNodeType*> Stack{ _Root.get() };
+        while (!Stack.empty())
+        {
+            const FNodeType* Node = Stack.back();
+            Stack.pop_back();
+
+            if (Node->GetAggregate().Count == 0 || Node->CalculateDistanceSquared(Point) > RadiusSquared)
+            {
+                continue;
+            }
+
+            if (Node->CalculateMaxDistanceSquared(Point) <= RadiusSquared)
+            {
+                Result.Merge(Node->GetAggregate());
+                continue;
+            }
+
+            for (LinkTargetType* Target : Node->GetLinks())
+            {
+                FNodeAggregate Source = Pred(*Target);
+                glm::vec3 Offset = Source.Centroid - Point;
+                if (glm::dot(Offset, Offset) <= RadiusSquared)
+                {
+                    Result.Merge(Source);
+                }
+            }
+
+            for (int i = 0; i != 8; ++i)
+            {
+                const FNodeType* NextNode = Node->GetNext(i).get();
+                if (NextNode != nullptr)
+                {
+                    Stack.push_back(NextNode);
+                }
+            }
+        }
+
+        return Result;
+    }
+
+    // 收集 Volume（FFrustum 或 FViewCone）内按 Criteria 可见的光源，需要先调用 BuildAggregates
+    // 子树中最亮的光源也看不见，或子树张角小于 MinSolidAngle 时，整棵子树作为一个汇总光源，足够亮才计入
+    // 其余叶子节点逐个检查链接对象，Pred 与 BuildAggregates 中的相同
+    template <typename VolumeType, typename Func>
+    void QueryVisible(const VolumeType& Volume, const FVisibilityCriteria& Criteria, Func&& Pred,
+                      std::vector<TVisibleSource<LinkTargetType>>& Results) const
+    {
+        std::vector<const FNodeType*> Stack{ _Root.get() };
+        while (!Stack.empty())
+        {
+            const FNodeType* Node = Stack.back();
+            Stack.pop_back();
+
+            const FNodeAggregate& Aggregate = Node->GetAggregate();
+            if (Aggregate.Count == 0 || !Volume.IntersectBox(Node->GetCenter(), Node->GetRadius()))
+            {
+                continue;
+            }
+
+            // 最近处的最亮光源能否单独看见；外接球张角 pi * r^2 / d^2 是否小于阈值，叶子节点不合并
+            float MinDistanceSquared = Node->CalculateDistanceSquared(Criteria.Observer);
+            glm::vec3 CenterOffset = Node->GetCenter() - Criteria.Observer;
+            float CenterDistanceSquared = glm::dot(CenterOffset, CenterOffset);
+            float BoundRadiusSquared = 3.0f * Node->GetRadius() * Node->GetRadius();
+
+            bool bLeaf       = Node->IsLeafNode();
+            bool bResolvable = Aggregate.MaxLuminosity >= Criteria.MinFlux * MinDistanceSquared;
+            bool bSmall      = !bLeaf && CenterDistanceSquared > BoundRadiusSquared &&
+                               Math::kPi * BoundRadiusSquared < Criteria.MinSolidAngle * CenterDistanceSquared;
+
+            if (!bResolvable || bSmall)
+            {
+                glm::vec3 Offset = Aggregate.Centroid - Criteria.Observer;
+                float DistanceSquared = std::max(glm::dot(Offset, Offset), MinDistanceSquared);
+                if (DistanceSquared > 0.0f && Aggregate.Luminosity >= Criteria.MinFlux * DistanceSquared)
+                {
+                    Results.push_back({ Node, nullptr, Aggregate.Centroid, Aggregate.Luminosity,
+                                        Aggregate.Luminosity / DistanceSquared, Aggregate.Teff, Aggregate.Count });
+                }
+
+                continue;
+            }
+
+            if (bLeaf)
+            {
+                for (LinkTargetType* Target : Node->GetLinks())
+                {
+                    FNodeAggregate Source = Pred(*Target);
+                    glm::vec3 Offset = Source.Centroid - Criteria.Observer;
+                    float DistanceSquared = glm::dot(Offset, Offset);
+                    if (DistanceSquared > 0.0f && Volume.Contains(Source.Centroid) &&
+                        Source.Luminosity >= Criteria.MinFlux * DistanceSquared)
+                    {
+                        Results.push_back({ Node, Target, Source.Centroid, Source.Luminosity,
+                                            Source.Luminosity / DistanceSquared, Source.Teff, Source.Count });
+                    }
+                }
+
+                continue;
+            }
+
+            for (int i = 0; i != 8; ++i)
+            {
+                const FNodeType* NextNode = Node->GetNext(i).get();
+                if (NextNode != nullptr)
+                {
+                    Stack.push_back(NextNode);
+                }
+            }
+        }
+    }
+
     std::size_t GetCapacity() const
     {
-        return GetCapacityImpl(_Root.get());
+        return _Root->GetValidLeafCount();
     }
 
     std::size_t GetSize() const
     {
-        return GetSizeImpl(_Root.get());
+        return _Root->GetPointCount();
+    }
+
+    std::size_t GetNodeCount() const
+    {
+        return _NodeCount;
     }
 
     const FNodeType* const GetRoot() const
@@ -235,15 +793,27 @@ public:
         return _Root.get();
     }
 
+    FNodeType* GetRoot()
+    {
+        return _Root.get();
+    }
+
+    int GetMaxDepth() const
+    {
+        return _MaxDepth;
+    }
+
 private:
-    void BuildEmptyTreeImpl(FNodeType* Node, float LeafRadius, int Depth)
+    // 返回新建的节点数，计数在子树建完后自底向上重算，避免并行建树时争用祖先节点
+    std::size_t BuildEmptyTreeImpl(FNodeType* Node, float LeafRadius, int Depth)
     {
         if (Node->GetRadius() <= LeafRadius || Depth == 0)
         {
-            return;
+            return 0;
         }
 
-        std::vector<std::future<void>> Futures;
+        std::size_t NodeCount = 8;
+        std::vector<std::future<std::size_t>> Futures;
         float NextRadius = Node->GetRadius() * 0.5f;
         for (int i = 0; i != 8; ++i)
         {
@@ -258,14 +828,17 @@ private:
             }
             else
             {
-                BuildEmptyTreeImpl(Node->GetNext(i).get(), LeafRadius, Depth - 1);
+                NodeCount += BuildEmptyTreeImpl(Node->GetNext(i).get(), LeafRadius, Depth - 1);
             }
         }
 
         for (auto& Future : Futures)
         {
-            Future.get();
+            NodeCount += Future.get();
         }
+
+        Node->RecalculateCounts();
+        return NodeCount;
     }
 
     void InsertImpl(FNodeType* Node, glm::vec3 Point, int Depth)
@@ -275,6 +848,13 @@ private:
             return;
         }
 
+        // 最深一层直接存点，不再细分出空的子节点
+        if (Depth == _MaxDepth)
+        {
+            Node->AddPoint(Point);
+            return;
+        }
+
         if (Node->GetNext(0) == nullptr)
         {
             for (int i = 0; i != 8; ++i)
@@ -286,163 +866,227 @@ private:
                 NewCenter.z += (i & 1) ? Radius * 0.5f : -Radius * 0.5f;
                 Node->GetNext(i) = std::make_unique<FNodeType>(NewCenter, Radius * 0.5f, Node);
             }
+
+            // 原来的叶子变为 8 个有效的新叶子
+            _NodeCount += 8;
+            Node->AdjustCounts(0, 8 - (Node->IsValid() ? 1 : 0));
         }
 
-        int Octant = Node->CalculateOctant(Point);
-        if (Depth == _MaxDepth)
+        InsertImpl(FindContainingChild(Node, Point), Point, Depth + 1);
+    }
+
+    bool DeleteImpl(FNodeType* Node, glm::vec3 Point)
+    {
+        if (Node == nullptr || !Node->Contains(Point) || Node->GetPointCount() == 0)
         {
-            Node->AddPoint(Point);
+            return false;
         }
-        else
+
+        if (Node->DeletePoint(Point))
         {
-            InsertImpl(Node->GetNext(Octant).get(), Point, Depth + 1);
+            return true;
         }
-    }
 
-    void DeleteImpl(FNodeType* Node, glm::vec3 Point)
-    {
-        if (Node == nullptr)
+        // 点在分割面上时可能存放在任意一个相邻的子节点中
+        for (int i = 0; i != 8; ++i)
         {
-            return;
+            if (DeleteImpl(Node->GetNext(i).get(), Point))
+            {
+                return true;
+            }
         }
 
-        if (Node->Contains(Point))
+        return false;
+    }
+
+    void QueryImpl(const FNodeType* Node, glm::vec3 Point, float RadiusSquared, std::vector<glm::vec3>& Results) const
+    {
+        // 点只存放在叶子节点中，叶子节点同样需要检查
+        const auto& Points = Node->GetPoints();
+        std::array<float, kLeafBlockSize> DistanceSquared{};
+        for (std::size_t Begin = 0; Begin < Points.size(); Begin += kLeafBlockSize)
         {
-            if (Node->IsLeafNode())
+            std::size_t Count = CalculateBlockDistances(Points, Begin, Point, DistanceSquared);
+            for (std::size_t i = 0; i != Count; ++i)
             {
-                auto& Points = Node->GetPoints();
-                auto it = std::find(Points.begin(), Points.end(), Point);
-                if (it != Points.end())
+                if (DistanceSquared[i] <= RadiusSquared && Points[Begin + i] != Point)
                 {
-                    Points.erase(it);
+                    Results.push_back(Points[Begin + i]);
                 }
             }
-            else
-            {
-                int Octant = Node->CalculateOctant(Point);
-                DeleteImpl(Node->GetNext(Octant).get(), Point);
-            }
+        }
 
-            if (Node->IsLeafNode() && Node->GetPoints().empty())
+        for (int i = 0; i != 8; ++i)
+        {
+            const FNodeType* NextNode = Node->GetNext(i).get();
+            if (NextNode != nullptr && NextNode->GetPointCount() != 0 &&
+                NextNode->CalculateDistanceSquared(Point) <= RadiusSquared)
             {
-                for (int i = 0; i != 8; ++i)
-                {
-                    auto& Next = Node->GetNext(i);
-                    Next.reset();
-                }
+                QueryImpl(NextNode, Point, RadiusSquared, Results);
             }
         }
     }
 
-    void QueryImpl(FNodeType* Node, glm::vec3 Point, float Radius, std::vector<glm::vec3>& Results) const
+    // 先对一整块点只算距离平方，循环内没有分支，可以向量化；筛选放在第二个循环
+    static std::size_t CalculateBlockDistances(const std::vector<glm::vec3>& Points, std::size_t Begin, glm::vec3 Point,
+                                               std::array<float, kLeafBlockSize>& DistanceSquared)
     {
-        if (Node == nullptr || Node->GetNext(0) == nullptr)
+        std::size_t Count = std::min(kLeafBlockSize, Points.size() - Begin);
+        for (std::size_t i = 0; i != Count; ++i)
         {
-            return;
+            glm::vec3 Delta    = Points[Begin + i] - Point;
+            DistanceSquared[i] = Delta.x * Delta.x + Delta.y * Delta.y + Delta.z * Delta.z;
         }
 
-        for (const auto& StoredPoint : Node->GetPoints())
+        return Count;
+    }
+
+    std::size_t CalculateQueryChunkCount(std::size_t QueryCount, int ThreadCount) const
+    {
+        if (ThreadCount <= 0)
         {
-            if (glm::distance(StoredPoint, Point) <= Radius && StoredPoint != Point)
-            {
-                Results.push_back(StoredPoint);
-            }
+            ThreadCount = _ThreadPool->GetMaxThreadCount();
+        }
+
+        // 多分几块，避免查询代价不均时个别线程拖后
+        return std::min(QueryCount / 256 + 1, static_cast<std::size_t>(ThreadCount) * 4);
+    }
+
+    // 调用前 Node 已确定包含 Point
+    template <typename Func>
+    FNodeType* FindImpl(FNodeType* Node, glm::vec3 Point, Func& Pred) const
+    {
+        if (Pred(*Node))
+        {
+            return Node;
         }
 
         for (int i = 0; i != 8; ++i)
         {
             FNodeType* NextNode = Node->GetNext(i).get();
-            if (NextNode != nullptr && NextNode->IntersectSphere(Point, Radius))
+            if (NextNode == nullptr || !NextNode->Contains(Point))
             {
-                QueryImpl(NextNode, Point, Radius, Results);
+                continue;
+            }
+
+            FNodeType* ResultNode = FindImpl(NextNode, Point, Pred);
+            if (ResultNode != nullptr)
+            {
+                return ResultNode;
             }
         }
+
+        return nullptr;
     }
 
-    template <typename Func>
-    FNodeType* FindImpl(FNodeType* Node, glm::vec3 Point, Func&& Pred) const
+    // 优先取 CalculateOctant 对应的子节点；BuildEmptyTree 建出的子节点排列不同，此时退回逐个检查
+    static FNodeType* FindContainingChild(FNodeType* Node, glm::vec3 Point)
     {
-        if (Node == nullptr)
+        FNodeType* Child = Node->GetNext(Node->CalculateOctant(Point)).get();
+        if (Child->Contains(Point))
         {
-            return nullptr;
+            return Child;
         }
 
-        if (Node->Contains(Point))
+        for (int i = 0; i != 8; ++i)
         {
-            if (Pred(*Node))
+            if (Node->GetNext(i)->Contains(Point))
             {
-                return Node;
+                return Node->GetNext(i).get();
             }
         }
 
+        return Child;
+    }
+
+    template <typename Func>
+    void BuildAggregatesImpl(FNodeType* Node, Func& Pred)
+    {
         for (int i = 0; i != 8; ++i)
         {
-            FNodeType* ResultNode = FindImpl(Node->GetNext(i).get(), Point, Pred);
-            if (ResultNode != nullptr)
+            FNodeType* NextNode = Node->GetNext(i).get();
+            if (NextNode != nullptr)
             {
-                return ResultNode;
+                BuildAggregatesImpl(NextNode, Pred);
             }
         }
 
-        return nullptr;
+        RecalculateAggregate(Node, Pred);
     }
 
+    // 只根据本节点的链接对象和直接子节点的汇总重算，不向上传播
     template <typename Func>
-    void TraverseImpl(FNodeType* Node, Func&& Pred) const
+    static void RecalculateAggregate(FNodeType* Node, Func& Pred)
     {
-        if (Node == nullptr)
+        FNodeAggregate Aggregate;
+        for (LinkTargetType* Target : Node->GetLinks())
         {
-            return;
+            Aggregate.Merge(Pred(*Target));
         }
 
-        Pred(*Node);
-
         for (int i = 0; i != 8; ++i)
         {
-            TraverseImpl(Node->GetNext(i).get(), Pred);
+            const FNodeType* NextNode = Node->GetNext(i).get();
+            if (NextNode != nullptr)
+            {
+                Aggregate.Merge(NextNode->GetAggregate());
+            }
         }
-    }
 
-    std::size_t GetCapacityImpl(const FNodeType* Node) const
-    {
-        if (Node == nullptr)
+        if (Aggregate.Count == 0)
         {
-            return 0;
+            Aggregate.Centroid = Node->GetCenter();
         }
 
-        if (Node->GetNext(0) == nullptr)
+        Node->SetAggregate(Aggregate);
+    }
+
+    static std::size_t CalculateTraverseWeight(const FNodeType* Node)
+    {
+        return Node->GetPointCount() + Node->GetValidLeafCount();
+    }
+
+    // 权重超过 MaxWeight 的内部节点继续拆分，放入 Upper；其余作为整棵子树的任务，两者都保持先序
+    static void SplitTraverseTasks(FNodeType* Node, std::size_t MaxWeight, bool bSplit,
+                                   std::vector<FNodeType*>& Upper, std::vector<FNodeType*>& Subtrees)
+    {
+        if (!bSplit || Node->IsLeafNode() || CalculateTraverseWeight(Node) <= MaxWeight)
         {
-            return Node->IsValid() ? 1 : 0;
+            Subtrees.push_back(Node);
+            return;
         }
 
-        std::size_t Capacity = 0;
+        Upper.push_back(Node);
         for (int i = 0; i != 8; ++i)
         {
-            Capacity += GetCapacityImpl(Node->GetNext(i).get());
+            FNodeType* NextNode = Node->GetNext(i).get();
+            if (NextNode != nullptr)
+            {
+                SplitTraverseTasks(NextNode, MaxWeight, bSplit, Upper, Subtrees);
+            }
         }
-
-        return Capacity;
     }
 
-    std::size_t GetSizeImpl(const FNodeType* Node) const
+    template <typename Func>
+    void TraverseImpl(FNodeType* Node, Func&& Pred) const
     {
         if (Node == nullptr)
         {
-            return 0;
+            return;
         }
 
-        std::size_t Size = Node->GetPoints().size();
+        Pred(*Node);
+
         for (int i = 0; i != 8; ++i)
         {
-            Size += GetSizeImpl(Node->GetNext(i).get());
+            TraverseImpl(Node->GetNext(i).get(), Pred);
         }
-
-        return Size;
     }
 
 private:
     std::unique_ptr<FNodeType>    _Root;
     Runtime::Thread::FThreadPool* _ThreadPool;
+    std::size_t                   _NodeCount{ 1 };
     int                           _MaxDepth;
 };
 
@@ -0,0 +1,218 @@
+#include "OctreeImage.h"
+
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::size_t kSectionAlignment = 16;
+
+    std::size_t AlignUp(std::size_t Size)
+    {
+        return (Size + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+    }
+
+    // 按除法比较，数量被篡改为极大值时不会溢出
+    bool IsSectionInside(std::uint64_t Offset, std::uint64_t Count, std::size_t ElementSize, std::uint64_t BlobSize)
+    {
+        return Offset % kSectionAlignment == 0 && Offset <= BlobSize && Count <= (BlobSize - Offset) / ElementSize;
+    }
+
+    bool IsRangeInside(std::uint32_t Begin, std::uint32_t Count, std::uint64_t Size)
+    {
+        return static_cast<std::uint64_t>(Begin) + Count <= Size;
+    }
+}
+
+// FOctreeImage implementations
+// ----------------------------
+FOctreeImage::FOctreeImage(const std::byte* Blob, std::size_t Size)
+    : _Blob(Blob)
+{
+    if (Size < sizeof(FBlobHeader))
+    {
+        throw std::invalid_argument("Blob is too small for an octree image.");
+    }
+
+    const FBlobHeader* Header = GetHeader();
+    if (Header->Magic != _kMagic || Header->Version != _kVersion)
+    {
+        throw std::invalid_argument("Blob is not an octree image of a supported version.");
+    }
+
+    if (Header->BlobSize > Size || Header->NodeCount == 0 ||
+        !IsSectionInside(Header->NodeOffset,  Header->NodeCount,  sizeof(FNodeRecord),   Header->BlobSize) ||
+        !IsSectionInside(Header->PointOffset, Header->PointCount, sizeof(glm::vec3),     Header->BlobSize) ||
+        !IsSectionInside(Header->LinkOffset,  Header->LinkCount,  sizeof(std::uint32_t), Header->BlobSize))
+    {
+        throw std::invalid_argument("Octree image is truncated.");
+    }
+
+    if (Header->NodeCount >= kInvalidIndex || Header->SystemCount >= kInvalidIndex)
+    {
+        throw std::invalid_argument("Octree image counts exceed the format limits.");
+    }
+
+    ValidateNodes();
+}
+
+void FOctreeImage::Save(const std::string& Filename) const
+{
+    std::ofstream File(Filename, std::ios::binary | std::ios::trunc);
+    if (!File.is_open())
+    {
+        throw std::runtime_error("Failed to open file for writing: " + Filename);
+    }
+
+    auto Blob = GetBlob();
+    File.write(reinterpret_cast<const char*>(Blob.data()), static_cast<std::streamsize>(Blob.size()));
+    if (!File.good())
+    {
+        throw std::runtime_error("Failed to write octree image: " + Filename);
+    }
+}
+
+void FOctreeImage::Query(glm::vec3 Point, float Radius, std::vector<glm::vec3>& Results) const
+{
+    float RadiusSquared = Radius * Radius;
+
+    std::vector<std::uint32_t> Stack{ 0 };
+    while (!Stack.empty())
+    {
+        std::uint32_t Index = Stack.back();
+        Stack.pop_back();
+
+        const FNodeRecord& Node = GetNode(Index);
+        if (Node.SubtreePointCount == 0)
+        {
+            continue;
+        }
+
+        glm::vec3 Delta = glm::max(glm::abs(Point - Node.Center) - glm::vec3(Node.Radius), glm::vec3(0.0f));
+        if (glm::dot(Delta, Delta) > RadiusSquared)
+        {
+            continue;
+        }
+
+        for (glm::vec3 StoredPoint : GetPoints(Index))
+        {
+            glm::vec3 Offset = StoredPoint - Point;
+            if (glm::dot(Offset, Offset) <= RadiusSquared && StoredPoint != Point)
+            {
+                Results.push_back(StoredPoint);
+            }
+        }
+
+        for (int Octant = 7; Octant >= 0; --Octant)
+        {
+            std::uint32_t Child = GetChild(Index, Octant);
+            if (Child != kInvalidIndex)
+            {
+                Stack.push_back(Child);
+            }
+        }
+    }
+}
+
+void FOctreeImage::ValidateNodes() const
+{
+    const FBlobHeader* Header = GetHeader();
+
+    // 子节点须与生成时一样按层序连续分配，Rebuild 依赖父节点先于子节点出现
+    std::uint64_t NextChild = 1;
+    for (std::uint32_t i = 0; i != Header->NodeCount; ++i)
+    {
+        const FNodeRecord& Node = GetNode(i);
+        if (!IsRangeInside(Node.PointBegin, Node.PointCount, Header->PointCount) ||
+            !IsRangeInside(Node.LinkBegin,  Node.LinkCount,  Header->LinkCount))
+        {
+            throw std::invalid_argument("Octree image node references data out of range.");
+        }
+
+        if (Node.ChildMask == 0)
+        {
+            continue;
+        }
+
+        std::uint64_t ChildCount = std::popcount(static_cast<unsigned>(Node.ChildMask));
+        if (Node.FirstChild != NextChild || NextChild + ChildCount > Header->NodeCount)
+        {
+            throw std::invalid_argument("Octree image node references children out of order.");
+        }
+
+        for (std::uint64_t Child = NextChild; Child != NextChild + ChildCount; ++Child)
+        {
+            if (GetNode(static_cast<std::uint32_t>(Child)).Parent != i)
+            {
+                throw std::invalid_argument("Octree image child does not point back to its parent.");
+            }
+        }
+
+        NextChild += ChildCount;
+    }
+
+    if (NextChild != Header->NodeCount || GetNode(0).Parent != kInvalidIndex)
+    {
+        throw std::invalid_argument("Octree image contains unreachable nodes.");
+    }
+
+    const std::uint32_t* Links = reinterpret_cast<const std::uint32_t*>(_Blob + Header->LinkOffset);
+    for (std::uint64_t i = 0; i != Header->LinkCount; ++i)
+    {
+        if (Links[i] >= Header->SystemCount)
+        {
+            throw std::invalid_argument("Octree image link index exceeds the recorded system count.");
+        }
+    }
+}
+
+void FOctreeImage::Allocate(std::size_t NodeCount, std::size_t PointCount, std::size_t LinkCount, std::size_t SystemCount,
+                            int MaxDepth)
+{
+    std::size_t NodeOffset  = AlignUp(sizeof(FBlobHeader));
+    std::size_t PointOffset = AlignUp(NodeOffset  + NodeCount  * sizeof(FNodeRecord));
+    std::size_t LinkOffset  = AlignUp(PointOffset + PointCount * sizeof(glm::vec3));
+    std::size_t BlobSize    = AlignUp(LinkOffset  + LinkCount  * sizeof(std::uint32_t));
+
+    _Storage.assign(BlobSize, std::byte{ 0 });
+    _Blob = _Storage.data();
+
+    FBlobHeader* Header = reinterpret_cast<FBlobHeader*>(_Storage.data());
+    Header->Magic       = _kMagic;
+    Header->Version     = _kVersion;
+    Header->BlobSize    = BlobSize;
+    Header->NodeCount   = NodeCount;
+    Header->PointCount  = PointCount;
+    Header->LinkCount   = LinkCount;
+    Header->SystemCount = SystemCount;
+    Header->NodeOffset  = NodeOffset;
+    Header->PointOffset = PointOffset;
+    Header->LinkOffset  = LinkOffset;
+    Header->MaxDepth    = MaxDepth;
+}
+
+FOctreeImage::FNodeRecord* FOctreeImage::GetMutableNodes()
+{
+    return reinterpret_cast<FNodeRecord*>(_Storage.data() + GetHeader()->NodeOffset);
+}
+
+glm::vec3* FOctreeImage::GetMutablePoints()
+{
+    return reinterpret_cast<glm::vec3*>(_Storage.data() + GetHeader()->PointOffset);
+}
+
+std::uint32_t* FOctreeImage::GetMutableLinks()
+{
+    return reinterpret_cast<std::uint32_t*>(_Storage.data() + GetHeader()->LinkOffset);
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
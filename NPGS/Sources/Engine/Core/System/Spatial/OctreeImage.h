@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Spatial/Octree.hpp"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// TOctree 的不含指针的存档格式，所有数据位于一块连续内存中，可以直接放在映射的文件上查询而不需要反序列化
+// 节点按层序存放，每个节点的子节点连续存放；链接对象保存为调用方系统表中的下标，系统表的大小也记录在存档中
+class FOctreeImage
+{
+public:
+    static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct FNodeRecord
+    {
+        glm::vec3      Center;
+        float          Radius;
+        std::uint32_t  Parent;         // 根节点为 kInvalidIndex
+        std::uint32_t  FirstChild;     // 存在的子节点按 ChildMask 中置位的顺序连续存放
+        std::uint32_t  PointBegin;
+        std::uint32_t  PointCount;
+        std::uint32_t  LinkBegin;
+        std::uint32_t  LinkCount;
+        std::uint32_t  SubtreePointCount;
+        std::uint32_t  ValidLeafCount;
+        std::uint8_t   ChildMask;      // 第 i 位对应 TOctreeNode::GetNext(i)
+        std::uint8_t   bIsValid;
+        std::uint16_t  Reserved;
+        FNodeAggregate Aggregate;
+    };
+
+public:
+    // 从树生成存档，GetLinkIndex(const LinkTargetType*) 返回链接对象在大小为 SystemCount 的系统表中的下标
+    template <typename LinkTargetType, typename Func>
+    FOctreeImage(const TOctree<LinkTargetType>& Octree, std::size_t SystemCount, Func&& GetLinkIndex);
+
+    // 不持有数据，Blob 须保持有效。构造时检查文件头和每个节点的子节点、点和链接范围以及链接下标，格式不符时抛出异常，
+    // 之后的查询和重建不再检查
+    FOctreeImage(const std::byte* Blob, std::size_t Size);
+    FOctreeImage(const FOctreeImage&) = delete;
+    FOctreeImage(FOctreeImage&&) noexcept = default;
+    ~FOctreeImage() = default;
+
+    FOctreeImage& operator=(const FOctreeImage&) = delete;
+    FOctreeImage& operator=(FOctreeImage&&) noexcept = default;
+
+    void Save(const std::string& Filename) const;
+
+    // 按存档重建树，链接指向 Table 中对应下标的对象；Table 的大小与存档记录的系统数不同时抛出异常
+    template <typename LinkTargetType>
+    std::unique_ptr<TOctree<LinkTargetType>> Rebuild(std::span<LinkTargetType> Table) const;
+
+    // 逐节点比较存档与树的结构、点、链接下标、计数和汇总
+    template <typename LinkTargetType, typename Func>
+    bool Validate(const TOctree<LinkTargetType>& Octree, Func&& GetLinkIndex) const;
+
+    // 与 TOctree::Find 相同，只沿包含 Point 的节点向下，返回第一个满足 Pred(const FNodeRecord&) 的节点下标
+    template <typename Func>
+    std::uint32_t Find(glm::vec3 Point, Func&& Pred) const;
+
+    // 与 TOctree::Query 相同，与 Point 坐标完全相同的点不计入
+    void Query(glm::vec3 Point, float Radius, std::vector<glm::vec3>& Results) const;
+
+    const FNodeRecord& GetNode(std::uint32_t Index) const;
+    std::uint32_t GetChild(std::uint32_t Index, int Octant) const;
+    std::span<const glm::vec3> GetPoints(std::uint32_t Index) const;
+    std::span<const std::uint32_t> GetLinks(std::uint32_t Index) const;
+    std::size_t GetNodeCount() const;
+    std::size_t GetSystemCount() const;
+    std::size_t GetSize() const;
+    std::size_t GetCapacity() const;
+    int GetMaxDepth() const;
+    std::span<const std::byte> GetBlob() const;
+
+private:
+    struct FBlobHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t BlobSize;
+        std::uint64_t NodeCount;
+        std::uint64_t PointCount;
+        std::uint64_t LinkCount;
+        std::uint64_t SystemCount;
+        std::uint64_t NodeOffset;
+        std::uint64_t PointOffset;
+        std::uint64_t LinkOffset;
+        std::int32_t  MaxDepth;
+        std::uint32_t Reserved;
+    };
+
+    static constexpr std::uint32_t _kMagic   = 0x544F504E; // "NPOT"
+    static constexpr std::uint32_t _kVersion = 2;
+
+    void Allocate(std::size_t NodeCount, std::size_t PointCount, std::size_t LinkCount, std::size_t SystemCount, int MaxDepth);
+    void ValidateNodes() const;
+    bool Contains(const FNodeRecord& Node, glm::vec3 Point) const;
+    const FBlobHeader* GetHeader() const;
+    FNodeRecord* GetMutableNodes();
+    glm::vec3* GetMutablePoints();
+    std::uint32_t* GetMutableLinks();
+
+private:
+    std::vector<std::byte> _Storage;
+    const std::byte*       _Blob;
+};
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
+
+#include "OctreeImage.inl"
@@ -0,0 +1,321 @@
+#include "OctreeImage.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+template <typename LinkTargetType, typename Func>
+FOctreeImage::FOctreeImage(const TOctree<LinkTargetType>& Octree, std::size_t SystemCount, Func&& GetLinkIndex)
+    : _Blob(nullptr)
+{
+    using FNodeType = typename TOctree<LinkTargetType>::FNodeType;
+
+    // 层序展开，同一节点的子节点在数组中相邻
+    std::vector<const FNodeType*> Nodes{ Octree.GetRoot() };
+    std::size_t PointCount = 0;
+    std::size_t LinkCount  = 0;
+    for (std::size_t i = 0; i != Nodes.size(); ++i)
+    {
+        PointCount += Nodes[i]->GetPoints().size();
+        LinkCount  += Nodes[i]->GetLinks().size();
+        for (int Octant = 0; Octant != 8; ++Octant)
+        {
+            if (Nodes[i]->GetNext(Octant) != nullptr)
+            {
+                Nodes.push_back(Nodes[i]->GetNext(Octant).get());
+            }
+        }
+    }
+
+    if (Nodes.size() >= kInvalidIndex || PointCount >= kInvalidIndex || LinkCount >= kInvalidIndex || SystemCount >= kInvalidIndex)
+    {
+        throw std::length_error("Octree is too large for the image format.");
+    }
+
+    Allocate(Nodes.size(), PointCount, LinkCount, SystemCount, Octree.GetMaxDepth());
+
+    FNodeRecord*   Records = GetMutableNodes();
+    glm::vec3*     Points  = GetMutablePoints();
+    std::uint32_t* Links   = GetMutableLinks();
+
+    std::uint32_t NextChild   = 1;
+    std::uint32_t PointOffset = 0;
+    std::uint32_t LinkOffset  = 0;
+    Records[0].Parent = kInvalidIndex;
+
+    for (std::size_t i = 0; i != Nodes.size(); ++i)
+    {
+        const FNodeType* Node   = Nodes[i];
+        FNodeRecord&     Record = Records[i];
+
+        Record.Center            = Node->GetCenter();
+        Record.Radius            = Node->GetRadius();
+        Record.FirstChild        = Node->IsLeafNode() ? kInvalidIndex : NextChild;
+        Record.SubtreePointCount = static_cast<std::uint32_t>(Node->GetPointCount());
+        Record.ValidLeafCount    = static_cast<std::uint32_t>(Node->GetValidLeafCount());
+        Record.bIsValid          = Node->IsValid() ? 1 : 0;
+        Record.Aggregate         = Node->GetAggregate();
+
+        for (int Octant = 0; Octant != 8; ++Octant)
+        {
+            if (Node->GetNext(Octant) != nullptr)
+            {
+                Record.ChildMask |= static_cast<std::uint8_t>(1u << Octant);
+                Records[NextChild++].Parent = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        Record.PointBegin = PointOffset;
+        Record.PointCount = static_cast<std::uint32_t>(Node->GetPoints().size());
+        for (glm::vec3 Point : Node->GetPoints())
+        {
+            Points[PointOffset++] = Point;
+        }
+
+        Record.LinkBegin = LinkOffset;
+        Record.LinkCount = static_cast<std::uint32_t>(Node->GetLinks().size());
+        for (const LinkTargetType* Target : Node->GetLinks())
+        {
+            std::size_t LinkIndex = GetLinkIndex(Target);
+            if (LinkIndex >= SystemCount)
+            {
+                throw std::out_of_range("Link index out of range of the system table.");
+            }
+
+            Links[LinkOffset++] = static_cast<std::uint32_t>(LinkIndex);
+        }
+    }
+}
+
+template <typename LinkTargetType>
+std::unique_ptr<TOctree<LinkTargetType>> FOctreeImage::Rebuild(std::span<LinkTargetType> Table) const
+{
+    using FNodeType = typename TOctree<LinkTargetType>::FNodeType;
+
+    // 链接下标已在构造时按记录的系统数检查过，这里只需确认系统表大小一致
+    if (Table.size() != GetSystemCount())
+    {
+        throw std::invalid_argument("System table size does not match the octree image.");
+    }
+
+    const FNodeRecord& Root = GetNode(0);
+    auto Octree = std::make_unique<TOctree<LinkTargetType>>(Root.Center, Root.Radius, GetMaxDepth());
+
+    // 层序处理，父节点总在子节点之前创建；子节点建好后再设置有效性，计数才能正确更新
+    std::vector<FNodeType*> Nodes(GetNodeCount(), nullptr);
+    Nodes[0] = Octree->GetRoot();
+    for (std::uint32_t i = 0; i != GetNodeCount(); ++i)
+    {
+        const FNodeRecord& Record = GetNode(i);
+        FNodeType* Node = Nodes[i];
+
+        for (int Octant = 0; Octant != 8; ++Octant)
+        {
+            std::uint32_t Child = GetChild(i, Octant);
+            if (Child != kInvalidIndex)
+            {
+                Nodes[Child] = Octree->CreateChild(Node, Octant, GetNode(Child).Center);
+            }
+        }
+
+        for (glm::vec3 Point : GetPoints(i))
+        {
+            Node->AddPoint(Point);
+        }
+
+        for (std::uint32_t LinkIndex : GetLinks(i))
+        {
+            Node->AddLink(&Table[LinkIndex]);
+        }
+
+        Node->SetValidation(Record.bIsValid != 0);
+        Node->SetAggregate(Record.Aggregate);
+    }
+
+    return Octree;
+}
+
+template <typename LinkTargetType, typename Func>
+bool FOctreeImage::Validate(const TOctree<LinkTargetType>& Octree, Func&& GetLinkIndex) const
+{
+    using FNodeType = typename TOctree<LinkTargetType>::FNodeType;
+
+    auto SameAggregate = [](const FNodeAggregate& Lhs, const FNodeAggregate& Rhs) -> bool
+    {
+        return Lhs.Centroid == Rhs.Centroid && Lhs.Luminosity == Rhs.Luminosity && Lhs.MaxLuminosity == Rhs.MaxLuminosity &&
+               Lhs.Teff == Rhs.Teff && Lhs.Count == Rhs.Count;
+    };
+
+    std::vector<const FNodeType*> Nodes{ Octree.GetRoot() };
+    for (std::size_t i = 0; i != Nodes.size(); ++i)
+    {
+        if (i >= GetNodeCount())
+        {
+            return false;
+        }
+
+        const FNodeType*   Node   = Nodes[i];
+        const FNodeRecord& Record = GetNode(static_cast<std::uint32_t>(i));
+
+        if (Record.Center != Node->GetCenter() || Record.Radius != Node->GetRadius() ||
+            (Record.bIsValid != 0) != Node->IsValid() || Record.SubtreePointCount != Node->GetPointCount() ||
+            Record.ValidLeafCount != Node->GetValidLeafCount() || !SameAggregate(Record.Aggregate, Node->GetAggregate()))
+        {
+            return false;
+        }
+
+        for (int Octant = 0; Octant != 8; ++Octant)
+        {
+            bool bHasChild = Node->GetNext(Octant) != nullptr;
+            if (bHasChild != ((Record.ChildMask >> Octant & 1) != 0))
+            {
+                return false;
+            }
+
+            if (bHasChild)
+            {
+                if (GetChild(static_cast<std::uint32_t>(i), Octant) != Nodes.size())
+                {
+                    return false;
+                }
+
+                Nodes.push_back(Node->GetNext(Octant).get());
+            }
+        }
+
+        auto Points = GetPoints(static_cast<std::uint32_t>(i));
+        if (!std::ranges::equal(Points, Node->GetPoints()))
+        {
+            return false;
+        }
+
+        auto Links = GetLinks(static_cast<std::uint32_t>(i));
+        if (Links.size() != Node->GetLinks().size())
+        {
+            return false;
+        }
+
+        for (std::size_t j = 0; j != Links.size(); ++j)
+        {
+            if (Links[j] != static_cast<std::uint32_t>(GetLinkIndex(Node->GetLinks()[j])))
+            {
+                return false;
+            }
+        }
+    }
+
+    return Nodes.size() == GetNodeCount();
+}
+
+template <typename Func>
+std::uint32_t FOctreeImage::Find(glm::vec3 Point, Func&& Pred) const
+{
+    if (!Contains(GetNode(0), Point))
+    {
+        return kInvalidIndex;
+    }
+
+    // 子节点逆序入栈，出栈顺序与 TOctree::Find 的递归顺序一致
+    std::vector<std::uint32_t> Stack{ 0 };
+    while (!Stack.empty())
+    {
+        std::uint32_t Index = Stack.back();
+        Stack.pop_back();
+
+        if (Pred(GetNode(Index)))
+        {
+            return Index;
+        }
+
+        for (int Octant = 7; Octant >= 0; --Octant)
+        {
+            std::uint32_t Child = GetChild(Index, Octant);
+            if (Child != kInvalidIndex && Contains(GetNode(Child), Point))
+            {
+                Stack.push_back(Child);
+            }
+        }
+    }
+
+    return kInvalidIndex;
+}
+
+NPGS_INLINE const FOctreeImage::FNodeRecord& FOctreeImage::GetNode(std::uint32_t Index) const
+{
+    return reinterpret_cast<const FNodeRecord*>(_Blob + GetHeader()->NodeOffset)[Index];
+}
+
+NPGS_INLINE std::uint32_t FOctreeImage::GetChild(std::uint32_t Index, int Octant) const
+{
+    const FNodeRecord& Node = GetNode(Index);
+    if ((Node.ChildMask >> Octant & 1) == 0)
+    {
+        return kInvalidIndex;
+    }
+
+    // 排在 Octant 之前的子节点个数
+    return Node.FirstChild + std::popcount(static_cast<unsigned>(Node.ChildMask & ((1u << Octant) - 1)));
+}
+
+NPGS_INLINE std::span<const glm::vec3> FOctreeImage::GetPoints(std::uint32_t Index) const
+{
+    const FNodeRecord& Node = GetNode(Index);
+    return { reinterpret_cast<const glm::vec3*>(_Blob + GetHeader()->PointOffset) + Node.PointBegin, Node.PointCount };
+}
+
+NPGS_INLINE std::span<const std::uint32_t> FOctreeImage::GetLinks(std::uint32_t Index) const
+{
+    const FNodeRecord& Node = GetNode(Index);
+    return { reinterpret_cast<const std::uint32_t*>(_Blob + GetHeader()->LinkOffset) + Node.LinkBegin, Node.LinkCount };
+}
+
+NPGS_INLINE std::size_t FOctreeImage::GetNodeCount() const
+{
+    return static_cast<std::size_t>(GetHeader()->NodeCount);
+}
+
+NPGS_INLINE std::size_t FOctreeImage::GetSystemCount() const
+{
+    return static_cast<std::size_t>(GetHeader()->SystemCount);
+}
+
+NPGS_INLINE std::size_t FOctreeImage::GetSize() const
+{
+    return GetNode(0).SubtreePointCount;
+}
+
+NPGS_INLINE std::size_t FOctreeImage::GetCapacity() const
+{
+    return GetNode(0).ValidLeafCount;
+}
+
+NPGS_INLINE int FOctreeImage::GetMaxDepth() const
+{
+    return GetHeader()->MaxDepth;
+}
+
+NPGS_INLINE std::span<const std::byte> FOctreeImage::GetBlob() const
+{
+    return { _Blob, static_cast<std::size_t>(GetHeader()->BlobSize) };
+}
+
+NPGS_INLINE bool FOctreeImage::Contains(const FNodeRecord& Node, glm::vec3 Point) const
+{
+    // 与 TOctreeNode::Contains 的写法保持一致，边界上的判定结果才相同
+    return Point.x >= Node.Center.x - Node.Radius && Point.x <= Node.Center.x + Node.Radius &&
+           Point.y >= Node.Center.y - Node.Radius && Point.y <= Node.Center.y + Node.Radius &&
+           Point.z >= Node.Center.z - Node.Radius && Point.z <= Node.Center.z + Node.Radius;
+}
+
+NPGS_INLINE const FOctreeImage::FBlobHeader* FOctreeImage::GetHeader() const
+{
+    return reinterpret_cast<const FBlobHeader*>(_Blob);
+}
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,591 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/System/Spatial/MortonCode.hpp"
+
+_NPGS_BEGIN
+_SYSTEM_BEGIN
+_SPATIAL_BEGIN
+
+// 哈希均匀网格。空间按边长 CellSize 划分为格子，以整数格子坐标为键；只保存非空格子
+// 点按格子坐标的 Morton 码排序后连续存放，每个格子的点是点数组中的一段连续区间，相邻格子在内存中也大多相邻
+// 格子坐标到格子的映射是开放寻址哈希表。密度均匀时比深度受限的八叉树少了逐层下降，每个格子的点数也不随总点数增长
+// 与 TLinearOctree 一样只能整体重建
+template <typename LinkTargetType>
+class TSpatialHashGrid
+{
+public:
+    static constexpr std::uint32_t kNoIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct FCell
+    {
+        glm::ivec3    Coord;
+        std::uint32_t PointBegin;
+        std::uint32_t PointCount;
+    };
+
+public:
+    explicit TSpatialHashGrid(float CellSize)
+        : _CellSize(CellSize), _InverseCellSize(1.0f / CellSize)
+    {
+        if (!(CellSize > 0.0f) || !std::isfinite(CellSize))
+        {
+            throw std::invalid_argument("Cell size must be positive and finite.");
+        }
+    }
+
+    // 用一组点（和与之一一对应的链接）重建网格，非有限的点和格子坐标超出 ±2^29 的点被丢弃
+    // 链接非空且数量与点数不同，或格子坐标在任一轴上的跨度超过 2^21 时抛出异常；ThreadCount 为 0 时使用线程池的全部线程
+    void Build(std::span<const glm::vec3> Points, std::span<LinkTargetType* const> Links = {}, int ThreadCount = 0)
+    {
+        if (Points.size() >= kNoIndex)
+        {
+            throw std::length_error("Too many points for a spatial hash grid.");
+        }
+
+        if (!Links.empty() && Links.size() != Points.size())
+        {
+            throw std::invalid_argument("Link count must be zero or equal to point count.");
+        }
+
+        std::size_t ChunkCount = ResolveChunkCount(ThreadCount);
+        std::size_t InputCount = Points.size();
+
+        // 求格子坐标及其范围
+        std::vector<glm::ivec3> Coords(InputCount);
+        std::vector<std::uint8_t> ValidFlags(InputCount);
+        std::vector<std::pair<glm::ivec3, glm::ivec3>> ChunkBounds(ChunkCount, { glm::ivec3(kMaxCoord), glm::ivec3(-kMaxCoord) });
+
+        std::size_t BuildChunkCount = std::min(ChunkCount, InputCount / 4096 + 1);
+        Runtime::Thread::ParallelFor(InputCount, BuildChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t Chunk) -> void
+        {
+            auto& [MinCoord, MaxCoord] = ChunkBounds[Chunk];
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                glm::vec3 Cell = glm::floor(Points[i] * _InverseCellSize);
+                ValidFlags[i]  = glm::all(glm::lessThan(glm::abs(Cell), glm::vec3(static_cast<float>(kMaxCoord)))) ? 1 : 0;
+                if (ValidFlags[i] == 0)
+                {
+                    continue;
+                }
+
+                Coords[i] = glm::ivec3(Cell);
+                MinCoord  = glm::min(MinCoord, Coords[i]);
+                MaxCoord  = glm::max(MaxCoord, Coords[i]);
+            }
+        });
+
+        _MinCoord = glm::ivec3(kMaxCoord);
+        _MaxCoord = glm::ivec3(-kMaxCoord);
+        for (const auto& [MinCoord, MaxCoord] : ChunkBounds)
+        {
+            _MinCoord = glm::min(_MinCoord, MinCoord);
+            _MaxCoord = glm::max(_MaxCoord, MaxCoord);
+        }
+
+        // 输入可能就是 _Points 和 _Links，非空时它们在收集完成后才被交换替换
+        _Cells.clear();
+        _Slots.clear();
+        if (glm::any(glm::greaterThan(_MinCoord, _MaxCoord)))
+        {
+            _Points.clear();
+            _Links.clear();
+            _MinCoord = glm::ivec3(0);
+            _MaxCoord = glm::ivec3(-1);
+            return;
+        }
+
+        glm::ivec3 Extent = _MaxCoord - _MinCoord;
+        int MaxExtent = std::max({ Extent.x, Extent.y, Extent.z });
+        if (MaxExtent >= (1 << kMortonBitsPerAxis))
+        {
+            throw std::length_error("Point extent is too large for the cell size.");
+        }
+
+        // 按格子的 Morton 码排序，丢弃的点使用哨兵值，排序后落在末尾
+        int           AxisBits = std::bit_width(static_cast<unsigned>(MaxExtent));
+        std::uint64_t Sentinel = std::uint64_t(1) << (3 * AxisBits);
+
+        std::vector<std::uint64_t> Codes(InputCount);
+        std::vector<std::uint32_t> Order(InputCount);
+        Runtime::Thread::ParallelFor(InputCount, BuildChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                Order[i] = static_cast<std::uint32_t>(i);
+                Codes[i] = ValidFlags[i] != 0 ? EncodeCoord(Coords[i]) : Sentinel;
+            }
+        });
+
+        RadixSortPairs(Codes, Order, 3 * AxisBits + 1, ChunkCount);
+
+        std::size_t Count = std::lower_bound(Codes.begin(), Codes.end(), Sentinel) - Codes.begin();
+        Codes.resize(Count);
+
+        // 输入可能就是本网格的点数组（例如 GetPointData），先写入新数组再交换
+        std::vector<glm::vec3>       SortedPoints(Count);
+        std::vector<LinkTargetType*> SortedLinks(Count);
+        std::vector<std::uint32_t>   ChunkCellCounts(BuildChunkCount + 1, 0);
+        Runtime::Thread::ParallelFor(Count, BuildChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t Chunk) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                SortedPoints[i] = Points[Order[i]];
+                SortedLinks[i]  = Links.empty() ? nullptr : Links[Order[i]];
+                ChunkCellCounts[Chunk + 1] += (i == 0 || Codes[i] != Codes[i - 1]) ? 1 : 0;
+            }
+        });
+
+        _Points.swap(SortedPoints);
+        _Links.swap(SortedLinks);
+
+        // 每块内格子的起点按块的前缀和写入，格子与 Morton 码同序
+        for (std::size_t Chunk = 0; Chunk != BuildChunkCount; ++Chunk)
+        {
+            ChunkCellCounts[Chunk + 1] += ChunkCellCounts[Chunk];
+        }
+
+        _Cells.resize(ChunkCellCounts.back());
+        Runtime::Thread::ParallelFor(Count, BuildChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t Chunk) -> void
+        {
+            std::uint32_t CellIndex = ChunkCellCounts[Chunk];
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                if (i == 0 || Codes[i] != Codes[i - 1])
+                {
+                    _Cells[CellIndex++] = { DecodeCoord(Codes[i]), static_cast<std::uint32_t>(i), 0 };
+                }
+            }
+        });
+
+        std::size_t CellCount = _Cells.size();
+        std::size_t CellChunkCount = std::min(ChunkCount, CellCount / 4096 + 1);
+        Runtime::Thread::ParallelFor(CellCount, CellChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                std::uint32_t PointEnd = i + 1 != CellCount ? _Cells[i + 1].PointBegin : static_cast<std::uint32_t>(Count);
+                _Cells[i].PointCount   = PointEnd - _Cells[i].PointBegin;
+            }
+        });
+
+        BuildSlots(Codes, CellChunkCount);
+    }
+
+    // 点所在格子的坐标，格子 c 覆盖 [c * CellSize, (c + 1) * CellSize)
+    glm::ivec3 GetCellCoord(glm::vec3 Point) const
+    {
+        glm::vec3 Cell = glm::clamp(glm::floor(Point * _InverseCellSize), glm::vec3(static_cast<float>(-kMaxCoord)),
+                                    glm::vec3(static_cast<float>(kMaxCoord)));
+        return glm::ivec3(Cell);
+    }
+
+    // 格子为空时返回空指针，期望 O(1)
+    const FCell* FindCell(glm::ivec3 Coord) const
+    {
+        if (_Slots.empty() || glm::any(glm::lessThan(Coord, _MinCoord)) || glm::any(glm::greaterThan(Coord, _MaxCoord)))
+        {
+            return nullptr;
+        }
+
+        std::uint64_t Key  = EncodeCoord(Coord);
+        std::size_t   Mask = _Slots.size() - 1;
+        for (std::size_t Slot = HashKey(Key) & Mask; _Slots[Slot].Key != kEmptyKey; Slot = (Slot + 1) & Mask)
+        {
+            if (_Slots[Slot].Key == Key)
+            {
+                return &_Cells[_Slots[Slot].CellIndex];
+            }
+        }
+
+        return nullptr;
+    }
+
+    // 对 [MinCoord, MaxCoord] 范围内的每个非空格子调用 Pred(const FCell&)
+    // 范围内的格子数多于非空格子数时改为遍历所有非空格子，避免在稀疏区域逐个查找空格子
+    template <typename Func>
+    void ForEachCellInRange(glm::ivec3 MinCoord, glm::ivec3 MaxCoord, Func&& Pred) const
+    {
+        MinCoord = glm::max(MinCoord, _MinCoord);
+        MaxCoord = glm::min(MaxCoord, _MaxCoord);
+        if (glm::any(glm::greaterThan(MinCoord, MaxCoord)))
+        {
+            return;
+        }
+
+        glm::ivec3    Extent     = MaxCoord - MinCoord + 1;
+        std::uint64_t RangeCount = static_cast<std::uint64_t>(Extent.x) * static_cast<std::uint64_t>(Extent.y) *
+                                   static_cast<std::uint64_t>(Extent.z);
+        if (RangeCount > _Cells.size())
+        {
+            for (const FCell& Cell : _Cells)
+            {
+                if (glm::all(glm::greaterThanEqual(Cell.Coord, MinCoord)) && glm::all(glm::lessThanEqual(Cell.Coord, MaxCoord)))
+                {
+                    Pred(Cell);
+                }
+            }
+
+            return;
+        }
+
+        for (int x = MinCoord.x; x <= MaxCoord.x; ++x)
+        {
+            for (int y = MinCoord.y; y <= MaxCoord.y; ++y)
+            {
+                for (int z = MinCoord.z; z <= MaxCoord.z; ++z)
+                {
+                    if (const FCell* Cell = FindCell(glm::ivec3(x, y, z)); Cell != nullptr)
+                    {
+                        Pred(*Cell);
+                    }
+                }
+            }
+        }
+    }
+
+    // 对切比雪夫距离不超过 Range 的非空格子（含 Coord 本身）调用 Pred(const FCell&)，Range 为 1 时即 3x3x3 邻域
+    template <typename Func>
+    void ForEachNeighbourCell(glm::ivec3 Coord, int Range, Func&& Pred) const
+    {
+        ForEachCellInRange(Coord - Range, Coord + Range, Pred);
+    }
+
+    // 收集与 Point 距离不超过 Radius 的点，与 Point 坐标完全相同的点不计入，与 TOctree::Query 一致
+    void Query(glm::vec3 Point, float Radius, std::vector<glm::vec3>& Results) const
+    {
+        float RadiusSquared = Radius * Radius;
+        ForEachCellInRange(GetCellCoord(Point - Radius), GetCellCoord(Point + Radius), [&](const FCell& Cell) -> void
+        {
+            for (glm::vec3 StoredPoint : GetPoints(Cell))
+            {
+                glm::vec3 Delta = StoredPoint - Point;
+                if (glm::dot(Delta, Delta) <= RadiusSquared && StoredPoint != Point)
+                {
+                    Results.push_back(StoredPoint);
+                }
+            }
+        });
+    }
+
+    // 按距离升序收集离 Point 最近的 K 个点，与 Point 坐标完全相同的点不计入
+    // 以 Point 所在格子为中心逐圈向外访问，当前第 K 近的距离不大于已访问区域到 Point 的最短边界距离时停止
+    void QueryNearest(glm::vec3 Point, std::size_t K, std::vector<glm::vec3>& Results) const
+    {
+        Results.clear();
+        if (K == 0 || _Cells.empty())
+        {
+            return;
+        }
+
+        using FPointEntry = std::pair<float, glm::vec3>;
+        auto ComparePoint = [](const FPointEntry& Lhs, const FPointEntry& Rhs) -> bool { return Lhs.first < Rhs.first; };
+        std::vector<FPointEntry> PointHeap; // 最大堆，当前最近的 K 个点
+
+        auto VisitCell = [&](const FCell& Cell) -> void
+        {
+            // 已有 K 个点时跳过包围盒比第 K 近的点还远的格子
+            glm::vec3 CellMin = glm::vec3(Cell.Coord) * _CellSize;
+            glm::vec3 Gap     = glm::max(glm::max(CellMin - Point, Point - CellMin - _CellSize), glm::vec3(0.0f));
+            if (PointHeap.size() == K && glm::dot(Gap, Gap) > PointHeap.front().first)
+            {
+                return;
+            }
+
+            for (glm::vec3 StoredPoint : GetPoints(Cell))
+            {
+                glm::vec3 Delta = StoredPoint - Point;
+                float DistanceSquared = glm::dot(Delta, Delta);
+                if (StoredPoint == Point)
+                {
+                    continue;
+                }
+
+                if (PointHeap.size() < K)
+                {
+                    PointHeap.emplace_back(DistanceSquared, StoredPoint);
+                    std::push_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+                }
+                else if (DistanceSquared < PointHeap.front().first)
+                {
+                    std::pop_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+                    PointHeap.back() = { DistanceSquared, StoredPoint };
+                    std::push_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+                }
+            }
+        };
+
+        // Point 在网格范围外时，离网格较近的几圈都是空的，直接跳过
+        glm::ivec3 Center    = GetCellCoord(Point);
+        glm::ivec3 MinDelta  = glm::max(glm::max(_MinCoord - Center, Center - _MaxCoord), glm::ivec3(0));
+        glm::ivec3 MaxDelta  = glm::max(glm::abs(Center - _MinCoord), glm::abs(_MaxCoord - Center));
+        int        FirstRing = std::max({ MinDelta.x, MinDelta.y, MinDelta.z });
+        int        MaxRing   = std::max({ MaxDelta.x, MaxDelta.y, MaxDelta.z });
+
+        for (int Ring = FirstRing; Ring <= MaxRing; ++Ring)
+        {
+            // 稀疏区域中一圈的格子数多于非空格子数时，剩下的格子一次遍历完
+            if (24 * static_cast<std::size_t>(Ring) * Ring + 2 > _Cells.size())
+            {
+                for (const FCell& Cell : _Cells)
+                {
+                    glm::ivec3 Delta = glm::abs(Cell.Coord - Center);
+                    if (std::max({ Delta.x, Delta.y, Delta.z }) >= Ring)
+                    {
+                        VisitCell(Cell);
+                    }
+                }
+
+                break;
+            }
+
+            ForEachRingCell(Center, Ring, VisitCell);
+
+            // 第 Ring 圈以内的格子围成的盒子，盒外的点到 Point 的距离不小于 Point 到盒面的距离
+            glm::vec3 BoxMin = glm::vec3(Center - Ring) * _CellSize;
+            glm::vec3 BoxMax = glm::vec3(Center + Ring + 1) * _CellSize;
+            glm::vec3 Gap    = glm::min(Point - BoxMin, BoxMax - Point);
+            float     Bound  = std::max(std::min({ Gap.x, Gap.y, Gap.z }), 0.0f);
+            if (PointHeap.size() == K && PointHeap.front().first <= Bound * Bound)
+            {
+                break;
+            }
+        }
+
+        std::sort_heap(PointHeap.begin(), PointHeap.end(), ComparePoint);
+        Results.reserve(PointHeap.size());
+        for (const auto& [Distance, StoredPoint] : PointHeap)
+        {
+            Results.push_back(StoredPoint);
+        }
+    }
+
+    // 批量查询，按查询点分块在线程池中并行，Results[i] 对应 Points[i]；ThreadCount 为 0 时使用全部线程
+    void QueryBatch(std::span<const glm::vec3> Points, float Radius, std::vector<std::vector<glm::vec3>>& Results,
+                    int ThreadCount = 0) const
+    {
+        Results.resize(Points.size());
+        Runtime::Thread::ParallelFor(Points.size(), CalculateQueryChunkCount(Points.size(), ThreadCount),
+        [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                Results[i].clear();
+                Query(Points[i], Radius, Results[i]);
+            }
+        });
+    }
+
+    void QueryNearestBatch(std::span<const glm::vec3> Points, std::size_t K, std::vector<std::vector<glm::vec3>>& Results,
+                           int ThreadCount = 0) const
+    {
+        Results.resize(Points.size());
+        Runtime::Thread::ParallelFor(Points.size(), CalculateQueryChunkCount(Points.size(), ThreadCount),
+        [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                QueryNearest(Points[i], K, Results[i]);
+            }
+        });
+    }
+
+    std::span<const glm::vec3> GetPoints(const FCell& Cell) const
+    {
+        return std::span<const glm::vec3>(_Points.data() + Cell.PointBegin, Cell.PointCount);
+    }
+
+    // 与 GetPoints 一一对应的链接
+    std::span<LinkTargetType* const> GetLinks(const FCell& Cell) const
+    {
+        return std::span<LinkTargetType* const>(_Links.data() + Cell.PointBegin, Cell.PointCount);
+    }
+
+    template <typename Func>
+    LinkTargetType* GetLink(const FCell& Cell, Func&& Pred) const
+    {
+        for (LinkTargetType* Target : GetLinks(Cell))
+        {
+            if (Target != nullptr && Pred(Target))
+            {
+                return Target;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // 在 Point 所在的格子中查找第一个满足 Pred 的链接对象
+    template <typename Func>
+    LinkTargetType* FindLink(glm::vec3 Point, Func&& Pred) const
+    {
+        const FCell* Cell = FindCell(GetCellCoord(Point));
+        return Cell != nullptr ? GetLink(*Cell, Pred) : nullptr;
+    }
+
+    std::size_t GetSize() const
+    {
+        return _Points.size();
+    }
+
+    std::size_t GetCellCount() const
+    {
+        return _Cells.size();
+    }
+
+    float GetCellSize() const
+    {
+        return _CellSize;
+    }
+
+    std::size_t GetMemoryUsage() const
+    {
+        return _Cells.capacity() * sizeof(FCell) + _Slots.capacity() * sizeof(FSlot) +
+               _Points.capacity() * sizeof(glm::vec3) + _Links.capacity() * sizeof(LinkTargetType*);
+    }
+
+    const std::vector<FCell>& GetCells() const
+    {
+        return _Cells;
+    }
+
+    const std::vector<glm::vec3>& GetPointData() const
+    {
+        return _Points;
+    }
+
+private:
+    struct FSlot
+    {
+        std::uint64_t Key;
+        std::uint32_t CellIndex;
+    };
+
+    static constexpr int           kMaxCoord = 1 << 29; // 坐标差不会溢出 int
+    static constexpr std::uint64_t kEmptyKey = std::numeric_limits<std::uint64_t>::max();
+
+    std::size_t ResolveChunkCount(int ThreadCount) const
+    {
+        if (ThreadCount <= 0)
+        {
+            ThreadCount = Runtime::Thread::FThreadPool::GetInstance()->GetMaxThreadCount();
+        }
+
+        return static_cast<std::size_t>(std::max(ThreadCount, 1));
+    }
+
+    std::size_t CalculateQueryChunkCount(std::size_t QueryCount, int ThreadCount) const
+    {
+        // 多分几块，避免查询代价不均时个别线程拖后
+        return std::min(QueryCount / 256 + 1, ResolveChunkCount(ThreadCount) * 4);
+    }
+
+    // 键为相对最小格子坐标的 Morton 码，不同格子的键互不相同
+    std::uint64_t EncodeCoord(glm::ivec3 Coord) const
+    {
+        glm::uvec3 Offset(Coord - _MinCoord);
+        return EncodeMorton(Offset.x, Offset.y, Offset.z);
+    }
+
+    glm::ivec3 DecodeCoord(std::uint64_t Code) const
+    {
+        return glm::ivec3(DecodeMorton(Code)) + _MinCoord;
+    }
+
+    static std::size_t HashKey(std::uint64_t Key)
+    {
+        // Fibonacci 散列，取高位，相邻格子的键分散到不同的槽
+        return static_cast<std::size_t>((Key * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    // 槽数为不小于格子数两倍的 2 的幂，线性探测；各线程用 CAS 抢占空槽，槽的分布可能随线程数变化，查找结果不变
+    void BuildSlots(const std::vector<std::uint64_t>& Codes, std::size_t ChunkCount)
+    {
+        std::size_t SlotCount = std::bit_ceil(std::max<std::size_t>(_Cells.size() * 2, 16));
+        std::size_t Mask      = SlotCount - 1;
+        _Slots.assign(SlotCount, { kEmptyKey, kNoIndex });
+
+        Runtime::Thread::ParallelFor(_Cells.size(), ChunkCount, [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+        {
+            for (std::size_t i = Begin; i != End; ++i)
+            {
+                std::uint64_t Key = Codes[_Cells[i].PointBegin];
+                for (std::size_t Slot = HashKey(Key) & Mask;; Slot = (Slot + 1) & Mask)
+                {
+                    std::uint64_t Expected = kEmptyKey;
+                    if (std::atomic_ref<std::uint64_t>(_Slots[Slot].Key).compare_exchange_strong(Expected, Key))
+                    {
+                        _Slots[Slot].CellIndex = static_cast<std::uint32_t>(i);
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    // 对与 Center 的切比雪夫距离恰为 Ring 的非空格子调用 Pred，跳过网格范围外的格子
+    template <typename Func>
+    void ForEachRingCell(glm::ivec3 Center, int Ring, Func& Pred) const
+    {
+        glm::ivec3 Low  = glm::max(Center - Ring, _MinCoord);
+        glm::ivec3 High = glm::min(Center + Ring, _MaxCoord);
+
+        for (int x = Low.x; x <= High.x; ++x)
+        {
+            for (int y = Low.y; y <= High.y; ++y)
+            {
+                // x 或 y 位于圈上时整列都在圈上，否则只有 z 方向的两端
+                if (std::abs(x - Center.x) == Ring || std::abs(y - Center.y) == Ring)
+                {
+                    for (int z = Low.z; z <= High.z; ++z)
+                    {
+                        if (const FCell* Cell = FindCell(glm::ivec3(x, y, z)); Cell != nullptr)
+                        {
+                            Pred(*Cell);
+                        }
+                    }
+
+                    continue;
+                }
+
+                for (int z : { Center.z - Ring, Center.z + Ring })
+                {
+                    if (const FCell* Cell = FindCell(glm::ivec3(x, y, z)); Cell != nullptr)
+                    {
+                        Pred(*Cell);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<FCell>           _Cells;  // 按 Morton 码升序
+    std::vector<FSlot>           _Slots;
+    std::vector<glm::vec3>       _Points;
+    std::vector<LinkTargetType*> _Links;
+    glm::ivec3                   _MinCoord{ 0 };
+    glm::ivec3                   _MaxCoord{ -1 };
+    float                        _CellSize;
+    float                        _InverseCellSize;
+};
+
+_SPATIAL_END
+_SYSTEM_END
+_NPGS_END
@@ -0,0 +1,163 @@
+#include "OrbitalHierarchy.h"
+
+#include <unordered_map>
+
+_NPGS_BEGIN
+_ASTRO_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    const INpgsObject* GetObjectKey(const FOrbit::FOrbitalObject& Object)
+    {
+        switch (Object.GetObjectType())
+        {
+        case FOrbit::EObjectType::kBaryCenter:
+            return Object.GetObject<FBaryCenter>();
+        case FOrbit::EObjectType::kStar:
+            return Object.GetObject<AStar>();
+        case FOrbit::EObjectType::kPlanet:
+            return Object.GetObject<APlanet>();
+        case FOrbit::EObjectType::kAsteroidCluster:
+            return Object.GetObject<AAsteroidCluster>();
+        case FOrbit::EObjectType::kArtifactCluster:
+            return Object.GetObject<Intelli::AArtifact>();
+        default:
+            return nullptr;
+        }
+    }
+
+    template <typename ObjectType>
+    void RegisterBodyIndices(const std::vector<std::unique_ptr<ObjectType>>& Bodies,
+                             std::unordered_map<const INpgsObject*, std::uint32_t>& BodyIndices)
+    {
+        for (std::size_t i = 0; i != Bodies.size(); ++i)
+        {
+            BodyIndices.emplace(Bodies[i].get(), static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+// FOrbitalHierarchy implementations
+// ---------------------------------
+FOrbitalHierarchy::FOrbitalHierarchy(FStellarSystem& System)
+{
+    std::unordered_map<const INpgsObject*, std::uint32_t> BodyIndices;
+    RegisterBodyIndices(System.StarsData(), BodyIndices);
+    RegisterBodyIndices(System.PlanetsData(), BodyIndices);
+    RegisterBodyIndices(System.AsteroidClustersData(), BodyIndices);
+
+    // 按上级天体给轨道分组，每组只会被展开一次
+    std::unordered_map<const INpgsObject*, std::vector<FOrbit*>> OrbitsByParent;
+    for (auto& Orbit : System.OrbitsData())
+    {
+        OrbitsByParent[GetObjectKey(Orbit->GetParent())].push_back(Orbit.get());
+    }
+
+    std::vector<const INpgsObject*> NodeKeys; // 与节点一一对应的天体指针，只在构建时使用
+
+    _Nodes.push_back(FNode
+    {
+        .Elements        = {},
+        .Normal          = {},
+        .Period          = 0.0f,
+        .ParentIndex     = kNoIndex,
+        .FirstChildIndex = 0,
+        .ChildCount      = 0,
+        .BodyIndex       = kNoIndex,
+        .Kind            = FOrbit::EObjectType::kBaryCenter
+    });
+    NodeKeys.push_back(System.GetBaryCenter());
+
+    // 广度优先展开，同一上级的下级节点因此连续存放
+    for (std::size_t NodeIndex = 0; NodeIndex < _Nodes.size(); ++NodeIndex)
+    {
+        auto FirstChildIndex = static_cast<std::uint32_t>(_Nodes.size());
+        _Nodes[NodeIndex].FirstChildIndex = FirstChildIndex;
+
+        auto It = OrbitsByParent.find(NodeKeys[NodeIndex]);
+        if (It == OrbitsByParent.end())
+        {
+            continue;
+        }
+
+        for (FOrbit* Orbit : It->second)
+        {
+            for (auto& Details : Orbit->ObjectsData())
+            {
+                const INpgsObject* Key     = GetObjectKey(Details.GetOrbitalObject());
+                auto               IndexIt = BodyIndices.find(Key);
+
+                _Nodes.push_back(FNode
+                {
+                    .Elements
+                    {
+                        .SemiMajorAxis            = Orbit->GetSemiMajorAxis(),
+                        .Eccentricity             = Orbit->GetEccentricity(),
+                        .Inclination              = Orbit->GetInclination(),
+                        .LongitudeOfAscendingNode = Orbit->GetLongitudeOfAscendingNode(),
+                        .ArgumentOfPeriapsis      = Orbit->GetArgumentOfPeriapsis(),
+                        .TrueAnomaly              = Details.GetInitialTrueAnomaly()
+                    },
+                    .Normal          = Orbit->GetNormal(),
+                    .Period          = Orbit->GetPeriod(),
+                    .ParentIndex     = static_cast<std::uint32_t>(NodeIndex),
+                    .FirstChildIndex = 0,
+                    .ChildCount      = 0,
+                    .BodyIndex       = IndexIt != BodyIndices.end() ? IndexIt->second : kNoIndex,
+                    .Kind            = Details.GetOrbitalObject().GetObjectType()
+                });
+                NodeKeys.push_back(Key);
+            }
+        }
+
+        _Nodes[NodeIndex].ChildCount = static_cast<std::uint32_t>(_Nodes.size()) - FirstChildIndex;
+        OrbitsByParent.erase(It);
+    }
+}
+
+FOrbitalHierarchy::FOrbitalHierarchy(std::span<const FNode> Nodes)
+    : _Nodes(Nodes.begin(), Nodes.end())
+{
+}
+
+FOrbit::FOrbitalObject FOrbitalHierarchy::GetOrbitalObject(FStellarSystem& System, std::size_t NodeIndex) const
+{
+    const FNode& Node = _Nodes[NodeIndex];
+    if (Node.Kind != FOrbit::EObjectType::kBaryCenter && Node.BodyIndex == kNoIndex)
+    {
+        return FOrbit::FOrbitalObject(nullptr, Node.Kind);
+    }
+
+    switch (Node.Kind)
+    {
+    case FOrbit::EObjectType::kBaryCenter:
+        return FOrbit::FOrbitalObject(System.GetBaryCenter(), Node.Kind);
+    case FOrbit::EObjectType::kStar:
+        return FOrbit::FOrbitalObject(System.StarsData()[Node.BodyIndex].get(), Node.Kind);
+    case FOrbit::EObjectType::kPlanet:
+        return FOrbit::FOrbitalObject(System.PlanetsData()[Node.BodyIndex].get(), Node.Kind);
+    case FOrbit::EObjectType::kAsteroidCluster:
+        return FOrbit::FOrbitalObject(System.AsteroidClustersData()[Node.BodyIndex].get(), Node.Kind);
+    default:
+        return FOrbit::FOrbitalObject(nullptr, Node.Kind);
+    }
+}
+
+std::uint32_t FOrbitalHierarchy::FindNode(FStellarSystem& System, const INpgsObject* Object) const
+{
+    for (std::size_t i = 0; i != _Nodes.size(); ++i)
+    {
+        if (_Nodes[i].Kind != FOrbit::EObjectType::kArtifactCluster &&
+            GetObjectKey(GetOrbitalObject(System, i)) == Object)
+        {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+
+    return kNoIndex;
+}
+
+_ASTRO_END
+_NPGS_END
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Types/Entries/Astro/StellarSystem.h"
+
+_NPGS_BEGIN
+_ASTRO_BEGIN
+
+// 扁平化的轨道层级，节点之间只用下标互相引用，不含任何指针
+// 节点按广度优先顺序排列：上级节点总在下级节点之前，同一上级的下级节点连续存放
+// 整个节点数组可以直接 memcpy 复制或搬移，天体本身仍通过下标到 FStellarSystem 的各类天体数组中取得
+class FOrbitalHierarchy
+{
+public:
+    static constexpr std::uint32_t kNoIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct FNode
+    {
+        FOrbit::FKeplerElements Elements;        // 相对上级节点的轨道根数，TrueAnomaly 为该天体的初始真近点角
+        glm::vec2               Normal;          // 轨道法向量 (theta, phi)
+        float                   Period;          // 轨道周期，单位 s
+        std::uint32_t           ParentIndex;     // 上级节点下标，根节点（质心）为 kNoIndex
+        std::uint32_t           FirstChildIndex; // 第一个下级节点下标
+        std::uint32_t           ChildCount;      // 下级节点数量
+        std::uint32_t           BodyIndex;       // 在对应类型天体数组中的下标，质心和人造物为 kNoIndex
+        FOrbit::EObjectType     Kind;            // 天体类型，决定 BodyIndex 指向哪个数组
+    };
+
+    static_assert(std::is_trivially_copyable_v<FNode>);
+
+public:
+    FOrbitalHierarchy() = default;
+    explicit FOrbitalHierarchy(FStellarSystem& System); // 从指针形式的轨道树构建，找不到上级天体的轨道会被跳过
+    explicit FOrbitalHierarchy(std::span<const FNode> Nodes);
+    ~FOrbitalHierarchy() = default;
+
+    std::span<const FNode> GetNodes() const;
+    const FNode& GetNode(std::size_t NodeIndex) const;
+    std::span<const FNode> GetChildren(std::size_t NodeIndex) const;
+    std::size_t GetNodeCount() const;
+
+    // 旧接口适配，按节点取回 FStellarSystem 中的天体，System 须为构建时使用的系统或其副本
+    template <typename ObjectType>
+    requires std::is_class_v<ObjectType>
+    ObjectType* GetObject(FStellarSystem& System, std::size_t NodeIndex) const;
+
+    FOrbit::FOrbitalObject GetOrbitalObject(FStellarSystem& System, std::size_t NodeIndex) const;
+    std::uint32_t FindNode(FStellarSystem& System, const INpgsObject* Object) const; // 线性查找，找不到时返回 kNoIndex
+
+private:
+    std::vector<FNode> _Nodes;
+};
+
+_ASTRO_END
+_NPGS_END
+
+#include "OrbitalHierarchy.inl"
@@ -0,0 +1,60 @@
+#include "OrbitalHierarchy.h"
+
+_NPGS_BEGIN
+_ASTRO_BEGIN
+
+NPGS_INLINE std::span<const FOrbitalHierarchy::FNode> FOrbitalHierarchy::GetNodes() const
+{
+    return _Nodes;
+}
+
+NPGS_INLINE const FOrbitalHierarchy::FNode& FOrbitalHierarchy::GetNode(std::size_t NodeIndex) const
+{
+    return _Nodes[NodeIndex];
+}
+
+NPGS_INLINE std::span<const FOrbitalHierarchy::FNode> FOrbitalHierarchy::GetChildren(std::size_t NodeIndex) const
+{
+    const FNode& Node = _Nodes[NodeIndex];
+    return std::span<const FNode>(_Nodes).subspan(Node.FirstChildIndex, Node.ChildCount);
+}
+
+NPGS_INLINE std::size_t FOrbitalHierarchy::GetNodeCount() const
+{
+    return _Nodes.size();
+}
+
+template <typename ObjectType>
+requires std::is_class_v<ObjectType>
+NPGS_INLINE ObjectType* FOrbitalHierarchy::GetObject(FStellarSystem& System, std::size_t NodeIndex) const
+{
+    const FNode& Node = _Nodes[NodeIndex];
+    if constexpr (std::is_same_v<ObjectType, FBaryCenter>)
+    {
+        return Node.Kind == FOrbit::EObjectType::kBaryCenter ? System.GetBaryCenter() : nullptr;
+    }
+
+    if (Node.BodyIndex == kNoIndex) // 人造物等没有对应天体数组的节点
+    {
+        return nullptr;
+    }
+
+    if constexpr (std::is_same_v<ObjectType, AStar>)
+    {
+        return Node.Kind == FOrbit::EObjectType::kStar ? System.StarsData()[Node.BodyIndex].get() : nullptr;
+    }
+    else if constexpr (std::is_same_v<ObjectType, APlanet>)
+    {
+        return Node.Kind == FOrbit::EObjectType::kPlanet ? System.PlanetsData()[Node.BodyIndex].get() : nullptr;
+    }
+    else if constexpr (std::is_same_v<ObjectType, AAsteroidCluster>)
+    {
+        return Node.Kind == FOrbit::EObjectType::kAsteroidCluster ?
+               System.AsteroidClustersData()[Node.BodyIndex].get() : nullptr;
+    }
+
+    return nullptr;
+}
+
+_ASTRO_END
+_NPGS_END
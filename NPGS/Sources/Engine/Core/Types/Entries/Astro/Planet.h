@@ -1,9 +1,9 @@
 #pragma once
 
 #include <memory>
-#include <boost/multiprecision/cpp_int.hpp>
 
 #include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Math/Uint128.h"
 #include "Engine/Core/Types/Entries/Astro/CelestialObject.h"
 #include "Engine/Core/Types/Properties/Intelli/Civilization.h"
 
@@ -12,9 +12,9 @@ _ASTRO_BEGIN
 
 struct FComplexMass
 {
-    boost::multiprecision::uint128_t Z;
-    boost::multiprecision::uint128_t Volatiles;
-    boost::multiprecision::uint128_t EnergeticNuclide;
+    Math::FUint128 Z;
+    Math::FUint128 Volatiles;
+    Math::FUint128 EnergeticNuclide;
 };
 
 class APlanet : public FCelestialBody
@@ -40,14 +40,14 @@ public:
 
     struct FExtendedProperties
     {
-        FComplexMass AtmosphereMass;                           // 大气层质量，单位 kg
-        FComplexMass CoreMass;                                 // 核心质量，单位 kg
-        FComplexMass OceanMass;                                // 海洋质量，单位 kg
-        boost::multiprecision::uint128_t    CrustMineralMass;  // 地壳矿脉质量，单位 kg
+        FComplexMass   AtmosphereMass;                         // 大气层质量，单位 kg
+        FComplexMass   CoreMass;                               // 核心质量，单位 kg
+        FComplexMass   OceanMass;                              // 海洋质量，单位 kg
+        Math::FUint128 CrustMineralMass;                       // 地壳矿脉质量，单位 kg
         std::unique_ptr<Intelli::FStandard> CivilizationData;  // 文明数据
-        EPlanetType  Type{ EPlanetType::kRocky };              // 行星类型
-        float        BalanceTemperature{};                     // 平衡温度，单位 K
-        bool         bIsMigrated{ false };                     // 是否为迁移行星
+        EPlanetType    Type{ EPlanetType::kRocky };            // 行星类型
+        float          BalanceTemperature{};                   // 平衡温度，单位 K
+        bool           bIsMigrated{ false };                   // 是否为迁移行星
     };
 
 public:
@@ -73,7 +73,7 @@ public:
     APlanet& SetCoreMass(const FComplexMass& CoreMass);
     APlanet& SetOceanMass(const FComplexMass& OceanMass);
     APlanet& SetCrustMineralMass(float CrustMineralMass);
-    APlanet& SetCrustMineralMass(const boost::multiprecision::uint128_t& CrustMineralMass);
+    APlanet& SetCrustMineralMass(const Math::FUint128& CrustMineralMass);
     APlanet& SetCivilizationData(std::unique_ptr<Intelli::FStandard>&& CivilizationData);
     APlanet& SetBalanceTemperature(float BalanceTemperature);
     APlanet& SetMigration(bool bIsMigrated);
@@ -82,47 +82,47 @@ public:
     // Setters for every mass property
     // -------------------------------
     APlanet& SetAtmosphereMassZ(float AtmosphereMassZ);
-    APlanet& SetAtmosphereMassZ(const boost::multiprecision::uint128_t& AtmosphereMassZ);
+    APlanet& SetAtmosphereMassZ(const Math::FUint128& AtmosphereMassZ);
     APlanet& SetAtmosphereMassVolatiles(float AtmosphereMassVolatiles);
-    APlanet& SetAtmosphereMassVolatiles(const boost::multiprecision::uint128_t& AtmosphereMassVolatiles);
+    APlanet& SetAtmosphereMassVolatiles(const Math::FUint128& AtmosphereMassVolatiles);
     APlanet& SetAtmosphereMassEnergeticNuclide(float AtmosphereMassEnergeticNuclide);
-    APlanet& SetAtmosphereMassEnergeticNuclide(const boost::multiprecision::uint128_t& AtmosphereMassEnergeticNuclide);
+    APlanet& SetAtmosphereMassEnergeticNuclide(const Math::FUint128& AtmosphereMassEnergeticNuclide);
     APlanet& SetCoreMassZ(float CoreMassZ);
-    APlanet& SetCoreMassZ(const boost::multiprecision::uint128_t& CoreMassZ);
+    APlanet& SetCoreMassZ(const Math::FUint128& CoreMassZ);
     APlanet& SetCoreMassVolatiles(float CoreMassVolatiles);
-    APlanet& SetCoreMassVolatiles(const boost::multiprecision::uint128_t& CoreMassVolatiles);
+    APlanet& SetCoreMassVolatiles(const Math::FUint128& CoreMassVolatiles);
     APlanet& SetCoreMassEnergeticNuclide(float CoreMassEnergeticNuclide);
-    APlanet& SetCoreMassEnergeticNuclide(const boost::multiprecision::uint128_t& CoreMassEnergeticNuclide);
+    APlanet& SetCoreMassEnergeticNuclide(const Math::FUint128& CoreMassEnergeticNuclide);
     APlanet& SetOceanMassZ(float OceanMassZ);
-    APlanet& SetOceanMassZ(const boost::multiprecision::uint128_t& OceanMassZ);
+    APlanet& SetOceanMassZ(const Math::FUint128& OceanMassZ);
     APlanet& SetOceanMassVolatiles(float OceanMassVolatiles);
-    APlanet& SetOceanMassVolatiles(const boost::multiprecision::uint128_t& OceanMassVolatiles);
+    APlanet& SetOceanMassVolatiles(const Math::FUint128& OceanMassVolatiles);
     APlanet& SetOceanMassEnergeticNuclide(float OceanMassEnergeticNuclide);
-    APlanet& SetOceanMassEnergeticNuclide(const boost::multiprecision::uint128_t& OceanMassEnergeticNuclide);
+    APlanet& SetOceanMassEnergeticNuclide(const Math::FUint128& OceanMassEnergeticNuclide);
 
     // Getters
     // Getters for ExtendedProperties
     // ------------------------------
-    const FComplexMass&                     GetAtmosphereMassStruct() const;
-    const boost::multiprecision::uint128_t  GetAtmosphereMass() const;
-    const boost::multiprecision::uint128_t& GetAtmosphereMassZ() const;
-    const boost::multiprecision::uint128_t& GetAtmosphereMassVolatiles() const;
-    const boost::multiprecision::uint128_t& GetAtmosphereMassEnergeticNuclide() const;
-    const FComplexMass&                     GetCoreMassStruct() const;
-    const boost::multiprecision::uint128_t  GetCoreMass() const;
-    const boost::multiprecision::uint128_t& GetCoreMassZ() const;
-    const boost::multiprecision::uint128_t& GetCoreMassVolatiles() const;
-    const boost::multiprecision::uint128_t& GetCoreMassEnergeticNuclide() const;
-    const FComplexMass&                     GetOceanMassStruct() const;
-    const boost::multiprecision::uint128_t  GetOceanMass() const;
-    const boost::multiprecision::uint128_t& GetOceanMassZ() const;
-    const boost::multiprecision::uint128_t& GetOceanMassVolatiles() const;
-    const boost::multiprecision::uint128_t& GetOceanMassEnergeticNuclide() const;
-    const boost::multiprecision::uint128_t  GetMass() const;
-    const boost::multiprecision::uint128_t& GetCrustMineralMass() const;
-    float                                   GetBalanceTemperature() const;
-    bool                                    IsMigrated() const;
-    EPlanetType                             GetPlanetType() const;
+    const FComplexMass&   GetAtmosphereMassStruct() const;
+    const Math::FUint128  GetAtmosphereMass() const;
+    const Math::FUint128& GetAtmosphereMassZ() const;
+    const Math::FUint128& GetAtmosphereMassVolatiles() const;
+    const Math::FUint128& GetAtmosphereMassEnergeticNuclide() const;
+    const FComplexMass&   GetCoreMassStruct() const;
+    const Math::FUint128  GetCoreMass() const;
+    const Math::FUint128& GetCoreMassZ() const;
+    const Math::FUint128& GetCoreMassVolatiles() const;
+    const Math::FUint128& GetCoreMassEnergeticNuclide() const;
+    const FComplexMass&   GetOceanMassStruct() const;
+    const Math::FUint128  GetOceanMass() const;
+    const Math::FUint128& GetOceanMassZ() const;
+    const Math::FUint128& GetOceanMassVolatiles() const;
+    const Math::FUint128& GetOceanMassEnergeticNuclide() const;
+    const Math::FUint128  GetMass() const;
+    const Math::FUint128& GetCrustMineralMass() const;
+    float                 GetBalanceTemperature() const;
+    bool                  IsMigrated() const;
+    EPlanetType           GetPlanetType() const;
 
     template <typename DigitalType>
     DigitalType GetAtmosphereMassDigital() const;
@@ -201,21 +201,21 @@ public:
     // Setters for every mass property
     // -------------------------------
     AAsteroidCluster& SetMassZ(float MassZ);
-    AAsteroidCluster& SetMassZ(const boost::multiprecision::uint128_t& MassZ);
+    AAsteroidCluster& SetMassZ(const Math::FUint128& MassZ);
     AAsteroidCluster& SetMassVolatiles(float MassVolatiles);
-    AAsteroidCluster& SetMassVolatiles(const boost::multiprecision::uint128_t& MassVolatiles);
+    AAsteroidCluster& SetMassVolatiles(const Math::FUint128& MassVolatiles);
     AAsteroidCluster& SetMassEnergeticNuclide(float MassEnergeticNuclide);
-    AAsteroidCluster& SetMassEnergeticNuclide(const boost::multiprecision::uint128_t& MassEnergeticNuclide);
+    AAsteroidCluster& SetMassEnergeticNuclide(const Math::FUint128& MassEnergeticNuclide);
     AAsteroidCluster& SetAsteroidType(EAsteroidType Type);
 
     // Getters
     // Getters for BasicProperties
     // ---------------------------
-    const boost::multiprecision::uint128_t  GetMass() const;
-    const boost::multiprecision::uint128_t& GetMassZ() const;
-    const boost::multiprecision::uint128_t& GetMassVolatiles() const;
-    const boost::multiprecision::uint128_t& GetMassEnergeticNuclide() const;
-    EAsteroidType                           GetAsteroidType() const;
+    const Math::FUint128  GetMass() const;
+    const Math::FUint128& GetMassZ() const;
+    const Math::FUint128& GetMassVolatiles() const;
+    const Math::FUint128& GetMassEnergeticNuclide() const;
+    EAsteroidType         GetAsteroidType() const;
 
     template <typename DigitalType>
     DigitalType GetMassDigital() const;
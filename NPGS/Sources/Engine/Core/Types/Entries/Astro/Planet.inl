@@ -34,11 +34,11 @@ NPGS_INLINE APlanet& APlanet::SetOceanMass(const FComplexMass& OceanMass)
 
 NPGS_INLINE APlanet& APlanet::SetCrustMineralMass(float CrustMineralMass)
 {
-    _ExtraProperties.CrustMineralMass = boost::multiprecision::uint128_t(CrustMineralMass);
+    _ExtraProperties.CrustMineralMass = Math::FUint128(CrustMineralMass);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetCrustMineralMass(const boost::multiprecision::uint128_t& CrustMineralMass)
+NPGS_INLINE APlanet& APlanet::SetCrustMineralMass(const Math::FUint128& CrustMineralMass)
 {
     _ExtraProperties.CrustMineralMass = CrustMineralMass;
     return *this;
@@ -70,11 +70,11 @@ NPGS_INLINE APlanet& APlanet::SetPlanetType(EPlanetType Type)
 
 NPGS_INLINE APlanet& APlanet::SetAtmosphereMassZ(float AtmosphereMassZ)
 {
-    _ExtraProperties.AtmosphereMass.Z = boost::multiprecision::uint128_t(AtmosphereMassZ);
+    _ExtraProperties.AtmosphereMass.Z = Math::FUint128(AtmosphereMassZ);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetAtmosphereMassZ(const boost::multiprecision::uint128_t& AtmosphereMassZ)
+NPGS_INLINE APlanet& APlanet::SetAtmosphereMassZ(const Math::FUint128& AtmosphereMassZ)
 {
     _ExtraProperties.AtmosphereMass.Z = AtmosphereMassZ;
     return *this;
@@ -82,11 +82,11 @@ NPGS_INLINE APlanet& APlanet::SetAtmosphereMassZ(const boost::multiprecision::ui
 
 NPGS_INLINE APlanet& APlanet::SetAtmosphereMassVolatiles(float AtmosphereMassVolatiles)
 {
-    _ExtraProperties.AtmosphereMass.Volatiles = boost::multiprecision::uint128_t(AtmosphereMassVolatiles);
+    _ExtraProperties.AtmosphereMass.Volatiles = Math::FUint128(AtmosphereMassVolatiles);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetAtmosphereMassVolatiles(const boost::multiprecision::uint128_t& AtmosphereMassVolatiles)
+NPGS_INLINE APlanet& APlanet::SetAtmosphereMassVolatiles(const Math::FUint128& AtmosphereMassVolatiles)
 {
     _ExtraProperties.AtmosphereMass.Volatiles = AtmosphereMassVolatiles;
     return *this;
@@ -94,11 +94,11 @@ NPGS_INLINE APlanet& APlanet::SetAtmosphereMassVolatiles(const boost::multipreci
 
 NPGS_INLINE APlanet& APlanet::SetAtmosphereMassEnergeticNuclide(float AtmosphereMassEnergeticNuclide)
 {
-    _ExtraProperties.AtmosphereMass.EnergeticNuclide = boost::multiprecision::uint128_t(AtmosphereMassEnergeticNuclide);
+    _ExtraProperties.AtmosphereMass.EnergeticNuclide = Math::FUint128(AtmosphereMassEnergeticNuclide);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetAtmosphereMassEnergeticNuclide(const boost::multiprecision::uint128_t& AtmosphereMassEnergeticNuclide)
+NPGS_INLINE APlanet& APlanet::SetAtmosphereMassEnergeticNuclide(const Math::FUint128& AtmosphereMassEnergeticNuclide)
 {
     _ExtraProperties.AtmosphereMass.EnergeticNuclide = AtmosphereMassEnergeticNuclide;
     return *this;
@@ -106,11 +106,11 @@ NPGS_INLINE APlanet& APlanet::SetAtmosphereMassEnergeticNuclide(const boost::mul
 
 NPGS_INLINE APlanet& APlanet::SetCoreMassZ(float CoreMassZ)
 {
-    _ExtraProperties.CoreMass.Z = boost::multiprecision::uint128_t(CoreMassZ);
+    _ExtraProperties.CoreMass.Z = Math::FUint128(CoreMassZ);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetCoreMassZ(const boost::multiprecision::uint128_t& CoreMassZ)
+NPGS_INLINE APlanet& APlanet::SetCoreMassZ(const Math::FUint128& CoreMassZ)
 {
     _ExtraProperties.CoreMass.Z = CoreMassZ;
     return *this;
@@ -118,11 +118,11 @@ NPGS_INLINE APlanet& APlanet::SetCoreMassZ(const boost::multiprecision::uint128_
 
 NPGS_INLINE APlanet& APlanet::SetCoreMassVolatiles(float CoreMassVolatiles)
 {
-    _ExtraProperties.CoreMass.Volatiles = boost::multiprecision::uint128_t(CoreMassVolatiles);
+    _ExtraProperties.CoreMass.Volatiles = Math::FUint128(CoreMassVolatiles);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetCoreMassVolatiles(const boost::multiprecision::uint128_t& CoreMassVolatiles)
+NPGS_INLINE APlanet& APlanet::SetCoreMassVolatiles(const Math::FUint128& CoreMassVolatiles)
 {
     _ExtraProperties.CoreMass.Volatiles = CoreMassVolatiles;
     return *this;
@@ -130,11 +130,11 @@ NPGS_INLINE APlanet& APlanet::SetCoreMassVolatiles(const boost::multiprecision::
 
 NPGS_INLINE APlanet& APlanet::SetCoreMassEnergeticNuclide(float CoreMassEnergeticNuclide)
 {
-    _ExtraProperties.CoreMass.EnergeticNuclide = boost::multiprecision::uint128_t(CoreMassEnergeticNuclide);
+    _ExtraProperties.CoreMass.EnergeticNuclide = Math::FUint128(CoreMassEnergeticNuclide);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetCoreMassEnergeticNuclide(const boost::multiprecision::uint128_t& CoreMassEnergeticNuclide)
+NPGS_INLINE APlanet& APlanet::SetCoreMassEnergeticNuclide(const Math::FUint128& CoreMassEnergeticNuclide)
 {
     _ExtraProperties.CoreMass.EnergeticNuclide = CoreMassEnergeticNuclide;
     return *this;
@@ -142,11 +142,11 @@ NPGS_INLINE APlanet& APlanet::SetCoreMassEnergeticNuclide(const boost::multiprec
 
 NPGS_INLINE APlanet& APlanet::SetOceanMassZ(float OceanMassZ)
 {
-    _ExtraProperties.OceanMass.Z = boost::multiprecision::uint128_t(OceanMassZ);
+    _ExtraProperties.OceanMass.Z = Math::FUint128(OceanMassZ);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetOceanMassZ(const boost::multiprecision::uint128_t& OceanMassZ)
+NPGS_INLINE APlanet& APlanet::SetOceanMassZ(const Math::FUint128& OceanMassZ)
 {
     _ExtraProperties.OceanMass.Z = OceanMassZ;
     return *this;
@@ -154,11 +154,11 @@ NPGS_INLINE APlanet& APlanet::SetOceanMassZ(const boost::multiprecision::uint128
 
 NPGS_INLINE APlanet& APlanet::SetOceanMassVolatiles(float OceanMassVolatiles)
 {
-    _ExtraProperties.OceanMass.Volatiles = boost::multiprecision::uint128_t(OceanMassVolatiles);
+    _ExtraProperties.OceanMass.Volatiles = Math::FUint128(OceanMassVolatiles);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetOceanMassVolatiles(const boost::multiprecision::uint128_t& OceanMassVolatiles)
+NPGS_INLINE APlanet& APlanet::SetOceanMassVolatiles(const Math::FUint128& OceanMassVolatiles)
 {
     _ExtraProperties.OceanMass.Volatiles = OceanMassVolatiles;
     return *this;
@@ -166,11 +166,11 @@ NPGS_INLINE APlanet& APlanet::SetOceanMassVolatiles(const boost::multiprecision:
 
 NPGS_INLINE APlanet& APlanet::SetOceanMassEnergeticNuclide(float OceanMassEnergeticNuclide)
 {
-    _ExtraProperties.OceanMass.EnergeticNuclide = boost::multiprecision::uint128_t(OceanMassEnergeticNuclide);
+    _ExtraProperties.OceanMass.EnergeticNuclide = Math::FUint128(OceanMassEnergeticNuclide);
     return *this;
 }
 
-NPGS_INLINE APlanet& APlanet::SetOceanMassEnergeticNuclide(const boost::multiprecision::uint128_t& OceanMassEnergeticNuclide)
+NPGS_INLINE APlanet& APlanet::SetOceanMassEnergeticNuclide(const Math::FUint128& OceanMassEnergeticNuclide)
 {
     _ExtraProperties.OceanMass.EnergeticNuclide = OceanMassEnergeticNuclide;
     return *this;
@@ -181,22 +181,22 @@ NPGS_INLINE const FComplexMass& APlanet::GetAtmosphereMassStruct() const
     return _ExtraProperties.AtmosphereMass;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t APlanet::GetAtmosphereMass() const
+NPGS_INLINE const Math::FUint128 APlanet::GetAtmosphereMass() const
 {
     return GetAtmosphereMassZ() + GetAtmosphereMassVolatiles() + GetAtmosphereMassEnergeticNuclide();
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetAtmosphereMassZ() const
+NPGS_INLINE const Math::FUint128& APlanet::GetAtmosphereMassZ() const
 {
     return _ExtraProperties.AtmosphereMass.Z;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetAtmosphereMassVolatiles() const
+NPGS_INLINE const Math::FUint128& APlanet::GetAtmosphereMassVolatiles() const
 {
     return _ExtraProperties.AtmosphereMass.Volatiles;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetAtmosphereMassEnergeticNuclide() const
+NPGS_INLINE const Math::FUint128& APlanet::GetAtmosphereMassEnergeticNuclide() const
 {
     return _ExtraProperties.AtmosphereMass.EnergeticNuclide;
 }
@@ -206,22 +206,22 @@ NPGS_INLINE const FComplexMass& APlanet::GetCoreMassStruct() const
     return _ExtraProperties.CoreMass;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t APlanet::GetCoreMass() const
+NPGS_INLINE const Math::FUint128 APlanet::GetCoreMass() const
 {
     return GetCoreMassZ() + GetCoreMassVolatiles() + GetCoreMassEnergeticNuclide();
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetCoreMassZ() const
+NPGS_INLINE const Math::FUint128& APlanet::GetCoreMassZ() const
 {
     return _ExtraProperties.CoreMass.Z;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetCoreMassVolatiles() const
+NPGS_INLINE const Math::FUint128& APlanet::GetCoreMassVolatiles() const
 {
     return _ExtraProperties.CoreMass.Volatiles;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetCoreMassEnergeticNuclide() const
+NPGS_INLINE const Math::FUint128& APlanet::GetCoreMassEnergeticNuclide() const
 {
     return _ExtraProperties.CoreMass.EnergeticNuclide;
 }
@@ -231,32 +231,32 @@ NPGS_INLINE const FComplexMass& APlanet::GetOceanMassStruct() const
     return _ExtraProperties.OceanMass;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t APlanet::GetOceanMass() const
+NPGS_INLINE const Math::FUint128 APlanet::GetOceanMass() const
 {
     return GetOceanMassZ() + GetOceanMassVolatiles() + GetOceanMassEnergeticNuclide();
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetOceanMassZ() const
+NPGS_INLINE const Math::FUint128& APlanet::GetOceanMassZ() const
 {
     return _ExtraProperties.OceanMass.Z;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetOceanMassVolatiles() const
+NPGS_INLINE const Math::FUint128& APlanet::GetOceanMassVolatiles() const
 {
     return _ExtraProperties.OceanMass.Volatiles;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetOceanMassEnergeticNuclide() const
+NPGS_INLINE const Math::FUint128& APlanet::GetOceanMassEnergeticNuclide() const
 {
     return _ExtraProperties.OceanMass.EnergeticNuclide;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t APlanet::GetMass() const
+NPGS_INLINE const Math::FUint128 APlanet::GetMass() const
 {
     return GetAtmosphereMass() + GetOceanMass() + GetCoreMass() + GetCrustMineralMass();
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& APlanet::GetCrustMineralMass() const
+NPGS_INLINE const Math::FUint128& APlanet::GetCrustMineralMass() const
 {
     return _ExtraProperties.CrustMineralMass;
 }
@@ -279,85 +279,85 @@ NPGS_INLINE APlanet::EPlanetType APlanet::GetPlanetType() const
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetAtmosphereMassDigital() const
 {
-    return GetAtmosphereMass().convert_to<DigitalType>();
+    return GetAtmosphereMass().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetAtmosphereMassZDigital() const
 {
-    return GetAtmosphereMassZ().convert_to<DigitalType>();
+    return GetAtmosphereMassZ().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetAtmosphereMassVolatilesDigital() const
 {
-    return GetAtmosphereMassVolatiles().convert_to<DigitalType>();
+    return GetAtmosphereMassVolatiles().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetAtmosphereMassEnergeticNuclideDigital() const
 {
-    return GetAtmosphereMassEnergeticNuclide().convert_to<DigitalType>();
+    return GetAtmosphereMassEnergeticNuclide().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetCoreMassDigital() const
 {
-    return GetCoreMass().convert_to<DigitalType>();
+    return GetCoreMass().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetCoreMassZDigital() const
 {
-    return GetCoreMassZ().convert_to<DigitalType>();
+    return GetCoreMassZ().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetCoreMassVolatilesDigital() const
 {
-    return GetCoreMassVolatiles().convert_to<DigitalType>();
+    return GetCoreMassVolatiles().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetCoreMassEnergeticNuclideDigital() const
 {
-    return GetCoreMassEnergeticNuclide().convert_to<DigitalType>();
+    return GetCoreMassEnergeticNuclide().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetOceanMassDigital() const
 {
-    return GetOceanMass().convert_to<DigitalType>();
+    return GetOceanMass().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetOceanMassZDigital() const
 {
-    return GetOceanMassZ().convert_to<DigitalType>();
+    return GetOceanMassZ().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetOceanMassVolatilesDigital() const
 {
-    return GetOceanMassVolatiles().convert_to<DigitalType>();
+    return GetOceanMassVolatiles().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetOceanMassEnergeticNuclideDigital() const
 {
-    return GetOceanMassEnergeticNuclide().convert_to<DigitalType>();
+    return GetOceanMassEnergeticNuclide().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetMassDigital() const
 {
-    return GetMass().convert_to<DigitalType>();
+    return GetMass().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType APlanet::GetCrustMineralMassDigital() const
 {
-    return GetCrustMineralMass().convert_to<DigitalType>();
+    return GetCrustMineralMass().ConvertTo<DigitalType>();
 }
 
 NPGS_INLINE Intelli::FStandard& APlanet::CivilizationData()
@@ -373,11 +373,11 @@ NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMass(const FComplexMass& Mass
 
 NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassZ(float MassZ)
 {
-    _Properties.Mass.Z = boost::multiprecision::uint128_t(MassZ);
+    _Properties.Mass.Z = Math::FUint128(MassZ);
     return *this;
 }
 
-NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassZ(const boost::multiprecision::uint128_t& MassZ)
+NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassZ(const Math::FUint128& MassZ)
 {
     _Properties.Mass.Z = MassZ;
     return *this;
@@ -385,11 +385,11 @@ NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassZ(const boost::multipreci
 
 NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassVolatiles(float MassVolatiles)
 {
-    _Properties.Mass.Volatiles = boost::multiprecision::uint128_t(MassVolatiles);
+    _Properties.Mass.Volatiles = Math::FUint128(MassVolatiles);
     return *this;
 }
 
-NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassVolatiles(const boost::multiprecision::uint128_t& MassVolatiles)
+NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassVolatiles(const Math::FUint128& MassVolatiles)
 {
     _Properties.Mass.Volatiles = MassVolatiles;
     return *this;
@@ -397,11 +397,11 @@ NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassVolatiles(const boost::mu
 
 NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassEnergeticNuclide(float MassEnergeticNuclide)
 {
-    _Properties.Mass.EnergeticNuclide = boost::multiprecision::uint128_t(MassEnergeticNuclide);
+    _Properties.Mass.EnergeticNuclide = Math::FUint128(MassEnergeticNuclide);
     return *this;
 }
 
-NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassEnergeticNuclide(const boost::multiprecision::uint128_t& MassEnergeticNuclide)
+NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetMassEnergeticNuclide(const Math::FUint128& MassEnergeticNuclide)
 {
     _Properties.Mass.EnergeticNuclide = MassEnergeticNuclide;
     return *this;
@@ -413,22 +413,22 @@ NPGS_INLINE AAsteroidCluster& AAsteroidCluster::SetAsteroidType(EAsteroidType Ty
     return *this;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t AAsteroidCluster::GetMass() const
+NPGS_INLINE const Math::FUint128 AAsteroidCluster::GetMass() const
 {
     return GetMassZ() + GetMassVolatiles() + GetMassEnergeticNuclide();
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& AAsteroidCluster::GetMassZ() const
+NPGS_INLINE const Math::FUint128& AAsteroidCluster::GetMassZ() const
 {
     return _Properties.Mass.Z;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& AAsteroidCluster::GetMassVolatiles() const
+NPGS_INLINE const Math::FUint128& AAsteroidCluster::GetMassVolatiles() const
 {
     return _Properties.Mass.Volatiles;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& AAsteroidCluster::GetMassEnergeticNuclide() const
+NPGS_INLINE const Math::FUint128& AAsteroidCluster::GetMassEnergeticNuclide() const
 {
     return _Properties.Mass.EnergeticNuclide;
 }
@@ -441,25 +441,25 @@ NPGS_INLINE AAsteroidCluster::EAsteroidType AAsteroidCluster::GetAsteroidType()
 template <typename DigitalType>
 NPGS_INLINE DigitalType AAsteroidCluster::GetMassDigital() const
 {
-    return GetMass().convert_to<DigitalType>();
+    return GetMass().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType AAsteroidCluster::GetMassZDigital() const
 {
-    return GetMassZ().convert_to<DigitalType>();
+    return GetMassZ().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType AAsteroidCluster::GetMassVolatilesDigital() const
 {
-    return GetMassVolatiles().convert_to<DigitalType>();
+    return GetMassVolatiles().ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType AAsteroidCluster::GetMassEnergeticNuclideDigital() const
 {
-    return GetMassEnergeticNuclide().convert_to<DigitalType>();
+    return GetMassEnergeticNuclide().ConvertTo<DigitalType>();
 }
 
 _ASTRO_END
@@ -1,9 +1,9 @@
 #pragma once
 
 #include <cstdint>
-#include <boost/multiprecision/cpp_int.hpp>
 
 #include "Engine/Core/Base/Base.h"
+#include "Engine/Core/Math/Uint128.h"
 #include "Engine/Core/Types/Entries/NpgsObject.h"
 
 _NPGS_BEGIN
@@ -26,17 +26,17 @@ public:
 
     struct FLifeProperties
     {
-        boost::multiprecision::uint128_t OrganismBiomass; // 生物量，单位 kg
+        Math::FUint128 OrganismBiomass;                   // 生物量，单位 kg
         float OrganismUsedPower{};                        // 生物圈使用的总功率，单位 W
         ELifePhase Phase{ ELifePhase::kNull };            // 生命阶段
     };
 
     struct FCivilizationProperties
     {
-        boost::multiprecision::uint128_t AtrificalStructureMass;  // 文明造物总质量，单位 kg
-        boost::multiprecision::uint128_t CitizenBiomass;          // 文明生物生物量，单位 kg
-        boost::multiprecision::uint128_t UseableEnergeticNuclide; // 可用含能核素总质量，单位 kg
-        boost::multiprecision::uint128_t OrbitAssetsMass;         // 轨道资产总质量，单位 kg
+        Math::FUint128 AtrificalStructureMass;                    // 文明造物总质量，单位 kg
+        Math::FUint128 CitizenBiomass;                            // 文明生物生物量，单位 kg
+        Math::FUint128 UseableEnergeticNuclide;                   // 可用含能核素总质量，单位 kg
+        Math::FUint128 OrbitAssetsMass;                           // 轨道资产总质量，单位 kg
         std::uint64_t GeneralintelligenceCount{};                 // 通用智能个体的数量
         float GeneralIntelligenceAverageSynapseActivationCount{}; // 通用智能个体的智力活动，单位 o/s
         float GeneralIntelligenceSynapseCount{};                  // 通用智能个体的突触数
@@ -57,20 +57,20 @@ public:
     // Setters for LifeProperties
     // --------------------------
     FStandard& SetOrganismBiomass(float OrganismBiomass);
-    FStandard& SetOrganismBiomass(const boost::multiprecision::uint128_t& OrganismBiomass);
+    FStandard& SetOrganismBiomass(const Math::FUint128& OrganismBiomass);
     FStandard& SetOrganismUsedPower(float OrganismUsedPower);
     FStandard& SetLifePhase(ELifePhase Phase);
 
     // Setters for CivilizationProperties
     // ----------------------------------
     FStandard& SetAtrificalStructureMass(float AtrificalStructureMass);
-    FStandard& SetAtrificalStructureMass(const boost::multiprecision::uint128_t& AtrificalStructureMass);
+    FStandard& SetAtrificalStructureMass(const Math::FUint128& AtrificalStructureMass);
     FStandard& SetCitizenBiomass(float CitizenBiomass);
-    FStandard& SetCitizenBiomass(const boost::multiprecision::uint128_t& CitizenBiomass);
+    FStandard& SetCitizenBiomass(const Math::FUint128& CitizenBiomass);
     FStandard& SetUseableEnergeticNuclide(float UseableEnergeticNuclide);
-    FStandard& SetUseableEnergeticNuclide(const boost::multiprecision::uint128_t& UseableEnergeticNuclide);
+    FStandard& SetUseableEnergeticNuclide(const Math::FUint128& UseableEnergeticNuclide);
     FStandard& SetOrbitAssetsMass(float OrbitAssetsMass);
-    FStandard& SetOrbitAssetsMass(const boost::multiprecision::uint128_t& OrbitAssetsMass);
+    FStandard& SetOrbitAssetsMass(const Math::FUint128& OrbitAssetsMass);
     FStandard& SetGeneralintelligenceCount(std::uint64_t GeneralintelligenceCount);
     FStandard& SetGeneralIntelligenceAverageSynapseActivationCount(float GeneralIntelligenceAverageSynapseActivationCount);
     FStandard& SetGeneralIntelligenceSynapseCount(float GeneralIntelligenceSynapseCount);
@@ -84,7 +84,7 @@ public:
     // Getters
     // Getters for LifeProperties
     // --------------------------
-    const boost::multiprecision::uint128_t& GetOrganismBiomass() const;
+    const Math::FUint128& GetOrganismBiomass() const;
     float GetOrganismUsedPower() const;
     ELifePhase GetLifePhase() const;
 
@@ -93,10 +93,10 @@ public:
 
     // Getters for CivilizationProperties
     // ----------------------------------
-    const boost::multiprecision::uint128_t& GetAtrificalStructureMass() const;
-    const boost::multiprecision::uint128_t& GetCitizenBiomass() const;
-    const boost::multiprecision::uint128_t& GetUseableEnergeticNuclide() const;
-    const boost::multiprecision::uint128_t& GetOrbitAssetsMass() const;
+    const Math::FUint128& GetAtrificalStructureMass() const;
+    const Math::FUint128& GetCitizenBiomass() const;
+    const Math::FUint128& GetUseableEnergeticNuclide() const;
+    const Math::FUint128& GetOrbitAssetsMass() const;
     std::uint64_t GetGeneralintelligenceCount() const;
     float GetGeneralIntelligenceAverageSynapseActivationCount() const;
     float GetGeneralIntelligenceSynapseCount() const;
@@ -5,11 +5,11 @@ _INTELLI_BEGIN
 
 NPGS_INLINE FStandard& FStandard::SetOrganismBiomass(float OrganismBiomass)
 {
-    _LifeProperties.OrganismBiomass = boost::multiprecision::uint128_t(OrganismBiomass);
+    _LifeProperties.OrganismBiomass = Math::FUint128(OrganismBiomass);
     return *this;
 }
 
-NPGS_INLINE FStandard& FStandard::SetOrganismBiomass(const boost::multiprecision::uint128_t& OrganismBiomass)
+NPGS_INLINE FStandard& FStandard::SetOrganismBiomass(const Math::FUint128& OrganismBiomass)
 {
     _LifeProperties.OrganismBiomass = OrganismBiomass;
     return *this;
@@ -29,11 +29,11 @@ NPGS_INLINE FStandard& FStandard::SetLifePhase(ELifePhase Phase)
 
 NPGS_INLINE FStandard& FStandard::SetAtrificalStructureMass(float AtrificalStructureMass)
 {
-    _CivilizationProperties.AtrificalStructureMass = boost::multiprecision::uint128_t(AtrificalStructureMass);
+    _CivilizationProperties.AtrificalStructureMass = Math::FUint128(AtrificalStructureMass);
     return *this;
 }
 
-NPGS_INLINE FStandard& FStandard::SetAtrificalStructureMass(const boost::multiprecision::uint128_t& AtrificalStructureMass)
+NPGS_INLINE FStandard& FStandard::SetAtrificalStructureMass(const Math::FUint128& AtrificalStructureMass)
 {
     _CivilizationProperties.AtrificalStructureMass = AtrificalStructureMass;
     return *this;
@@ -41,11 +41,11 @@ NPGS_INLINE FStandard& FStandard::SetAtrificalStructureMass(const boost::multipr
 
 NPGS_INLINE FStandard& FStandard::SetCitizenBiomass(float CitizenBiomass)
 {
-    _CivilizationProperties.CitizenBiomass = boost::multiprecision::uint128_t(CitizenBiomass);
+    _CivilizationProperties.CitizenBiomass = Math::FUint128(CitizenBiomass);
     return *this;
 }
 
-NPGS_INLINE FStandard& FStandard::SetCitizenBiomass(const boost::multiprecision::uint128_t& CitizenBiomass)
+NPGS_INLINE FStandard& FStandard::SetCitizenBiomass(const Math::FUint128& CitizenBiomass)
 {
     _CivilizationProperties.CitizenBiomass = CitizenBiomass;
     return *this;
@@ -53,11 +53,11 @@ NPGS_INLINE FStandard& FStandard::SetCitizenBiomass(const boost::multiprecision:
 
 NPGS_INLINE FStandard& FStandard::SetUseableEnergeticNuclide(float UseableEnergeticNuclide)
 {
-    _CivilizationProperties.UseableEnergeticNuclide = boost::multiprecision::uint128_t(UseableEnergeticNuclide);
+    _CivilizationProperties.UseableEnergeticNuclide = Math::FUint128(UseableEnergeticNuclide);
     return *this;
 }
 
-NPGS_INLINE FStandard& FStandard::SetUseableEnergeticNuclide(const boost::multiprecision::uint128_t& UseableEnergeticNuclide)
+NPGS_INLINE FStandard& FStandard::SetUseableEnergeticNuclide(const Math::FUint128& UseableEnergeticNuclide)
 {
     _CivilizationProperties.UseableEnergeticNuclide = UseableEnergeticNuclide;
     return *this;
@@ -65,11 +65,11 @@ NPGS_INLINE FStandard& FStandard::SetUseableEnergeticNuclide(const boost::multip
 
 NPGS_INLINE FStandard& FStandard::SetOrbitAssetsMass(float OrbitAssetsMass)
 {
-    _CivilizationProperties.OrbitAssetsMass = boost::multiprecision::uint128_t(OrbitAssetsMass);
+    _CivilizationProperties.OrbitAssetsMass = Math::FUint128(OrbitAssetsMass);
     return *this;
 }
 
-NPGS_INLINE FStandard& FStandard::SetOrbitAssetsMass(const boost::multiprecision::uint128_t& OrbitAssetsMass)
+NPGS_INLINE FStandard& FStandard::SetOrbitAssetsMass(const Math::FUint128& OrbitAssetsMass)
 {
     _CivilizationProperties.OrbitAssetsMass = OrbitAssetsMass;
     return *this;
@@ -129,7 +129,7 @@ NPGS_INLINE FStandard& FStandard::SetIsIndependentIndividual(bool bIsIndependent
     return *this;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& FStandard::GetOrganismBiomass() const
+NPGS_INLINE const Math::FUint128& FStandard::GetOrganismBiomass() const
 {
     return _LifeProperties.OrganismBiomass;
 }
@@ -147,25 +147,25 @@ NPGS_INLINE FStandard::ELifePhase FStandard::GetLifePhase() const
 template <typename DigitalType>
 NPGS_INLINE DigitalType FStandard::GetOrganismBiomassDigital() const
 {
-    return _LifeProperties.OrganismBiomass.convert_to<DigitalType>();
+    return _LifeProperties.OrganismBiomass.ConvertTo<DigitalType>();
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& FStandard::GetAtrificalStructureMass() const
+NPGS_INLINE const Math::FUint128& FStandard::GetAtrificalStructureMass() const
 {
     return _CivilizationProperties.AtrificalStructureMass;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& FStandard::GetCitizenBiomass() const
+NPGS_INLINE const Math::FUint128& FStandard::GetCitizenBiomass() const
 {
     return _CivilizationProperties.CitizenBiomass;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& FStandard::GetUseableEnergeticNuclide() const
+NPGS_INLINE const Math::FUint128& FStandard::GetUseableEnergeticNuclide() const
 {
     return _CivilizationProperties.UseableEnergeticNuclide;
 }
 
-NPGS_INLINE const boost::multiprecision::uint128_t& FStandard::GetOrbitAssetsMass() const
+NPGS_INLINE const Math::FUint128& FStandard::GetOrbitAssetsMass() const
 {
     return _CivilizationProperties.OrbitAssetsMass;
 }
@@ -218,25 +218,25 @@ NPGS_INLINE bool FStandard::IsIndependentIndividual() const
 template <typename DigitalType>
 NPGS_INLINE DigitalType FStandard::GetAtrificalStructureMassDigital() const
 {
-    return _CivilizationProperties.AtrificalStructureMass.convert_to<DigitalType>();
+    return _CivilizationProperties.AtrificalStructureMass.ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType FStandard::GetCitizenBiomassDigital() const
 {
-    return _CivilizationProperties.CitizenBiomass.convert_to<DigitalType>();
+    return _CivilizationProperties.CitizenBiomass.ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType FStandard::GetUseableEnergeticNuclideDigital() const
 {
-    return _CivilizationProperties.UseableEnergeticNuclide.convert_to<DigitalType>();
+    return _CivilizationProperties.UseableEnergeticNuclide.ConvertTo<DigitalType>();
 }
 
 template <typename DigitalType>
 NPGS_INLINE DigitalType FStandard::GetOrbitAssetsMassDigital() const
 {
-    return _CivilizationProperties.OrbitAssetsMass.convert_to<DigitalType>();
+    return _CivilizationProperties.OrbitAssetsMass.ConvertTo<DigitalType>();
 }
 
 _INTELLI_END
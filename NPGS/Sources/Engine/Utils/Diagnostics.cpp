@@ -0,0 +1,125 @@
+#include "Diagnostics.h"
+
+#include <iterator>
+
+_NPGS_BEGIN
+_UTIL_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    void WriteJsonString(std::ostream& Stream, std::string_view String)
+    {
+        Stream << '"';
+        for (char Char : String)
+        {
+            switch (Char)
+            {
+            case '"':
+                Stream << "\\\"";
+                break;
+            case '\\':
+                Stream << "\\\\";
+                break;
+            case '\n':
+                Stream << "\\n";
+                break;
+            case '\t':
+                Stream << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(Char) < 0x20)
+                {
+                    Stream << std::format("\\u{:04x}", static_cast<unsigned>(Char));
+                }
+                else
+                {
+                    Stream << Char;
+                }
+                break;
+            }
+        }
+        Stream << '"';
+    }
+}
+
+// FDiagnostics::FScopedSystem implementations
+// -------------------------------------------
+FDiagnostics::FScopedSystem::FScopedSystem(std::size_t SystemIndex)
+    : _PrevSystemIndex(_kThreadSystemIndex), _bPrevTracing(_kbThreadTracing)
+{
+#ifndef NPGS_DISABLE_DIAGNOSTICS
+    _kThreadSystemIndex = SystemIndex;
+    _kbThreadTracing    = SystemIndex == GetTargetSystem();
+#endif // NPGS_DISABLE_DIAGNOSTICS
+}
+
+FDiagnostics::FScopedSystem::~FScopedSystem()
+{
+#ifndef NPGS_DISABLE_DIAGNOSTICS
+    if (_kbThreadTracing)
+    {
+        FlushThreadRecords();
+    }
+
+    _kThreadSystemIndex = _PrevSystemIndex;
+    _kbThreadTracing    = _bPrevTracing;
+#endif // NPGS_DISABLE_DIAGNOSTICS
+}
+
+// FDiagnostics implementations
+// ----------------------------
+void FDiagnostics::Dump(std::ostream& Stream)
+{
+    std::lock_guard Lock(_kRecordMutex);
+    for (const auto& Record : _kRecords)
+    {
+        Stream << "{\"system\":" << Record.SystemIndex << ",\"channel\":";
+        WriteJsonString(Stream, Record.Channel);
+        Stream << ",\"message\":";
+        WriteJsonString(Stream, Record.Message);
+        Stream << "}\n";
+    }
+}
+
+std::vector<FDiagnostics::FRecord> FDiagnostics::TakeRecords()
+{
+    std::lock_guard Lock(_kRecordMutex);
+    return std::exchange(_kRecords, {});
+}
+
+void FDiagnostics::Clear()
+{
+    std::lock_guard Lock(_kRecordMutex);
+    _kRecords.clear();
+}
+
+void FDiagnostics::RecordImpl(std::string_view Channel, std::string&& Message)
+{
+    _kThreadRecords.emplace_back(_kThreadSystemIndex, std::string(Channel), std::move(Message));
+}
+
+void FDiagnostics::FlushThreadRecords()
+{
+    if (_kThreadRecords.empty())
+    {
+        return;
+    }
+
+    std::lock_guard Lock(_kRecordMutex);
+    _kRecords.insert(_kRecords.end(), std::make_move_iterator(_kThreadRecords.begin()),
+                     std::make_move_iterator(_kThreadRecords.end()));
+    _kThreadRecords.clear();
+}
+
+std::atomic<std::size_t>           FDiagnostics::_kTargetSystem{ FDiagnostics::kNoTarget };
+std::mutex                         FDiagnostics::_kRecordMutex;
+std::vector<FDiagnostics::FRecord> FDiagnostics::_kRecords;
+
+thread_local std::vector<FDiagnostics::FRecord> FDiagnostics::_kThreadRecords;
+thread_local std::size_t                        FDiagnostics::_kThreadSystemIndex = FDiagnostics::kNoTarget;
+thread_local bool                               FDiagnostics::_kbThreadTracing    = false;
+
+_UTIL_END
+_NPGS_END
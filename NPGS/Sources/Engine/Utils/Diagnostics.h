@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <format>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_UTIL_BEGIN
+
+// 按恒星系统记录的生成诊断信息，只追踪运行时选定的一个系统
+// 追踪期间记录写入线程局部缓冲，系统生成结束时一次性并入全局记录，关闭时每个诊断点只有一次线程局部读取
+// 定义 NPGS_DISABLE_DIAGNOSTICS 时 IsTracing 恒为 false，诊断宏展开为空
+class FDiagnostics
+{
+public:
+    static constexpr std::size_t kNoTarget = std::numeric_limits<std::size_t>::max();
+
+    struct FRecord
+    {
+        std::size_t SystemIndex{};
+        std::string Channel;
+        std::string Message;
+    };
+
+    // 标记当前线程正在生成的系统，可嵌套
+    class FScopedSystem
+    {
+    public:
+        explicit FScopedSystem(std::size_t SystemIndex);
+        FScopedSystem(const FScopedSystem&) = delete;
+        ~FScopedSystem();
+
+        FScopedSystem& operator=(const FScopedSystem&) = delete;
+
+    private:
+        std::size_t _PrevSystemIndex;
+        bool        _bPrevTracing;
+    };
+
+public:
+    static void SetTargetSystem(std::size_t SystemIndex);
+    static void Disable();
+    static std::size_t GetTargetSystem();
+    static bool IsTracing();
+
+    template <typename... Args>
+    static void Record(std::string_view Channel, std::format_string<Args...> Format, Args&&... Arguments);
+
+    // 每条记录输出一行 JSON：{"system":N,"channel":"...","message":"..."}
+    static void Dump(std::ostream& Stream);
+    static std::vector<FRecord> TakeRecords();
+    static void Clear();
+
+private:
+    static void RecordImpl(std::string_view Channel, std::string&& Message);
+    static void FlushThreadRecords();
+
+private:
+    static std::atomic<std::size_t> _kTargetSystem;
+    static std::mutex               _kRecordMutex;
+    static std::vector<FRecord>     _kRecords;
+
+    static thread_local std::vector<FRecord> _kThreadRecords;
+    static thread_local std::size_t          _kThreadSystemIndex;
+    static thread_local bool                 _kbThreadTracing;
+};
+
+_UTIL_END
+_NPGS_END
+
+#ifndef NPGS_DISABLE_DIAGNOSTICS
+#define NpgsDiagnostic(Channel, ...)                                        \
+    do                                                                      \
+    {                                                                       \
+        if (::Npgs::Util::FDiagnostics::IsTracing())                        \
+        {                                                                   \
+            ::Npgs::Util::FDiagnostics::Record(Channel, __VA_ARGS__);       \
+        }                                                                   \
+    } while (false)
+#else
+#define NpgsDiagnostic(Channel, ...) static_cast<void>(0)
+#endif // NPGS_DISABLE_DIAGNOSTICS
+
+#include "Diagnostics.inl"
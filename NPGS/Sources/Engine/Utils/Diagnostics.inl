@@ -0,0 +1,40 @@
+#include "Diagnostics.h"
+
+_NPGS_BEGIN
+_UTIL_BEGIN
+
+NPGS_INLINE void FDiagnostics::SetTargetSystem(std::size_t SystemIndex)
+{
+    _kTargetSystem.store(SystemIndex, std::memory_order_relaxed);
+}
+
+NPGS_INLINE void FDiagnostics::Disable()
+{
+    _kTargetSystem.store(kNoTarget, std::memory_order_relaxed);
+}
+
+NPGS_INLINE std::size_t FDiagnostics::GetTargetSystem()
+{
+    return _kTargetSystem.load(std::memory_order_relaxed);
+}
+
+NPGS_INLINE bool FDiagnostics::IsTracing()
+{
+#ifndef NPGS_DISABLE_DIAGNOSTICS
+    return _kbThreadTracing;
+#else
+    return false;
+#endif // NPGS_DISABLE_DIAGNOSTICS
+}
+
+template <typename... Args>
+NPGS_INLINE void FDiagnostics::Record(std::string_view Channel, std::format_string<Args...> Format, Args&&... Arguments)
+{
+    if (IsTracing())
+    {
+        RecordImpl(Channel, std::format(Format, std::forward<Args>(Arguments)...));
+    }
+}
+
+_UTIL_END
+_NPGS_END
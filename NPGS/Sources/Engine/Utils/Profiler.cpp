@@ -0,0 +1,39 @@
+#include "Profiler.h"
+
+_NPGS_BEGIN
+_UTIL_BEGIN
+
+namespace
+{
+    thread_local FStageProfiler::FStageRecords kThreadStageRecords{};
+    thread_local std::uint64_t                 kThreadAllocationCount = 0;
+}
+
+// FStageProfiler implementations
+// ------------------------------
+FStageProfiler::FStageRecords& FStageProfiler::GetThreadRecords()
+{
+    return kThreadStageRecords;
+}
+
+void FStageProfiler::ResetThreadRecords()
+{
+    kThreadStageRecords.fill({});
+}
+
+// FAllocationCounter implementations
+// ----------------------------------
+void FAllocationCounter::RecordAllocation()
+{
+    ++kThreadAllocationCount;
+}
+
+std::uint64_t FAllocationCounter::GetThreadCount()
+{
+    return kThreadAllocationCount;
+}
+
+std::atomic<bool> FStageProfiler::_kbEnabled{ false };
+
+_UTIL_END
+_NPGS_END
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+_UTIL_BEGIN
+
+// 分段计时统计，每个线程独立累计，读写均无锁
+// 运行时默认关闭，关闭时每个计时点只有一次 relaxed 读取；定义 NPGS_DISABLE_STAGE_PROFILER 时计时宏展开为空
+class FStageProfiler
+{
+public:
+    static constexpr std::size_t kMaxStageCount = 32;
+
+    struct FStageRecord
+    {
+        std::uint64_t Calls{};
+        std::uint64_t Nanoseconds{};
+    };
+
+    using FStageRecords = std::array<FStageRecord, kMaxStageCount>;
+
+    class FScopedTimer
+    {
+    public:
+        explicit FScopedTimer(std::size_t StageIndex);
+        FScopedTimer(const FScopedTimer&) = delete;
+        ~FScopedTimer();
+
+        FScopedTimer& operator=(const FScopedTimer&) = delete;
+
+    private:
+        std::chrono::steady_clock::time_point _Start;
+        std::size_t                           _StageIndex;
+        bool                                  _bActive;
+    };
+
+    // 顺序分段计时，用于一个长函数内首尾相接的多个阶段；Switch 结束当前阶段并开始下一个，Stop 或析构时结束当前阶段
+    class FSequentialTimer
+    {
+    public:
+        FSequentialTimer();
+        FSequentialTimer(const FSequentialTimer&) = delete;
+        ~FSequentialTimer();
+
+        FSequentialTimer& operator=(const FSequentialTimer&) = delete;
+
+        void Switch(std::size_t StageIndex);
+        void Stop();
+
+    private:
+        std::chrono::steady_clock::time_point _Start;
+        std::size_t                           _StageIndex;
+        bool                                  _bActive;
+        bool                                  _bRunning;
+    };
+
+public:
+    static void SetEnabled(bool bEnabled);
+    static bool IsEnabled();
+
+    // 当前线程的累计值，嵌套的阶段各自计入完整耗时
+    static FStageRecords& GetThreadRecords();
+    static void ResetThreadRecords();
+
+private:
+    static std::atomic<bool> _kbEnabled;
+};
+
+// 当前线程的内存分配计数，由替换全局 operator new 的程序调用 RecordAllocation
+// 只有定义 NPGS_ENABLE_ALLOCATION_COUNTER 的基准测试构建会替换 operator new，其他构建中计数始终为 0
+class FAllocationCounter
+{
+public:
+    static void RecordAllocation();
+    static std::uint64_t GetThreadCount();
+    static constexpr bool IsEnabled();
+};
+
+_UTIL_END
+_NPGS_END
+
+#ifndef NPGS_DISABLE_STAGE_PROFILER
+#define NpgsProfileStage(Stage) ::Npgs::Util::FStageProfiler::FScopedTimer _NpgsStageTimer(static_cast<std::size_t>(Stage))
+#define NpgsProfileSequence() ::Npgs::Util::FStageProfiler::FSequentialTimer _NpgsSequenceTimer
+#define NpgsProfileSequenceSwitch(Stage) _NpgsSequenceTimer.Switch(static_cast<std::size_t>(Stage))
+#define NpgsProfileSequenceStop() _NpgsSequenceTimer.Stop()
+#else
+#define NpgsProfileStage(Stage) static_cast<void>(0)
+#define NpgsProfileSequence() static_cast<void>(0)
+#define NpgsProfileSequenceSwitch(Stage) static_cast<void>(0)
+#define NpgsProfileSequenceStop() static_cast<void>(0)
+#endif // NPGS_DISABLE_STAGE_PROFILER
+
+#include "Profiler.inl"
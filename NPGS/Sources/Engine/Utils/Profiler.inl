@@ -0,0 +1,79 @@
+#include "Profiler.h"
+
+_NPGS_BEGIN
+_UTIL_BEGIN
+
+NPGS_INLINE FStageProfiler::FScopedTimer::FScopedTimer(std::size_t StageIndex)
+    : _StageIndex(StageIndex), _bActive(IsEnabled())
+{
+    if (_bActive)
+    {
+        _Start = std::chrono::steady_clock::now();
+    }
+}
+
+NPGS_INLINE FStageProfiler::FScopedTimer::~FScopedTimer()
+{
+    if (_bActive)
+    {
+        auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _Start);
+        auto& Record = GetThreadRecords()[_StageIndex];
+        ++Record.Calls;
+        Record.Nanoseconds += static_cast<std::uint64_t>(Elapsed.count());
+    }
+}
+
+NPGS_INLINE FStageProfiler::FSequentialTimer::FSequentialTimer()
+    : _StageIndex(0), _bActive(IsEnabled()), _bRunning(false)
+{
+}
+
+NPGS_INLINE FStageProfiler::FSequentialTimer::~FSequentialTimer()
+{
+    Stop();
+}
+
+NPGS_INLINE void FStageProfiler::FSequentialTimer::Switch(std::size_t StageIndex)
+{
+    if (_bActive)
+    {
+        Stop();
+        _StageIndex = StageIndex;
+        _bRunning   = true;
+        _Start      = std::chrono::steady_clock::now();
+    }
+}
+
+NPGS_INLINE void FStageProfiler::FSequentialTimer::Stop()
+{
+    if (_bRunning)
+    {
+        auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _Start);
+        auto& Record = GetThreadRecords()[_StageIndex];
+        ++Record.Calls;
+        Record.Nanoseconds += static_cast<std::uint64_t>(Elapsed.count());
+        _bRunning = false;
+    }
+}
+
+NPGS_INLINE void FStageProfiler::SetEnabled(bool bEnabled)
+{
+    _kbEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+NPGS_INLINE bool FStageProfiler::IsEnabled()
+{
+    return _kbEnabled.load(std::memory_order_relaxed);
+}
+
+NPGS_INLINE constexpr bool FAllocationCounter::IsEnabled()
+{
+#ifdef NPGS_ENABLE_ALLOCATION_COUNTER
+    return true;
+#else
+    return false;
+#endif // NPGS_ENABLE_ALLOCATION_COUNTER
+}
+
+_UTIL_END
+_NPGS_END
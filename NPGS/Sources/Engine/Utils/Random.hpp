@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
 #include "Engine/Core/Base/Base.h"
@@ -127,5 +130,72 @@ private:
     std::bernoulli_distribution _Distribution;
 };
 
+// 稀疏伯努利采样器，对候选序列中的每个候选做一次概率为 Probability 的伯努利试验
+// 两次命中之间间隔的失败次数服从几何分布，因此只在命中后抽一次间隔，其余候选只做一次递减
+// 与逐个候选调用 TBernoulliDistribution 在统计上等价，但随机数消耗从每个候选一次降为每次命中一次
+template <typename RandomEngine = std::mt19937>
+requires std::is_class_v<RandomEngine>
+class TGeometricSkipSampler
+{
+public:
+    TGeometricSkipSampler() = default;
+    TGeometricSkipSampler(double Probability)
+        : _Distribution(std::clamp(Probability, kMinProbability, kMaxProbability)), _Probability(Probability)
+    {
+    }
+
+    // 消耗一个候选，返回该候选是否命中
+    bool operator()(RandomEngine& Engine)
+    {
+        // 概率过小时第一次命中前的期望候选数远超实际会遇到的数量，直接视为不会发生
+        if (_Probability < kMinProbability)
+        {
+            return false;
+        }
+        if (_Probability >= 1.0)
+        {
+            return true;
+        }
+
+        // 间隔在第一个候选到来时才抽取，没有候选时不消耗随机数
+        if (!_bGapDrawn)
+        {
+            _RemainingGap = _Distribution(Engine);
+            _bGapDrawn    = true;
+        }
+
+        if (_RemainingGap == 0)
+        {
+            _bGapDrawn = false;
+            return true;
+        }
+
+        --_RemainingGap;
+        return false;
+    }
+
+    bool Generate(RandomEngine& Engine)
+    {
+        return operator()(Engine);
+    }
+
+    // 丢弃已抽取的间隔，下一个候选重新开始计数
+    void Reset()
+    {
+        _bGapDrawn = false;
+    }
+
+private:
+    // 更小的概率下 log(1 - p) 舍入为 0 或间隔超出 uint64 范围，几何分布无法正确抽样
+    static constexpr double kMinProbability = 1e-12;
+    static constexpr double kMaxProbability = 1.0 - std::numeric_limits<double>::epsilon();
+
+private:
+    std::geometric_distribution<std::uint64_t> _Distribution;
+    std::uint64_t                              _RemainingGap{};
+    double                                     _Probability{ 0.5 };
+    bool                                       _bGapDrawn{ false };
+};
+
 _UTIL_END
 _NPGS_END
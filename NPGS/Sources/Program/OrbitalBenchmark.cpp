@@ -0,0 +1,453 @@
+#include "OrbitalBenchmark.h"
+
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Math/NumericConstants.h"
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Core/Types/Entries/Astro/OrbitalHierarchy.h"
+#include "Engine/Utils/Logger.h"
+#include "Engine/Utils/Random.hpp"
+
+_NPGS_BEGIN
+
+namespace SysGen = System::Generator;
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::array kStageNames
+    {
+        "generate_orbitals",
+        "generate_binary_orbit",
+        "generate_planets",
+        "planetary_disk",
+        "core_masses",
+        "semi_major_axes",
+        "disk_age",
+        "binary_stability",
+        "zones",
+        "migration",
+        "planet_details",
+        "kuiper_belt",
+        "finalize_planets",
+        "judge_large_planets",
+        "generate_moons",
+        "generate_rings",
+        "generate_terra",
+        "generate_trojan",
+        "generate_civilization",
+        "calculate_orbital_periods"
+    };
+
+    static_assert(kStageNames.size() == static_cast<std::size_t>(SysGen::FOrbitalGenerator::EGenerationStage::kCount));
+    static_assert(kStageNames.size() <= Util::FStageProfiler::kMaxStageCount);
+
+    std::vector<std::uint32_t> GenerateSeeds(std::mt19937& RandomEngine)
+    {
+        std::vector<std::uint32_t> Seeds(32);
+        std::generate(Seeds.begin(), Seeds.end(), std::ref(RandomEngine));
+        return Seeds;
+    }
+
+    // 按场景生成恒星系统样本，双星的伴星质量和年龄参照 FUniverse::GenerateBinaryStars 生成
+    std::vector<Astro::FStellarSystem>
+    GenerateSystems(const FOrbitalBenchmark::FScenario& Scenario, std::mt19937& RandomEngine, std::size_t SystemCount)
+    {
+        using FStellarGenerator = SysGen::FStellarGenerator;
+
+        std::vector<std::uint32_t> PrimarySeeds   = GenerateSeeds(RandomEngine);
+        std::vector<std::uint32_t> SecondarySeeds = GenerateSeeds(RandomEngine);
+        std::seed_seq PrimarySeedSequence(PrimarySeeds.begin(), PrimarySeeds.end());
+        std::seed_seq SecondarySeedSequence(SecondarySeeds.begin(), SecondarySeeds.end());
+
+        FStellarGenerator::FGenerationInfo PrimaryGenerationInfo
+        {
+            .SeedSequence      = &PrimarySeedSequence,
+            .StellarTypeOption = Scenario.StellarTypeOption,
+            .MassLowerLimit    = Scenario.MassLowerLimit,
+            .MassUpperLimit    = Scenario.MassUpperLimit
+        };
+
+        FStellarGenerator::FGenerationInfo SecondaryGenerationInfo
+        {
+            .SeedSequence       = &SecondarySeedSequence,
+            .StellarTypeOption  = FStellarGenerator::EStellarTypeGenerationOption::kRandom,
+            .MultiplicityOption = FStellarGenerator::EMultiplicityGenerationOption::kBinarySecondStar
+        };
+
+        FStellarGenerator PrimaryGenerator(PrimaryGenerationInfo);
+        FStellarGenerator SecondaryGenerator(SecondaryGenerationInfo);
+
+        std::vector<Astro::FStellarSystem> Systems;
+        Systems.reserve(SystemCount);
+        for (std::size_t i = 0; i != SystemCount; ++i)
+        {
+            auto Properties = PrimaryGenerator.GenerateBasicProperties();
+            Properties.MultiplicityOption = Scenario.bBinary ? FStellarGenerator::EMultiplicityGenerationOption::kBinaryFirstStar
+                                                             : FStellarGenerator::EMultiplicityGenerationOption::kSingleStar;
+            Properties.bIsSingleStar      = !Scenario.bBinary;
+
+            Astro::FBaryCenter SystemBary(glm::vec3(0.0f), glm::vec2(0.0f), i, "");
+            Astro::FStellarSystem& System = Systems.emplace_back(SystemBary);
+            System.StarsData().push_back(std::make_unique<Astro::AStar>(PrimaryGenerator.GenerateStar(Properties)));
+            System.SetBaryNormal(System.StarsData().front()->GetNormal());
+
+            if (Scenario.bBinary)
+            {
+                const auto& Star              = System.StarsData().front();
+                float FirstStarInitialMassSol = Star->GetInitialMass() / kSolarMass;
+
+                SecondaryGenerator.SetMassLowerLimit(std::max(0.075f, 0.1f * FirstStarInitialMassSol));
+                SecondaryGenerator.SetMassUpperLimit(std::min(10 * FirstStarInitialMassSol, 300.0f));
+                SecondaryGenerator.SetLogMassSuggestDistribution(
+                    std::make_unique<Util::TNormalDistribution<>>(std::log10(FirstStarInitialMassSol), 0.25f));
+
+                double Age = Star->GetAge();
+                if (std::to_underlying(Star->GetEvolutionPhase()) > 10)
+                {
+                    Age -= Star->GetLifetime();
+                }
+
+                auto SecondaryProperties = SecondaryGenerator.GenerateBasicProperties(static_cast<float>(Age), Star->GetFeH());
+                System.StarsData().push_back(std::make_unique<Astro::AStar>(SecondaryGenerator.GenerateStar(SecondaryProperties)));
+            }
+        }
+
+        return Systems;
+    }
+
+    std::uint64_t CountBodies(Astro::FStellarSystem& System)
+    {
+        return System.StarsData().size() + System.PlanetsData().size() + System.AsteroidClustersData().size();
+    }
+
+    const char* GetSchemeName(FOrbitalBenchmark::EIntegrationScheme Scheme)
+    {
+        switch (Scheme)
+        {
+        case FOrbitalBenchmark::EIntegrationScheme::kWisdomHolman:
+            return "wisdom_holman";
+        case FOrbitalBenchmark::EIntegrationScheme::kLeapfrog:
+            return "leapfrog";
+        default:
+            return "automatic";
+        }
+    }
+}
+
+// FOrbitalBenchmark implementations
+// ---------------------------------
+FOrbitalBenchmark::FOrbitalBenchmark(std::uint32_t Seed, std::size_t SystemCount, int ThreadCount)
+    : _Seed(Seed), _SystemCount(SystemCount), _ThreadCount(std::max(ThreadCount, 1))
+{
+}
+
+void FOrbitalBenchmark::AddScenario(const FScenario& Scenario)
+{
+    _Scenarios.push_back(Scenario);
+}
+
+void FOrbitalBenchmark::AddDefaultScenarios()
+{
+    using EOption = FStellarGenerator::EStellarTypeGenerationOption;
+
+    // 主序星按初始质量近似划分光谱型，致密星按前身星初始质量划分
+    std::vector<FScenario> Classes;
+    Classes.push_back({ .Name = "o",            .MassLowerLimit = 16.0f,  .MassUpperLimit = 90.0f  });
+    Classes.push_back({ .Name = "b",            .MassLowerLimit = 2.1f,   .MassUpperLimit = 16.0f  });
+    Classes.push_back({ .Name = "a",            .MassLowerLimit = 1.4f,   .MassUpperLimit = 2.1f   });
+    Classes.push_back({ .Name = "f",            .MassLowerLimit = 1.04f,  .MassUpperLimit = 1.4f   });
+    Classes.push_back({ .Name = "g",            .MassLowerLimit = 0.8f,   .MassUpperLimit = 1.04f  });
+    Classes.push_back({ .Name = "k",            .MassLowerLimit = 0.45f,  .MassUpperLimit = 0.8f   });
+    Classes.push_back({ .Name = "m",            .MassLowerLimit = 0.075f, .MassUpperLimit = 0.45f  });
+    Classes.push_back({ .Name = "white_dwarf",  .StellarTypeOption = EOption::kDeathStar, .MassLowerLimit = 0.8f,  .MassUpperLimit = 8.0f   });
+    Classes.push_back({ .Name = "neutron_star", .StellarTypeOption = EOption::kDeathStar, .MassLowerLimit = 10.0f, .MassUpperLimit = 20.0f  });
+    Classes.push_back({ .Name = "black_hole",   .StellarTypeOption = EOption::kDeathStar, .MassLowerLimit = 25.0f, .MassUpperLimit = 100.0f });
+
+    for (bool bBinary : { false, true })
+    {
+        for (auto Scenario : Classes)
+        {
+            Scenario.bBinary = bBinary;
+            _Scenarios.push_back(std::move(Scenario));
+        }
+    }
+
+    _Scenarios.push_back({ .Name = "g_batch_civilization", .MassLowerLimit = 0.8f,  .MassUpperLimit = 1.04f, .bBatchCivilizations = true });
+    _Scenarios.push_back({ .Name = "k_batch_civilization", .MassLowerLimit = 0.45f, .MassUpperLimit = 0.8f,  .bBatchCivilizations = true });
+
+    // 单星系统中心天体占主导，两种格式都适用；双星系统自动选择时基本都会退回 leapfrog
+    std::vector<int> IntegrationThreadCounts{ 1 };
+    if (_ThreadCount > 1)
+    {
+        IntegrationThreadCounts.push_back(_ThreadCount);
+    }
+
+    for (int ThreadCount : IntegrationThreadCounts)
+    {
+        for (auto Scheme : { EIntegrationScheme::kWisdomHolman, EIntegrationScheme::kLeapfrog })
+        {
+            _Scenarios.push_back({ .Name = std::string("g_nbody_") + GetSchemeName(Scheme), .MassLowerLimit = 0.8f, .MassUpperLimit = 1.04f,
+                                   .bIntegrate = true, .IntegrationScheme = Scheme, .IntegrationThreadCount = ThreadCount });
+        }
+
+        _Scenarios.push_back({ .Name = "g_nbody_automatic", .MassLowerLimit = 0.8f, .MassUpperLimit = 1.04f, .bBinary = true,
+                               .bIntegrate = true, .IntegrationThreadCount = ThreadCount });
+    }
+}
+
+void FOrbitalBenchmark::Run(std::ostream& Output)
+{
+    if (!Util::FAllocationCounter::IsEnabled())
+    {
+        NpgsCoreWarn("Allocation counter is disabled, allocs_per_system will be nan. Build with /p:NpgsAllocationCounter=true to measure it.");
+    }
+
+    PrintHeader(Output);
+    for (const auto& Scenario : _Scenarios)
+    {
+        NpgsCoreInfo("Benchmarking {} ({}), {} systems on {} threads...",
+                     Scenario.Name, Scenario.bBinary ? "binary" : "single", _SystemCount, _ThreadCount);
+
+        FResult Result = RunScenario(Scenario);
+        PrintResult(Output, Scenario, Result);
+        Output.flush();
+    }
+}
+
+FOrbitalBenchmark::FResult FOrbitalBenchmark::RunScenario(const FScenario& Scenario)
+{
+    // 每个场景使用相同的种子，保证不同版本之间的恒星样本和行星生成序列一致
+    std::mt19937 RandomEngine(_Seed);
+
+    std::vector<std::vector<Astro::FStellarSystem>> SystemChunks;
+    std::vector<FOrbitalGenerator> Generators;
+    std::vector<FCivilizationGenerator::FBatchInput> CandidateChunks(_ThreadCount);
+    SystemChunks.reserve(_ThreadCount);
+    Generators.reserve(_ThreadCount);
+    for (int i = 0; i != _ThreadCount; ++i)
+    {
+        std::size_t ChunkSize = _SystemCount / _ThreadCount + (static_cast<std::size_t>(i) < _SystemCount % _ThreadCount ? 1 : 0);
+        SystemChunks.push_back(GenerateSystems(Scenario, RandomEngine, ChunkSize));
+
+        std::vector<std::uint32_t> Seeds = GenerateSeeds(RandomEngine);
+        std::seed_seq SeedSequence(Seeds.begin(), Seeds.end());
+
+        FOrbitalGenerator::FGenerationInfo GenerationInfo;
+        GenerationInfo.SeedSequence           = &SeedSequence;
+        GenerationInfo.CivilizationCandidates = Scenario.bBatchCivilizations ? &CandidateChunks[i] : nullptr;
+        Generators.emplace_back(GenerationInfo);
+    }
+
+    // 批量生成使用的参数与行星生成器内部的文明生成器一致
+    std::vector<std::uint32_t> CivilizationSeeds = GenerateSeeds(RandomEngine);
+    std::seed_seq CivilizationSeedSequence(CivilizationSeeds.begin(), CivilizationSeeds.end());
+    FOrbitalGenerator::FGenerationInfo DefaultGenerationInfo;
+    FCivilizationGenerator CivilizationGenerator(
+    {
+        .SeedSequence              = &CivilizationSeedSequence,
+        .LifeOccurrenceProbability = DefaultGenerationInfo.LifeOccurrenceProbability,
+        .bEnableAsiFilter          = DefaultGenerationInfo.bEnableAsiFilter
+    });
+
+    // 恒星样本生成完毕后才开启分段计时，避免恒星生成器的阶段混入统计
+    Util::FStageProfiler::SetEnabled(true);
+
+    auto* ThreadPool = Runtime::Thread::FThreadPool::GetInstance();
+    std::vector<std::future<FResult>> Futures;
+    Futures.reserve(_ThreadCount);
+
+    auto StartTime = std::chrono::steady_clock::now();
+    for (int i = 0; i != _ThreadCount; ++i)
+    {
+        Futures.push_back(ThreadPool->Submit([&Generator = Generators[i], &Systems = SystemChunks[i]]() -> FResult
+        {
+            Util::FStageProfiler::ResetThreadRecords();
+            std::uint64_t AllocationsBefore = Util::FAllocationCounter::GetThreadCount();
+
+            for (auto& System : Systems)
+            {
+                Generator.GenerateOrbitals(System);
+            }
+
+            FResult LocalResult;
+            LocalResult.Allocations  = Util::FAllocationCounter::GetThreadCount() - AllocationsBefore;
+            LocalResult.StageRecords = Util::FStageProfiler::GetThreadRecords();
+            return LocalResult;
+        }));
+    }
+
+    FResult Result;
+    for (auto& Future : Futures)
+    {
+        FResult LocalResult = Future.get();
+        Result.Allocations += LocalResult.Allocations;
+        for (std::size_t i = 0; i != Result.StageRecords.size(); ++i)
+        {
+            Result.StageRecords[i].Calls       += LocalResult.StageRecords[i].Calls;
+            Result.StageRecords[i].Nanoseconds += LocalResult.StageRecords[i].Nanoseconds;
+        }
+    }
+
+    if (Scenario.bBatchCivilizations)
+    {
+        // 按分块顺序合并候选，结果与线程数无关
+        auto CivilizationStartTime = std::chrono::steady_clock::now();
+        FCivilizationGenerator::FBatchInput Candidates;
+        std::size_t CandidateCount = 0;
+        for (const auto& Chunk : CandidateChunks)
+        {
+            CandidateCount += Chunk.Size();
+        }
+
+        Candidates.Reserve(CandidateCount);
+        for (const auto& Chunk : CandidateChunks)
+        {
+            for (std::size_t i = 0; i != Chunk.Size(); ++i)
+            {
+                Candidates.Push(Chunk.StarAges[i], Chunk.PoyntingVectors[i], Chunk.Planets[i]);
+            }
+        }
+
+        FCivilizationGenerator::FCivilizationTable Table;
+        CivilizationGenerator.GenerateCivilizations(Candidates, _Seed, Table, _ThreadCount);
+        Table.ApplyTo(Candidates);
+
+        Result.Civilizations       = Table.Size();
+        Result.CivilizationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - CivilizationStartTime).count();
+    }
+
+    Result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    Util::FStageProfiler::SetEnabled(false);
+
+    if (Scenario.bIntegrate)
+    {
+        IntegrateSystems(Scenario, SystemChunks, Result);
+    }
+
+    for (auto& Systems : SystemChunks)
+    {
+        for (auto& System : Systems)
+        {
+            Result.Bodies  += CountBodies(System);
+            Result.Planets += System.PlanetsData().size();
+        }
+    }
+
+    return Result;
+}
+
+void FOrbitalBenchmark::IntegrateSystems(const FScenario& Scenario, std::vector<std::vector<Astro::FStellarSystem>>& SystemChunks,
+                                         FResult& Result) const
+{
+    System::Dynamics::FNBodyBatch Batch;
+    for (auto& Systems : SystemChunks)
+    {
+        for (auto& System : Systems)
+        {
+            Batch.AppendStellarSystem(System, Astro::FOrbitalHierarchy(System));
+        }
+    }
+
+    std::vector<double> InitialEnergies(Batch.GetSystemCount());
+    for (std::size_t i = 0; i != InitialEnergies.size(); ++i)
+    {
+        InitialEnergies[i] = Batch.CalculateEnergy(i);
+    }
+
+    int ThreadCount = Scenario.IntegrationThreadCount > 0 ? Scenario.IntegrationThreadCount : _ThreadCount;
+    System::Dynamics::FSymplecticIntegrator Integrator(Scenario.IntegrationScheme);
+
+    auto StartTime = std::chrono::steady_clock::now();
+    Integrator.Integrate(Batch, Scenario.IntegrationTimeStep, Scenario.IntegrationStepCount, ThreadCount);
+    Result.IntegrationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    Result.IntegratedBodies   = Batch.GetBodyCount();
+
+    // 单个天体的系统能量守恒是平凡的，不计入漂移
+    std::size_t ComparedCount = 0;
+    double      DriftSum      = 0.0;
+    Result.MaxEnergyDrift     = 0.0;
+    for (std::size_t i = 0; i != InitialEnergies.size(); ++i)
+    {
+        if (Batch.GetSystemBodyRange(i).second < 2 || InitialEnergies[i] == 0.0)
+        {
+            continue;
+        }
+
+        double Drift = std::abs(Batch.CalculateEnergy(i) - InitialEnergies[i]) / std::abs(InitialEnergies[i]);
+        Result.MaxEnergyDrift = std::max(Result.MaxEnergyDrift, Drift);
+        DriftSum += Drift;
+        ++ComparedCount;
+    }
+
+    Result.MeanEnergyDrift = ComparedCount != 0 ? DriftSum / ComparedCount : std::numeric_limits<double>::quiet_NaN();
+    if (ComparedCount == 0)
+    {
+        Result.MaxEnergyDrift = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+void FOrbitalBenchmark::PrintHeader(std::ostream& Output) const
+{
+    Output << "scenario,multiplicity,mass_lower,mass_upper,threads,systems,planets,bodies,seconds,"
+              "systems_per_sec,bodies_per_sec,allocs_per_system";
+
+    for (const char* StageName : kStageNames)
+    {
+        Output << ',' << StageName << "_calls," << StageName << "_ns_per_system";
+    }
+
+    Output << ",batch_civilizations,civilizations,civilization_seconds,nbody_scheme,nbody_threads,nbody_bodies,nbody_steps,"
+              "nbody_time_step,nbody_seconds,nbody_body_steps_per_sec,nbody_max_energy_drift,nbody_mean_energy_drift\n";
+}
+
+void FOrbitalBenchmark::PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const
+{
+    double SystemCount = static_cast<double>(std::max<std::size_t>(_SystemCount, 1));
+    double AllocationsPerSystem = Util::FAllocationCounter::IsEnabled()
+                                ? Result.Allocations / SystemCount : std::numeric_limits<double>::quiet_NaN();
+
+    Output << std::format("{},{},{:.6g},{:.6g},{},{},{},{},{:.6f},{:.2f},{:.2f},{:.3f}",
+                          Scenario.Name, Scenario.bBinary ? "binary" : "single", Scenario.MassLowerLimit, Scenario.MassUpperLimit,
+                          _ThreadCount, _SystemCount, Result.Planets, Result.Bodies, Result.Seconds,
+                          _SystemCount / Result.Seconds, Result.Bodies / Result.Seconds, AllocationsPerSystem);
+
+    // 各阶段耗时为所有线程的总和，嵌套阶段计入完整耗时：generate_planets 包含其内部首尾相接的各阶段，
+    // planet_details 包含卫星、行星环、类地行星、特洛伊带和文明的生成
+    for (std::size_t i = 0; i != kStageNames.size(); ++i)
+    {
+        const auto& Record = Result.StageRecords[i];
+        Output << std::format(",{},{:.1f}", Record.Calls, Record.Nanoseconds / SystemCount);
+    }
+
+    Output << std::format(",{},{},{:.6f}", Scenario.bBatchCivilizations, Result.Civilizations, Result.CivilizationSeconds);
+
+    if (Scenario.bIntegrate)
+    {
+        int    ThreadCount = Scenario.IntegrationThreadCount > 0 ? Scenario.IntegrationThreadCount : _ThreadCount;
+        double BodySteps   = static_cast<double>(Result.IntegratedBodies) * static_cast<double>(Scenario.IntegrationStepCount);
+        Output << std::format(",{},{},{},{},{:.6g},{:.6f},{:.2f},{:.3e},{:.3e}\n",
+                              GetSchemeName(Scenario.IntegrationScheme), ThreadCount, Result.IntegratedBodies,
+                              Scenario.IntegrationStepCount, Scenario.IntegrationTimeStep, Result.IntegrationSeconds,
+                              BodySteps / Result.IntegrationSeconds, Result.MaxEnergyDrift, Result.MeanEnergyDrift);
+    }
+    else
+    {
+        Output << ",none,0,0,0,0,0.000000,nan,nan,nan\n";
+    }
+}
+
+_NPGS_END
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Dynamics/SymplecticIntegrator.h"
+#include "Engine/Core/System/Generators/OrbitalGenerator.h"
+#include "Engine/Core/System/Generators/StellarGenerator.h"
+#include "Engine/Core/Types/Entries/Astro/StellarSystem.h"
+#include "Engine/Utils/Profiler.h"
+
+_NPGS_BEGIN
+
+// 行星系统生成基准测试，不创建窗口和图形上下文
+// 恒星样本按固定种子预先生成且不计时，只统计 FOrbitalGenerator::GenerateOrbitals 的耗时
+// 每个场景输出一行 CSV，包含吞吐量、每个系统的分配次数和各阶段耗时；相同的种子和线程数下生成的系统完全一致
+// 分配次数需要以 /p:NpgsAllocationCounter=true 构建，否则输出 nan
+// 批量文明场景先收集候选行星，全部系统生成后再用 FCivilizationGenerator::GenerateCivilizations 生成并写回，计入总耗时
+// N 体场景在生成后把所有系统装入 FNBodyBatch，用指定的辛积分格式和线程数推进固定步数，单独计时，并给出各系统总能量的相对漂移
+class FOrbitalBenchmark
+{
+public:
+    using FOrbitalGenerator = System::Generator::FOrbitalGenerator;
+    using FStellarGenerator = System::Generator::FStellarGenerator;
+    using FCivilizationGenerator = System::Generator::FCivilizationGenerator;
+    using EIntegrationScheme = System::Dynamics::FSymplecticIntegrator::EScheme;
+
+    struct FScenario
+    {
+        std::string Name;
+        FStellarGenerator::EStellarTypeGenerationOption StellarTypeOption{ FStellarGenerator::EStellarTypeGenerationOption::kRandom };
+        float MassLowerLimit{ 0.075f }; // 主星初始质量范围，单位太阳
+        float MassUpperLimit{ 300.0f };
+        bool  bBinary{ false };
+        bool  bBatchCivilizations{ false };
+        bool  bIntegrate{ false };
+        EIntegrationScheme IntegrationScheme{ EIntegrationScheme::kAutomatic };
+        int         IntegrationThreadCount{};     // 0 表示与生成使用相同的线程数
+        std::size_t IntegrationStepCount{ 1000 };
+        double      IntegrationTimeStep{ 600.0 }; // 单位 s，须远小于最短的卫星轨道周期
+    };
+
+    struct FResult
+    {
+        double        Seconds{};
+        std::uint64_t Allocations{};
+        std::uint64_t Bodies{};  // 生成后所有系统的恒星、行星和小行星带总数，可用于确认不同版本的输出一致
+        std::uint64_t Planets{};
+        std::uint64_t Civilizations{};      // 只统计批量生成的文明
+        double        CivilizationSeconds{};
+        std::uint64_t IntegratedBodies{};
+        double        IntegrationSeconds{};
+        double        MaxEnergyDrift{};  // 积分前后系统总能量的相对变化，只统计至少有两个天体的系统
+        double        MeanEnergyDrift{};
+        Util::FStageProfiler::FStageRecords StageRecords{};
+    };
+
+public:
+    FOrbitalBenchmark(std::uint32_t Seed, std::size_t SystemCount, int ThreadCount);
+    ~FOrbitalBenchmark() = default;
+
+    void AddScenario(const FScenario& Scenario);
+    void AddDefaultScenarios(); // 按初始质量划分的各光谱型主序星与致密星，各自分为单星和双星，另有 G、K 型单星的批量文明场景和 G 型系统的 N 体场景
+    void Run(std::ostream& Output);
+
+private:
+    FResult RunScenario(const FScenario& Scenario);
+    void IntegrateSystems(const FScenario& Scenario, std::vector<std::vector<Astro::FStellarSystem>>& SystemChunks,
+                          FResult& Result) const;
+    void PrintHeader(std::ostream& Output) const;
+    void PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const;
+
+private:
+    std::vector<FScenario> _Scenarios;
+    std::uint32_t          _Seed;
+    std::size_t            _SystemCount;
+    int                    _ThreadCount;
+};
+
+_NPGS_END
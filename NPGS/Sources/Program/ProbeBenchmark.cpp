@@ -0,0 +1,134 @@
+#include "ProbeBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <random>
+
+#include "Engine/Utils/Logger.h"
+#include "Universe.h"
+
+_NPGS_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    double MeasureSeconds(std::chrono::steady_clock::time_point StartTime)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+}
+
+// FProbeBenchmark implementations
+// -------------------------------
+FProbeBenchmark::FProbeBenchmark(std::uint32_t Seed, std::size_t SystemCount, int ThreadCount)
+    :
+    _Seed(Seed),
+    _SystemCount(std::max<std::size_t>(SystemCount, 2)),
+    _RouteCount(std::min(_SystemCount, _kMaxRouteCount)),
+    _ThreadCount(std::max(ThreadCount, 1))
+{
+}
+
+void FProbeBenchmark::AddScenario(const FScenario& Scenario)
+{
+    _Scenarios.push_back(Scenario);
+}
+
+void FProbeBenchmark::AddDefaultScenarios()
+{
+    // 恒星平均间距约 6 ly
+    _Scenarios.push_back({ .Name = "k8_20ly",           .MaxNeighbours = 8,  .MaxJumpDistance = 20.0f, .HeuristicWeight = 1.0f });
+    _Scenarios.push_back({ .Name = "k16_20ly",          .MaxNeighbours = 16, .MaxJumpDistance = 20.0f, .HeuristicWeight = 1.0f });
+    _Scenarios.push_back({ .Name = "k8_20ly_weighted",  .MaxNeighbours = 8,  .MaxJumpDistance = 20.0f, .HeuristicWeight = 1.5f });
+    _Scenarios.push_back({ .Name = "k8_10ly",           .MaxNeighbours = 8,  .MaxJumpDistance = 10.0f, .HeuristicWeight = 1.0f });
+    _Scenarios.push_back({ .Name = "k8_20ly_fast",      .MaxNeighbours = 8,  .MaxJumpDistance = 20.0f, .HeuristicWeight = 1.0f, .ProbeSpeed = 0.1f });
+}
+
+void FProbeBenchmark::Run(std::ostream& Output)
+{
+    NpgsCoreInfo("Generating universe of {} stars for probe benchmark...", _SystemCount);
+    FUniverse Universe(_Seed, _SystemCount);
+    Universe.FillUniverse();
+
+    PrintHeader(Output);
+    for (const auto& Scenario : _Scenarios)
+    {
+        NpgsCoreInfo("Benchmarking {}, {} systems, {} routes...", Scenario.Name, _SystemCount, _RouteCount);
+        PrintResult(Output, Scenario, RunScenario(Universe, Scenario));
+        Output.flush();
+    }
+}
+
+FProbeBenchmark::FResult FProbeBenchmark::RunScenario(FUniverse& Universe, const FScenario& Scenario)
+{
+    FResult Result;
+
+    System::Spatial::FNeighbourGraph::FBuildInfo BuildInfo
+    {
+        .MaxNeighbours   = Scenario.MaxNeighbours,
+        .MaxJumpDistance = Scenario.MaxJumpDistance
+    };
+
+    auto StartTime = std::chrono::steady_clock::now();
+    Universe.BuildNeighbourGraph(BuildInfo);
+    Result.BuildSeconds = MeasureSeconds(StartTime);
+
+    const auto* Graph = Universe.GetNeighbourGraph();
+    Result.EdgeCount  = Graph->GetEdgeCount();
+    Result.GraphBytes = Graph->GetMemoryUsage();
+
+    // 每个场景使用相同的种子，保证各场景规划的是同一批航线
+    std::mt19937 RandomEngine(_Seed);
+    std::uniform_int_distribution<std::size_t> RankDistribution(1, Graph->GetSystemCount() - 1);
+
+    StartTime = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i != _RouteCount; ++i)
+    {
+        auto Route = Universe.FindProbeRoute(0, RankDistribution(RandomEngine), Scenario.MaxJumpDistance, Scenario.HeuristicWeight);
+        if (!Route.empty())
+        {
+            ++Result.ReachableCount;
+            Result.HopCount += Route.size() - 1;
+        }
+    }
+    Result.RouteSeconds = MeasureSeconds(StartTime);
+
+    System::Simulation::FProbeExpansionSimulator::FSimulationInfo SimulationInfo
+    {
+        .ProbeSpeed      = Scenario.ProbeSpeed,
+        .MaxJumpDistance = Scenario.MaxJumpDistance,
+        .ThreadCount     = _ThreadCount
+    };
+
+    StartTime = std::chrono::steady_clock::now();
+    auto Simulator = Universe.CreateProbeExpansion(SimulationInfo);
+    Simulator->Run();
+    Result.SimulationSeconds = MeasureSeconds(StartTime);
+    Result.Statistics        = Simulator->GetStatistics();
+
+    return Result;
+}
+
+void FProbeBenchmark::PrintHeader(std::ostream& Output) const
+{
+    Output << "scenario,systems,max_neighbours,max_jump,heuristic_weight,build_seconds,edges,graph_bytes,routes,"
+              "routes_per_sec,reachable,avg_hops,threads,probe_speed,simulation_seconds,colonized,barren,launched,superseded,"
+              "events,windows,last_event_years\n";
+}
+
+void FProbeBenchmark::PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const
+{
+    const auto& Statistics = Result.Statistics;
+    Output << std::format("{},{},{},{:.3g},{:.3g},{:.6f},{},{},{},{:.2f},{},{:.2f},{},{:.3g},{:.6f},{},{},{},{},{},{},{:.6g}\n",
+                          Scenario.Name, _SystemCount, Scenario.MaxNeighbours, Scenario.MaxJumpDistance, Scenario.HeuristicWeight,
+                          Result.BuildSeconds, Result.EdgeCount, Result.GraphBytes, _RouteCount, _RouteCount / Result.RouteSeconds,
+                          Result.ReachableCount,
+                          static_cast<double>(Result.HopCount) / std::max<std::size_t>(Result.ReachableCount, 1),
+                          _ThreadCount, Scenario.ProbeSpeed, Result.SimulationSeconds, Statistics.ColonizedCount,
+                          Statistics.BarrenCount, Statistics.LaunchedProbeCount, Statistics.SupersededProbeCount,
+                          Statistics.ProcessedEventCount, Statistics.WindowCount, Statistics.LastEventTime);
+}
+
+_NPGS_END
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Simulation/ProbeExpansion.h"
+
+_NPGS_BEGIN
+
+class FUniverse;
+
+// 探测器航线与扩张基准测试，不创建窗口和图形上下文
+// 按固定种子生成一次宇宙（不计时），每个场景重建邻接图，从家园系统向随机系统规划航线，再模拟探测器扩张到结束，
+// 输出一行 CSV，包含建图耗时、边数、内存占用、航线吞吐量、可达航线数、平均跳数和模拟的耗时与统计；
+// 相同的种子下模拟结果与线程数无关
+class FProbeBenchmark
+{
+public:
+    struct FScenario
+    {
+        std::string Name;
+        std::size_t MaxNeighbours{ 8 };
+        float       MaxJumpDistance{ 20.0f }; // 单位 ly
+        float       HeuristicWeight{ 1.0f };
+        float       ProbeSpeed{ 0.01f };      // 单位 c
+    };
+
+    struct FResult
+    {
+        double      BuildSeconds{};
+        double      RouteSeconds{};
+        std::size_t EdgeCount{};
+        std::size_t GraphBytes{};
+        std::size_t ReachableCount{};
+        std::size_t HopCount{};    // 可达航线的总跳数
+        double      SimulationSeconds{};
+        System::Simulation::FProbeExpansionSimulator::FStatistics Statistics{};
+    };
+
+public:
+    FProbeBenchmark(std::uint32_t Seed, std::size_t SystemCount, int ThreadCount);
+    ~FProbeBenchmark() = default;
+
+    void AddScenario(const FScenario& Scenario);
+    void AddDefaultScenarios(); // 不同的邻居数和跳跃距离，以及加权 A*
+    void Run(std::ostream& Output);
+
+private:
+    FResult RunScenario(FUniverse& Universe, const FScenario& Scenario);
+    void PrintHeader(std::ostream& Output) const;
+    void PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const;
+
+private:
+    std::vector<FScenario> _Scenarios;
+    std::uint32_t          _Seed;
+    std::size_t            _SystemCount;
+    std::size_t            _RouteCount;
+    int                    _ThreadCount;
+
+    static constexpr std::size_t _kMaxRouteCount = 1000;
+};
+
+_NPGS_END
@@ -0,0 +1,428 @@
+#include "SpatialBenchmark.h"
+
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <span>
+#include <utility>
+
+#include "Engine/Core/System/Spatial/LinearOctree.hpp"
+#include "Engine/Core/System/Spatial/NeighbourGraph.h"
+#include "Engine/Core/System/Spatial/Octree.hpp"
+#include "Engine/Core/System/Spatial/OctreeImage.h"
+#include "Engine/Core/System/Spatial/SpatialHashGrid.hpp"
+#include "Engine/Utils/Logger.h"
+
+_NPGS_BEGIN
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::size_t kClusterCount = 32;
+
+    float CalculateDistanceSquared(glm::vec3 Point1, glm::vec3 Point2)
+    {
+        glm::vec3 Delta = Point1 - Point2;
+        return glm::dot(Delta, Delta);
+    }
+
+    // 暴力搜索，返回半径内的点数和最近 K 个点的距离平方，与八叉树查询一样排除坐标相同的点
+    std::pair<std::size_t, std::vector<float>>
+    BruteForceQuery(const std::vector<glm::vec3>& Points, glm::vec3 Point, float Radius, std::size_t K)
+    {
+        std::size_t        Count = 0;
+        std::vector<float> Distances;
+        Distances.reserve(Points.size());
+        for (glm::vec3 StoredPoint : Points)
+        {
+            if (StoredPoint == Point)
+            {
+                continue;
+            }
+
+            float DistanceSquared = CalculateDistanceSquared(StoredPoint, Point);
+            Count += DistanceSquared <= Radius * Radius ? 1 : 0;
+            Distances.push_back(DistanceSquared);
+        }
+
+        K = std::min(K, Distances.size());
+        std::partial_sort(Distances.begin(), Distances.begin() + K, Distances.end());
+        Distances.resize(K);
+        return { Count, std::move(Distances) };
+    }
+
+    // 单源 Dijkstra，作为 A* 航线长度的参照，不可达的系统为无穷大
+    std::vector<float> CalculateShortestDistances(const System::Spatial::FNeighbourGraph& Graph, std::uint32_t Source)
+    {
+        using FEntry = std::pair<float, std::uint32_t>;
+
+        std::vector<float> Distances(Graph.GetSystemCount(), std::numeric_limits<float>::infinity());
+        std::priority_queue<FEntry, std::vector<FEntry>, std::greater<FEntry>> OpenList;
+        Distances[Source] = 0.0f;
+        OpenList.emplace(0.0f, Source);
+
+        while (!OpenList.empty())
+        {
+            auto [Distance, Index] = OpenList.top();
+            OpenList.pop();
+            if (Distance > Distances[Index])
+            {
+                continue;
+            }
+
+            auto Neighbours    = Graph.GetNeighbours(Index);
+            auto JumpDistances = Graph.GetJumpDistances(Index);
+            for (std::size_t i = 0; i != Neighbours.size(); ++i)
+            {
+                float Candidate = Distance + JumpDistances[i];
+                if (Candidate < Distances[Neighbours[i]])
+                {
+                    Distances[Neighbours[i]] = Candidate;
+                    OpenList.emplace(Candidate, Neighbours[i]);
+                }
+            }
+        }
+
+        return Distances;
+    }
+
+    double MeasureSeconds(std::chrono::steady_clock::time_point StartTime)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    // 不适用的列（如邻接图的半径查询）耗时为 0，输出 nan
+    double CalculateRate(std::size_t Count, double Seconds)
+    {
+        return Seconds > 0.0 ? Count / Seconds : std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+// FSpatialBenchmark implementations
+// ---------------------------------
+FSpatialBenchmark::FSpatialBenchmark(std::uint32_t Seed, std::size_t PointCount, int ThreadCount)
+    :
+    _Seed(Seed),
+    _PointCount(std::max<std::size_t>(PointCount, 1)),
+    _QueryCount(std::min(_PointCount, _kMaxQueryCount)),
+    _ThreadCount(std::max(ThreadCount, 1))
+{
+}
+
+void FSpatialBenchmark::AddScenario(const FScenario& Scenario)
+{
+    _Scenarios.push_back(Scenario);
+}
+
+void FSpatialBenchmark::AddDefaultScenarios()
+{
+    _Scenarios.push_back({ .Name = "uniform_near",   .Distribution = EDistribution::kUniform,   .QueryRadius = 2.0f, .NearestCount = 8  });
+    _Scenarios.push_back({ .Name = "uniform_far",    .Distribution = EDistribution::kUniform,   .QueryRadius = 4.0f, .NearestCount = 32 });
+    // 星团中心的密度约为平均密度的几十倍，查询半径相应缩小，避免结果数量过大
+    _Scenarios.push_back({ .Name = "clustered_near", .Distribution = EDistribution::kClustered, .QueryRadius = 0.5f, .NearestCount = 8  });
+    _Scenarios.push_back({ .Name = "clustered_far",  .Distribution = EDistribution::kClustered, .QueryRadius = 1.0f, .NearestCount = 32 });
+}
+
+void FSpatialBenchmark::Run(std::ostream& Output)
+{
+    PrintHeader(Output);
+    for (const auto& Scenario : _Scenarios)
+    {
+        NpgsCoreInfo("Benchmarking {}, {} points, {} queries on {} threads...", Scenario.Name, _PointCount, _QueryCount, _ThreadCount);
+
+        for (const FResult& Result : RunScenario(Scenario))
+        {
+            PrintResult(Output, Scenario, Result);
+        }
+
+        Output.flush();
+    }
+}
+
+std::vector<glm::vec3> FSpatialBenchmark::GeneratePoints(EDistribution Distribution) const
+{
+    // 每个场景使用相同的种子，保证不同版本之间的点集一致
+    std::mt19937 RandomEngine(_Seed);
+
+    float HalfSide = 0.5f * std::cbrt(static_cast<float>(_PointCount));
+    std::uniform_real_distribution<float> Uniform(-HalfSide, HalfSide);
+
+    std::vector<glm::vec3> Points(_PointCount);
+    if (Distribution == EDistribution::kUniform)
+    {
+        for (auto& Point : Points)
+        {
+            Point = glm::vec3(Uniform(RandomEngine), Uniform(RandomEngine), Uniform(RandomEngine));
+        }
+
+        return Points;
+    }
+
+    std::vector<glm::vec3> Centers(kClusterCount);
+    for (auto& Center : Centers)
+    {
+        Center = 0.7f * glm::vec3(Uniform(RandomEngine), Uniform(RandomEngine), Uniform(RandomEngine));
+    }
+
+    std::uniform_int_distribution<std::size_t> ClusterIndex(0, kClusterCount - 1);
+    std::normal_distribution<float> Offset(0.0f, HalfSide / 8.0f);
+    for (auto& Point : Points)
+    {
+        glm::vec3 Center = Centers[ClusterIndex(RandomEngine)];
+        Point = glm::vec3(std::clamp(Center.x + Offset(RandomEngine), -HalfSide, HalfSide),
+                          std::clamp(Center.y + Offset(RandomEngine), -HalfSide, HalfSide),
+                          std::clamp(Center.z + Offset(RandomEngine), -HalfSide, HalfSide));
+    }
+
+    return Points;
+}
+
+std::vector<FSpatialBenchmark::FResult> FSpatialBenchmark::RunScenario(const FScenario& Scenario)
+{
+    std::vector<glm::vec3> Points = GeneratePoints(Scenario.Distribution);
+    std::span<const glm::vec3> Queries(Points.data(), _QueryCount);
+
+    // 叶子边长约为 2 个平均间距，均匀分布时每个叶子约 8 个点；网格使用相同的格子边长，两者的桶大小相当
+    float HalfSide = 0.5f * std::cbrt(static_cast<float>(_PointCount));
+
+    FResult OctreeResult;
+    OctreeResult.IndexName = "octree";
+    OctreeResult.MaxDepth  = std::max(1, static_cast<int>(std::ceil(std::log2(HalfSide))));
+    OctreeResult.CellSize  = 2.0f * HalfSide / static_cast<float>(1 << OctreeResult.MaxDepth);
+
+    auto StartTime = std::chrono::steady_clock::now();
+    System::Spatial::TOctree<glm::vec3> Octree(glm::vec3(0.0f), HalfSide, OctreeResult.MaxDepth);
+    for (glm::vec3 Point : Points)
+    {
+        Octree.Insert(Point);
+    }
+    OctreeResult.BuildSeconds = MeasureSeconds(StartTime);
+
+    std::vector<std::vector<glm::vec3>> RadiusResults;
+    StartTime = std::chrono::steady_clock::now();
+    Octree.QueryBatch(Queries, Scenario.QueryRadius, RadiusResults, _ThreadCount);
+    OctreeResult.RadiusSeconds = MeasureSeconds(StartTime);
+
+    std::vector<std::vector<glm::vec3>> NearestResults;
+    StartTime = std::chrono::steady_clock::now();
+    Octree.QueryNearestBatch(Queries, Scenario.NearestCount, NearestResults, _ThreadCount);
+    OctreeResult.NearestSeconds = MeasureSeconds(StartTime);
+
+    for (const auto& Results : RadiusResults)
+    {
+        OctreeResult.RadiusResults += Results.size();
+    }
+
+    // 每个点链接到系统表中的一项，与 FUniverse 的恒星系统表相同，用于检查存档的链接往返；预留容量保证链接地址不变
+    std::vector<glm::vec3> LinkTable;
+    LinkTable.reserve(Points.size());
+    Octree.Traverse([&LinkTable](System::Spatial::TOctree<glm::vec3>::FNodeType& Node) -> void
+    {
+        for (glm::vec3 Point : Node.GetPoints())
+        {
+            LinkTable.push_back(Point);
+            Node.AddLink(&LinkTable.back());
+        }
+    });
+
+    auto GetLinkIndex = [&LinkTable](const glm::vec3* Target) -> std::size_t
+    {
+        return static_cast<std::size_t>(Target - LinkTable.data());
+    };
+
+    StartTime = std::chrono::steady_clock::now();
+    System::Spatial::FOctreeImage Image(Octree, LinkTable.size(), GetLinkIndex);
+    OctreeResult.ImageSeconds = MeasureSeconds(StartTime);
+    OctreeResult.ImageBytes   = Image.GetBlob().size();
+
+    System::Spatial::FOctreeImage ImageView(Image.GetBlob().data(), Image.GetBlob().size());
+    OctreeResult.Mismatches += ImageView.Validate(Octree, GetLinkIndex) ? 0 : 1;
+
+    // 按存档重建的树应与存档逐节点一致，链接指向系统表中的同一项
+    StartTime = std::chrono::steady_clock::now();
+    auto RebuiltOctree = ImageView.Rebuild(std::span<glm::vec3>(LinkTable));
+    OctreeResult.RebuildSeconds = MeasureSeconds(StartTime);
+    OctreeResult.Mismatches += ImageView.Validate(*RebuiltOctree, GetLinkIndex) ? 0 : 1;
+
+    OctreeResult.Mismatches += CountMismatches(Points, Scenario, RadiusResults, NearestResults);
+
+    // 存档和重建树的查询应与原树完全一致
+    for (std::size_t i = 0; i != std::min(_QueryCount, _kVerifyQueryCount); ++i)
+    {
+        std::vector<glm::vec3> ImageResults;
+        ImageView.Query(Queries[i], Scenario.QueryRadius, ImageResults);
+        OctreeResult.Mismatches += ImageResults.size() == RadiusResults[i].size() ? 0 : 1;
+
+        std::vector<glm::vec3> RebuiltResults;
+        RebuiltOctree->Query(Queries[i], Scenario.QueryRadius, RebuiltResults);
+        OctreeResult.Mismatches += RebuiltResults == RadiusResults[i] ? 0 : 1;
+    }
+
+    FResult GridResult;
+    GridResult.IndexName = "hash_grid";
+    GridResult.CellSize  = OctreeResult.CellSize;
+
+    StartTime = std::chrono::steady_clock::now();
+    System::Spatial::TSpatialHashGrid<void> Grid(GridResult.CellSize);
+    Grid.Build(Points, {}, _ThreadCount);
+    GridResult.BuildSeconds = MeasureSeconds(StartTime);
+
+    StartTime = std::chrono::steady_clock::now();
+    Grid.QueryBatch(Queries, Scenario.QueryRadius, RadiusResults, _ThreadCount);
+    GridResult.RadiusSeconds = MeasureSeconds(StartTime);
+
+    StartTime = std::chrono::steady_clock::now();
+    Grid.QueryNearestBatch(Queries, Scenario.NearestCount, NearestResults, _ThreadCount);
+    GridResult.NearestSeconds = MeasureSeconds(StartTime);
+
+    for (const auto& Results : RadiusResults)
+    {
+        GridResult.RadiusResults += Results.size();
+    }
+
+    GridResult.Mismatches = CountMismatches(Points, Scenario, RadiusResults, NearestResults);
+
+    // 线性八叉树用同一组点和相同的范围、深度建树，只比较建树耗时，查询列输出 nan
+    FResult LinearOctreeResult;
+    LinearOctreeResult.IndexName = "linear_octree";
+    LinearOctreeResult.MaxDepth  = OctreeResult.MaxDepth;
+    LinearOctreeResult.CellSize  = OctreeResult.CellSize;
+
+    StartTime = std::chrono::steady_clock::now();
+    System::Spatial::TLinearOctree<void> LinearOctree(glm::vec3(0.0f), HalfSide, LinearOctreeResult.MaxDepth);
+    LinearOctree.Build(Points, {}, _ThreadCount);
+    LinearOctreeResult.BuildSeconds = MeasureSeconds(StartTime);
+
+    // 保留的点数应与八叉树相同，抽查的点应能在所在叶子中找到
+    LinearOctreeResult.Mismatches += LinearOctree.GetSize() == Octree.GetSize() ? 0 : 1;
+    for (std::size_t i = 0; i != std::min(_QueryCount, _kVerifyQueryCount); ++i)
+    {
+        const auto* Leaf = LinearOctree.Find(Queries[i], [](const auto& Node) -> bool { return Node.IsLeafNode(); });
+        if (Leaf == nullptr)
+        {
+            ++LinearOctreeResult.Mismatches;
+            continue;
+        }
+
+        auto LeafPoints = LinearOctree.GetPoints(*Leaf);
+        LinearOctreeResult.Mismatches += std::ranges::find(LeafPoints, Queries[i]) != LeafPoints.end() ? 0 : 1;
+    }
+
+    return
+    {
+        std::move(OctreeResult), std::move(LinearOctreeResult), std::move(GridResult), RunNeighbourGraph(Points, Scenario)
+    };
+}
+
+FSpatialBenchmark::FResult FSpatialBenchmark::RunNeighbourGraph(const std::vector<glm::vec3>& Points, const FScenario& Scenario) const
+{
+    FResult Result;
+    Result.IndexName = "neighbour_graph";
+
+    // 不限跳跃距离，每个系统的前 K 条边即为其 k 近邻，可以直接与暴力搜索比较
+    System::Spatial::FNeighbourGraph::FBuildInfo BuildInfo{ .MaxNeighbours = Scenario.NearestCount };
+
+    auto StartTime = std::chrono::steady_clock::now();
+    System::Spatial::FNeighbourGraph Graph;
+    Graph.Build(Points, BuildInfo, _ThreadCount);
+    Result.BuildSeconds = MeasureSeconds(StartTime);
+    Result.EdgeCount    = Graph.GetEdgeCount();
+
+    // 对称图中补上的反向边都不短于该系统的第 K 近邻，排序后不会排到前 K 条之前
+    for (std::size_t i = 0; i != std::min(_QueryCount, _kVerifyQueryCount); ++i)
+    {
+        auto [ExpectedCount, ExpectedDistances] = BruteForceQuery(Points, Points[i], 0.0f, Scenario.NearestCount);
+        auto JumpDistances = Graph.GetJumpDistances(static_cast<std::uint32_t>(i));
+
+        bool bMatched = JumpDistances.size() >= ExpectedDistances.size();
+        for (std::size_t j = 0; bMatched && j != ExpectedDistances.size(); ++j)
+        {
+            bMatched = JumpDistances[j] == std::sqrt(ExpectedDistances[j]);
+        }
+
+        Result.Mismatches += bMatched ? 0 : 1;
+    }
+
+    if (Points.size() < 2)
+    {
+        return Result;
+    }
+
+    // 从系统 0 出发规划到随机系统的航线，抽查的航线长度与 Dijkstra 的最短距离比较，允许浮点累加顺序带来的误差
+    std::mt19937 RandomEngine(_Seed);
+    std::uniform_int_distribution<std::uint32_t> TargetDistribution(1, static_cast<std::uint32_t>(Points.size() - 1));
+
+    std::vector<System::Spatial::FNeighbourGraph::FRouteRequest> Requests(std::min(Points.size() - 1, _kMaxRouteCount));
+    for (auto& Request : Requests)
+    {
+        Request.Source = 0;
+        Request.Target = TargetDistribution(RandomEngine);
+    }
+
+    std::vector<System::Spatial::FNeighbourGraph::FRoute> Routes;
+    StartTime = std::chrono::steady_clock::now();
+    Graph.FindRoutes(Requests, Routes, _ThreadCount);
+    Result.RouteSeconds = MeasureSeconds(StartTime);
+    Result.RouteCount   = Requests.size();
+
+    std::vector<float> ShortestDistances = CalculateShortestDistances(Graph, 0);
+    for (std::size_t i = 0; i != std::min(Requests.size(), _kVerifyQueryCount); ++i)
+    {
+        float Expected = ShortestDistances[Requests[i].Target];
+        bool  bMatched = Routes[i].Systems.empty()
+                       ? std::isinf(Expected)
+                       : std::abs(Routes[i].Distance - Expected) <= 1e-5f * std::max(Expected, 1.0f);
+
+        Result.Mismatches += bMatched ? 0 : 1;
+    }
+
+    return Result;
+}
+
+// 抽查若干个查询与暴力搜索比较，k 近邻只比较距离，距离相同的点顺序可以不同
+std::size_t FSpatialBenchmark::CountMismatches(const std::vector<glm::vec3>& Points, const FScenario& Scenario,
+                                               const std::vector<std::vector<glm::vec3>>& RadiusResults,
+                                               const std::vector<std::vector<glm::vec3>>& NearestResults) const
+{
+    std::size_t Mismatches = 0;
+    for (std::size_t i = 0; i != std::min(_QueryCount, _kVerifyQueryCount); ++i)
+    {
+        auto [ExpectedCount, ExpectedDistances] = BruteForceQuery(Points, Points[i], Scenario.QueryRadius, Scenario.NearestCount);
+
+        bool bMatched = RadiusResults[i].size() == ExpectedCount && NearestResults[i].size() == ExpectedDistances.size();
+        for (std::size_t j = 0; bMatched && j != ExpectedDistances.size(); ++j)
+        {
+            bMatched = CalculateDistanceSquared(NearestResults[i][j], Points[i]) == ExpectedDistances[j];
+        }
+
+        Mismatches += bMatched ? 0 : 1;
+    }
+
+    return Mismatches;
+}
+
+void FSpatialBenchmark::PrintHeader(std::ostream& Output) const
+{
+    Output << "scenario,index,max_depth,cell_size,threads,points,queries,build_seconds,radius,radius_queries_per_sec,"
+              "radius_avg_results,k,knn_queries_per_sec,image_seconds,image_bytes,rebuild_seconds,edges,routes,routes_per_sec,"
+              "mismatches\n";
+}
+
+void FSpatialBenchmark::PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const
+{
+    Output << std::format("{},{},{},{:.3g},{},{},{},{:.6f},{:.3g},{:.2f},{:.3f},{},{:.2f},{:.6f},{},{:.6f},{},{},{:.2f},{}\n",
+                          Scenario.Name, Result.IndexName, Result.MaxDepth, Result.CellSize, _ThreadCount, _PointCount, _QueryCount,
+                          Result.BuildSeconds, Scenario.QueryRadius, CalculateRate(_QueryCount, Result.RadiusSeconds),
+                          static_cast<double>(Result.RadiusResults) / _QueryCount,
+                          Scenario.NearestCount, CalculateRate(_QueryCount, Result.NearestSeconds), Result.ImageSeconds,
+                          Result.ImageBytes, Result.RebuildSeconds, Result.EdgeCount, Result.RouteCount,
+                          CalculateRate(Result.RouteCount, Result.RouteSeconds), Result.Mismatches);
+}
+
+_NPGS_END
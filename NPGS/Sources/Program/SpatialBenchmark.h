@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base/Base.h"
+
+_NPGS_BEGIN
+
+// 空间索引基准测试，不创建窗口和图形上下文
+// 点的平均间距为 1，每个场景对八叉树和哈希均匀网格各输出一行 CSV，包含建立索引的耗时、半径查询和 k 近邻查询的吞吐量，
+// 以及与暴力搜索结果不一致的查询数，用于确认优化没有改变查询结果；同时检查八叉树存档、按存档重建的树及其链接与原树一致
+// 线性八叉树用同一组点、相同的范围和深度建树，单独输出一行建树耗时，与八叉树逐点插入的耗时直接比较
+// 另有一行邻接图结果：建图耗时、边数和 A* 航线吞吐量，抽查的 k 近邻与暴力搜索比较，抽查的航线长度与 Dijkstra 比较
+class FSpatialBenchmark
+{
+public:
+    enum class EDistribution
+    {
+        kUniform,   // 立方体内均匀分布，与 FUniverse::GenerateSlots 的栅格采样密度相当
+        kClustered  // 若干个高斯星团，密度差异大
+    };
+
+    struct FScenario
+    {
+        std::string   Name;
+        EDistribution Distribution{ EDistribution::kUniform };
+        float         QueryRadius{ 2.0f }; // 单位为平均间距
+        std::size_t   NearestCount{ 8 };
+    };
+
+    struct FResult
+    {
+        std::string   IndexName;
+        int           MaxDepth{};        // 只对八叉树有意义
+        float         CellSize{};        // 八叉树叶子或网格格子的边长
+        double        BuildSeconds{};
+        double        RadiusSeconds{};
+        double        NearestSeconds{};
+        double        ImageSeconds{};
+        double        RebuildSeconds{};  // 按存档重建八叉树和链接
+        double        RouteSeconds{};    // 以下只对邻接图有意义
+        std::size_t   RouteCount{};
+        std::size_t   EdgeCount{};
+        std::uint64_t RadiusResults{};
+        std::size_t   ImageBytes{};
+        std::size_t   Mismatches{};
+    };
+
+public:
+    FSpatialBenchmark(std::uint32_t Seed, std::size_t PointCount, int ThreadCount);
+    ~FSpatialBenchmark() = default;
+
+    void AddScenario(const FScenario& Scenario);
+    void AddDefaultScenarios(); // 两种分布，各自使用较小和较大的查询范围
+    void Run(std::ostream& Output);
+
+private:
+    std::vector<glm::vec3> GeneratePoints(EDistribution Distribution) const;
+    std::vector<FResult> RunScenario(const FScenario& Scenario);
+    FResult RunNeighbourGraph(const std::vector<glm::vec3>& Points, const FScenario& Scenario) const;
+    std::size_t CountMismatches(const std::vector<glm::vec3>& Points, const FScenario& Scenario,
+                                const std::vector<std::vector<glm::vec3>>& RadiusResults,
+                                const std::vector<std::vector<glm::vec3>>& NearestResults) const;
+    void PrintHeader(std::ostream& Output) const;
+    void PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const;
+
+private:
+    std::vector<FScenario> _Scenarios;
+    std::uint32_t          _Seed;
+    std::size_t            _PointCount;
+    std::size_t            _QueryCount;
+    int                    _ThreadCount;
+
+    static constexpr std::size_t _kMaxQueryCount    = 20000;
+    static constexpr std::size_t _kVerifyQueryCount = 16;
+    static constexpr std::size_t _kMaxRouteCount    = 1000;
+};
+
+_NPGS_END
@@ -0,0 +1,408 @@
+#include "StellarBenchmark.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <future>
+#include <limits>
+#include <new>
+#include <random>
+#include <utility>
+
+#include "Engine/Core/Runtime/Threads/ThreadPool.h"
+#include "Engine/Utils/Logger.h"
+
+#ifdef NPGS_ENABLE_ALLOCATION_COUNTER
+// 替换全局 operator new 以统计每个线程的分配次数，计数只是一次线程局部自增
+// 替换对整个程序生效，只在基准测试构建中定义 NPGS_ENABLE_ALLOCATION_COUNTER 启用
+// ------------------------------------------------------------------------
+void* operator new(std::size_t Size)
+{
+    Npgs::Util::FAllocationCounter::RecordAllocation();
+    if (void* Pointer = std::malloc(Size == 0 ? 1 : Size))
+    {
+        return Pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t Size)
+{
+    return operator new(Size);
+}
+
+void* operator new(std::size_t Size, const std::nothrow_t&) noexcept
+{
+    Npgs::Util::FAllocationCounter::RecordAllocation();
+    return std::malloc(Size == 0 ? 1 : Size);
+}
+
+void* operator new[](std::size_t Size, const std::nothrow_t& Tag) noexcept
+{
+    return operator new(Size, Tag);
+}
+
+void operator delete(void* Pointer) noexcept
+{
+    std::free(Pointer);
+}
+
+void operator delete[](void* Pointer) noexcept
+{
+    std::free(Pointer);
+}
+
+void operator delete(void* Pointer, std::size_t) noexcept
+{
+    std::free(Pointer);
+}
+
+void operator delete[](void* Pointer, std::size_t) noexcept
+{
+    std::free(Pointer);
+}
+
+// 对齐版本同样计数，std::pmr 的资源和过对齐类型的分配走这里
+void* operator new(std::size_t Size, std::align_val_t Alignment)
+{
+    Npgs::Util::FAllocationCounter::RecordAllocation();
+    if (void* Pointer = _aligned_malloc(Size == 0 ? 1 : Size, static_cast<std::size_t>(Alignment)))
+    {
+        return Pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t Size, std::align_val_t Alignment)
+{
+    return operator new(Size, Alignment);
+}
+
+void* operator new(std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept
+{
+    Npgs::Util::FAllocationCounter::RecordAllocation();
+    return _aligned_malloc(Size == 0 ? 1 : Size, static_cast<std::size_t>(Alignment));
+}
+
+void* operator new[](std::size_t Size, std::align_val_t Alignment, const std::nothrow_t& Tag) noexcept
+{
+    return operator new(Size, Alignment, Tag);
+}
+
+void operator delete(void* Pointer, std::align_val_t) noexcept
+{
+    _aligned_free(Pointer);
+}
+
+void operator delete[](void* Pointer, std::align_val_t) noexcept
+{
+    _aligned_free(Pointer);
+}
+
+void operator delete(void* Pointer, std::size_t, std::align_val_t) noexcept
+{
+    _aligned_free(Pointer);
+}
+
+void operator delete[](void* Pointer, std::size_t, std::align_val_t) noexcept
+{
+    _aligned_free(Pointer);
+}
+#endif // NPGS_ENABLE_ALLOCATION_COUNTER
+
+_NPGS_BEGIN
+
+namespace SysGen = System::Generator;
+
+// Tool functions
+// --------------
+namespace
+{
+    constexpr std::array kStageNames
+    {
+        "generate_basic_properties",
+        "get_full_mist_data",
+        "interpolate_mist_data",
+        "calculate_spectral_type",
+        "generate_magnetic",
+        "generate_spin",
+        "process_death_star"
+    };
+
+    static_assert(kStageNames.size() == static_cast<std::size_t>(SysGen::FStellarGenerator::EGenerationStage::kCount));
+
+    constexpr std::array kComparedPropertyNames{ "mass", "teff", "radius", "luminosity" };
+
+    SysGen::FStellarGenerator::FGenerationInfo MakeGenerationInfo(const FStellarBenchmark::FScenario& Scenario,
+                                                                 const std::seed_seq& SeedSequence)
+    {
+        return
+        {
+            .SeedSequence      = &SeedSequence,
+            .StellarTypeOption = Scenario.StellarTypeOption,
+            .MassLowerLimit    = Scenario.MassLowerLimit,
+            .MassUpperLimit    = Scenario.MassUpperLimit,
+            .MassDistribution  = Scenario.MassDistribution,
+            .AgeLowerLimit     = Scenario.AgeLowerLimit,
+            .AgeUpperLimit     = Scenario.AgeUpperLimit,
+            .AgeDistribution   = Scenario.AgeDistribution,
+            .FeHLowerLimit     = Scenario.FeHLowerLimit,
+            .FeHUpperLimit     = Scenario.FeHUpperLimit,
+            .FeHDistribution   = Scenario.FeHDistribution
+        };
+    }
+
+    double CalculateRelativeDelta(double Lhs, double Rhs)
+    {
+        double Scale = std::max(std::abs(Lhs), std::abs(Rhs));
+        return Scale == 0.0 ? 0.0 : std::abs(Lhs - Rhs) / Scale;
+    }
+
+    const char* GetOptionName(SysGen::FStellarGenerator::EStellarTypeGenerationOption Option)
+    {
+        switch (Option)
+        {
+        case SysGen::FStellarGenerator::EStellarTypeGenerationOption::kRandom:
+            return "random";
+        case SysGen::FStellarGenerator::EStellarTypeGenerationOption::kGiant:
+            return "giant";
+        case SysGen::FStellarGenerator::EStellarTypeGenerationOption::kDeathStar:
+            return "death_star";
+        case SysGen::FStellarGenerator::EStellarTypeGenerationOption::kMergeStar:
+            return "merge_star";
+        default:
+            return "unknown";
+        }
+    }
+}
+
+// FStellarBenchmark implementations
+// ---------------------------------
+FStellarBenchmark::FStellarBenchmark(std::uint32_t Seed, std::size_t StarCount, int ThreadCount)
+    : _Seed(Seed), _StarCount(StarCount), _ThreadCount(std::max(ThreadCount, 1))
+{
+}
+
+void FStellarBenchmark::AddScenario(const FScenario& Scenario)
+{
+    _Scenarios.push_back(Scenario);
+}
+
+void FStellarBenchmark::AddDefaultScenarios()
+{
+    using EOption       = FStellarGenerator::EStellarTypeGenerationOption;
+    using EDistribution = FStellarGenerator::EGenerationDistribution;
+
+    const std::array kOptions{ EOption::kRandom, EOption::kGiant, EOption::kDeathStar, EOption::kMergeStar };
+
+    std::vector<FScenario> Ranges;
+    Ranges.push_back({ .Name = "full" });
+    Ranges.push_back({ .Name = "metal_poor", .FeHLowerLimit = -4.0f,    .FeHUpperLimit = -2.0f,   .FeHDistribution  = EDistribution::kUniform });
+    Ranges.push_back({ .Name = "metal_rich", .FeHLowerLimit = -0.5f,    .FeHUpperLimit = 0.5f,    .FeHDistribution  = EDistribution::kUniform });
+    Ranges.push_back({ .Name = "low_mass",   .MassLowerLimit = 0.075f,  .MassUpperLimit = 1.0f,   .MassDistribution = EDistribution::kUniform });
+    Ranges.push_back({ .Name = "high_mass",  .MassLowerLimit = 10.0f,   .MassUpperLimit = 300.0f, .MassDistribution = EDistribution::kUniform });
+    Ranges.push_back({ .Name = "young",      .AgeLowerLimit  = 0.0f,    .AgeUpperLimit  = 1e8f,   .AgeDistribution  = EDistribution::kUniform });
+    Ranges.push_back({ .Name = "old",        .AgeLowerLimit  = 1e10f,   .AgeUpperLimit  = 1.26e10f, .AgeDistribution = EDistribution::kUniform });
+
+    for (auto Option : kOptions)
+    {
+        for (auto Scenario : Ranges)
+        {
+            Scenario.StellarTypeOption = Option;
+            _Scenarios.push_back(std::move(Scenario));
+        }
+    }
+}
+
+void FStellarBenchmark::Run(std::ostream& Output)
+{
+    Util::FStageProfiler::SetEnabled(true);
+    if (!Util::FAllocationCounter::IsEnabled())
+    {
+        NpgsCoreWarn("Allocation counter is disabled, allocs_per_star will be nan. Build with /p:NpgsAllocationCounter=true to measure it.");
+    }
+
+    PrintHeader(Output);
+    for (const auto& Scenario : _Scenarios)
+    {
+        NpgsCoreInfo("Benchmarking {} ({}), {} stars on {} threads...",
+                     Scenario.Name, GetOptionName(Scenario.StellarTypeOption), _StarCount, _ThreadCount);
+
+        FResult Result = RunScenario(Scenario);
+        PrintResult(Output, Scenario, Result);
+        Output.flush();
+    }
+
+    Util::FStageProfiler::SetEnabled(false);
+}
+
+FStellarBenchmark::FResult FStellarBenchmark::RunScenario(const FScenario& Scenario)
+{
+    // 每个场景使用相同的种子，保证不同版本之间生成的恒星序列一致
+    std::mt19937 RandomEngine(_Seed);
+
+    std::vector<FStellarGenerator> Generators;
+    Generators.reserve(_ThreadCount);
+    for (int i = 0; i != _ThreadCount; ++i)
+    {
+        std::vector<std::uint32_t> Seeds(32);
+        std::generate(Seeds.begin(), Seeds.end(), std::ref(RandomEngine));
+        std::seed_seq SeedSequence(Seeds.begin(), Seeds.end());
+
+        Generators.emplace_back(MakeGenerationInfo(Scenario, SeedSequence));
+    }
+
+    auto* ThreadPool = Runtime::Thread::FThreadPool::GetInstance();
+    std::vector<std::future<FResult>> Futures;
+    Futures.reserve(_ThreadCount);
+
+    auto StartTime = std::chrono::steady_clock::now();
+    for (int i = 0; i != _ThreadCount; ++i)
+    {
+        std::size_t ChunkSize = _StarCount / _ThreadCount + (static_cast<std::size_t>(i) < _StarCount % _ThreadCount ? 1 : 0);
+        Futures.push_back(ThreadPool->Submit([&Generator = Generators[i], ChunkSize]() -> FResult
+        {
+            Util::FStageProfiler::ResetThreadRecords();
+            std::uint64_t AllocationsBefore = Util::FAllocationCounter::GetThreadCount();
+
+            for (std::size_t j = 0; j != ChunkSize; ++j)
+            {
+                auto Properties = Generator.GenerateBasicProperties();
+                auto Star       = Generator.GenerateStar(Properties);
+            }
+
+            FResult LocalResult;
+            LocalResult.Allocations  = Util::FAllocationCounter::GetThreadCount() - AllocationsBefore;
+            LocalResult.StageRecords = Util::FStageProfiler::GetThreadRecords();
+            return LocalResult;
+        }));
+    }
+
+    FResult Result;
+    for (auto& Future : Futures)
+    {
+        FResult LocalResult = Future.get();
+        Result.Allocations += LocalResult.Allocations;
+        for (std::size_t i = 0; i != Result.StageRecords.size(); ++i)
+        {
+            Result.StageRecords[i].Calls       += LocalResult.StageRecords[i].Calls;
+            Result.StageRecords[i].Nanoseconds += LocalResult.StageRecords[i].Nanoseconds;
+        }
+    }
+
+    Result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    Result.MistComparison = CompareMistData(Scenario);
+    return Result;
+}
+
+FStellarBenchmark::FMistComparison FStellarBenchmark::CompareMistData(const FScenario& Scenario) const
+{
+    std::mt19937 RandomEngine(_Seed);
+    std::vector<std::uint32_t> Seeds(32);
+    std::generate(Seeds.begin(), Seeds.end(), std::ref(RandomEngine));
+    std::seed_seq SeedSequence(Seeds.begin(), Seeds.end());
+
+    FStellarGenerator Generator(MakeGenerationInfo(Scenario, SeedSequence));
+
+    FMistComparison Comparison;
+    Comparison.StarCount = std::min(_StarCount, _kMaxComparedStars);
+    for (std::size_t i = 0; i != Comparison.StarCount; ++i)
+    {
+        // 两个生成器从相同的状态出发生成同一颗恒星，之后只沿用全局数据的生成器，避免随机数消耗不同导致后续恒星错位
+        auto Properties = Generator.GenerateBasicProperties();
+        auto AlternateProperties = Properties;
+
+        FStellarGenerator AlternateGenerator(Generator);
+        AlternateGenerator.UseAlternateMistData();
+
+        auto Star          = Generator.GenerateStar(Properties);
+        auto AlternateStar = AlternateGenerator.GenerateStar(AlternateProperties);
+
+        const std::array Deltas
+        {
+            CalculateRelativeDelta(Star.GetMass(),       AlternateStar.GetMass()),
+            CalculateRelativeDelta(Star.GetTeff(),       AlternateStar.GetTeff()),
+            CalculateRelativeDelta(Star.GetRadius(),     AlternateStar.GetRadius()),
+            CalculateRelativeDelta(Star.GetLuminosity(), AlternateStar.GetLuminosity())
+        };
+
+        for (std::size_t j = 0; j != Deltas.size(); ++j)
+        {
+            Comparison.MaxDeltas[j]   = std::max(Comparison.MaxDeltas[j], Deltas[j]);
+            Comparison.MeanDeltas[j] += Deltas[j];
+        }
+
+        if (Star.GetEvolutionPhase() != AlternateStar.GetEvolutionPhase())
+        {
+            ++Comparison.PhaseMismatches;
+        }
+
+        if (Star.GetStellarClass().ToString() != AlternateStar.GetStellarClass().ToString())
+        {
+            ++Comparison.ClassMismatches;
+        }
+    }
+
+    for (double& MeanDelta : Comparison.MeanDeltas)
+    {
+        MeanDelta /= static_cast<double>(std::max<std::size_t>(Comparison.StarCount, 1));
+    }
+
+    return Comparison;
+}
+
+void FStellarBenchmark::PrintHeader(std::ostream& Output) const
+{
+    Output << "scenario,option,feh_lower,feh_upper,mass_lower,mass_upper,age_lower,age_upper,"
+              "threads,stars,seconds,stars_per_sec,allocs_per_star";
+
+    for (const char* StageName : kStageNames)
+    {
+        Output << ',' << StageName << "_calls," << StageName << "_ns_per_star";
+    }
+
+    Output << ",compared_stars,phase_mismatches,class_mismatches";
+    for (const char* PropertyName : kComparedPropertyNames)
+    {
+        Output << ',' << PropertyName << "_max_delta," << PropertyName << "_mean_delta";
+    }
+
+    Output << '\n';
+}
+
+void FStellarBenchmark::PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const
+{
+    double StarCount = static_cast<double>(std::max<std::size_t>(_StarCount, 1));
+    double AllocationsPerStar = Util::FAllocationCounter::IsEnabled()
+                              ? Result.Allocations / StarCount : std::numeric_limits<double>::quiet_NaN();
+
+    Output << std::format("{},{},{},{},{},{},{:.6g},{:.6g},{},{},{:.6f},{:.2f},{:.3f}",
+                          Scenario.Name, GetOptionName(Scenario.StellarTypeOption),
+                          Scenario.FeHLowerLimit, Scenario.FeHUpperLimit, Scenario.MassLowerLimit, Scenario.MassUpperLimit,
+                          Scenario.AgeLowerLimit, Scenario.AgeUpperLimit, _ThreadCount, _StarCount, Result.Seconds,
+                          _StarCount / Result.Seconds, AllocationsPerStar);
+
+    // 各阶段耗时为所有线程的总和，嵌套阶段（如 GetFullMistData 包含 InterpolateMistData）计入完整耗时
+    for (std::size_t i = 0; i != kStageNames.size(); ++i)
+    {
+        const auto& Record = Result.StageRecords[i];
+        Output << std::format(",{},{:.1f}", Record.Calls, Record.Nanoseconds / StarCount);
+    }
+
+    // 偏差为完整数据与紧凑数据生成结果的相对差，与全局注册表使用哪一种无关
+    const auto& Comparison = Result.MistComparison;
+    Output << std::format(",{},{},{}", Comparison.StarCount, Comparison.PhaseMismatches, Comparison.ClassMismatches);
+    for (std::size_t i = 0; i != kComparedPropertyNames.size(); ++i)
+    {
+        Output << std::format(",{:.3e},{:.3e}", Comparison.MaxDeltas[i], Comparison.MeanDeltas[i]);
+    }
+
+    Output << '\n';
+}
+
+_NPGS_END
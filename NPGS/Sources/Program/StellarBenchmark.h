@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Generators/StellarGenerator.h"
+#include "Engine/Utils/Profiler.h"
+
+_NPGS_BEGIN
+
+// 恒星生成基准测试，不创建窗口和图形上下文
+// 每个场景输出一行 CSV，包含吞吐量、每颗恒星的分配次数和各阶段耗时，便于不同版本之间对比
+// 计时结束后再用完整和紧凑两种 MIST 数据生成同一批恒星（不计时），输出性质的相对偏差和演化阶段、光谱型不一致的数量
+class FStellarBenchmark
+{
+public:
+    using FStellarGenerator = System::Generator::FStellarGenerator;
+
+    struct FScenario
+    {
+        std::string Name;
+        FStellarGenerator::EStellarTypeGenerationOption StellarTypeOption{ FStellarGenerator::EStellarTypeGenerationOption::kRandom };
+        float MassLowerLimit{ 0.075f };
+        float MassUpperLimit{ 300.0f };
+        FStellarGenerator::EGenerationDistribution MassDistribution{ FStellarGenerator::EGenerationDistribution::kFromPdf };
+        float AgeLowerLimit{ 0.0f };
+        float AgeUpperLimit{ 1.26e10f };
+        FStellarGenerator::EGenerationDistribution AgeDistribution{ FStellarGenerator::EGenerationDistribution::kFromPdf };
+        float FeHLowerLimit{ -4.0f };
+        float FeHUpperLimit{ 0.5f };
+        FStellarGenerator::EGenerationDistribution FeHDistribution{ FStellarGenerator::EGenerationDistribution::kFromPdf };
+    };
+
+    struct FMistComparison
+    {
+        std::size_t           StarCount{};
+        std::size_t           PhaseMismatches{};
+        std::size_t           ClassMismatches{};
+        std::array<double, 4> MaxDeltas{};  // 质量、有效温度、半径、光度的最大相对偏差
+        std::array<double, 4> MeanDeltas{};
+    };
+
+    struct FResult
+    {
+        double        Seconds{};
+        std::uint64_t Allocations{};
+        Util::FStageProfiler::FStageRecords StageRecords{};
+        FMistComparison MistComparison{};
+    };
+
+public:
+    FStellarBenchmark(std::uint32_t Seed, std::size_t StarCount, int ThreadCount);
+    ~FStellarBenchmark() = default;
+
+    void AddScenario(const FScenario& Scenario);
+    void AddDefaultScenarios(); // 四种生成选项与若干金属丰度、质量、年龄范围的组合
+    void Run(std::ostream& Output);
+
+private:
+    FResult RunScenario(const FScenario& Scenario);
+    FMistComparison CompareMistData(const FScenario& Scenario) const;
+    void PrintHeader(std::ostream& Output) const;
+    void PrintResult(std::ostream& Output, const FScenario& Scenario, const FResult& Result) const;
+
+private:
+    std::vector<FScenario> _Scenarios;
+    std::uint32_t          _Seed;
+    std::size_t            _StarCount;
+    int                    _ThreadCount;
+
+    static constexpr std::size_t _kMaxComparedStars = 1000;
+};
+
+_NPGS_END
@@ -1,5 +1,6 @@
 #include "Universe.h"
 
+#include <cmath>
 #include <cstdlib>
 #include <algorithm>
 #include <array>
@@ -9,19 +10,110 @@
 #include <limits>
 #include <print>
 #include <ranges>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
 #include "Engine/Core/Base/Base.h"
 #include "Engine/Core/Math/NumericConstants.h"
 #include "Engine/Core/System/Generators/OrbitalGenerator.h"
+#include "Engine/Core/System/Generators/StellarPopulation.h"
+#include "Engine/Core/System/Spatial/OctreeImage.h"
+#include "Engine/Core/Runtime/AssetLoaders/MappedFile.h"
 #include "Engine/Utils/Logger.h"
 
 _NPGS_BEGIN
 
 namespace SysGen = Npgs::System::Generator;
 
+// Tool functions
+// --------------
+namespace
+{
+    // 恒星系统作为一个光源，光度为所有恒星之和，单位为太阳光度；位置单位为光年，有效温度按光度加权
+    System::Spatial::FNodeAggregate MakeStellarSource(Astro::FStellarSystem& System)
+    {
+        double Luminosity   = 0.0;
+        double WeightedTeff = 0.0;
+        double TeffSum      = 0.0;
+        for (const auto& Star : System.StarsData())
+        {
+            Luminosity   += Star->GetLuminosity();
+            WeightedTeff += Star->GetLuminosity() * Star->GetTeff();
+            TeffSum      += Star->GetTeff();
+        }
+
+        std::size_t StarCount = System.StarsData().size();
+        float Teff = Luminosity > 0.0 ? static_cast<float>(WeightedTeff / Luminosity)
+                                      : (StarCount != 0 ? static_cast<float>(TeffSum / StarCount) : 0.0f);
+
+        float LuminositySol = static_cast<float>(Luminosity / kSolarLuminosity);
+        return { System.GetBaryPosition(), LuminositySol, LuminositySol, Teff, 1 };
+    }
+
+    // 探测器以恒星辐射为能源，复制时间与总光度的平方根成反比，绕太阳为 1000 yr；主星为致密残骸时只发射 1 个探测器
+    // 给出 PlanetarySystem 时，探测器数再按可开采质量（行星地壳矿物和小行星带）的数量级调整，没有固体物质的系统无法复制
+    System::Simulation::FProbeExpansionSimulator::FSystemTraits
+    EvaluateProbeTraits(Astro::FStellarSystem& System, Astro::FStellarSystem* PlanetarySystem)
+    {
+        constexpr float         kSolarReplicationTime = 1000.0f;
+        constexpr std::uint32_t kBaseProbeCount       = 4;
+        constexpr std::uint32_t kMaxProbeCount        = 8;
+        constexpr float         kMinMineralMassLog    = 18.0f; // 1e18 kg 以下视为不足以复制
+
+        if (System.StarsData().empty())
+        {
+            return {};
+        }
+
+        double Luminosity = 0.0;
+        for (const auto& Star : System.StarsData())
+        {
+            Luminosity += Star->GetLuminosity();
+        }
+
+        float LuminositySol   = static_cast<float>(Luminosity / kSolarLuminosity);
+        float ReplicationTime = kSolarReplicationTime / std::sqrt(std::clamp(LuminositySol, 1e-2f, 1e2f));
+
+        // 恒星按质量降序存放，第一颗为主星
+        auto Phase = System.StarsData().front()->GetEvolutionPhase();
+        bool bIsCompactRemnant = Phase >= Astro::AStar::EEvolutionPhase::kHeliumWhiteDwarf &&
+                                 Phase != Astro::AStar::EEvolutionPhase::kNull;
+        std::uint32_t ProbeCount = bIsCompactRemnant ? 1 : kBaseProbeCount;
+
+        if (PlanetarySystem != nullptr)
+        {
+            float MineralMass = 0.0f;
+            for (const auto& Planet : PlanetarySystem->PlanetsData())
+            {
+                MineralMass += Planet->GetCrustMineralMassDigital<float>();
+            }
+
+            for (const auto& Cluster : PlanetarySystem->AsteroidClustersData())
+            {
+                MineralMass += Cluster->GetMassDigital<float>();
+            }
+
+            if (!(MineralMass > 0.0f))
+            {
+                return {};
+            }
+
+            float Magnitude = std::floor(std::log10(MineralMass) - kMinMineralMassLog);
+            if (Magnitude < 0.0f)
+            {
+                return {};
+            }
+
+            ProbeCount = std::min(ProbeCount + static_cast<std::uint32_t>(Magnitude), kMaxProbeCount);
+        }
+
+        return { ReplicationTime, ProbeCount };
+    }
+}
+
 FUniverse::FUniverse(std::uint32_t Seed, std::size_t StarCount, std::size_t ExtraGiantCount, std::size_t ExtraMassiveStarCount,
                      std::size_t ExtraNeutronStarCount, std::size_t ExtraBlackHoleCount, std::size_t ExtraMergeStarCount,
                      float UniverseAge)
@@ -55,29 +147,236 @@ void FUniverse::FillUniverse()
     int MaxThread = _ThreadPool->GetMaxThreadCount();
 
     GenerateStars(MaxThread);
-    FillStellarSystem(MaxThread);
-
-    _ThreadPool->Terminate();
+    FillStellarSystem();
 }
 
 void FUniverse::ReplaceStar(std::size_t DistanceRank, const Astro::AStar& StarData)
 {
-    for (auto& System : _StellarSystems)
+    std::size_t Index = FindSystemIndex(DistanceRank);
+    if (Index == _StellarSystems.size())
     {
-        if (DistanceRank == System.GetBaryDistanceRank())
+        return;
+    }
+
+    auto& System = _StellarSystems[Index];
+    if (System.StarsData().size() > 1)
+    {
+        return; // TODO: 处理双星
+    }
+
+    // 行星缓存可能正在其他线程复制该系统的恒星，修改须在缓存锁内进行
+    auto Updater = [&StarData](Astro::FStellarSystem& Target) -> void
+    {
+        auto& Stars = Target.StarsData();
+        Stars.clear();
+        Stars.push_back(std::make_unique<Astro::AStar>(StarData));
+    };
+
+    if (_PlanetarySystemCache != nullptr)
+    {
+        _PlanetarySystemCache->UpdateSource(Index, Updater);
+    }
+    else
+    {
+        Updater(System);
+    }
+
+    // 只重算所在叶子到根的汇总
+    if (_Octree != nullptr)
+    {
+        FNodeType* Node = _Octree->Find(System.GetBaryPosition(), [&System](const FNodeType& Candidate) -> bool
         {
-            auto& Stars = System.StarsData();
-            if (Stars.size() > 1)
-            {
-                return; // TODO: 处理双星
-            }
+            return Candidate.GetLink([&System](Astro::FStellarSystem* Target) -> bool { return Target == &System; }) != nullptr;
+        });
 
-            Stars.clear();
-            Stars.push_back(std::make_unique<Astro::AStar>(StarData));
+        if (Node != nullptr)
+        {
+            _Octree->UpdateAggregates(Node, &MakeStellarSource);
         }
     }
 }
 
+void FUniverse::QueryVisibleSystems(const System::Spatial::FFrustum& Frustum, const System::Spatial::FVisibilityCriteria& Criteria,
+                                    std::vector<FVisibleSystem>& Results) const
+{
+    Results.clear();
+    if (_Octree != nullptr)
+    {
+        _Octree->QueryVisible(Frustum, Criteria, &MakeStellarSource, Results);
+    }
+}
+
+void FUniverse::QueryVisibleSystems(const System::Spatial::FViewCone& Cone, const System::Spatial::FVisibilityCriteria& Criteria,
+                                    std::vector<FVisibleSystem>& Results) const
+{
+    Results.clear();
+    if (_Octree != nullptr)
+    {
+        _Octree->QueryVisible(Cone, Criteria, &MakeStellarSource, Results);
+    }
+}
+
+System::Spatial::FNodeAggregate FUniverse::QueryRegionAggregate(glm::vec3 Center, float Radius) const
+{
+    if (_Octree == nullptr)
+    {
+        return {};
+    }
+
+    return _Octree->QueryAggregate(Center, Radius, &MakeStellarSource);
+}
+
+void FUniverse::SaveOctree(const std::string& Filename) const
+{
+    if (_Octree == nullptr)
+    {
+        throw std::logic_error("Octree has not been built.");
+    }
+
+    System::Spatial::FOctreeImage Image(*_Octree, _StellarSystems.size(), [this](const Astro::FStellarSystem* System) -> std::size_t
+    {
+        return static_cast<std::size_t>(System - _StellarSystems.data());
+    });
+
+    Image.Save(Filename);
+}
+
+bool FUniverse::LoadOctree(const std::string& Filename)
+{
+    auto File = Runtime::Asset::FMappedFile::Open(Filename);
+    if (File == nullptr)
+    {
+        return false;
+    }
+
+    try
+    {
+        System::Spatial::FOctreeImage Image(File->GetData(), File->GetSize());
+        _Octree = Image.Rebuild(std::span<Astro::FStellarSystem>(_StellarSystems));
+    }
+    catch (const std::exception& e)
+    {
+        NpgsCoreError("Failed to load octree image \"{}\": {}", Filename, e.what());
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<Astro::FStellarSystem> FUniverse::GetPlanetarySystem(std::size_t DistanceRank)
+{
+    if (_PlanetarySystemCache == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::size_t Index = FindSystemIndex(DistanceRank);
+    return Index != _StellarSystems.size() ? _PlanetarySystemCache->Acquire(Index) : nullptr;
+}
+
+void FUniverse::BuildSpatialHashGrid(float CellSize)
+{
+    NpgsCoreInfo("Building spatial hash grid of {} stellar systems...", _StellarSystems.size());
+
+    std::vector<glm::vec3>              Positions(_StellarSystems.size());
+    std::vector<Astro::FStellarSystem*> Links(_StellarSystems.size());
+    for (std::size_t i = 0; i != _StellarSystems.size(); ++i)
+    {
+        Positions[i] = _StellarSystems[i].GetBaryPosition();
+        Links[i]     = &_StellarSystems[i];
+    }
+
+    _SpatialHashGrid = std::make_unique<System::Spatial::TSpatialHashGrid<Astro::FStellarSystem>>(CellSize);
+    _SpatialHashGrid->Build(Positions, Links);
+
+    NpgsCoreInfo("Spatial hash grid completed with {} cells, {} MiB.", _SpatialHashGrid->GetCellCount(),
+                 _SpatialHashGrid->GetMemoryUsage() >> 20);
+}
+
+const System::Spatial::TSpatialHashGrid<Astro::FStellarSystem>* FUniverse::GetSpatialHashGrid() const
+{
+    return _SpatialHashGrid.get();
+}
+
+void FUniverse::BuildNeighbourGraph(const System::Spatial::FNeighbourGraph::FBuildInfo& BuildInfo)
+{
+    NpgsCoreInfo("Building neighbour graph of {} stellar systems...", _StellarSystems.size());
+
+    std::vector<glm::vec3> Positions(_StellarSystems.size());
+    for (std::size_t i = 0; i != _StellarSystems.size(); ++i)
+    {
+        Positions[i] = _StellarSystems[i].GetBaryPosition();
+    }
+
+    _NeighbourGraph = std::make_unique<System::Spatial::FNeighbourGraph>();
+    _NeighbourGraph->Build(Positions, BuildInfo);
+
+    NpgsCoreInfo("Neighbour graph completed with {} edges, {} MiB.", _NeighbourGraph->GetEdgeCount(),
+                 _NeighbourGraph->GetMemoryUsage() >> 20);
+}
+
+const System::Spatial::FNeighbourGraph* FUniverse::GetNeighbourGraph() const
+{
+    return _NeighbourGraph.get();
+}
+
+std::vector<std::size_t> FUniverse::FindProbeRoute(std::size_t SourceRank, std::size_t TargetRank, float MaxJumpDistance,
+                                                   float HeuristicWeight) const
+{
+    std::size_t Source = FindSystemIndex(SourceRank);
+    std::size_t Target = FindSystemIndex(TargetRank);
+    if (_NeighbourGraph == nullptr || Source == _StellarSystems.size() || Target == _StellarSystems.size())
+    {
+        return {};
+    }
+
+    System::Spatial::FNeighbourGraph::FRouteRequest Request;
+    Request.Source          = static_cast<std::uint32_t>(Source);
+    Request.Target          = static_cast<std::uint32_t>(Target);
+    Request.MaxJumpDistance = MaxJumpDistance;
+    Request.HeuristicWeight = HeuristicWeight;
+
+    auto Route = _NeighbourGraph->FindRoute(Request);
+
+    std::vector<std::size_t> Ranks;
+    Ranks.reserve(Route.Systems.size());
+    for (std::uint32_t Index : Route.Systems)
+    {
+        Ranks.push_back(_StellarSystems[Index].GetBaryDistanceRank());
+    }
+
+    return Ranks;
+}
+
+std::unique_ptr<System::Simulation::FProbeExpansionSimulator>
+FUniverse::CreateProbeExpansion(const System::Simulation::FProbeExpansionSimulator::FSimulationInfo& SimulationInfo,
+                                bool bConsultPlanets)
+{
+    std::size_t Home = FindSystemIndex(0);
+    if (_NeighbourGraph == nullptr || Home == _StellarSystems.size())
+    {
+        return nullptr;
+    }
+
+    auto Info = SimulationInfo;
+    Info.HomeSystem = static_cast<std::uint32_t>(Home);
+
+    // 求值函数会被多个线程同时调用，只读恒星数据；行星缓存内部加锁
+    bool bUsePlanets = bConsultPlanets && _PlanetarySystemCache != nullptr;
+    auto Evaluator = [this, bUsePlanets](std::uint32_t SystemIndex) -> System::Simulation::FProbeExpansionSimulator::FSystemTraits
+    {
+        if (!bUsePlanets)
+        {
+            return EvaluateProbeTraits(_StellarSystems[SystemIndex], nullptr);
+        }
+
+        auto PlanetarySystem = _PlanetarySystemCache->Acquire(SystemIndex);
+        return EvaluateProbeTraits(_StellarSystems[SystemIndex], PlanetarySystem.get());
+    };
+
+    return std::make_unique<System::Simulation::FProbeExpansionSimulator>(*_NeighbourGraph, Info, std::move(Evaluator));
+}
+
 void FUniverse::CountStars()
 {
     constexpr int kTypeOIndex = 0;
@@ -582,6 +881,38 @@ void FUniverse::CountStars()
     std::println("");
 }
 
+void FUniverse::SynthesizePopulation(std::size_t StarCount)
+{
+    int MaxThread = _ThreadPool->GetMaxThreadCount();
+
+    std::vector<SysGen::FStellarGenerator> Generators;
+    Generators.reserve(MaxThread);
+    for (int i = 0; i != MaxThread; ++i)
+    {
+        std::vector<std::uint32_t> Seeds(32);
+        for (int i = 0; i != 32; ++i)
+        {
+            Seeds[i] = _SeedGenerator(_RandomEngine);
+        }
+
+        std::shuffle(Seeds.begin(), Seeds.end(), _RandomEngine);
+        std::seed_seq SeedSequence(Seeds.begin(), Seeds.end());
+
+        SysGen::FStellarGenerator::FGenerationInfo GenerationInfo
+        {
+            .SeedSequence   = &SeedSequence,
+            .UniverseAge    = _UniverseAge,
+            .MassLowerLimit = 0.075f
+        };
+
+        Generators.emplace_back(GenerationInfo);
+    }
+
+    NpgsCoreInfo("Streaming {} stars into census as {} physical cores...", StarCount, MaxThread);
+    auto Census = SysGen::StreamStellarPopulation(Generators, StarCount, SysGen::FStellarCensus());
+    Census.Print();
+}
+
 void FUniverse::GenerateStars(int MaxThread)
 {
     NpgsCoreInfo("Initializating and generating basic properties...");
@@ -786,29 +1117,36 @@ void FUniverse::GenerateStars(int MaxThread)
         Star->SetNormal(glm::vec3(0.0f));
     }
 
+    NpgsCoreInfo("Building octree luminosity aggregates...");
+    _Octree->BuildAggregates(&MakeStellarSource, MaxThread);
+
     NpgsCoreInfo("Stellar generation completed.");
 }
 
-void FUniverse::FillStellarSystem(int MaxThread)
+void FUniverse::FillStellarSystem()
 {
-    NpgsCoreInfo("Generating planets...");
+    NpgsCoreInfo("Assigning planetary system seeds...");
 
-    std::vector<SysGen::FOrbitalGenerator> Generators;
+    // 行星不在此处生成，只为每个恒星系统分配种子，访问时再由缓存展开
+    SysGen::FOrbitalGenerator::FGenerationInfo GenerationInfo;
+    GenerationInfo.UniverseAge = _UniverseAge;
 
-    for (int i = 0; i != MaxThread; ++i)
+    _PlanetarySystemCache = std::make_unique<SysGen::FPlanetarySystemCache>(GenerationInfo, _kPlanetarySystemCacheCapacity);
+    _PlanetarySystemCache->Reserve(_StellarSystems.size());
+    for (auto& System : _StellarSystems)
     {
-        std::vector<std::uint32_t> Seeds(32);
-        for (int i = 0; i != 32; ++i)
+        _PlanetarySystemCache->Register(&System, _SeedGenerator(_RandomEngine));
+    }
+
+    // 距离排名到下标的对照表，排名相同时取下标最小的系统；空位填 _StellarSystems.size() 表示不存在
+    _SystemIndices.assign(_StellarSystems.size(), _StellarSystems.size());
+    for (std::size_t i = _StellarSystems.size(); i-- != 0;)
+    {
+        std::size_t DistanceRank = _StellarSystems[i].GetBaryDistanceRank();
+        if (DistanceRank < _SystemIndices.size())
         {
-            Seeds[i] = _SeedGenerator(_RandomEngine);
+            _SystemIndices[DistanceRank] = i;
         }
-
-        std::shuffle(Seeds.begin(), Seeds.end(), _RandomEngine);
-        std::seed_seq SeedSequence(Seeds.begin(), Seeds.end());
-
-        SysGen::FOrbitalGenerator::FGenerationInfo GenerationInfo;
-        GenerationInfo.SeedSequence = &SeedSequence;
-        Generators.emplace_back(GenerationInfo);
     }
 }
 
@@ -859,7 +1197,7 @@ void FUniverse::GenerateSlots(float MinDistance, std::size_t SampleCount, float
     _Octree->BuildEmptyTree(LeafRadius); // 快速构建一个空树，每个叶子节点作为一个格子，用于生成恒星
 
     // 遍历八叉树，将距离原点大于半径的叶子节点标记为无效，保证恒星只会在范围内生成
-    _Octree->Traverse([Radius](FNodeType& Node) -> void
+    _Octree->ParallelTraverse([Radius](FNodeType& Node) -> void
     {
         if (Node.IsLeafNode() && glm::length(Node.GetCenter()) > Radius)
         {
@@ -870,19 +1208,24 @@ void FUniverse::GenerateSlots(float MinDistance, std::size_t SampleCount, float
     std::size_t ValidLeafCount = _Octree->GetCapacity();
     std::vector<FNodeType*> LeafNodes;
 
-    auto CollectLeafNodes = [&LeafNodes](FNodeType& Node) -> void
+    // 并行收集，合并后的顺序与串行遍历相同，保证打乱结果不变
+    auto CollectLeafNodes = [](FNodeType& Node, std::vector<FNodeType*>& Nodes) -> void
     {
         if (Node.IsLeafNode())
         {
-            LeafNodes.push_back(&Node);
+            Nodes.push_back(&Node);
         }
     };
 
+    auto MergeLeafNodes = [](std::vector<FNodeType*>& Target, std::vector<FNodeType*>&& Source) -> void
+    {
+        Target.insert(Target.end(), Source.begin(), Source.end());
+    };
+
     // 使用栅格采样，八叉树的每个叶子节点作为一个格子，在这个格子中生成一个恒星
     while (ValidLeafCount != SampleCount)
     {
-        LeafNodes.clear();
-        _Octree->Traverse(CollectLeafNodes);
+        LeafNodes = _Octree->ParallelReduce(std::vector<FNodeType*>{}, CollectLeafNodes, MergeLeafNodes);
         std::shuffle(LeafNodes.begin(), LeafNodes.end(), _RandomEngine); // 打乱叶子节点，保证随机性
 
         // 删除或收回叶子节点，直到格子数量等于目标数量
@@ -948,28 +1291,60 @@ void FUniverse::GenerateSlots(float MinDistance, std::size_t SampleCount, float
 
 void FUniverse::OctreeLinkToStellarSystems(std::vector<Astro::AStar>& Stars, std::vector<glm::vec3>& Slots)
 {
-    std::size_t Index = 0;
-
-    _Octree->Traverse([&](FNodeType& Node) -> void
+    // 先按遍历顺序收集有效叶子，用前缀和确定每个叶子中恒星系统的编号，再并行链接，编号与串行遍历时相同
+    std::vector<FNodeType*> ValidLeafNodes = _Octree->ParallelReduce(std::vector<FNodeType*>{},
+    [](FNodeType& Node, std::vector<FNodeType*>& Nodes) -> void
     {
         if (Node.IsLeafNode() && Node.IsValid())
         {
-            for (const auto& Point : Node.GetPoints())
+            Nodes.push_back(&Node);
+        }
+    },
+    [](std::vector<FNodeType*>& Target, std::vector<FNodeType*>&& Source) -> void
+    {
+        Target.insert(Target.end(), Source.begin(), Source.end());
+    });
+
+    std::vector<std::size_t> Offsets(ValidLeafNodes.size() + 1, 0);
+    for (std::size_t i = 0; i != ValidLeafNodes.size(); ++i)
+    {
+        Offsets[i + 1] = Offsets[i] + ValidLeafNodes[i]->GetPoints().size();
+    }
+
+    std::size_t SystemCount = Offsets.back();
+    std::size_t StarCount   = Stars.size();
+    _StellarSystems.resize(SystemCount);
+    Slots.resize(SystemCount);
+
+    // 第 Index 个系统取 Stars 从末尾数起的第 Index 颗恒星
+    Runtime::Thread::ParallelFor(ValidLeafNodes.size(), _ThreadPool->GetMaxThreadCount(),
+    [&](std::size_t Begin, std::size_t End, std::size_t) -> void
+    {
+        for (std::size_t i = Begin; i != End; ++i)
+        {
+            FNodeType* Node = ValidLeafNodes[i];
+            std::size_t Index = Offsets[i];
+            for (const auto& Point : Node->GetPoints())
             {
                 Astro::FBaryCenter NewBary(Point, glm::vec2(0.0f), 0, "");
-                Astro::FStellarSystem NewSystem(NewBary);
-                NewSystem.StarsData().push_back(std::make_unique<Astro::AStar>(Stars.back()));
+                Astro::FStellarSystem& NewSystem = _StellarSystems[Index];
+                NewSystem = Astro::FStellarSystem(NewBary);
+                NewSystem.StarsData().push_back(std::make_unique<Astro::AStar>(std::move(Stars[StarCount - 1 - Index])));
                 NewSystem.SetBaryNormal(NewSystem.StarsData().front()->GetNormal());
-                Stars.pop_back();
-
-                _StellarSystems.push_back(std::move(NewSystem));
 
-                Node.AddLink(&_StellarSystems[Index]);
-                Slots.push_back(Point);
+                Node->AddLink(&NewSystem);
+                Slots[Index] = Point;
                 ++Index;
             }
         }
     });
+
+    Stars.erase(Stars.end() - static_cast<std::ptrdiff_t>(SystemCount), Stars.end());
+}
+
+std::size_t FUniverse::FindSystemIndex(std::size_t DistanceRank) const
+{
+    return DistanceRank < _SystemIndices.size() ? _SystemIndices[DistanceRank] : _StellarSystems.size();
 }
 
 void FUniverse::GenerateBinaryStars(int MaxThread)
@@ -3,13 +3,18 @@
 #include <cstddef>
 #include <memory>
 #include <random>
+#include <string>
 #include <vector>
 
 #include <glm/glm.hpp>
 
 #include "Engine/Core/Base/Base.h"
+#include "Engine/Core/System/Generators/PlanetarySystemCache.h"
 #include "Engine/Core/System/Generators/StellarGenerator.h"
+#include "Engine/Core/System/Simulation/ProbeExpansion.h"
+#include "Engine/Core/System/Spatial/NeighbourGraph.h"
 #include "Engine/Core/System/Spatial/Octree.hpp"
+#include "Engine/Core/System/Spatial/SpatialHashGrid.hpp"
 #include "Engine/Core/Runtime/Threads/ThreadPool.h"
 #include "Engine/Core/Types/Entries/Astro/Star.h"
 #include "Engine/Core/Types/Entries/Astro/StellarSystem.h"
@@ -19,6 +24,9 @@ _NPGS_BEGIN
 
 class FUniverse
 {
+public:
+    using FVisibleSystem = System::Spatial::TVisibleSource<Astro::FStellarSystem>;
+
 public:
     FUniverse() = delete;
     FUniverse(std::uint32_t Seed, std::size_t StarCount, std::size_t ExtraGiantCount = 0, std::size_t ExtraMassiveStarCount = 0,
@@ -30,28 +38,71 @@ public:
     void FillUniverse();
     void ReplaceStar(std::size_t DistanceRank, const Astro::AStar& StarData);
     void CountStars();
+    void SynthesizePopulation(std::size_t StarCount); // 流式生成并统计恒星族群，不保存恒星
+
+    // 按距离排名取得展开了行星的恒星系统，行星在第一次访问时生成并进入 LRU 缓存，找不到时返回空指针
+    std::shared_ptr<Astro::FStellarSystem> GetPlanetarySystem(std::size_t DistanceRank);
+
+    // 查询视锥体或圆锥内可见的恒星系统，远处暗弱的子树合并为汇总光源；判据中光度单位为太阳光度，距离单位为光年
+    void QueryVisibleSystems(const System::Spatial::FFrustum& Frustum, const System::Spatial::FVisibilityCriteria& Criteria,
+                             std::vector<FVisibleSystem>& Results) const;
+    void QueryVisibleSystems(const System::Spatial::FViewCone& Cone, const System::Spatial::FVisibilityCriteria& Criteria,
+                             std::vector<FVisibleSystem>& Results) const;
+
+    // 球形区域内恒星系统的总光度、数量、质心和光度加权有效温度，代价取决于访问的节点数而不是恒星数
+    System::Spatial::FNodeAggregate QueryRegionAggregate(glm::vec3 Center, float Radius) const;
+
+    // 保存八叉树的不含指针存档，链接保存为 _StellarSystems 的下标
+    void SaveOctree(const std::string& Filename) const;
+    // 映射存档并按当前的 _StellarSystems 重建八叉树，代替插入和链接过程；文件不可用时返回 false
+    bool LoadOctree(const std::string& Filename);
+
+    // 以恒星系统质心建立哈希均匀网格，链接指向 _StellarSystems。恒星按抖动栅格均匀分布，近邻查询可以用它代替八叉树，
+    // 哪个更快可以用 --spatial-benchmark 比较；CellSize 单位为光年，取平均间距的一到两倍较合适
+    void BuildSpatialHashGrid(float CellSize);
+    const System::Spatial::TSpatialHashGrid<Astro::FStellarSystem>* GetSpatialHashGrid() const;
+
+    // 以恒星系统为顶点建立邻接图，顶点编号为 _StellarSystems 中的下标，探测器航线在此图上规划
+    void BuildNeighbourGraph(const System::Spatial::FNeighbourGraph::FBuildInfo& BuildInfo);
+    const System::Spatial::FNeighbourGraph* GetNeighbourGraph() const;
+
+    // 按距离排名规划航线，返回途经系统的距离排名，含起点和终点；不可达或邻接图未建立时返回空
+    std::vector<std::size_t> FindProbeRoute(std::size_t SourceRank, std::size_t TargetRank, float MaxJumpDistance,
+                                            float HeuristicWeight = 1.0f) const;
+
+    // 在邻接图上模拟从家园系统（距离排名为 0）出发的探测器扩张，SimulationInfo.HomeSystem 会被忽略；邻接图未建立时返回空指针
+    // 复制时间和探测器数由恒星光度和演化阶段决定，bConsultPlanets 为 true 时还按行星和小行星带的质量决定探测器数，
+    // 每个抵达的系统都要展开行星，慢得多。模拟器引用本对象的数据，邻接图重建或恒星被替换后不应继续使用
+    std::unique_ptr<System::Simulation::FProbeExpansionSimulator>
+    CreateProbeExpansion(const System::Simulation::FProbeExpansionSimulator::FSimulationInfo& SimulationInfo,
+                         bool bConsultPlanets = false);
 
 private:
     void GenerateStars(int MaxThread);
-    void FillStellarSystem(int MaxThread);
+    void FillStellarSystem();
 
     std::vector<Astro::AStar> InterpolateStars(int MaxThread, std::vector<System::Generator::FStellarGenerator>& Generators,
                                                std::vector<System::Generator::FStellarGenerator::FBasicProperties>& BasicProperties);
 
     void GenerateSlots(float MinDistance, std::size_t SampleCount, float Density);
     void OctreeLinkToStellarSystems(std::vector<Astro::AStar>& Stars, std::vector<glm::vec3>& Slots);
+    std::size_t FindSystemIndex(std::size_t DistanceRank) const; // 查 _SystemIndices，找不到时返回 _StellarSystems.size()
     void GenerateBinaryStars(int MaxThread);
 
 private:
     using FNodeType = System::Spatial::TOctree<Astro::FStellarSystem>::FNodeType;
 
 private:
-    std::mt19937                                                     _RandomEngine;
-    std::vector<Astro::FStellarSystem>                               _StellarSystems;
-    Util::TUniformIntDistribution<std::uint32_t>                     _SeedGenerator;
-    Util::TUniformRealDistribution<>                                 _CommonGenerator;
-    std::unique_ptr<System::Spatial::TOctree<Astro::FStellarSystem>> _Octree;
-    Runtime::Thread::FThreadPool*                                    _ThreadPool;
+    std::mt19937                                                              _RandomEngine;
+    std::vector<Astro::FStellarSystem>                                        _StellarSystems;
+    std::vector<std::size_t>                                                  _SystemIndices; // 按距离排名索引 _StellarSystems 的下标
+    Util::TUniformIntDistribution<std::uint32_t>                              _SeedGenerator;
+    Util::TUniformRealDistribution<>                                          _CommonGenerator;
+    std::unique_ptr<System::Spatial::TOctree<Astro::FStellarSystem>>          _Octree;
+    std::unique_ptr<System::Generator::FPlanetarySystemCache>                 _PlanetarySystemCache;
+    std::unique_ptr<System::Spatial::FNeighbourGraph>                         _NeighbourGraph;
+    std::unique_ptr<System::Spatial::TSpatialHashGrid<Astro::FStellarSystem>> _SpatialHashGrid;
+    Runtime::Thread::FThreadPool*                                             _ThreadPool;
 
     std::size_t _StarCount;
     std::size_t _ExtraGiantCount;
@@ -60,6 +111,8 @@ private:
     std::size_t _ExtraBlackHoleCount;
     std::size_t _ExtraMergeStarCount;
     float       _UniverseAge;
+
+    static constexpr std::size_t _kPlanetarySystemCacheCapacity = 4096;
 };
 
 _NPGS_END
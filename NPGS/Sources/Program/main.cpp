@@ -1,13 +1,156 @@
 #include "Npgs.h"
 #include "Application.h"
+#include "OrbitalBenchmark.h"
+#include "ProbeBenchmark.h"
+#include "SpatialBenchmark.h"
+#include "StellarBenchmark.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
 
 using namespace Npgs;
 using namespace Npgs::Util;
 
-int main()
+namespace
+{
+    struct FBenchmarkOptions
+    {
+        std::size_t   Count{};
+        int           ThreadCount{ 1 };
+        std::uint32_t Seed{ 42 };
+        std::string   OutputFile;
+        std::string   SharedMistName;
+        bool          bCompactMist{ false };
+    };
+
+    FBenchmarkOptions ParseBenchmarkOptions(int argc, char* argv[], std::string_view CountPrefix, std::size_t DefaultCount)
+    {
+        FBenchmarkOptions Options{ .Count = DefaultCount };
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view Argument(argv[i]);
+            auto GetValue = [Argument](std::string_view Prefix) -> std::string_view
+            {
+                return Argument.starts_with(Prefix) ? Argument.substr(Prefix.size()) : std::string_view();
+            };
+
+            if (auto Value = GetValue(CountPrefix); !Value.empty())
+            {
+                Options.Count = std::strtoull(Value.data(), nullptr, 10);
+            }
+            else if (auto Value = GetValue("--threads="); !Value.empty())
+            {
+                Options.ThreadCount = std::atoi(Value.data());
+            }
+            else if (auto Value = GetValue("--seed="); !Value.empty())
+            {
+                Options.Seed = static_cast<std::uint32_t>(std::strtoul(Value.data(), nullptr, 10));
+            }
+            else if (auto Value = GetValue("--output="); !Value.empty())
+            {
+                Options.OutputFile = Value;
+            }
+            else if (Argument == "--compact-mist")
+            {
+                Options.bCompactMist = true;
+            }
+            else if (auto Value = GetValue("--compact-mist="); !Value.empty())
+            {
+                Options.bCompactMist   = true;
+                Options.SharedMistName = Value;
+            }
+        }
+
+        return Options;
+    }
+
+    template <typename BenchmarkType>
+    int RunBenchmark(const FBenchmarkOptions& Options)
+    {
+        if (Options.bCompactMist)
+        {
+            System::Generator::FStellarGenerator::EnableCompactMistData(Options.SharedMistName);
+        }
+
+        BenchmarkType Benchmark(Options.Seed, Options.Count, Options.ThreadCount);
+        Benchmark.AddDefaultScenarios();
+
+        if (Options.OutputFile.empty())
+        {
+            Benchmark.Run(std::cout);
+        }
+        else
+        {
+            std::ofstream Output(Options.OutputFile);
+            if (!Output.is_open())
+            {
+                NpgsCoreError("Failed to open benchmark output file \"{}\".", Options.OutputFile);
+                return EXIT_FAILURE;
+            }
+
+            Benchmark.Run(Output);
+        }
+
+        return 0;
+    }
+
+    // 以下基准测试均可附加 --compact-mist[=SharedMemoryName]，以紧凑格式驻留 MIST 数据，给出名称时与其他进程共享
+    // 分配次数只在定义 NPGS_ENABLE_ALLOCATION_COUNTER 的构建中统计，否则输出 nan。该宏由项目属性 NpgsAllocationCounter 控制，
+    // 例如 msbuild NPGS.sln /p:Configuration=Release /p:Platform=x64 /p:NpgsAllocationCounter=true；
+    // 此时 operator new 在整个程序中被替换，只应用于基准测试
+    // 用法：NPGS --stellar-benchmark [--stars=N] [--threads=N] [--seed=N] [--output=File]
+    int RunStellarBenchmark(int argc, char* argv[])
+    {
+        return RunBenchmark<FStellarBenchmark>(ParseBenchmarkOptions(argc, argv, "--stars=", 20000));
+    }
+
+    // 用法：NPGS --orbital-benchmark [--systems=N] [--threads=N] [--seed=N] [--output=File]
+    int RunOrbitalBenchmark(int argc, char* argv[])
+    {
+        return RunBenchmark<FOrbitalBenchmark>(ParseBenchmarkOptions(argc, argv, "--systems=", 2000));
+    }
+
+    // 用法：NPGS --spatial-benchmark [--stars=N] [--threads=N] [--seed=N] [--output=File]
+    int RunSpatialBenchmark(int argc, char* argv[])
+    {
+        return RunBenchmark<FSpatialBenchmark>(ParseBenchmarkOptions(argc, argv, "--stars=", 1000000));
+    }
+
+    // 用法：NPGS --probe-benchmark [--stars=N] [--threads=N] [--seed=N] [--output=File]
+    int RunProbeBenchmark(int argc, char* argv[])
+    {
+        return RunBenchmark<FProbeBenchmark>(ParseBenchmarkOptions(argc, argv, "--stars=", 100000));
+    }
+}
+
+int main(int argc, char* argv[])
 {
     FLogger::Initialize();
 
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--stellar-benchmark")
+        {
+            return RunStellarBenchmark(argc, argv);
+        }
+        else if (std::string_view(argv[i]) == "--orbital-benchmark")
+        {
+            return RunOrbitalBenchmark(argc, argv);
+        }
+        else if (std::string_view(argv[i]) == "--spatial-benchmark")
+        {
+            return RunSpatialBenchmark(argc, argv);
+        }
+        else if (std::string_view(argv[i]) == "--probe-benchmark")
+        {
+            return RunProbeBenchmark(argc, argv);
+        }
+    }
+
     FApplication App({ 1280, 960 }, "Learn glNext FPS:", false, false, true);
     App.ExecuteMainRender();
     return 0;
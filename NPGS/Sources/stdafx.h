@@ -5,7 +5,6 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <fast-cpp-csv-parser/csv.h>
 
 #define GLFW_INCLUDE_VULKAN